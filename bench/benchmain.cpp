@@ -0,0 +1,790 @@
+#include "benchmarkrunner.h"
+#include "asynclogger.h"
+#include "calchandler.h"
+#include "calculationhistory.h"
+#include "calculatorconfig.h"
+#include "calculatorsession.h"
+#include "displayformatter.h"
+#include "historyarchive.h"
+#include "historyindex.h"
+#include "historymodel.h"
+#include "keystrokelog.h"
+#include "logcategories.h"
+#include "memorymanager.h"
+#include "numberformatter.h"
+#include "numberparser.h"
+#include "tracer.h"
+
+#include <QBuffer>
+#include <QFile>
+#include <QStringList>
+#include <QTemporaryDir>
+#include <QVector>
+#include <cstdio>
+#include <random>
+
+// Микробенчмарки вычислительного ядра:
+//   calc_bench [-o <файл>] [--filter <подстрока>] [--min-time <мс>]
+//              [--samples <n>] [--max-entries <n>] [--keylog <файл>]
+// Результаты пишутся в JSON (по умолчанию в stdout), ход выполнения - в stderr.
+// Имена бенчмарков стабильны: по ним сравниваются прогоны между версиями.
+
+namespace {
+
+const int OPERAND_COUNT = 4096;
+const int EXPRESSION_COUNT = 1024;
+// Строк истории, которые панель показывает без прокрутки
+const int VISIBLE_HISTORY_ROWS = 12;
+
+struct Operands {
+    QVector<double> left;
+    QVector<double> right;
+    QVector<double> positive;
+    QVector<double> results;
+};
+
+void printUsage()
+{
+    std::fprintf(stderr,
+                 "Использование: calc_bench [-o <файл>] [--filter <подстрока>] [--min-time <мс>]\n"
+                 "                          [--samples <n>] [--max-entries <n>] [--keylog <файл>]\n"
+                 "  -o             файл для JSON (по умолчанию стандартный вывод)\n"
+                 "  --filter       запускать только бенчмарки, имя которых содержит подстроку\n"
+                 "  --min-time     минимальная длительность одного замера, мс\n"
+                 "  --samples      число замеров на бенчмарк (в JSON - медиана и минимум)\n"
+                 "  --max-entries  наибольший размер истории (от 10^3 до 10^6)\n"
+                 "  --keylog       журнал нажатий: проверить прогоном и замерить скорость;\n"
+                 "                 при несовпадении код возврата 2\n");
+}
+
+// Отладочные сообщения модулей выключены категориями (logcategories.h); включенные
+// через QT_LOGGING_RULES не попадают в терминал, но их стоимость остается в измерениях
+void silentMessageHandler(QtMsgType type, const QMessageLogContext&, const QString& message)
+{
+    if (type != QtDebugMsg && type != QtInfoMsg) {
+        std::fprintf(stderr, "%s\n", qPrintable(message));
+    }
+}
+
+Operands makeOperands()
+{
+    // Фиксированное зерно: одинаковые данные во всех прогонах
+    std::mt19937_64 generator(20240501);
+    std::uniform_real_distribution<double> magnitude(1e-3, 1e6);
+    std::bernoulli_distribution negative(0.5);
+
+    Operands operands;
+    operands.left.resize(OPERAND_COUNT);
+    operands.right.resize(OPERAND_COUNT);
+    operands.positive.resize(OPERAND_COUNT);
+    operands.results.resize(OPERAND_COUNT);
+    for (int i = 0; i < OPERAND_COUNT; ++i) {
+        operands.left[i] = negative(generator) ? -magnitude(generator) : magnitude(generator);
+        operands.right[i] = negative(generator) ? -magnitude(generator) : magnitude(generator);
+        operands.positive[i] = magnitude(generator);
+    }
+    return operands;
+}
+
+QStringList makeExpressions(const Operands& operands)
+{
+    QStringList expressions;
+    expressions.reserve(EXPRESSION_COUNT);
+    for (int i = 0; i < EXPRESSION_COUNT; ++i) {
+        const double left = operands.left.at(i);
+        const double right = operands.right.at(i);
+        const double sum = left + right;
+        expressions.append(QString("%1 + %2 = %3")
+                               .arg(DisplayFormatter::formatNumber(left))
+                               .arg(DisplayFormatter::formatNumber(right))
+                               .arg(DisplayFormatter::formatNumber(sum)));
+    }
+    return expressions;
+}
+
+void benchCalcHandler(BenchmarkRunner& runner, Operands& operands)
+{
+    const CalcHandler::Operation binaryOperations[] = {
+        CalcHandler::Operation::Add,
+        CalcHandler::Operation::Subtract,
+        CalcHandler::Operation::Multiply,
+        CalcHandler::Operation::Divide
+    };
+    const CalcHandler::Operation unaryOperations[] = {
+        CalcHandler::Operation::Percent,
+        CalcHandler::Operation::Negate,
+        CalcHandler::Operation::Square,
+        CalcHandler::Operation::SquareRoot,
+        CalcHandler::Operation::Reciprocal
+    };
+    const char* binaryNames[] = {"Add", "Subtract", "Multiply", "Divide"};
+    const char* unaryNames[] = {"Percent", "Negate", "Square", "SquareRoot", "Reciprocal"};
+
+    const double* left = operands.left.constData();
+    const double* right = operands.right.constData();
+    const double* positive = operands.positive.constData();
+    double* results = operands.results.data();
+
+    CalcHandler handler;
+    const CalcHandler::Backend backends[] = {
+        CalcHandler::Backend::Double,
+        CalcHandler::Backend::Decimal
+    };
+    const char* backendNames[] = {"double", "decimal"};
+
+    for (int b = 0; b < 2; ++b) {
+        handler.setBackend(backends[b]);
+
+        for (int o = 0; o < 4; ++o) {
+            const CalcHandler::Operation op = binaryOperations[o];
+            runner.run(QString("CalcHandler/performBinaryOperation/%1/%2")
+                           .arg(binaryNames[o]).arg(backendNames[b]),
+                       OPERAND_COUNT, [&]() {
+                double sum = 0.0;
+                for (int i = 0; i < OPERAND_COUNT; ++i) {
+                    sum += handler.performBinaryOperation(left[i], right[i], op).value;
+                }
+                BenchmarkRunner::consume(sum);
+            });
+        }
+
+        for (int o = 0; o < 5; ++o) {
+            const CalcHandler::Operation op = unaryOperations[o];
+            runner.run(QString("CalcHandler/applyUnaryOperation/%1/%2")
+                           .arg(unaryNames[o]).arg(backendNames[b]),
+                       OPERAND_COUNT, [&]() {
+                double sum = 0.0;
+                for (int i = 0; i < OPERAND_COUNT; ++i) {
+                    sum += handler.applyUnaryOperation(op, positive[i]).value;
+                }
+                BenchmarkRunner::consume(sum);
+            });
+        }
+    }
+
+    // Пакетные варианты над массивами (BatchKernels)
+    for (int o = 0; o < 4; ++o) {
+        const CalcHandler::Operation op = binaryOperations[o];
+        runner.run(QString("CalcHandler/batch/binary/%1").arg(binaryNames[o]),
+                   OPERAND_COUNT, [&]() {
+            const int errors = CalcHandler::performBinaryOperation(left, right, results,
+                                                                   OPERAND_COUNT, op);
+            BenchmarkRunner::consume(results[errors & (OPERAND_COUNT - 1)]);
+        });
+    }
+    for (int o = 0; o < 5; ++o) {
+        const CalcHandler::Operation op = unaryOperations[o];
+        runner.run(QString("CalcHandler/batch/unary/%1").arg(unaryNames[o]),
+                   OPERAND_COUNT, [&]() {
+            const int errors = CalcHandler::applyUnaryOperation(op, positive, results,
+                                                                OPERAND_COUNT);
+            BenchmarkRunner::consume(results[errors & (OPERAND_COUNT - 1)]);
+        });
+    }
+}
+
+void benchDisplayFormatter(BenchmarkRunner& runner, const Operands& operands)
+{
+    const double* left = operands.left.constData();
+
+    runner.run("DisplayFormatter/formatNumber", OPERAND_COUNT, [&]() {
+        qint64 length = 0;
+        for (int i = 0; i < OPERAND_COUNT; ++i) {
+            length += DisplayFormatter::formatNumber(
+                left[i], CalculatorConfig::MAX_DIGIT_LENGTH).size();
+        }
+        BenchmarkRunner::consume(length);
+    });
+
+    runner.run("NumberFormatter/formatGeneral", OPERAND_COUNT, [&]() {
+        QChar buffer[NumberFormatter::BUFFER_SIZE];
+        qint64 length = 0;
+        for (int i = 0; i < OPERAND_COUNT; ++i) {
+            length += NumberFormatter::formatGeneral(
+                left[i], CalculatorConfig::MAX_DIGIT_LENGTH, buffer);
+        }
+        BenchmarkRunner::consume(length);
+    });
+
+    runner.run("NumberFormatter/formatShortest", OPERAND_COUNT, [&]() {
+        char buffer[NumberFormatter::BUFFER_SIZE];
+        qint64 length = 0;
+        for (int i = 0; i < OPERAND_COUNT; ++i) {
+            length += NumberFormatter::formatShortest(left[i], buffer);
+        }
+        BenchmarkRunner::consume(length);
+    });
+
+    QStringList texts;
+    texts.reserve(OPERAND_COUNT);
+    for (int i = 0; i < OPERAND_COUNT; ++i) {
+        texts.append(DisplayFormatter::formatNumber(left[i], CalculatorConfig::MAX_DIGIT_LENGTH));
+    }
+
+    runner.run("DisplayFormatter/toDouble", OPERAND_COUNT, [&]() {
+        double sum = 0.0;
+        for (int i = 0; i < OPERAND_COUNT; ++i) {
+            sum += DisplayFormatter::toDouble(texts.at(i));
+        }
+        BenchmarkRunner::consume(sum);
+    });
+
+    // Базовая линия для NumberParser: разбор Qt с учетом локали
+    runner.run("QString/toDouble", OPERAND_COUNT, [&]() {
+        double sum = 0.0;
+        for (int i = 0; i < OPERAND_COUNT; ++i) {
+            sum += texts.at(i).toDouble();
+        }
+        BenchmarkRunner::consume(sum);
+    });
+
+    QStringList shortestTexts;
+    shortestTexts.reserve(OPERAND_COUNT);
+    for (int i = 0; i < OPERAND_COUNT; ++i) {
+        QChar buffer[NumberFormatter::BUFFER_SIZE];
+        shortestTexts.append(QString(buffer, NumberFormatter::formatShortest(left[i], buffer)));
+    }
+
+    runner.run("NumberParser/toDouble17", OPERAND_COUNT, [&]() {
+        double sum = 0.0;
+        for (int i = 0; i < OPERAND_COUNT; ++i) {
+            sum += NumberParser::toDouble(shortestTexts.at(i));
+        }
+        BenchmarkRunner::consume(sum);
+    });
+}
+
+void fillHistory(CalculationHistory& history, const QStringList& expressions, int entries)
+{
+    history.clear();
+    history.setMaxSize(entries);
+    for (int i = 0; i < entries; ++i) {
+        history.addEntry(expressions.at(i % EXPRESSION_COUNT));
+    }
+}
+
+void benchCalculationHistory(BenchmarkRunner& runner, const QStringList& expressions,
+                             int maxEntries, const QTemporaryDir& directory)
+{
+    for (int entries = 1000; entries <= maxEntries; entries *= 10) {
+        const QString suffix = QString::number(entries);
+
+        CalculationHistory history;
+        runner.run("CalculationHistory/addEntry/" + suffix, entries, [&]() {
+            fillHistory(history, expressions, entries);
+            BenchmarkRunner::consume(qint64(history.count()));
+        });
+
+        // Установившийся режим: буфер полон, каждая запись вытесняет самую старую
+        HistoryEntry entry;
+        entry.operation = CalcOperation::Add;
+        entry.resultPrecision = CalculatorConfig::HISTORY_RESULT_PRECISION;
+        fillHistory(history, expressions, entries);
+        runner.run("CalculationHistory/addEntryEvicting/" + suffix, entries, [&]() {
+            for (int i = 0; i < entries; ++i) {
+                entry.expression = expressions.at(i % EXPRESSION_COUNT);
+                entry.lhs = i;
+                entry.rhs = 1.0;
+                entry.result = i + 1.0;
+                history.addEntry(entry);
+            }
+            BenchmarkRunner::consume(qint64(history.count()));
+        });
+
+        // Панель истории после каждого вычисления: модель сбрасывается,
+        // делегат запрашивает роли только видимых строк
+        HistoryModel model(&history);
+        runner.run("HistoryModel/addEntryAndPaint/" + suffix, EXPRESSION_COUNT, [&]() {
+            qint64 length = 0;
+            for (int i = 0; i < EXPRESSION_COUNT; ++i) {
+                entry.expression = expressions.at(i);
+                entry.lhs = i;
+                entry.result = i + 1.0;
+                history.addEntry(entry);
+                for (int row = 0; row < VISIBLE_HISTORY_ROWS; ++row) {
+                    const QModelIndex index = model.index(row);
+                    length += index.data(HistoryModel::ExpressionRole).toString().size();
+                    length += index.data(HistoryModel::ResultRole).toString().size();
+                }
+            }
+            BenchmarkRunner::consume(length);
+        });
+
+        // Поиск в панели истории: индекс строится при первом запросе, дальше
+        // каждое изменение текста в поле поиска - один запрос с ограничением панели
+        if (runner.isSelected("HistoryIndex/build/" + suffix)
+            || runner.isSelected("HistoryIndex/search/" + suffix)) {
+            runner.run("HistoryIndex/build/" + suffix, entries, [&]() {
+                HistoryIndex built(&history);
+                BenchmarkRunner::consume(qint64(built.search(HistoryQuery(), 1).size()));
+            });
+
+            QVector<HistoryQuery> queries;
+            queries << HistoryQuery::parse("1") << HistoryQuery::parse("12")
+                    << HistoryQuery::parse("+ 1") << HistoryQuery::parse("5 + 3")
+                    << HistoryQuery::parse("1e3..2e3");
+            HistoryQuery operation;
+            operation.operation = CalcOperation::Add;
+            operation.rhs = 1.0;
+            queries << operation;
+
+            HistoryIndex index(&history);
+            index.search(HistoryQuery(), 1);
+            runner.run("HistoryIndex/search/" + suffix, queries.size(), [&]() {
+                qint64 found = 0;
+                for (const HistoryQuery& query : queries) {
+                    found += index.search(query, CalculatorConfig::HISTORY_SEARCH_LIMIT).size();
+                }
+                BenchmarkRunner::consume(found);
+            });
+        }
+
+        // Журнал: addEntry только кодирует кадр, запись идет в фоновом потоке
+        const bool loadJournalSelected = runner.isSelected("CalculationHistory/loadJournal/" + suffix);
+        if (runner.isSelected("CalculationHistory/addEntryJournaled/" + suffix) || loadJournalSelected) {
+            const QString journalPath = directory.filePath(QString("history_%1.journal").arg(entries));
+            CalculationHistory journaled;
+            journaled.setMaxSize(entries);
+            journaled.openJournal(journalPath);
+            const auto fillJournaled = [&]() {
+                for (int i = 0; i < entries; ++i) {
+                    entry.expression = expressions.at(i % EXPRESSION_COUNT);
+                    entry.lhs = i;
+                    entry.result = i + 1.0;
+                    journaled.addEntry(entry);
+                }
+                BenchmarkRunner::consume(qint64(journaled.count()));
+            };
+            if (!runner.run("CalculationHistory/addEntryJournaled/" + suffix, entries, fillJournaled)) {
+                // Двух полных наборов хватает, чтобы большая часть записей ушла в снимок
+                fillJournaled();
+                fillJournaled();
+            }
+            journaled.closeJournal();
+
+            // Запуск приложения: снимок отображается, в память читается только хвост
+            CalculationHistory restored;
+            restored.setMaxSize(entries);
+            runner.run("CalculationHistory/loadJournal/" + suffix, entries, [&]() {
+                restored.loadFromFile(journalPath);
+                BenchmarkRunner::consume(qint64(restored.count()));
+            });
+            QFile::remove(journalPath);
+            QFile::remove(HistoryJournal::snapshotFileName(journalPath));
+        }
+
+        // Архив: запись блоками, последовательное чтение всех полей
+        // и подсчет по одному столбцу без разбора остальных
+        if (runner.isSelected("HistoryArchive/write/" + suffix)
+            || runner.isSelected("HistoryArchive/read/" + suffix)
+            || runner.isSelected("HistoryArchive/scanResults/" + suffix)) {
+            const QString archivePath = directory.filePath(QString("history_%1.archive").arg(entries));
+            runner.run("HistoryArchive/write/" + suffix, entries, [&]() {
+                HistoryArchive::Writer writer;
+                writer.open(archivePath);
+                for (int i = 0; i < entries; ++i) {
+                    entry.expression = expressions.at(i % EXPRESSION_COUNT);
+                    entry.lhs = i;
+                    entry.rhs = 1.0;
+                    entry.result = i + 1.0;
+                    entry.timestamp = 1600000000000LL + i * 1000LL + i % 7;
+                    writer.append(entry);
+                }
+                BenchmarkRunner::consume(qint64(writer.commit()));
+            });
+            if (!QFile::exists(archivePath)) {
+                HistoryArchive::Writer writer;
+                writer.open(archivePath);
+                for (int i = 0; i < entries; ++i) {
+                    entry.expression = expressions.at(i % EXPRESSION_COUNT);
+                    writer.append(entry);
+                }
+                writer.commit();
+            }
+
+            HistoryArchive archive;
+            archive.open(archivePath);
+            runner.run("HistoryArchive/read/" + suffix, entries, [&]() {
+                qint64 length = 0;
+                HistoryEntry read;
+                archive.seek(0);
+                while (archive.next(read)) {
+                    length += read.expression.size();
+                }
+                BenchmarkRunner::consume(length);
+            });
+
+            HistoryArchive::Block block;
+            runner.run("HistoryArchive/scanResults/" + suffix, entries, [&]() {
+                double sum = 0.0;
+                for (int i = 0; i < archive.blockCount(); ++i) {
+                    archive.readBlock(i, block, HistoryArchive::Results);
+                    for (double result : block.results) {
+                        sum += result;
+                    }
+                }
+                BenchmarkRunner::consume(sum);
+            });
+            archive.close();
+            QFile::remove(archivePath);
+        }
+
+        const QString path = directory.filePath(QString("history_%1.txt").arg(entries));
+        const bool saveSelected = runner.isSelected("CalculationHistory/saveToFile/" + suffix);
+        const bool loadSelected = runner.isSelected("CalculationHistory/loadFromFile/" + suffix);
+        if (!saveSelected && !loadSelected) {
+            continue;
+        }
+
+        fillHistory(history, expressions, entries);
+        runner.run("CalculationHistory/saveToFile/" + suffix, entries, [&]() {
+            history.saveToFile(path);
+        });
+        if (!QFile::exists(path)) {
+            history.saveToFile(path);
+        }
+
+        CalculationHistory loaded;
+        runner.run("CalculationHistory/loadFromFile/" + suffix, entries, [&]() {
+            loaded.loadFromFile(path);
+            BenchmarkRunner::consume(qint64(loaded.count()));
+        });
+        QFile::remove(path);
+    }
+}
+
+void benchMemoryManager(BenchmarkRunner& runner, const Operands& operands)
+{
+    const double* left = operands.left.constData();
+    const int operations = 1024;
+
+    MemoryManager memory;
+    for (int i = 0; i < operations; ++i) {
+        memory.addToList(left[i]);
+    }
+
+    // Список ограничен, поэтому после заполнения addToList вытесняет старые значения
+    runner.run("MemoryManager/addToList", operations, [&]() {
+        for (int i = 0; i < operations; ++i) {
+            memory.addToList(left[i]);
+        }
+    });
+
+    runner.run("MemoryManager/recallFromList", operations, [&]() {
+        const int size = memory.listSize();
+        for (int i = 0; i < operations; ++i) {
+            memory.recallFromList(i % size);
+        }
+        BenchmarkRunner::consume(memory.value());
+    });
+
+    runner.run("MemoryManager/getMemoryList", operations, [&]() {
+        double sum = 0.0;
+        for (int i = 0; i < operations; ++i) {
+            sum += memory.getMemoryList().at(i % memory.listSize());
+        }
+        BenchmarkRunner::consume(sum);
+    });
+
+    runner.run("MemoryManager/removeFromList+addToList", operations, [&]() {
+        for (int i = 0; i < operations; ++i) {
+            memory.removeFromList(i % memory.listSize());
+            memory.addToList(left[i]);
+        }
+    });
+
+    runner.run("MemoryManager/clearList+refill", operations, [&]() {
+        for (int i = 0; i < operations; i += 8) {
+            memory.clearList();
+            for (int j = 0; j < 8; ++j) {
+                memory.addToList(left[i + j]);
+            }
+        }
+    });
+}
+
+void benchCalculatorSession(BenchmarkRunner& runner)
+{
+    typedef CalculatorSession::Key Key;
+    // Типичный сеанс: "12.5 + 7 × 3 =", корень из результата, M+, затем C
+    const QVector<Key> keys = {
+        Key::Digit1, Key::Digit2, Key::DecimalPoint, Key::Digit5, Key::Add,
+        Key::Digit7, Key::Multiply, Key::Digit3, Key::Equals, Key::SquareRoot,
+        Key::MemoryAdd, Key::Clear
+    };
+    const int sessions = 1024;
+
+    CalculatorSession session;
+    runner.run("CalculatorSession/session", sessions, [&]() {
+        for (int i = 0; i < sessions; ++i) {
+            for (Key key : keys) {
+                session.press(key);
+            }
+        }
+        BenchmarkRunner::consume(qint64(session.displayText().size()));
+    });
+
+    CalculationHistory history;
+    MemoryManager memory;
+    session.setHistory(&history);
+    session.setMemory(&memory);
+    runner.run("CalculatorSession/session+history", sessions, [&]() {
+        for (int i = 0; i < sessions; ++i) {
+            for (Key key : keys) {
+                session.press(key);
+            }
+        }
+        BenchmarkRunner::consume(qint64(history.count()));
+    });
+}
+
+// Случайные сеансы ввода с проверками там же, где их пишет окно: после каждого
+// результата или ошибки на дисплее
+KeystrokeLog makeKeystrokeLog(int sessions)
+{
+    typedef CalculatorSession::Key Key;
+    std::mt19937 generator(20240502);
+    std::bernoulli_distribution digit(0.6);
+    std::uniform_int_distribution<int> digits(0, 9);
+    std::uniform_int_distribution<int> keys(int(Key::DecimalPoint), int(Key::MemoryStore));
+    std::uniform_int_distribution<int> pause(80, 400);
+
+    CalculationHistory history;
+    MemoryManager memory;
+    CalculatorSession session(&history, &memory);
+    KeystrokeLog log;
+    KeystrokeLog::Event start;
+    start.type = KeystrokeLog::EventType::Memory;
+    log.append(start);
+
+    qint64 time = 0;
+    for (int i = 0; i < sessions; ++i) {
+        const int length = 4 + i % 12;
+        for (int j = 0; j <= length; ++j) {
+            KeystrokeLog::Event event;
+            event.time = (time += pause(generator));
+            if (j == length) {
+                event.key = Key::Clear;
+            } else if (digit(generator)) {
+                event.key = CalculatorSession::digitKey(digits(generator));
+            } else {
+                event.key = static_cast<Key>(keys(generator));
+            }
+            session.press(event.key);
+            log.append(event);
+
+            if (session.isResultDisplayed()) {
+                KeystrokeLog::Event check = KeystrokeLog::checkpoint(session, 0);
+                check.time = time;
+                log.append(check);
+            }
+        }
+    }
+    return log;
+}
+
+// false - журнал из файла не читается или разошелся с текущей логикой сеанса
+bool benchKeystrokeLog(BenchmarkRunner& runner, const QString& keylogPath)
+{
+    CalculationHistory history;
+    MemoryManager memory;
+    CalculatorSession session(&history, &memory);
+
+    const KeystrokeLog generated = makeKeystrokeLog(4096);
+    const QByteArray encoded = generated.encode();
+    KeystrokeLog decoded;
+    runner.run("KeystrokeLog/decode", generated.count(), [&]() {
+        decoded.decode(encoded);
+        BenchmarkRunner::consume(qint64(decoded.count()));
+    });
+
+    int keys = 0;
+    for (const KeystrokeLog::Event& event : generated.events()) {
+        keys += event.type == KeystrokeLog::EventType::Key ? 1 : 0;
+    }
+    runner.run("KeystrokeLog/replay", keys, [&]() {
+        BenchmarkRunner::consume(qint64(generated.replay(session).checks));
+    });
+
+    if (keylogPath.isEmpty()) {
+        return true;
+    }
+
+    KeystrokeLog recorded;
+    if (!recorded.load(keylogPath)) {
+        std::fprintf(stderr, "Не удалось прочитать журнал нажатий: %s\n", qPrintable(keylogPath));
+        return false;
+    }
+    const KeystrokeLog::ReplayResult result = recorded.replay(session);
+    std::fprintf(stderr, "%s: нажатий %d, проверок %d\n",
+                 qPrintable(keylogPath), result.keys, result.checks);
+    if (!result.passed()) {
+        std::fprintf(stderr, "Событие %d: ожидалось %s, получено %s\n", result.failedEvent,
+                     qPrintable(result.expected), qPrintable(result.actual));
+        return false;
+    }
+    runner.run("KeystrokeLog/replay/file", qMax(result.keys, 1), [&]() {
+        BenchmarkRunner::consume(qint64(recorded.replay(session).checks));
+    });
+    return true;
+}
+
+// Цена интервала: выключенный - чтение флага, включенный - два чтения часов
+// и запись в буфер потока
+void benchTracer(BenchmarkRunner& runner)
+{
+    const int spans = 4096;
+    runner.run("Tracer/span/disabled", spans, [&]() {
+        for (int i = 0; i < spans; ++i) {
+            const TraceSpan span("bench", "span");
+        }
+        BenchmarkRunner::consume(qint64(Tracer::isEnabled()));
+    });
+
+    Tracer::setEnabled(true);
+    runner.run("Tracer/span/enabled", spans, [&]() {
+        for (int i = 0; i < spans; ++i) {
+            const TraceSpan span("bench", "span");
+        }
+        BenchmarkRunner::consume(qint64(Tracer::eventCount()));
+    });
+    Tracer::setEnabled(false);
+
+    const int events = Tracer::eventCount();
+    runner.run("Tracer/toJson", qMax(events, 1), [&]() {
+        BenchmarkRunner::consume(qint64(Tracer::toJson().toJson(QJsonDocument::Compact).size()));
+    });
+    Tracer::clear();
+}
+
+// Выключенная категория против очереди AsyncLogger: постановка, оформление
+// и запись в память фоновым потоком до конца flush()
+void benchLogging(BenchmarkRunner& runner, const Operands& operands)
+{
+    const QVector<double>& values = operands.left;
+    const int count = values.size();
+    runner.run("Logging/qCDebug/disabled", count, [&]() {
+        for (int i = 0; i < count; ++i) {
+            qCDebug(lcMemory) << "M+:" << values[i] << "-> Память:" << values[i];
+        }
+        BenchmarkRunner::consume(qint64(lcMemory().isDebugEnabled()));
+    });
+
+    QBuffer output;
+    output.open(QIODevice::WriteOnly);
+    AsyncLogger logger(count);
+    logger.setOutput(&output);
+    const QMessageLogContext context(nullptr, 0, nullptr, "calc.memory");
+    const QString message("M+: 12.5 -> Память: 37.5");
+    runner.run("AsyncLogger/log", count, [&]() {
+        for (int i = 0; i < count; ++i) {
+            logger.log(QtDebugMsg, context, message);
+        }
+        logger.flush();
+        output.seek(0);
+        BenchmarkRunner::consume(qint64(logger.droppedCount()));
+    });
+}
+
+bool parseInt(const char* text, int minimum, int& value)
+{
+    bool ok = false;
+    const int parsed = QString::fromLocal8Bit(text).toInt(&ok);
+    if (!ok || parsed < minimum) {
+        return false;
+    }
+    value = parsed;
+    return true;
+}
+
+} // namespace
+
+int main(int argc, char *argv[])
+{
+    QString outputPath;
+    QString filter;
+    QString keylogPath;
+    int minTime = 0;
+    int samples = 0;
+    int maxEntries = 1000000;
+
+    for (int i = 1; i < argc; ++i) {
+        const QString arg = QString::fromLocal8Bit(argv[i]);
+        const bool hasValue = i + 1 < argc;
+        if ((arg == "-o" || arg == "--output") && hasValue) {
+            outputPath = QString::fromLocal8Bit(argv[++i]);
+        } else if (arg == "--filter" && hasValue) {
+            filter = QString::fromLocal8Bit(argv[++i]);
+        } else if (arg == "--keylog" && hasValue) {
+            keylogPath = QString::fromLocal8Bit(argv[++i]);
+        } else if (arg == "--min-time" && hasValue) {
+            if (!parseInt(argv[++i], 1, minTime)) {
+                printUsage();
+                return 1;
+            }
+        } else if (arg == "--samples" && hasValue) {
+            if (!parseInt(argv[++i], 1, samples)) {
+                printUsage();
+                return 1;
+            }
+        } else if (arg == "--max-entries" && hasValue) {
+            if (!parseInt(argv[++i], 1000, maxEntries)) {
+                printUsage();
+                return 1;
+            }
+        } else if (arg == "-h" || arg == "--help") {
+            printUsage();
+            return 0;
+        } else {
+            printUsage();
+            return 1;
+        }
+    }
+
+    qInstallMessageHandler(silentMessageHandler);
+
+    QTemporaryDir directory;
+    if (!directory.isValid()) {
+        std::fprintf(stderr, "Не удалось создать временный каталог\n");
+        return 1;
+    }
+
+    BenchmarkRunner runner;
+    runner.setFilter(filter);
+    if (minTime > 0) {
+        runner.setMinSampleTime(minTime);
+    }
+    if (samples > 0) {
+        runner.setSamples(samples);
+    }
+
+    Operands operands = makeOperands();
+    const QStringList expressions = makeExpressions(operands);
+
+    benchCalcHandler(runner, operands);
+    benchDisplayFormatter(runner, operands);
+    benchCalculationHistory(runner, expressions, maxEntries, directory);
+    benchMemoryManager(runner, operands);
+    benchCalculatorSession(runner);
+    const bool keylogPassed = benchKeystrokeLog(runner, keylogPath);
+    benchTracer(runner);
+    benchLogging(runner, operands);
+
+    const QByteArray json = runner.toJson().toJson(QJsonDocument::Indented);
+
+    QFile output;
+    bool outputOpened = false;
+    if (outputPath.isEmpty()) {
+        outputOpened = output.open(stdout, QIODevice::WriteOnly);
+    } else {
+        output.setFileName(outputPath);
+        outputOpened = output.open(QIODevice::WriteOnly | QIODevice::Truncate);
+    }
+    if (!outputOpened) {
+        std::fprintf(stderr, "Не удалось открыть файл для записи: %s\n", qPrintable(outputPath));
+        return 1;
+    }
+    output.write(json);
+    output.flush();
+    return keylogPassed ? 0 : 2;
+}
@@ -0,0 +1,105 @@
+#include "benchmarkrunner.h"
+#include <QDateTime>
+#include <QJsonArray>
+#include <QJsonObject>
+#include <QSysInfo>
+#include <cstdio>
+
+namespace {
+
+volatile double g_doubleSink = 0.0;
+volatile qint64 g_integerSink = 0;
+
+} // namespace
+
+BenchmarkRunner::BenchmarkRunner()
+    : m_minSampleNsecs(qint64(DEFAULT_MIN_SAMPLE_MSECS) * 1000000)
+    , m_samples(DEFAULT_SAMPLES)
+{
+}
+
+void BenchmarkRunner::setFilter(const QString& filter)
+{
+    m_filter = filter;
+}
+
+void BenchmarkRunner::setMinSampleTime(int msecs)
+{
+    m_minSampleNsecs = qint64(qMax(1, msecs)) * 1000000;
+}
+
+void BenchmarkRunner::setSamples(int samples)
+{
+    m_samples = qMax(1, samples);
+}
+
+bool BenchmarkRunner::isSelected(const QString& name) const
+{
+    return m_filter.isEmpty() || name.contains(m_filter, Qt::CaseInsensitive);
+}
+
+const QVector<BenchmarkRunner::Result>& BenchmarkRunner::results() const
+{
+    return m_results;
+}
+
+QJsonDocument BenchmarkRunner::toJson() const
+{
+    QJsonArray benchmarks;
+    for (const Result& result : m_results) {
+        QJsonObject entry;
+        entry.insert("name", result.name);
+        entry.insert("items", result.items);
+        entry.insert("iterations", result.iterations);
+        entry.insert("samples", result.samples);
+        entry.insert("ns_per_item", result.nsPerItem);
+        entry.insert("ns_per_item_min", result.nsPerItemMin);
+        entry.insert("items_per_second",
+                     result.nsPerItem > 0.0 ? 1e9 / result.nsPerItem : 0.0);
+        benchmarks.append(entry);
+    }
+
+    QJsonObject context;
+    context.insert("date", QDateTime::currentDateTimeUtc().toString(Qt::ISODate));
+    context.insert("qt_version", QString(qVersion()));
+    context.insert("cpu_architecture", QSysInfo::currentCpuArchitecture());
+    context.insert("os", QSysInfo::prettyProductName());
+#ifdef QT_NO_DEBUG
+    context.insert("build_type", QString("release"));
+#else
+    context.insert("build_type", QString("debug"));
+#endif
+
+    QJsonObject root;
+    root.insert("context", context);
+    root.insert("benchmarks", benchmarks);
+    return QJsonDocument(root);
+}
+
+void BenchmarkRunner::consume(double value)
+{
+    g_doubleSink = g_doubleSink + value;
+}
+
+void BenchmarkRunner::consume(qint64 value)
+{
+    g_integerSink = g_integerSink + value;
+}
+
+void BenchmarkRunner::addResult(const QString& name, qint64 items, qint64 iterations,
+                                QVector<double>& nsPerItem)
+{
+    std::sort(nsPerItem.begin(), nsPerItem.end());
+
+    Result result;
+    result.name = name;
+    result.items = items;
+    result.iterations = iterations;
+    result.samples = nsPerItem.size();
+    result.nsPerItem = nsPerItem.at(nsPerItem.size() / 2);
+    result.nsPerItemMin = nsPerItem.first();
+    m_results.append(result);
+
+    // Прогресс виден сразу, даже если весь набор идет минутами
+    std::fprintf(stderr, "%-52s %14.2f нс/эл.\n", qPrintable(name), result.nsPerItem);
+}
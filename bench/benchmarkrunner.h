@@ -0,0 +1,107 @@
+#ifndef BENCHMARKRUNNER_H
+#define BENCHMARKRUNNER_H
+
+#include <QElapsedTimer>
+#include <QJsonDocument>
+#include <QString>
+#include <QVector>
+#include <algorithm>
+
+// Простой исполнитель микробенчмарков с выводом в JSON.
+// Тело бенчмарка обрабатывает items элементов за вызов. Число вызовов в замере
+// подбирается так, чтобы замер длился не меньше minSampleTime, затем делается
+// samples замеров и в результат идут медиана и минимум времени на элемент.
+class BenchmarkRunner
+{
+public:
+    struct Result {
+        QString name;
+        qint64 items;           // элементов за один вызов тела
+        qint64 iterations;      // вызовов тела в одном замере
+        int samples;
+        double nsPerItem;       // медиана по замерам
+        double nsPerItemMin;
+    };
+
+public:
+    BenchmarkRunner();
+    ~BenchmarkRunner() = default;
+
+public:
+    void setFilter(const QString& filter);
+    void setMinSampleTime(int msecs);
+    void setSamples(int samples);
+    bool isSelected(const QString& name) const;
+
+    // Прогоняет body, если name проходит фильтр. Возвращает false, если бенчмарк пропущен.
+    // Тело должно быть самодостаточным: оно вызывается много раз подряд.
+    template<typename Body>
+    bool run(const QString& name, qint64 items, Body body);
+
+public:
+    const QVector<Result>& results() const;
+    QJsonDocument toJson() const;
+
+public:
+    // Не дает компилятору выбросить вычисления, результат которых не используется
+    static void consume(double value);
+    static void consume(qint64 value);
+
+private:
+    void addResult(const QString& name, qint64 items, qint64 iterations,
+                   QVector<double>& nsPerItem);
+
+private:
+    QString m_filter;
+    qint64 m_minSampleNsecs;
+    int m_samples;
+    QVector<Result> m_results;
+
+    static const int DEFAULT_MIN_SAMPLE_MSECS = 20;
+    static const int DEFAULT_SAMPLES = 5;
+};
+
+template<typename Body>
+bool BenchmarkRunner::run(const QString& name, qint64 items, Body body)
+{
+    if (!isSelected(name)) {
+        return false;
+    }
+
+    QElapsedTimer timer;
+
+    // Калибровка: увеличиваем число вызовов, пока замер короче minSampleTime.
+    // Первый вызов заодно прогревает кэши и аллокатор
+    qint64 iterations = 1;
+    for (;;) {
+        timer.start();
+        for (qint64 i = 0; i < iterations; ++i) {
+            body();
+        }
+        const qint64 elapsed = timer.nsecsElapsed();
+        if (elapsed >= m_minSampleNsecs) {
+            break;
+        }
+        // Цель с запасом, чтобы не калибровать слишком долго
+        const qint64 estimate = elapsed > 0
+            ? iterations * m_minSampleNsecs / elapsed + 1
+            : iterations * 2;
+        iterations = std::max(iterations * 2, std::min(estimate, iterations * 100));
+    }
+
+    QVector<double> nsPerItem;
+    nsPerItem.reserve(m_samples);
+    for (int sample = 0; sample < m_samples; ++sample) {
+        timer.start();
+        for (qint64 i = 0; i < iterations; ++i) {
+            body();
+        }
+        const double elapsed = static_cast<double>(timer.nsecsElapsed());
+        nsPerItem.append(elapsed / (static_cast<double>(iterations) * items));
+    }
+
+    addResult(name, items, iterations, nsPerItem);
+    return true;
+}
+
+#endif // BENCHMARKRUNNER_H
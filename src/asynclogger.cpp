@@ -0,0 +1,306 @@
+#include "asynclogger.h"
+
+#include <QDateTime>
+#include <QReadWriteLock>
+#include <QThread>
+#include <cstdio>
+
+std::atomic<AsyncLogger*> AsyncLogger::s_instance(nullptr);
+
+namespace {
+
+// Номера ячеек сравниваются по модулю: емкость - степень двойки
+quint64 cellCount(int capacity)
+{
+    quint64 count = 2;
+    while (count < quint64(capacity)) {
+        count <<= 1;
+    }
+    return count;
+}
+
+// Пачка текста, после которой вывод не ждет конца очереди
+const int WRITE_CHUNK_SIZE = 64 * 1024;
+
+// Вызов обработчика держит блокировку на чтение, пока пользуется логгером.
+// Ожидающая запись не пускает новых читателей, поэтому снятие обработчика
+// не ждет бесконечно при непрерывном потоке сообщений
+QReadWriteLock& handlerLock()
+{
+    static QReadWriteLock lock(QReadWriteLock::Recursive);
+    return lock;
+}
+
+} // namespace
+
+class AsyncLogger::Thread : public QThread
+{
+public:
+    explicit Thread(AsyncLogger* logger)
+        : m_logger(logger)
+    {
+    }
+
+protected:
+    void run() override
+    {
+        m_logger->workerLoop();
+    }
+
+private:
+    AsyncLogger* m_logger;
+};
+
+AsyncLogger::AsyncLogger(int capacity)
+    : m_cells(new Cell[cellCount(capacity)])
+    , m_mask(cellCount(capacity) - 1)
+    , m_enqueuePosition(0)
+    , m_dequeuePosition(0)
+    , m_dropped(0)
+    , m_droppedReported(0)
+    , m_sleeping(false)
+    , m_output(nullptr)
+    , m_thread(new Thread(this))
+    , m_stopping(false)
+    , m_requested(0)
+    , m_completed(0)
+    , m_previousHandler(nullptr)
+    , m_installed(false)
+{
+    for (quint64 i = 0; i <= m_mask; ++i) {
+        m_cells[i].sequence.store(i, std::memory_order_relaxed);
+    }
+    m_thread->start();
+}
+
+AsyncLogger::~AsyncLogger()
+{
+    uninstall();
+    {
+        QMutexLocker locker(&m_mutex);
+        m_stopping = true;
+        m_wakeUp.wakeOne();
+    }
+    m_thread->wait();
+    delete m_thread;
+}
+
+void AsyncLogger::setOutput(QIODevice* output)
+{
+    QMutexLocker locker(&m_outputMutex);
+    m_output = output;
+}
+
+bool AsyncLogger::log(QtMsgType type, const QMessageLogContext& context, const QString& message)
+{
+    Record record;
+    record.type = type;
+    record.category = context.category ? context.category : "default";
+    record.time = QDateTime::currentMSecsSinceEpoch();
+    record.message = message;
+
+    if (type == QtFatalMsg) {
+        // После возврата Qt завершает процесс: все поставленное раньше должно успеть.
+        // Из фонового потока flush() ждал бы сам себя
+        if (QThread::currentThread() != m_thread) {
+            flush();
+        }
+        QMutexLocker locker(&m_outputMutex);
+        write(formatMessage(type, record.category, record.time, message).toLocal8Bit() + '\n');
+        return true;
+    }
+
+    if (!push(record)) {
+        m_dropped.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+    // Работающий поток сам дойдет до сообщения; будить нужно только уснувший
+    if (m_sleeping.load(std::memory_order_relaxed) && m_sleeping.exchange(false)) {
+        QMutexLocker locker(&m_mutex);
+        m_wakeUp.wakeOne();
+    }
+    return true;
+}
+
+void AsyncLogger::flush()
+{
+    QMutexLocker locker(&m_mutex);
+    const quint64 target = ++m_requested;
+    m_wakeUp.wakeOne();
+    while (m_completed < target) {
+        m_done.wait(&m_mutex);
+    }
+}
+
+void AsyncLogger::install()
+{
+    if (m_installed) {
+        return;
+    }
+    s_instance.store(this);
+    m_previousHandler = qInstallMessageHandler(messageHandler);
+    m_installed = true;
+}
+
+void AsyncLogger::uninstall()
+{
+    if (!m_installed) {
+        return;
+    }
+    qInstallMessageHandler(m_previousHandler);
+    s_instance.store(nullptr);
+    // Новые вызовы логгер уже не увидят; начатые раньше завершаются до разрушения
+    QWriteLocker locker(&handlerLock());
+    m_installed = false;
+}
+
+int AsyncLogger::capacity() const
+{
+    return int(m_mask + 1);
+}
+
+quint64 AsyncLogger::droppedCount() const
+{
+    return m_dropped.load(std::memory_order_relaxed);
+}
+
+QString AsyncLogger::formatMessage(QtMsgType type, const char* category, qint64 time,
+                                   const QString& message)
+{
+    char level = 'D';
+    switch (type) {
+        case QtDebugMsg: level = 'D'; break;
+        case QtInfoMsg: level = 'I'; break;
+        case QtWarningMsg: level = 'W'; break;
+        case QtCriticalMsg: level = 'C'; break;
+        case QtFatalMsg: level = 'F'; break;
+    }
+    return QString("%1 %2 %3: %4")
+        .arg(QDateTime::fromMSecsSinceEpoch(time).toString("hh:mm:ss.zzz"))
+        .arg(QChar(level))
+        .arg(QString::fromLatin1(category))
+        .arg(message);
+}
+
+bool AsyncLogger::push(Record& record)
+{
+    quint64 position = m_enqueuePosition.load(std::memory_order_relaxed);
+    for (;;) {
+        Cell& cell = m_cells[position & m_mask];
+        const quint64 sequence = cell.sequence.load(std::memory_order_acquire);
+        const qint64 difference = qint64(sequence - position);
+        if (difference == 0) {
+            // Ячейка свободна: занимает тот, кто первым сдвинет позицию
+            if (m_enqueuePosition.compare_exchange_weak(position, position + 1,
+                                                        std::memory_order_relaxed)) {
+                cell.record.type = record.type;
+                cell.record.category = record.category;
+                cell.record.time = record.time;
+                cell.record.message.swap(record.message);
+                cell.sequence.store(position + 1, std::memory_order_release);
+                return true;
+            }
+        } else if (difference < 0) {
+            // Фоновый поток еще не забрал сообщение круг назад
+            return false;
+        } else {
+            position = m_enqueuePosition.load(std::memory_order_relaxed);
+        }
+    }
+}
+
+bool AsyncLogger::pop(Record& record)
+{
+    Cell& cell = m_cells[m_dequeuePosition & m_mask];
+    if (cell.sequence.load(std::memory_order_acquire) != m_dequeuePosition + 1) {
+        return false;
+    }
+    record.type = cell.record.type;
+    record.category = cell.record.category;
+    record.time = cell.record.time;
+    // Строка освобождается здесь, а не в потоке, который пишет в журнал
+    record.message.swap(cell.record.message);
+    cell.record.message.clear();
+    cell.sequence.store(m_dequeuePosition + m_mask + 1, std::memory_order_release);
+    ++m_dequeuePosition;
+    return true;
+}
+
+void AsyncLogger::workerLoop()
+{
+    QMutexLocker locker(&m_mutex);
+    for (;;) {
+        const quint64 requested = m_requested;
+        const bool stopping = m_stopping;
+        locker.unlock();
+        drain();
+        locker.relock();
+
+        if (m_completed != requested) {
+            m_completed = requested;
+            m_done.wakeAll();
+        }
+        if (stopping) {
+            return;
+        }
+        if (m_requested != requested || m_stopping) {
+            continue;
+        }
+
+        // Сообщение, поставленное между drain() и сном, ждет не дольше IDLE_INTERVAL
+        m_sleeping.store(true);
+        const Cell& next = m_cells[m_dequeuePosition & m_mask];
+        if (next.sequence.load(std::memory_order_acquire) != m_dequeuePosition + 1) {
+            m_wakeUp.wait(&m_mutex, IDLE_INTERVAL);
+        }
+        m_sleeping.store(false);
+    }
+}
+
+void AsyncLogger::drain()
+{
+    QByteArray text;
+    Record record;
+    while (pop(record)) {
+        text += formatMessage(record.type, record.category, record.time, record.message)
+                    .toLocal8Bit();
+        text += '\n';
+        if (text.size() >= WRITE_CHUNK_SIZE) {
+            QMutexLocker locker(&m_outputMutex);
+            write(text);
+            text.clear();
+        }
+    }
+
+    const quint64 dropped = m_dropped.load(std::memory_order_relaxed);
+    if (dropped != m_droppedReported) {
+        text += QString("Журнал: пропущено сообщений: %1\n")
+                    .arg(dropped - m_droppedReported).toLocal8Bit();
+        m_droppedReported = dropped;
+    }
+
+    if (!text.isEmpty()) {
+        QMutexLocker locker(&m_outputMutex);
+        write(text);
+    }
+}
+
+void AsyncLogger::write(const QByteArray& text)
+{
+    if (m_output) {
+        m_output->write(text);
+        return;
+    }
+    std::fwrite(text.constData(), 1, size_t(text.size()), stderr);
+    std::fflush(stderr);
+}
+
+void AsyncLogger::messageHandler(QtMsgType type, const QMessageLogContext& context,
+                                 const QString& message)
+{
+    QReadLocker locker(&handlerLock());
+    AsyncLogger* logger = s_instance.load();
+    if (logger) {
+        logger->log(type, context, message);
+    }
+}
@@ -0,0 +1,112 @@
+#ifndef ASYNCLOGGER_H
+#define ASYNCLOGGER_H
+
+#include <QIODevice>
+#include <QMutex>
+#include <QScopedPointer>
+#include <QString>
+#include <QWaitCondition>
+#include <QtGlobal>
+#include <atomic>
+
+// Обработчик сообщений Qt, который выносит оформление строки и вывод в фоновый поток.
+// Вызвавший поток только кладет сообщение в очередь: кольцо фиксированной емкости
+// без блокировок (ячейки с номерами последовательности), писать в него могут
+// несколько потоков сразу. Фоновый поток добавляет время, уровень и категорию,
+// перекодирует и пишет пачкой в stderr или в заданное устройство.
+//
+// Текст сообщения собирает QDebug в вызвавшем потоке - так устроены qDebug/qCDebug;
+// сообщения выключенных категорий (см. logcategories.h) до этого не доходят.
+// Полная очередь не блокирует: сообщение отбрасывается, число пропущенных
+// выводится следующей строкой. Фатальные сообщения пишутся сразу, после
+// всех поставленных раньше
+class AsyncLogger
+{
+public:
+    explicit AsyncLogger(int capacity = DEFAULT_CAPACITY);
+    // Снимает обработчик, выводит все поставленное и останавливает поток
+    ~AsyncLogger();
+
+public:
+    // nullptr - stderr. Устройство используется фоновым потоком до деструктора
+    void setOutput(QIODevice* output);
+
+    // Ставит сообщение в очередь; false - очередь полна, сообщение отброшено
+    bool log(QtMsgType type, const QMessageLogContext& context, const QString& message);
+    // Блокирует, пока не будет выведено все поставленное до вызова
+    void flush();
+
+    // Делает логгер обработчиком qInstallMessageHandler; uninstall() возвращает прежний
+    // и ждет, пока завершатся вызовы обработчика из других потоков
+    void install();
+    void uninstall();
+
+    int capacity() const;
+    quint64 droppedCount() const;
+
+public:
+    // "12:34:56.789 D calc.memory: текст"
+    static QString formatMessage(QtMsgType type, const char* category, qint64 time,
+                                 const QString& message);
+
+public:
+    // Округляется вверх до степени двойки
+    static const int DEFAULT_CAPACITY = 4096;
+    // Сколько фоновый поток спит, если его не разбудили, мс
+    static const int IDLE_INTERVAL = 100;
+
+private:
+    class Thread;
+    friend class Thread;
+
+    // Категория - имя QLoggingCategory: строка живет, пока живет категория
+    struct Record {
+        QtMsgType type;
+        const char* category;
+        qint64 time;
+        QString message;
+    };
+
+    struct Cell {
+        std::atomic<quint64> sequence;
+        Record record;
+    };
+
+private:
+    bool push(Record& record);
+    bool pop(Record& record);
+    void workerLoop();
+    // Выводит все, что есть в очереди. Только из фонового потока
+    void drain();
+    void write(const QByteArray& text);
+    static void messageHandler(QtMsgType type, const QMessageLogContext& context,
+                               const QString& message);
+
+private:
+    QScopedArrayPointer<Cell> m_cells;
+    const quint64 m_mask;
+    std::atomic<quint64> m_enqueuePosition;
+    quint64 m_dequeuePosition;
+    std::atomic<quint64> m_dropped;
+    quint64 m_droppedReported;
+    // Фоновый поток ждет m_wakeUp; производитель будит его, только если он уснул
+    std::atomic<bool> m_sleeping;
+
+    QIODevice* m_output;
+    Thread* m_thread;
+    mutable QMutex m_mutex;
+    QWaitCondition m_wakeUp;
+    QWaitCondition m_done;
+    bool m_stopping;
+    quint64 m_requested;
+    quint64 m_completed;
+    // Защищает вывод от одновременной записи фатального сообщения
+    QMutex m_outputMutex;
+
+    QtMessageHandler m_previousHandler;
+    bool m_installed;
+
+    static std::atomic<AsyncLogger*> s_instance;
+};
+
+#endif // ASYNCLOGGER_H
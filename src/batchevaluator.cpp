@@ -0,0 +1,151 @@
+#include "batchevaluator.h"
+#include "calculatorconfig.h"
+#include "errormessages.h"
+#include "expressioncompiler.h"
+#include "numberformatter.h"
+#include <QIODevice>
+#include <cstring>
+
+namespace {
+
+inline bool isSpace(char c)
+{
+    return c == ' ' || c == '\t' || c == '\r';
+}
+
+inline void skipSpaces(const char*& pos, const char* end)
+{
+    while (pos < end && isSpace(*pos)) {
+        ++pos;
+    }
+}
+
+} // namespace
+
+BatchEvaluator::BatchEvaluator()
+    : m_stats{0, 0}
+    , m_backend(CalcHandler::Backend::Double)
+{
+}
+
+BatchEvaluator::Statistics BatchEvaluator::run(QIODevice* input, QIODevice* output)
+{
+    QByteArray buffer;
+    QByteArray out;
+    out.reserve(WRITE_CHUNK_SIZE + 256);
+
+    int carried = 0;
+    bool atEnd = false;
+    while (!atEnd) {
+        buffer.resize(carried + READ_CHUNK_SIZE);
+        const qint64 bytesRead = input->read(buffer.data() + carried, READ_CHUNK_SIZE);
+        atEnd = bytesRead <= 0;
+        const int available = carried + (atEnd ? 0 : static_cast<int>(bytesRead));
+
+        const char* lineStart = buffer.constData();
+        const char* dataEnd = lineStart + available;
+        while (lineStart < dataEnd) {
+            const char* lineEnd = static_cast<const char*>(
+                std::memchr(lineStart, '\n', dataEnd - lineStart));
+            if (!lineEnd) {
+                if (!atEnd) {
+                    break;
+                }
+                // Последняя строка без завершающего перевода строки
+                lineEnd = dataEnd;
+            }
+
+            evaluateLine(lineStart, lineEnd, out);
+            lineStart = lineEnd < dataEnd ? lineEnd + 1 : dataEnd;
+
+            if (out.size() >= WRITE_CHUNK_SIZE) {
+                output->write(out);
+                out.clear();
+            }
+        }
+
+        // Перенести незавершенную строку в начало буфера
+        carried = static_cast<int>(dataEnd - lineStart);
+        if (carried > 0) {
+            std::memmove(buffer.data(), lineStart, carried);
+        }
+    }
+
+    if (!out.isEmpty()) {
+        output->write(out);
+    }
+
+    return m_stats;
+}
+
+void BatchEvaluator::evaluateLine(const char* begin, const char* end, QByteArray& out)
+{
+    ++m_stats.lines;
+
+    const char* pos = begin;
+    skipSpaces(pos, end);
+    if (pos == end) {
+        out.append('\n');
+        return;
+    }
+
+    // Программа переиспользуется между строками, чтобы не выделять память заново
+    if (!ExpressionCompiler::compile(pos, end, m_program)) {
+        appendError(CalculatorConfig::ERROR_INVALID_INPUT, out);
+        return;
+    }
+
+    if (m_backend == CalcHandler::Backend::Decimal) {
+        appendResult(m_program.evaluate(m_decimalContext), out);
+    } else {
+        appendResult(m_program.evaluate(), out);
+    }
+}
+
+BatchEvaluator::Statistics BatchEvaluator::statistics() const
+{
+    return m_stats;
+}
+
+void BatchEvaluator::setBackend(CalcHandler::Backend backend, const DecimalContext& context)
+{
+    m_backend = backend;
+    m_decimalContext = context;
+}
+
+CalcHandler::Backend BatchEvaluator::backend() const
+{
+    return m_backend;
+}
+
+void BatchEvaluator::appendResult(const CalcHandler::CalculationResult& result, QByteArray& out)
+{
+    if (!result.success()) {
+        appendError(ErrorMessages::text(result.error), out);
+        return;
+    }
+
+    // Тот же формат, что и DisplayFormatter::formatNumber в окне калькулятора
+    char buffer[NumberFormatter::BUFFER_SIZE];
+    const int length = NumberFormatter::formatGeneral(
+        result.value, CalculatorConfig::MAX_DIGIT_LENGTH, buffer);
+    out.append(buffer, length);
+    out.append('\n');
+}
+
+void BatchEvaluator::appendResult(const CalcResult<Decimal>& result, QByteArray& out)
+{
+    if (!result.success()) {
+        appendError(ErrorMessages::text(result.error), out);
+        return;
+    }
+    out.append(result.value.toString().toLatin1());
+    out.append('\n');
+}
+
+void BatchEvaluator::appendError(const QString& message, QByteArray& out)
+{
+    ++m_stats.errors;
+    out.append(message.toUtf8());
+    out.append('\n');
+}
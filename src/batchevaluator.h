@@ -0,0 +1,54 @@
+#ifndef BATCHEVALUATOR_H
+#define BATCHEVALUATOR_H
+
+#include <QByteArray>
+#include "calchandler.h"
+#include "expressionprogram.h"
+
+class QIODevice;
+
+// Пакетное вычисление выражений без GUI.
+// Одна строка входа - одна строка выхода. Строка - выражение ExpressionCompiler,
+// в том числе в формате истории: "5 + 3", "2.5 × -4", "√(16)", "x²(3)", "1/x(4)",
+// и полные формулы: "3 + 4 × 2 ÷ (1 − 5)²".
+// Ошибки выводятся текстом ошибки вместо результата, нумерация строк сохраняется.
+// С Backend::Decimal выражение целиком считается в Decimal и результат выводится
+// всеми значащими цифрами контекста, без перевода в double.
+class BatchEvaluator
+{
+public:
+    struct Statistics {
+        qint64 lines;
+        qint64 errors;
+    };
+
+public:
+    BatchEvaluator();
+    ~BatchEvaluator() = default;
+
+public:
+    Statistics run(QIODevice* input, QIODevice* output);
+    void evaluateLine(const char* begin, const char* end, QByteArray& out);
+    Statistics statistics() const;
+
+public:
+    void setBackend(CalcHandler::Backend backend,
+                    const DecimalContext& context = DecimalContext());
+    CalcHandler::Backend backend() const;
+
+private:
+    void appendResult(const CalcHandler::CalculationResult& result, QByteArray& out);
+    void appendResult(const CalcResult<Decimal>& result, QByteArray& out);
+    void appendError(const QString& message, QByteArray& out);
+
+private:
+    ExpressionProgram m_program;
+    Statistics m_stats;
+    CalcHandler::Backend m_backend;
+    DecimalContext m_decimalContext;
+
+    static const int READ_CHUNK_SIZE = 1 << 20;
+    static const int WRITE_CHUNK_SIZE = 1 << 20;
+};
+
+#endif // BATCHEVALUATOR_H
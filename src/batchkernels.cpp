@@ -0,0 +1,548 @@
+#include "batchkernels.h"
+#include <cmath>
+#include <cstring>
+
+#if defined(Q_PROCESSOR_X86) && (defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64) \
+    || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+#  define CALC_KERNELS_SSE2
+#  include <emmintrin.h>
+#endif
+
+#if defined(CALC_KERNELS_SSE2) && (defined(Q_CC_GNU) || defined(Q_CC_CLANG) || defined(Q_CC_MSVC))
+#  define CALC_KERNELS_AVX2
+#  include <immintrin.h>
+#  if defined(Q_CC_MSVC) && !defined(Q_CC_CLANG)
+#    include <intrin.h>
+#    define CALC_TARGET_AVX2
+#  else
+#    define CALC_TARGET_AVX2 __attribute__((target("avx2")))
+#  endif
+#endif
+
+namespace {
+
+// Число единичных бит в 4-битной маске сравнения
+const int BIT_COUNT[16] = { 0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4 };
+
+inline void markError(quint64* errorMask, int index)
+{
+    if (errorMask) {
+        errorMask[index >> 6] |= quint64(1) << (index & 63);
+    }
+}
+
+inline void markErrors(quint64* errorMask, int index, int bits)
+{
+    // index кратен ширине вектора (2 или 4), поэтому биты не пересекают границу слова
+    if (errorMask) {
+        errorMask[index >> 6] |= quint64(bits) << (index & 63);
+    }
+}
+
+int divideScalar(const double* lhs, const double* rhs, double* out,
+                 int begin, int count, quint64* errorMask)
+{
+    int errors = 0;
+    for (int i = begin; i < count; ++i) {
+        const double divisor = rhs[i];
+        if (divisor == 0.0) {
+            out[i] = 0.0;
+            markError(errorMask, i);
+            ++errors;
+        } else {
+            out[i] = lhs[i] / divisor;
+        }
+    }
+    return errors;
+}
+
+int binaryScalar(CalcHandler::Operation op, const double* lhs, const double* rhs, double* out,
+                 int begin, int count, quint64* errorMask)
+{
+    switch (op) {
+        case CalcHandler::Operation::Add:
+            for (int i = begin; i < count; ++i) {
+                out[i] = lhs[i] + rhs[i];
+            }
+            return 0;
+
+        case CalcHandler::Operation::Subtract:
+            for (int i = begin; i < count; ++i) {
+                out[i] = lhs[i] - rhs[i];
+            }
+            return 0;
+
+        case CalcHandler::Operation::Multiply:
+            for (int i = begin; i < count; ++i) {
+                out[i] = lhs[i] * rhs[i];
+            }
+            return 0;
+
+        case CalcHandler::Operation::Divide:
+            return divideScalar(lhs, rhs, out, begin, count, errorMask);
+
+        default:
+            return 0;
+    }
+}
+
+int unaryScalar(CalcHandler::Operation op, const double* values, double* out,
+                int begin, int count, quint64* errorMask)
+{
+    int errors = 0;
+    switch (op) {
+        case CalcHandler::Operation::Percent:
+            for (int i = begin; i < count; ++i) {
+                out[i] = values[i] * 0.01;
+            }
+            break;
+
+        case CalcHandler::Operation::Negate:
+            for (int i = begin; i < count; ++i) {
+                out[i] = -values[i];
+            }
+            break;
+
+        case CalcHandler::Operation::Square:
+            for (int i = begin; i < count; ++i) {
+                out[i] = values[i] * values[i];
+            }
+            break;
+
+        case CalcHandler::Operation::SquareRoot:
+            for (int i = begin; i < count; ++i) {
+                const double value = values[i];
+                if (value < 0.0) {
+                    out[i] = 0.0;
+                    markError(errorMask, i);
+                    ++errors;
+                } else {
+                    out[i] = std::sqrt(value);
+                }
+            }
+            break;
+
+        case CalcHandler::Operation::Reciprocal:
+            for (int i = begin; i < count; ++i) {
+                const double value = values[i];
+                if (value == 0.0) {
+                    out[i] = 0.0;
+                    markError(errorMask, i);
+                    ++errors;
+                } else {
+                    out[i] = 1.0 / value;
+                }
+            }
+            break;
+
+        default:
+            break;
+    }
+    return errors;
+}
+
+#ifdef CALC_KERNELS_SSE2
+int binarySse2(CalcHandler::Operation op, const double* lhs, const double* rhs, double* out,
+               int count, quint64* errorMask)
+{
+    const int vectorEnd = count & ~1;
+    int errors = 0;
+
+    switch (op) {
+        case CalcHandler::Operation::Add:
+            for (int i = 0; i < vectorEnd; i += 2) {
+                _mm_storeu_pd(out + i, _mm_add_pd(_mm_loadu_pd(lhs + i), _mm_loadu_pd(rhs + i)));
+            }
+            break;
+
+        case CalcHandler::Operation::Subtract:
+            for (int i = 0; i < vectorEnd; i += 2) {
+                _mm_storeu_pd(out + i, _mm_sub_pd(_mm_loadu_pd(lhs + i), _mm_loadu_pd(rhs + i)));
+            }
+            break;
+
+        case CalcHandler::Operation::Multiply:
+            for (int i = 0; i < vectorEnd; i += 2) {
+                _mm_storeu_pd(out + i, _mm_mul_pd(_mm_loadu_pd(lhs + i), _mm_loadu_pd(rhs + i)));
+            }
+            break;
+
+        case CalcHandler::Operation::Divide: {
+            const __m128d zero = _mm_setzero_pd();
+            for (int i = 0; i < vectorEnd; i += 2) {
+                const __m128d divisor = _mm_loadu_pd(rhs + i);
+                const __m128d isZero = _mm_cmpeq_pd(divisor, zero);
+                const __m128d quotient = _mm_div_pd(_mm_loadu_pd(lhs + i), divisor);
+                _mm_storeu_pd(out + i, _mm_andnot_pd(isZero, quotient));
+
+                const int bits = _mm_movemask_pd(isZero);
+                if (bits) {
+                    markErrors(errorMask, i, bits);
+                    errors += BIT_COUNT[bits];
+                }
+            }
+            break;
+        }
+
+        default:
+            return 0;
+    }
+
+    return errors + binaryScalar(op, lhs, rhs, out, vectorEnd, count, errorMask);
+}
+
+int unarySse2(CalcHandler::Operation op, const double* values, double* out,
+              int count, quint64* errorMask)
+{
+    const int vectorEnd = count & ~1;
+    const __m128d zero = _mm_setzero_pd();
+    int errors = 0;
+
+    switch (op) {
+        case CalcHandler::Operation::Percent: {
+            const __m128d factor = _mm_set1_pd(0.01);
+            for (int i = 0; i < vectorEnd; i += 2) {
+                _mm_storeu_pd(out + i, _mm_mul_pd(_mm_loadu_pd(values + i), factor));
+            }
+            break;
+        }
+
+        case CalcHandler::Operation::Negate: {
+            const __m128d signBit = _mm_set1_pd(-0.0);
+            for (int i = 0; i < vectorEnd; i += 2) {
+                _mm_storeu_pd(out + i, _mm_xor_pd(_mm_loadu_pd(values + i), signBit));
+            }
+            break;
+        }
+
+        case CalcHandler::Operation::Square:
+            for (int i = 0; i < vectorEnd; i += 2) {
+                const __m128d value = _mm_loadu_pd(values + i);
+                _mm_storeu_pd(out + i, _mm_mul_pd(value, value));
+            }
+            break;
+
+        case CalcHandler::Operation::SquareRoot:
+            for (int i = 0; i < vectorEnd; i += 2) {
+                const __m128d value = _mm_loadu_pd(values + i);
+                const __m128d isNegative = _mm_cmplt_pd(value, zero);
+                _mm_storeu_pd(out + i, _mm_andnot_pd(isNegative, _mm_sqrt_pd(value)));
+
+                const int bits = _mm_movemask_pd(isNegative);
+                if (bits) {
+                    markErrors(errorMask, i, bits);
+                    errors += BIT_COUNT[bits];
+                }
+            }
+            break;
+
+        case CalcHandler::Operation::Reciprocal: {
+            // Точное деление: приближенный rcp для double без AVX-512 недоступен
+            const __m128d one = _mm_set1_pd(1.0);
+            for (int i = 0; i < vectorEnd; i += 2) {
+                const __m128d value = _mm_loadu_pd(values + i);
+                const __m128d isZero = _mm_cmpeq_pd(value, zero);
+                _mm_storeu_pd(out + i, _mm_andnot_pd(isZero, _mm_div_pd(one, value)));
+
+                const int bits = _mm_movemask_pd(isZero);
+                if (bits) {
+                    markErrors(errorMask, i, bits);
+                    errors += BIT_COUNT[bits];
+                }
+            }
+            break;
+        }
+
+        default:
+            return 0;
+    }
+
+    return errors + unaryScalar(op, values, out, vectorEnd, count, errorMask);
+}
+#endif // CALC_KERNELS_SSE2
+
+#ifdef CALC_KERNELS_AVX2
+CALC_TARGET_AVX2
+int binaryAvx2(CalcHandler::Operation op, const double* lhs, const double* rhs, double* out,
+               int count, quint64* errorMask)
+{
+    const int vectorEnd = count & ~3;
+    int errors = 0;
+
+    switch (op) {
+        case CalcHandler::Operation::Add:
+            for (int i = 0; i < vectorEnd; i += 4) {
+                _mm256_storeu_pd(out + i,
+                                 _mm256_add_pd(_mm256_loadu_pd(lhs + i), _mm256_loadu_pd(rhs + i)));
+            }
+            break;
+
+        case CalcHandler::Operation::Subtract:
+            for (int i = 0; i < vectorEnd; i += 4) {
+                _mm256_storeu_pd(out + i,
+                                 _mm256_sub_pd(_mm256_loadu_pd(lhs + i), _mm256_loadu_pd(rhs + i)));
+            }
+            break;
+
+        case CalcHandler::Operation::Multiply:
+            for (int i = 0; i < vectorEnd; i += 4) {
+                _mm256_storeu_pd(out + i,
+                                 _mm256_mul_pd(_mm256_loadu_pd(lhs + i), _mm256_loadu_pd(rhs + i)));
+            }
+            break;
+
+        case CalcHandler::Operation::Divide: {
+            const __m256d zero = _mm256_setzero_pd();
+            for (int i = 0; i < vectorEnd; i += 4) {
+                const __m256d divisor = _mm256_loadu_pd(rhs + i);
+                const __m256d isZero = _mm256_cmp_pd(divisor, zero, _CMP_EQ_OQ);
+                const __m256d quotient = _mm256_div_pd(_mm256_loadu_pd(lhs + i), divisor);
+                _mm256_storeu_pd(out + i, _mm256_andnot_pd(isZero, quotient));
+
+                const int bits = _mm256_movemask_pd(isZero);
+                if (bits) {
+                    markErrors(errorMask, i, bits);
+                    errors += BIT_COUNT[bits];
+                }
+            }
+            break;
+        }
+
+        default:
+            return 0;
+    }
+
+    return errors + binaryScalar(op, lhs, rhs, out, vectorEnd, count, errorMask);
+}
+
+CALC_TARGET_AVX2
+int unaryAvx2(CalcHandler::Operation op, const double* values, double* out,
+              int count, quint64* errorMask)
+{
+    const int vectorEnd = count & ~3;
+    const __m256d zero = _mm256_setzero_pd();
+    int errors = 0;
+
+    switch (op) {
+        case CalcHandler::Operation::Percent: {
+            const __m256d factor = _mm256_set1_pd(0.01);
+            for (int i = 0; i < vectorEnd; i += 4) {
+                _mm256_storeu_pd(out + i, _mm256_mul_pd(_mm256_loadu_pd(values + i), factor));
+            }
+            break;
+        }
+
+        case CalcHandler::Operation::Negate: {
+            const __m256d signBit = _mm256_set1_pd(-0.0);
+            for (int i = 0; i < vectorEnd; i += 4) {
+                _mm256_storeu_pd(out + i, _mm256_xor_pd(_mm256_loadu_pd(values + i), signBit));
+            }
+            break;
+        }
+
+        case CalcHandler::Operation::Square:
+            for (int i = 0; i < vectorEnd; i += 4) {
+                const __m256d value = _mm256_loadu_pd(values + i);
+                _mm256_storeu_pd(out + i, _mm256_mul_pd(value, value));
+            }
+            break;
+
+        case CalcHandler::Operation::SquareRoot:
+            for (int i = 0; i < vectorEnd; i += 4) {
+                const __m256d value = _mm256_loadu_pd(values + i);
+                const __m256d isNegative = _mm256_cmp_pd(value, zero, _CMP_LT_OQ);
+                _mm256_storeu_pd(out + i, _mm256_andnot_pd(isNegative, _mm256_sqrt_pd(value)));
+
+                const int bits = _mm256_movemask_pd(isNegative);
+                if (bits) {
+                    markErrors(errorMask, i, bits);
+                    errors += BIT_COUNT[bits];
+                }
+            }
+            break;
+
+        case CalcHandler::Operation::Reciprocal: {
+            const __m256d one = _mm256_set1_pd(1.0);
+            for (int i = 0; i < vectorEnd; i += 4) {
+                const __m256d value = _mm256_loadu_pd(values + i);
+                const __m256d isZero = _mm256_cmp_pd(value, zero, _CMP_EQ_OQ);
+                _mm256_storeu_pd(out + i, _mm256_andnot_pd(isZero, _mm256_div_pd(one, value)));
+
+                const int bits = _mm256_movemask_pd(isZero);
+                if (bits) {
+                    markErrors(errorMask, i, bits);
+                    errors += BIT_COUNT[bits];
+                }
+            }
+            break;
+        }
+
+        default:
+            return 0;
+    }
+
+    return errors + unaryScalar(op, values, out, vectorEnd, count, errorMask);
+}
+#endif // CALC_KERNELS_AVX2
+
+BatchKernels::InstructionSet detectInstructionSet()
+{
+#if defined(CALC_KERNELS_AVX2) && defined(Q_CC_MSVC) && !defined(Q_CC_CLANG)
+    int info[4];
+    __cpuid(info, 0);
+    if (info[0] >= 7) {
+        __cpuid(info, 1);
+        const bool osSavesYmm = (info[2] & (1 << 27)) && (_xgetbv(0) & 0x6) == 0x6;
+        __cpuidex(info, 7, 0);
+        if (osSavesYmm && (info[1] & (1 << 5))) {
+            return BatchKernels::InstructionSet::Avx2;
+        }
+    }
+#elif defined(CALC_KERNELS_AVX2)
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) {
+        return BatchKernels::InstructionSet::Avx2;
+    }
+#endif
+
+#ifdef CALC_KERNELS_SSE2
+    return BatchKernels::InstructionSet::Sse2;
+#else
+    return BatchKernels::InstructionSet::Scalar;
+#endif
+}
+
+bool isBinaryOperation(CalcHandler::Operation op)
+{
+    return op == CalcHandler::Operation::Add
+        || op == CalcHandler::Operation::Subtract
+        || op == CalcHandler::Operation::Multiply
+        || op == CalcHandler::Operation::Divide;
+}
+
+bool isUnaryOperation(CalcHandler::Operation op)
+{
+    return op == CalcHandler::Operation::Percent
+        || op == CalcHandler::Operation::Negate
+        || op == CalcHandler::Operation::Square
+        || op == CalcHandler::Operation::SquareRoot
+        || op == CalcHandler::Operation::Reciprocal;
+}
+
+int markAllErrors(double* out, int count, quint64* errorMask)
+{
+    for (int i = 0; i < count; ++i) {
+        out[i] = 0.0;
+        markError(errorMask, i);
+    }
+    return count;
+}
+
+} // namespace
+
+int BatchKernels::binary(CalcHandler::Operation op,
+                         const double* lhs, const double* rhs, double* out, int count,
+                         quint64* errorMask)
+{
+    return binary(activeInstructionSet(), op, lhs, rhs, out, count, errorMask);
+}
+
+int BatchKernels::binary(InstructionSet isa, CalcHandler::Operation op,
+                         const double* lhs, const double* rhs, double* out, int count,
+                         quint64* errorMask)
+{
+    if (count <= 0) {
+        return 0;
+    }
+
+    if (errorMask) {
+        std::memset(errorMask, 0, sizeof(quint64) * errorMaskWords(count));
+    }
+
+    if (!isBinaryOperation(op)) {
+        // Неизвестная операция: как и performBinaryOperation, все элементы ошибочны
+        return markAllErrors(out, count, errorMask);
+    }
+
+    switch (supportedInstructionSet(isa)) {
+#ifdef CALC_KERNELS_AVX2
+        case InstructionSet::Avx2:
+            return binaryAvx2(op, lhs, rhs, out, count, errorMask);
+#endif
+#ifdef CALC_KERNELS_SSE2
+        case InstructionSet::Sse2:
+            return binarySse2(op, lhs, rhs, out, count, errorMask);
+#endif
+        default:
+            return binaryScalar(op, lhs, rhs, out, 0, count, errorMask);
+    }
+}
+
+int BatchKernels::unary(CalcHandler::Operation op,
+                        const double* values, double* out, int count,
+                        quint64* errorMask)
+{
+    return unary(activeInstructionSet(), op, values, out, count, errorMask);
+}
+
+int BatchKernels::unary(InstructionSet isa, CalcHandler::Operation op,
+                        const double* values, double* out, int count,
+                        quint64* errorMask)
+{
+    if (count <= 0) {
+        return 0;
+    }
+
+    if (errorMask) {
+        std::memset(errorMask, 0, sizeof(quint64) * errorMaskWords(count));
+    }
+
+    if (!isUnaryOperation(op)) {
+        return markAllErrors(out, count, errorMask);
+    }
+
+    switch (supportedInstructionSet(isa)) {
+#ifdef CALC_KERNELS_AVX2
+        case InstructionSet::Avx2:
+            return unaryAvx2(op, values, out, count, errorMask);
+#endif
+#ifdef CALC_KERNELS_SSE2
+        case InstructionSet::Sse2:
+            return unarySse2(op, values, out, count, errorMask);
+#endif
+        default:
+            return unaryScalar(op, values, out, 0, count, errorMask);
+    }
+}
+
+BatchKernels::InstructionSet BatchKernels::activeInstructionSet()
+{
+    static const InstructionSet detected = detectInstructionSet();
+    return detected;
+}
+
+BatchKernels::InstructionSet BatchKernels::supportedInstructionSet(InstructionSet requested)
+{
+    const InstructionSet available = activeInstructionSet();
+    return static_cast<int>(requested) <= static_cast<int>(available) ? requested : available;
+}
+
+const char* BatchKernels::instructionSetName(InstructionSet isa)
+{
+    switch (isa) {
+        case InstructionSet::Avx2: return "avx2";
+        case InstructionSet::Sse2: return "sse2";
+        case InstructionSet::Scalar:
+        default: return "scalar";
+    }
+}
+
+int BatchKernels::errorMaskWords(int count)
+{
+    return count > 0 ? (count + 63) / 64 : 0;
+}
+
+bool BatchKernels::hasError(const quint64* errorMask, int index)
+{
+    return (errorMask[index >> 6] >> (index & 63)) & 1;
+}
@@ -0,0 +1,54 @@
+#ifndef BATCHKERNELS_H
+#define BATCHKERNELS_H
+
+#include <QtGlobal>
+#include "calchandler.h"
+
+// Векторизованные ядра арифметики над непрерывными массивами double.
+// Набор инструкций (AVX2/SSE2/скалярный) выбирается один раз во время выполнения.
+// Ошибки домена не меняют состояние CalcHandler: они возвращаются битовой маской
+// (бит i слова i / 64 соответствует элементу i) и количеством ошибочных элементов.
+// Значение ошибочного элемента равно 0.0, как и в CalculationResult.
+// Переполнение (inf из конечных операндов) в маске не отмечается.
+class BatchKernels
+{
+public:
+    enum class InstructionSet {
+        Scalar,
+        Sse2,
+        Avx2
+    };
+
+public:
+    // out может совпадать с входными массивами. errorMask может быть nullptr,
+    // иначе должен вмещать errorMaskWords(count) слов.
+    static int binary(CalcHandler::Operation op,
+                      const double* lhs, const double* rhs, double* out, int count,
+                      quint64* errorMask);
+    static int binary(InstructionSet isa, CalcHandler::Operation op,
+                      const double* lhs, const double* rhs, double* out, int count,
+                      quint64* errorMask);
+
+    // Percent, Negate, Square, SquareRoot, Reciprocal. Ошибки домена
+    // (корень из отрицательного, обратное к нулю) отмечаются в errorMask.
+    static int unary(CalcHandler::Operation op,
+                     const double* values, double* out, int count,
+                     quint64* errorMask);
+    static int unary(InstructionSet isa, CalcHandler::Operation op,
+                     const double* values, double* out, int count,
+                     quint64* errorMask);
+
+public:
+    static InstructionSet activeInstructionSet();
+    static InstructionSet supportedInstructionSet(InstructionSet requested);
+    static const char* instructionSetName(InstructionSet isa);
+
+public:
+    static int errorMaskWords(int count);
+    static bool hasError(const quint64* errorMask, int index);
+
+private:
+    BatchKernels() = default;
+};
+
+#endif // BATCHKERNELS_H
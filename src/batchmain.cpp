@@ -0,0 +1,107 @@
+#include "batchevaluator.h"
+
+#include <QFile>
+#include <QString>
+#include <cstdio>
+
+// Пакетный режим калькулятора без GUI:
+//   calc_batch [-o <файл>] [--decimal[=<цифр>]] <файл|->
+// Читает выражения построчно и пишет результаты построчно (по умолчанию в stdout).
+// Намеренно не создает QCoreApplication: для потоковой обработки он не нужен,
+// а время запуска критично при вызове из скриптов.
+
+namespace {
+
+void printUsage()
+{
+    std::fprintf(stderr,
+                 "Использование: calc_batch [-o <файл>] [--decimal[=<цифр>]] <файл|->\n"
+                 "  <файл|->   входной файл с выражениями, '-' - стандартный ввод\n"
+                 "  -o         файл для результатов (по умолчанию стандартный вывод)\n"
+                 "  --decimal  десятичная арифметика с заданным числом значащих цифр\n"
+                 "             (по умолчанию %d) вместо double\n",
+                 DecimalContext::DEFAULT_DIGITS);
+}
+
+} // namespace
+
+int main(int argc, char *argv[])
+{
+    QString inputPath;
+    QString outputPath;
+    CalcHandler::Backend backend = CalcHandler::Backend::Double;
+    DecimalContext decimalContext;
+
+    for (int i = 1; i < argc; ++i) {
+        const QString arg = QString::fromLocal8Bit(argv[i]);
+        if (arg == "-o" || arg == "--output") {
+            if (i + 1 >= argc) {
+                printUsage();
+                return 1;
+            }
+            outputPath = QString::fromLocal8Bit(argv[++i]);
+        } else if (arg == "--decimal" || arg.startsWith("--decimal=")) {
+            backend = CalcHandler::Backend::Decimal;
+            if (arg != "--decimal") {
+                bool ok = false;
+                const int digits = arg.mid(int(sizeof("--decimal=")) - 1).toInt(&ok);
+                if (!ok || digits < 1) {
+                    printUsage();
+                    return 1;
+                }
+                decimalContext = DecimalContext(digits);
+            }
+        } else if (arg == "-h" || arg == "--help") {
+            printUsage();
+            return 0;
+        } else if (inputPath.isEmpty()) {
+            inputPath = arg;
+        } else {
+            printUsage();
+            return 1;
+        }
+    }
+
+    if (inputPath.isEmpty()) {
+        printUsage();
+        return 1;
+    }
+
+    QFile input;
+    bool inputOpened = false;
+    if (inputPath == "-") {
+        inputOpened = input.open(stdin, QIODevice::ReadOnly);
+    } else {
+        input.setFileName(inputPath);
+        inputOpened = input.open(QIODevice::ReadOnly);
+    }
+    if (!inputOpened) {
+        std::fprintf(stderr, "Не удалось открыть файл для чтения: %s\n", qPrintable(inputPath));
+        return 1;
+    }
+
+    QFile output;
+    bool outputOpened = false;
+    if (outputPath.isEmpty()) {
+        outputOpened = output.open(stdout, QIODevice::WriteOnly);
+    } else {
+        output.setFileName(outputPath);
+        outputOpened = output.open(QIODevice::WriteOnly | QIODevice::Truncate);
+    }
+    if (!outputOpened) {
+        std::fprintf(stderr, "Не удалось открыть файл для записи: %s\n", qPrintable(outputPath));
+        return 1;
+    }
+
+    BatchEvaluator evaluator;
+    evaluator.setBackend(backend, decimalContext);
+    const BatchEvaluator::Statistics stats = evaluator.run(&input, &output);
+    output.flush();
+
+    if (stats.errors > 0) {
+        std::fprintf(stderr, "Обработано строк: %lld, ошибок: %lld\n",
+                     static_cast<long long>(stats.lines),
+                     static_cast<long long>(stats.errors));
+    }
+    return 0;
+}
@@ -0,0 +1,193 @@
+#ifndef CALCENGINE_H
+#define CALCENGINE_H
+
+#include <QtGlobal>
+#include <cmath>
+#include <type_traits>
+#include "decimal.h"
+
+// Операции калькулятора. В CalcHandler доступны как CalcHandler::Operation
+enum class CalcOperation {
+    None,
+    Add,
+    Subtract,
+    Multiply,
+    Divide,
+    Percent,
+    Negate,
+    Square,
+    SquareRoot,
+    Reciprocal
+};
+
+// Код ошибки вычисления. Текст для пользователя - ErrorMessages::text()
+enum class CalcError : quint8 {
+    None,
+    DivisionByZero,
+    NegativeRoot,
+    Overflow,
+    UnknownOperation,
+    InsufficientData,
+    InvalidInput
+};
+
+// Результат без выделений памяти: значение и код ошибки.
+// При ошибке value равно нулю типа T.
+template<typename T>
+struct CalcResult {
+    T value;
+    CalcError error;
+
+    bool success() const { return error == CalcError::None; }
+};
+
+// Свойства числового типа для CalcEngine: проверки домена и арифметика.
+// Общий вариант - для двоичных типов с плавающей точкой (float, double, long double),
+// у которых контекст пуст, а переполнение дает бесконечность.
+template<typename T>
+struct NumericTraits
+{
+    static_assert(std::is_floating_point<T>::value,
+                  "NumericTraits: нужна специализация для этого типа");
+
+    struct Context {};
+
+    static bool isZero(T value) { return value == T(0); }
+    static bool isNegative(T value) { return value < T(0); }
+    static bool isFinite(T value) { return std::isfinite(value); }
+
+    static T add(T lhs, T rhs, const Context&) { return lhs + rhs; }
+    static T subtract(T lhs, T rhs, const Context&) { return lhs - rhs; }
+    static T multiply(T lhs, T rhs, const Context&) { return lhs * rhs; }
+    static T divide(T lhs, T rhs, const Context&) { return lhs / rhs; }
+    // Умножение на 0.01, а не деление на 100: для double совпадает с BatchKernels
+    static T percent(T value, const Context&) { return value * T(0.01L); }
+    static T negate(T value, const Context&) { return -value; }
+    static T squareRoot(T value, const Context&) { return std::sqrt(value); }
+};
+
+// Decimal: точность и округление задаются DecimalContext, переполнения нет
+template<>
+struct NumericTraits<Decimal>
+{
+    typedef DecimalContext Context;
+
+    static bool isZero(const Decimal& value) { return value.isZero(); }
+    static bool isNegative(const Decimal& value) { return value.isNegative(); }
+    static bool isFinite(const Decimal&) { return true; }
+
+    static Decimal add(const Decimal& lhs, const Decimal& rhs, const Context& context)
+    {
+        return Decimal::add(lhs, rhs, context);
+    }
+    static Decimal subtract(const Decimal& lhs, const Decimal& rhs, const Context& context)
+    {
+        return Decimal::subtract(lhs, rhs, context);
+    }
+    static Decimal multiply(const Decimal& lhs, const Decimal& rhs, const Context& context)
+    {
+        return Decimal::multiply(lhs, rhs, context);
+    }
+    static Decimal divide(const Decimal& lhs, const Decimal& rhs, const Context& context)
+    {
+        return Decimal::divide(lhs, rhs, context);
+    }
+    static Decimal percent(const Decimal& value, const Context& context)
+    {
+        return Decimal::scaled(value, -2).rounded(context);
+    }
+    static Decimal negate(const Decimal& value, const Context& context)
+    {
+        return value.negated().rounded(context);
+    }
+    static Decimal squareRoot(const Decimal& value, const Context& context)
+    {
+        return Decimal::squareRoot(value, context);
+    }
+};
+
+// Арифметика калькулятора над числовым типом T.
+// Одна реализация для всех типов: CalcHandler использует double и Decimal,
+// пакетные задачи могут взять float, точные - long double или Decimal.
+// Проверки домена (деление на ноль, корень из отрицательного) берутся из Traits.
+template<typename T, typename Traits = NumericTraits<T> >
+class CalcEngine
+{
+public:
+    typedef T Value;
+    typedef typename Traits::Context Context;
+    typedef CalcResult<T> Result;
+
+public:
+    static Result computeBinary(const T& operand1, const T& operand2, CalcOperation op,
+                                const Context& context = Context())
+    {
+        switch (op) {
+            case CalcOperation::Add:
+                return finish(Traits::add(operand1, operand2, context), operand1, operand2);
+
+            case CalcOperation::Subtract:
+                return finish(Traits::subtract(operand1, operand2, context), operand1, operand2);
+
+            case CalcOperation::Multiply:
+                return finish(Traits::multiply(operand1, operand2, context), operand1, operand2);
+
+            case CalcOperation::Divide:
+                if (Traits::isZero(operand2)) {
+                    return failure(CalcError::DivisionByZero);
+                }
+                return finish(Traits::divide(operand1, operand2, context), operand1, operand2);
+
+            default:
+                return failure(CalcError::UnknownOperation);
+        }
+    }
+
+    static Result computeUnary(CalcOperation op, const T& value,
+                               const Context& context = Context())
+    {
+        switch (op) {
+            case CalcOperation::Percent:
+                return finish(Traits::percent(value, context), value, value);
+
+            case CalcOperation::Negate:
+                return finish(Traits::negate(value, context), value, value);
+
+            case CalcOperation::Square:
+                return finish(Traits::multiply(value, value, context), value, value);
+
+            case CalcOperation::SquareRoot:
+                if (Traits::isNegative(value)) {
+                    return failure(CalcError::NegativeRoot);
+                }
+                return finish(Traits::squareRoot(value, context), value, value);
+
+            case CalcOperation::Reciprocal:
+                if (Traits::isZero(value)) {
+                    return failure(CalcError::DivisionByZero);
+                }
+                return finish(Traits::divide(T(1), value, context), value, value);
+
+            default:
+                return failure(CalcError::UnknownOperation);
+        }
+    }
+
+private:
+    static Result failure(CalcError error)
+    {
+        return {T(), error};
+    }
+
+    // Бесконечность из конечных операндов означает выход за диапазон типа
+    static Result finish(const T& value, const T& operand1, const T& operand2)
+    {
+        if (!Traits::isFinite(value)
+            && Traits::isFinite(operand1) && Traits::isFinite(operand2)) {
+            return failure(CalcError::Overflow);
+        }
+        return {value, CalcError::None};
+    }
+};
+
+#endif // CALCENGINE_H
@@ -1,4 +1,6 @@
 #include "calchandler.h"
+#include "batchkernels.h"
+#include "tracer.h"
 #include <cmath>
 #include <QDebug>
 
@@ -8,6 +10,7 @@ CalcHandler::CalcHandler(QObject *parent)
     , m_storedValue(0.0)
     , m_operation(Operation::None)
     , m_hasStoredValue(false)
+    , m_backend(Backend::Double)
 {
 }
 
@@ -33,109 +36,110 @@ void CalcHandler::setOperation(Operation op)
 
 CalcHandler::CalculationResult CalcHandler::calculate()
 {
+    const TraceSpan span("calc", "CalcHandler::calculate");
     if (!m_hasStoredValue || m_operation == Operation::None) {
-        return {false, 0.0, "Недостаточно данных для вычисления"};
+        return {0.0, Error::InsufficientData};
     }
     
     m_state = State::ResultDisplayed;
-    return {true, m_storedValue, ""};
+    return {m_storedValue, Error::None};
 }
 
 CalcHandler::CalculationResult CalcHandler::performBinaryOperation(
     double operand1, double operand2, Operation op)
 {
-    CalculationResult result;
-    result.success = true;
-    result.errorMessage = "";
-    
-    switch (op) {
-        case Operation::Add:
-            result.value = operand1 + operand2;
-            break;
-            
-        case Operation::Subtract:
-            result.value = operand1 - operand2;
-            break;
-            
-        case Operation::Multiply:
-            result.value = operand1 * operand2;
-            break;
-            
-        case Operation::Divide:
-            if (!isValidDivision(operand2)) {
-                result.success = false;
-                result.value = 0.0;
-                result.errorMessage = "Ошибка: деление на 0";
-                m_state = State::Error;
-                return result;
-            }
-            result.value = operand1 / operand2;
-            break;
-            
-        default:
-            result.success = false;
-            result.value = 0.0;
-            result.errorMessage = "Неизвестная операция";
-            m_state = State::Error;
-            return result;
+    const TraceSpan span("calc", "CalcHandler::performBinaryOperation");
+    CalculationResult result = m_backend == Backend::Decimal
+        ? computeBinary(operand1, operand2, op, m_decimalContext)
+        : computeBinary(operand1, operand2, op);
+    if (result.success()) {
+        m_storedValue = result.value;
+        m_state = State::ResultDisplayed;
+    } else {
+        m_state = State::Error;
     }
-    
-    m_storedValue = result.value;
-    m_state = State::ResultDisplayed;
     return result;
 }
 
+int CalcHandler::performBinaryOperation(const double* operands1, const double* operands2,
+                                        double* results, int count, Operation op,
+                                        quint64* errorMask)
+{
+    const TraceSpan span("calc", "CalcHandler::performBinaryOperation[batch]");
+    return BatchKernels::binary(op, operands1, operands2, results, count, errorMask);
+}
+
 CalcHandler::CalculationResult CalcHandler::applyUnaryOperation(Operation op, double value)
 {
-    CalculationResult result;
-    result.success = true;
-    result.errorMessage = "";
-    
-    switch (op) {
-        case Operation::Percent:
-            result.value = value * 0.01;
-            break;
-            
-        case Operation::Negate:
-            result.value = -value;
-            break;
-            
-        case Operation::Square:
-            result.value = value * value;
-            break;
-            
-        case Operation::SquareRoot:
-            if (value < 0.0) {
-                result.success = false;
-                result.value = 0.0;
-                result.errorMessage = "Ошибка: корень из отрицательного числа";
-                m_state = State::Error;
-                return result;
-            }
-            result.value = std::sqrt(value);
-            break;
-            
-        case Operation::Reciprocal:
-            if (!isValidDivision(value)) {
-                result.success = false;
-                result.value = 0.0;
-                result.errorMessage = "Ошибка: деление на 0";
-                m_state = State::Error;
-                return result;
-            }
-            result.value = 1.0 / value;
-            break;
-            
-        default:
-            result.success = false;
-            result.value = 0.0;
-            result.errorMessage = "Неизвестная унарная операция";
-            return result;
+    const TraceSpan span("calc", "CalcHandler::applyUnaryOperation");
+    CalculationResult result = m_backend == Backend::Decimal
+        ? computeUnary(op, value, m_decimalContext)
+        : computeUnary(op, value);
+    // Неприменимая операция состояние не меняет
+    if (!result.success() && result.error != Error::UnknownOperation) {
+        m_state = State::Error;
     }
-    
     return result;
 }
 
+int CalcHandler::applyUnaryOperation(Operation op, const double* values, double* results,
+                                     int count, quint64* errorMask)
+{
+    const TraceSpan span("calc", "CalcHandler::applyUnaryOperation[batch]");
+    return BatchKernels::unary(op, values, results, count, errorMask);
+}
+
+CalcHandler::CalculationResult CalcHandler::computeBinary(
+    double operand1, double operand2, Operation op)
+{
+    return CalcEngine<double>::computeBinary(operand1, operand2, op);
+}
+
+CalcHandler::CalculationResult CalcHandler::computeUnary(Operation op, double value)
+{
+    return CalcEngine<double>::computeUnary(op, value);
+}
+
+CalcHandler::CalculationResult CalcHandler::computeBinary(
+    double operand1, double operand2, Operation op, const DecimalContext& context)
+{
+    bool ok1 = false;
+    bool ok2 = false;
+    const Decimal decimal1 = Decimal::fromDouble(operand1, &ok1);
+    const Decimal decimal2 = Decimal::fromDouble(operand2, &ok2);
+    // Бесконечности и NaN в Decimal не представимы
+    if (!ok1 || !ok2) {
+        return computeBinary(operand1, operand2, op);
+    }
+
+    return fromDecimal(CalcEngine<Decimal>::computeBinary(decimal1, decimal2, op, context));
+}
+
+CalcHandler::CalculationResult CalcHandler::computeUnary(
+    Operation op, double value, const DecimalContext& context)
+{
+    bool ok = false;
+    const Decimal decimal = Decimal::fromDouble(value, &ok);
+    if (!ok) {
+        return computeUnary(op, value);
+    }
+
+    return fromDecimal(CalcEngine<Decimal>::computeUnary(op, decimal, context));
+}
+
+CalcHandler::CalculationResult CalcHandler::fromDecimal(const CalcResult<Decimal>& result)
+{
+    if (!result.success()) {
+        return {0.0, result.error};
+    }
+    // Операнды конечны, поэтому бесконечность при обратном переводе - переполнение double
+    const double value = result.value.toDouble();
+    if (!std::isfinite(value)) {
+        return {0.0, Error::Overflow};
+    }
+    return {value, Error::None};
+}
+
 void CalcHandler::clear()
 {
     m_storedValue = 0.0;
@@ -149,6 +153,26 @@ void CalcHandler::reset()
     clear();
 }
 
+void CalcHandler::setBackend(Backend backend)
+{
+    m_backend = backend;
+}
+
+CalcHandler::Backend CalcHandler::backend() const
+{
+    return m_backend;
+}
+
+void CalcHandler::setDecimalContext(const DecimalContext& context)
+{
+    m_decimalContext = context;
+}
+
+DecimalContext CalcHandler::decimalContext() const
+{
+    return m_decimalContext;
+}
+
 CalcHandler::State CalcHandler::currentState() const
 {
     return m_state;
@@ -195,8 +219,3 @@ QString CalcHandler::operationToString(Operation op)
         default: return "";
     }
 }
-
-bool CalcHandler::isValidDivision(double divisor) const
-{
-    return !qFuzzyCompare(divisor, 0.0);
-}
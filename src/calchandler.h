@@ -4,6 +4,7 @@
 #include <QObject>
 #include <QString>
 #include <QChar>
+#include "calcengine.h"
 
 class CalcHandler : public QObject
 {
@@ -18,23 +19,19 @@ public:
         Error
     };
 
-    enum class Operation {
-        None,
-        Add,
-        Subtract,
-        Multiply,
-        Divide,
-        Percent,
-        Negate,
-        Square,
-        SquareRoot,
-        Reciprocal
-    };
+    // Операции, коды ошибок и результат общие с CalcEngine (calcengine.h)
+    typedef CalcOperation Operation;
+    typedef CalcError Error;
+    typedef CalcResult<double> CalculationResult;
 
-    struct CalculationResult {
-        bool success;
-        double value;
-        QString errorMessage;
+    // Арифметика интерактивных операций: double или десятичная произвольной точности.
+    // Обработчик хранит значения в double, поэтому с Decimal каждая операция точна,
+    // но ее результат снова округляется до double (не больше 17 значащих цифр).
+    // Десятичный результат без потерь - ExpressionProgram::evaluate(DecimalContext)
+    // и calc_batch --decimal
+    enum class Backend {
+        Double,
+        Decimal
     };
 
 public:
@@ -47,6 +44,33 @@ public:
     CalculationResult calculate();
     CalculationResult applyUnaryOperation(Operation op, double value);
     CalculationResult performBinaryOperation(double operand1, double operand2, Operation op);
+
+public:
+    // Пакетные варианты над массивами: состояние не меняется, ошибки домена
+    // отмечаются в битовой маске errorMask (см. BatchKernels). Возвращают число ошибок.
+    static int performBinaryOperation(const double* operands1, const double* operands2,
+                                      double* results, int count, Operation op,
+                                      quint64* errorMask = nullptr);
+    static int applyUnaryOperation(Operation op, const double* values, double* results,
+                                   int count, quint64* errorMask = nullptr);
+
+public:
+    void setBackend(Backend backend);
+    Backend backend() const;
+    void setDecimalContext(const DecimalContext& context);
+    DecimalContext decimalContext() const;
+
+public:
+    // Чистые вычисления без изменения состояния (для ExpressionProgram и пакетного режима).
+    // Делегируют CalcEngine<double> и CalcEngine<Decimal>
+    static CalculationResult computeBinary(double operand1, double operand2, Operation op);
+    static CalculationResult computeUnary(Operation op, double value);
+    // Через Decimal: операнды берутся в кратчайшем десятичном виде (0.1 + 0.2 = 0.3),
+    // результат возвращается в double
+    static CalculationResult computeBinary(double operand1, double operand2, Operation op,
+                                           const DecimalContext& context);
+    static CalculationResult computeUnary(Operation op, double value,
+                                          const DecimalContext& context);
     
 public:
     void clear();
@@ -63,13 +87,15 @@ public:
     static QString operationToString(Operation op);
 
 private:
-    bool isValidDivision(double divisor) const;
+    static CalculationResult fromDecimal(const CalcResult<Decimal>& result);
 
 private:
     State m_state;
     double m_storedValue;
     Operation m_operation;
     bool m_hasStoredValue;
+    Backend m_backend;
+    DecimalContext m_decimalContext;
 };
 
 #endif // CALCHANDLER_H
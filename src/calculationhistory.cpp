@@ -1,119 +1,484 @@
 #include "calculationhistory.h"
+#include "calculatorconfig.h"
+#include "historyarchive.h"
+#include "numberformatter.h"
+#include "numberparser.h"
+#include "persistenceworker.h"
+#include "tracer.h"
+#include "logcategories.h"
+#include <QDateTime>
 #include <QFile>
+#include <QSharedPointer>
 #include <QTextStream>
-#include <QDebug>
+
+namespace {
+
+const int DEFAULT_MAX_SIZE = 20;
+// Меньше этого пул текстов не пересобирается
+const int MIN_POOL_SIZE = 64;
+// Журнал сжимается, когда кадров в нем больше этой доли всех записей (но не меньше
+// MIN_JOURNAL_RECORDS): при запуске журнал читается целиком, а снимок - нет.
+// Сжатие копирует все кадры, порог амортизирует это числом добавлений
+const int JOURNAL_COMPACTION_DIVISOR = 4;
+const int MIN_JOURNAL_RECORDS = 1024;
+
+// Готовая строка хранится как есть; результат, если он есть, доступен и числом
+HistoryEntry entryFromText(const QString& text)
+{
+    HistoryEntry entry;
+    entry.expression = text;
+    const int separator = text.lastIndexOf(" = ");
+    if (separator >= 0) {
+        bool ok = false;
+        const double result = NumberParser::toDouble(
+            text.constData() + separator + 3, text.constData() + text.size(), &ok);
+        if (ok) {
+            entry.result = result;
+        }
+    }
+    return entry;
+}
+
+} // namespace
+
+QString HistoryEntry::text() const
+{
+    if (resultPrecision == 0) {
+        return expression;
+    }
+
+    Q_ASSERT(resultPrecision + 12 <= NumberFormatter::BUFFER_SIZE);
+    QChar buffer[NumberFormatter::BUFFER_SIZE];
+    const int length = NumberFormatter::formatGeneral(result, resultPrecision, buffer);
+
+    QString entry;
+    entry.reserve(expression.size() + 3 + length);
+    entry.append(expression);
+    entry.append(" = ");
+    entry.append(buffer, length);
+    return entry;
+}
 
 CalculationHistory::CalculationHistory(QObject *parent)
     : QObject(parent)
-    , m_maxSize(20)
+    , m_entries(DEFAULT_MAX_SIZE)
+    , m_archiveBegin(0)
+    , m_archiveEnd(0)
+    , m_journalRecords(0)
+    , m_persistence(nullptr)
 {
 }
 
-void CalculationHistory::addEntry(const QString& expression, double result)
+CalculationHistory::~CalculationHistory()
 {
-    QString entry = QString("%1 = %2").arg(expression).arg(result);
-    addEntry(entry);
+    closeJournal();
 }
 
-void CalculationHistory::addEntry(const QString& fullExpression)
+void CalculationHistory::addEntry(const HistoryEntry& entry)
 {
-    if (fullExpression.isEmpty()) {
+    const TraceSpan span("history", "CalculationHistory::addEntry");
+    if (entry.expression.isEmpty() || m_entries.capacity() == 0) {
         return;
     }
-    
-    m_history.prepend(fullExpression);
-    
-    while (m_history.size() > m_maxSize) {
-        m_history.removeLast();
+
+    HistoryEntry stored = entry;
+    stored.expression = intern(entry.expression);
+    if (stored.timestamp == 0) {
+        stored.timestamp = QDateTime::currentMSecsSinceEpoch();
     }
-    
-    qDebug() << "История добавлена:" << fullExpression;
+    const int oldCount = count();
+    m_entries.append(stored);
+    // Пока есть записи в снимке, кольцо не заполнено и вытесняется самая старая из снимка
+    if (m_archiveBegin < m_archiveEnd && count() > m_entries.capacity()) {
+        ++m_archiveBegin;
+    }
+
+    if (m_journal) {
+        m_journal->append(stored);
+        if (++m_journalRecords > qMax(count() / JOURNAL_COMPACTION_DIVISOR,
+                                      MIN_JOURNAL_RECORDS)) {
+            compactJournal();
+        }
+    }
+
+    const int evicted = oldCount + 1 - count();
+    if (evicted > 0) {
+        emit entriesEvicted(evicted);
+    }
+    emit entriesAdded(1);
     emit historyChanged();
 }
 
+void CalculationHistory::addEntry(const QString& expression, double result)
+{
+    HistoryEntry entry;
+    entry.expression = expression;
+    entry.result = result;
+    entry.resultPrecision = CalculatorConfig::HISTORY_RESULT_PRECISION;
+    addEntry(entry);
+}
+
+void CalculationHistory::addEntry(const QString& fullExpression)
+{
+    addEntry(entryFromText(fullExpression));
+}
+
 QStringList CalculationHistory::getAll() const
 {
-    return m_history;
+    QStringList all;
+    all.reserve(count());
+    for (int i = 0; i < count(); ++i) {
+        all.append(entryAt(i).text());
+    }
+    return all;
 }
 
 QString CalculationHistory::getLast() const
 {
-    if (m_history.isEmpty()) {
+    if (count() == 0) {
         return QString();
     }
-    return m_history.first();
+    return entryAt(0).text();
 }
 
 int CalculationHistory::count() const
 {
-    return m_history.size();
+    return archiveSize() + m_entries.size();
 }
 
 void CalculationHistory::clear()
 {
-    m_history.clear();
-    qDebug() << "История очищена";
-    emit historyChanged();
+    m_entries.clear();
+    m_expressions.clear();
+    resetArchive();
+    if (m_journal) {
+        compactJournal();
+    }
+    qCDebug(lcHistory) << "История очищена";
+    notifyReset();
 }
 
-void CalculationHistory::saveToFile(const QString& filename)
+const CalculationHistory::Entries& CalculationHistory::entries() const
 {
-    QFile file(filename);
-    if (!file.open(QIODevice::WriteOnly | QIODevice::Text)) {
-        qDebug() << "Не удалось открыть файл для записи:" << filename;
-        return;
+    return m_entries;
+}
+
+HistoryEntry CalculationHistory::entryAt(int index) const
+{
+    Q_ASSERT(index >= 0 && index < count());
+    if (index < m_entries.size()) {
+        return m_entries.at(m_entries.size() - 1 - index);
     }
-    
-    QTextStream out(&file);
-    for (const QString& entry : m_history) {
-        out << entry << "\n";
+    HistoryEntry entry;
+    m_archive.entryAt(m_archiveEnd - 1 - (index - m_entries.size()), entry);
+    return entry;
+}
+
+void CalculationHistory::saveToFile(const QString& filename)
+{
+    const TraceSpan span("history", "CalculationHistory::saveToFile");
+    const QStringList lines = getAll();
+    const PersistenceWorker::Task save = [filename, lines]() {
+        const TraceSpan span("history", "CalculationHistory::saveToFile[write]");
+        QFile file(filename);
+        if (!file.open(QIODevice::WriteOnly | QIODevice::Text)) {
+            qCWarning(lcHistory) << "Не удалось открыть файл для записи:" << filename;
+            return;
+        }
+
+        QTextStream out(&file);
+        for (const QString& line : lines) {
+            out << line << "\n";
+        }
+
+        file.close();
+        qCDebug(lcHistory) << "История сохранена в файл:" << filename;
+    };
+
+    if (m_persistence) {
+        m_persistence->post("history:" + filename, save);
+    } else {
+        save();
     }
-    
-    file.close();
-    qDebug() << "История сохранена в файл:" << filename;
 }
 
 void CalculationHistory::loadFromFile(const QString& filename)
 {
+    const TraceSpan span("history", "CalculationHistory::loadFromFile");
+    // Отложенное сохранение в тот же файл должно быть прочитано
+    if (m_persistence) {
+        m_persistence->flush();
+    }
+    if (HistoryJournal::isJournal(filename)) {
+        flushJournal();
+        const bool current = loadJournal(filename);
+        if (m_journal && (!current || m_journal->fileName() != filename)) {
+            compactJournal();
+        }
+        qCDebug(lcHistory) << "История восстановлена из журнала:" << filename << "(" << count() << "записей)";
+        notifyReset();
+        return;
+    }
+
+    if (HistoryArchive::isArchive(filename)) {
+        loadArchive(filename);
+        return;
+    }
+
     QFile file(filename);
     if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) {
-        qDebug() << "Не удалось открыть файл для чтения:" << filename;
+        qCWarning(lcHistory) << "Не удалось открыть файл для чтения:" << filename;
         emit historyChanged();
         return;
     }
     
-    m_history.clear();
-    
-    QStringList lines;
+    m_entries.clear();
+    m_expressions.clear();
+    resetArchive();
+
+    // Строки читаются в порядке файла, последняя становится самой новой записью
     QTextStream in(&file);
     while (!in.atEnd()) {
-        QString line = in.readLine().trimmed();
+        const QString line = in.readLine().trimmed();
         if (!line.isEmpty()) {
-            lines.append(line);
+            HistoryEntry entry = entryFromText(line);
+            entry.expression = intern(line);
+            m_entries.append(entry);
         }
     }
     
-    // Добавляем в обратном порядке, чтобы сохранить исходный порядок
-    // (т.к. в памяти новые записи в начале через prepend)
-    for (int i = lines.size() - 1; i >= 0; --i) {
-        m_history.append(lines.at(i));
-    }
-    
     file.close();
-    qDebug() << "История загружена из файла:" << filename << "(" << m_history.size() << "записей)";
-    emit historyChanged();
+    if (m_journal) {
+        compactJournal();
+    }
+    qCDebug(lcHistory) << "История загружена из файла:" << filename << "(" << m_entries.size() << "записей)";
+    notifyReset();
 }
 
 void CalculationHistory::setMaxSize(int maxSize)
 {
-    m_maxSize = maxSize;
-    
-    while (m_history.size() > m_maxSize) {
-        m_history.removeLast();
+    const int oldCount = count();
+    m_entries.setCapacity(maxSize);
+    const int archiveKept = qMin(archiveSize(), m_entries.capacity() - m_entries.size());
+    m_archiveBegin = m_archiveEnd - archiveKept;
+
+    // Все вытесненные записи - одним уведомлением
+    const int evicted = oldCount - count();
+    if (evicted > 0) {
+        emit entriesEvicted(evicted);
+        emit historyChanged();
     }
 }
 
 int CalculationHistory::maxSize() const
 {
-    return m_maxSize;
+    return m_entries.capacity();
+}
+
+bool CalculationHistory::openJournal(const QString& filename,
+                                     const HistoryJournal::Options& options)
+{
+    const TraceSpan span("history", "CalculationHistory::openJournal");
+    closeJournal();
+    // Прежний журнал может еще закрываться в фоне, а файл тот же
+    if (m_persistence) {
+        m_persistence->flush();
+    }
+
+    const bool exists = QFile::exists(filename);
+    if (exists && !HistoryJournal::isJournal(filename)) {
+        qCWarning(lcHistory) << "Файл не является журналом истории:" << filename;
+        return false;
+    }
+
+    // Снимок без журнала - сбой сразу после сжатия или удаленный журнал
+    const bool stored = exists || QFile::exists(HistoryJournal::snapshotFileName(filename));
+    const bool current = stored ? loadJournal(filename) : true;
+    if (stored) {
+        notifyReset();
+    }
+
+    QScopedPointer<HistoryJournal> journal(new HistoryJournal());
+    if (!journal->open(filename, options)) {
+        return false;
+    }
+    m_journal.reset(journal.take());
+
+    if (stored ? !current : count() > 0) {
+        compactJournal();
+    } else if (!stored) {
+        m_journalRecords = 0;
+    }
+    return true;
+}
+
+void CalculationHistory::closeJournal()
+{
+    if (m_journal && m_persistence) {
+        QSharedPointer<HistoryJournal> journal(m_journal.take());
+        m_persistence->post([journal]() {
+            journal->close();
+        });
+    }
+    m_journal.reset();
+    m_journalRecords = 0;
+}
+
+void CalculationHistory::flushJournal()
+{
+    if (m_journal) {
+        m_journal->flush();
+    }
+}
+
+bool CalculationHistory::hasJournal() const
+{
+    return !m_journal.isNull();
+}
+
+void CalculationHistory::setPersistenceWorker(PersistenceWorker* worker)
+{
+    m_persistence = worker;
+}
+
+bool CalculationHistory::loadJournal(const QString& filename)
+{
+    const TraceSpan span("history", "CalculationHistory::loadJournal");
+    m_entries.clear();
+    m_expressions.clear();
+    resetArchive();
+
+    Entries journaled(m_entries.capacity());
+    int records = 0;
+    quint16 generation = 0;
+    const bool hasJournal = HistoryJournal::replay(filename, journaled, &records, &generation);
+    const QString snapshotName = HistoryJournal::snapshotFileName(filename);
+    const bool hasSnapshot = QFile::exists(snapshotName) && m_archive.open(snapshotName);
+
+    // Журнал другого поколения остался от прерванного сжатия: его записи уже в снимке
+    const bool current = hasJournal && (!hasSnapshot || m_archive.generation() == generation);
+    if (!current) {
+        journaled.clear();
+        records = 0;
+    }
+
+    // Снимок не разбирается: в память попадают только последние записи, сколько
+    // видно сразу после запуска, остальные читаются из снимка по запросу
+    const int snapshotCount = m_archive.count();
+    const int archiveKept = qMin(snapshotCount, m_entries.capacity() - journaled.size());
+    const int materialized = qMin(archiveKept,
+        qMax(0, CalculatorConfig::HISTORY_VISIBLE_ENTRIES - journaled.size()));
+    m_archiveBegin = snapshotCount - archiveKept;
+    m_archiveEnd = snapshotCount - materialized;
+
+    for (int i = m_archiveEnd; i < snapshotCount; ++i) {
+        HistoryEntry entry;
+        if (m_archive.entryAt(i, entry)) {
+            entry.expression = intern(entry.expression);
+            m_entries.append(entry);
+        }
+    }
+    for (const HistoryEntry& loaded : journaled) {
+        HistoryEntry entry = loaded;
+        entry.expression = intern(entry.expression);
+        m_entries.append(entry);
+    }
+
+    m_journalRecords = records;
+    return current;
+}
+
+void CalculationHistory::loadArchive(const QString& filename)
+{
+    const TraceSpan span("history", "CalculationHistory::loadArchive");
+    HistoryArchive archive;
+    if (!archive.open(filename)) {
+        emit historyChanged();
+        return;
+    }
+
+    m_entries.clear();
+    m_expressions.clear();
+    resetArchive();
+
+    // В кольцо попадут только последние записи, более ранние блоки не разбираются
+    archive.seek(qMax<qint64>(0, archive.count() - m_entries.capacity()));
+    HistoryEntry entry;
+    while (archive.next(entry)) {
+        entry.expression = intern(entry.expression);
+        m_entries.append(entry);
+    }
+
+    if (m_journal) {
+        compactJournal();
+    }
+    qCDebug(lcHistory) << "История загружена из архива:" << filename << "(" << m_entries.size() << "записей)";
+    notifyReset();
+}
+
+void CalculationHistory::resetArchive()
+{
+    m_archive.close();
+    m_archiveBegin = 0;
+    m_archiveEnd = 0;
+}
+
+int CalculationHistory::archiveSize() const
+{
+    return m_archiveEnd - m_archiveBegin;
+}
+
+void CalculationHistory::notifyReset()
+{
+    emit historyReset();
+    emit historyChanged();
+}
+
+void CalculationHistory::compactJournal()
+{
+    const TraceSpan span("history", "CalculationHistory::compactJournal");
+    // Кадры из снимка переносятся как есть, без декодирования
+    QByteArray frames = m_archive.frames(m_archiveBegin, m_archiveEnd);
+    if (frames.isEmpty() && archiveSize() > 0) {
+        qCWarning(lcHistory) << "Снимок истории поврежден, старые записи отброшены";
+        resetArchive();
+    }
+    for (const HistoryEntry& entry : m_entries) {
+        HistoryJournal::appendFrame(entry, frames);
+    }
+    const int total = count();
+    const QByteArray snapshot = HistorySnapshot::serialize(m_journal->generation() + 1,
+                                                           frames, total);
+
+    // Снимок в памяти становится архивом, в кольце остаются только последние записи.
+    // Заодно освобождается отображенный файл - на Windows иначе его не заменить
+    const int materialized = qMin(m_entries.size(), CalculatorConfig::HISTORY_VISIBLE_ENTRIES);
+    m_archive.open(snapshot);
+    m_archiveBegin = 0;
+    m_archiveEnd = total - materialized;
+    const int capacity = m_entries.capacity();
+    m_entries.setCapacity(materialized);
+    m_entries.setCapacity(capacity);
+
+    m_journal->compact(snapshot);
+    m_journalRecords = 0;
+}
+
+QString CalculationHistory::intern(const QString& expression)
+{
+    QSet<QString>::const_iterator it = m_expressions.constFind(expression);
+    if (it != m_expressions.constEnd()) {
+        return *it;
+    }
+
+    // Вытесненные записи оставляют тексты в пуле; пересборка по живым записям
+    // амортизируется числом вставок с прошлой пересборки
+    if (m_expressions.size() >= 2 * qMax(m_entries.size(), MIN_POOL_SIZE)) {
+        m_expressions.clear();
+        for (const HistoryEntry& entry : m_entries) {
+            m_expressions.insert(entry.expression);
+        }
+    }
+    m_expressions.insert(expression);
+    return expression;
 }
@@ -2,40 +2,127 @@
 #define CALCULATIONHISTORY_H
 
 #include <QObject>
+#include <QScopedPointer>
+#include <QSet>
 #include <QStringList>
 #include <QString>
+#include <limits>
+#include "calcengine.h"
+#include "historyjournal.h"
+#include "historysnapshot.h"
+#include "ringbuffer.h"
 
-// Класс для управления историей вычислений
+class PersistenceWorker;
+
+// Запись истории: операнды, операция и результат хранятся как числа,
+// текст для показа собирается по запросу
+struct HistoryEntry {
+    // Левая часть ("5 + 3", "sqrt(9)"); строки с одинаковым текстом разделяют данные.
+    // Если resultPrecision == 0 - вся строка истории целиком
+    QString expression;
+    double lhs = std::numeric_limits<double>::quiet_NaN();
+    double rhs = std::numeric_limits<double>::quiet_NaN();
+    double result = std::numeric_limits<double>::quiet_NaN();
+    // Миллисекунды с начала эпохи UTC; 0 - время неизвестно
+    qint64 timestamp = 0;
+    CalcOperation operation = CalcOperation::None;
+    // Значащие цифры результата в тексте записи
+    quint8 resultPrecision = 0;
+
+    // "5 + 3 = 8"
+    QString text() const;
+};
+
+// Класс для управления историей вычислений.
+// Новые записи лежат в памяти (entries()), более старые после загрузки журнала
+// остаются в отображенном снимке и читаются по одной при обращении
 class CalculationHistory : public QObject
 {
     Q_OBJECT
 
+public:
+    typedef RingBuffer<HistoryEntry> Entries;
+
 public:
     explicit CalculationHistory(QObject *parent = nullptr);
-    ~CalculationHistory() override = default;
+    ~CalculationHistory() override;
 
 public:
+    // Время не задано - ставится текущее
+    void addEntry(const HistoryEntry& entry);
     void addEntry(const QString& expression, double result);
     void addEntry(const QString& fullExpression);
+    // Копия всех строк, новые первыми. Для обхода без копирования - count() и entryAt()
     QStringList getAll() const;
     QString getLast() const;
     int count() const;
     void clear();
-    
+
 public:
+    // Записи в памяти, от самой старой к самой новой. Записи старше них
+    // остаются в снимке и доступны только через entryAt()
+    const Entries& entries() const;
+    // 0 - самая новая запись; запись из снимка декодируется при каждом вызове
+    HistoryEntry entryAt(int index) const;
+
+public:
+    // С PersistenceWorker строки копируются, а файл пишется в его потоке
     void saveToFile(const QString& filename);
+    // Текстовый файл, журнал или архив (определяется по заголовку)
     void loadFromFile(const QString& filename);
-    
+
+public:
+    // Восстанавливает историю из журнала (если файл есть) и дальше дописывает в него
+    // каждую запись. Текущие записи, если журнала еще нет, становятся его содержимым
+    bool openJournal(const QString& filename,
+                     const HistoryJournal::Options& options = HistoryJournal::Options());
+    // Дописывает буфер журнала, синхронизирует файл и отключает журнал.
+    // С PersistenceWorker дописывание и fsync идут в его потоке
+    void closeJournal();
+    // Синхронно дописывает буфер журнала
+    void flushJournal();
+    bool hasJournal() const;
+    // Поток для записи на диск; должен жить дольше истории или быть сброшен в nullptr
+    void setPersistenceWorker(PersistenceWorker* worker);
+
 public:
     void setMaxSize(int maxSize);
     int maxSize() const;
 
 signals:
+    // Любое изменение содержимого; подробности - в сигналах ниже, они приходят раньше
     void historyChanged();
+    // count новых записей в начале: индексы 0..count-1 в порядке entryAt()
+    void entriesAdded(int count);
+    // count самых старых записей вытеснены с конца. Если запись добавлена
+    // в полную историю, этот сигнал приходит перед entriesAdded
+    void entriesEvicted(int count);
+    // Содержимое заменено целиком (очистка, загрузка): один сигнал на операцию
+    void historyReset();
+
+private:
+    QString intern(const QString& expression);
+    // Снимок и журнал рядом с filename; false - журнал устарел и нужно сжатие
+    bool loadJournal(const QString& filename);
+    void loadArchive(const QString& filename);
+    void resetArchive();
+    int archiveSize() const;
+    void notifyReset();
+    void compactJournal();
 
 private:
-    QStringList m_history;
-    int m_maxSize;
+    Entries m_entries;
+    // Записи старше m_entries: [m_archiveBegin, m_archiveEnd) в m_archive.
+    // Лишние при ограничении размера отбрасываются с начала
+    HistorySnapshot m_archive;
+    int m_archiveBegin;
+    int m_archiveEnd;
+    // Пул текстов выражений; чистится, когда переживает записи вдвое
+    QSet<QString> m_expressions;
+    QScopedPointer<HistoryJournal> m_journal;
+    // Кадров в файле журнала: при заметном превышении числа записей журнал сжимается
+    int m_journalRecords;
+    PersistenceWorker* m_persistence;
 };
 
 #endif // CALCULATIONHISTORY_H
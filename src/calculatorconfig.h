@@ -9,11 +9,33 @@ namespace CalculatorConfig {
     constexpr int MAX_DECIMAL_PLACES = 10;
     constexpr char NUMBER_FORMAT = 'g';
     constexpr int PRECISION = 10;
+    // Точность результата в CalculationHistory::addEntry(expression, result),
+    // как у прежнего QString::arg(double)
+    constexpr int HISTORY_RESULT_PRECISION = 6;
+    // Сколько последних записей истории разбирается при запуске; остальные
+    // остаются в снимке журнала до первого обращения
+    constexpr int HISTORY_VISIBLE_ENTRIES = 64;
+    // Сколько самых новых совпадений показывает поиск в панели истории
+    constexpr int HISTORY_SEARCH_LIMIT = 1000;
+    
+    // Журнал истории и прежний текстовый формат, из которого история переносится один раз
+    const QString HISTORY_JOURNAL_FILE = "calculator_history.journal";
+    const QString HISTORY_TEXT_FILE = "calculator_history.txt";
+    // Переменная окружения с путем журнала нажатий (KeystrokeLog); без нее запись выключена
+    constexpr char KEYSTROKE_LOG_VARIABLE[] = "CALC_KEYSTROKE_LOG";
+    // Непустая переменная (кроме "0") включает LatencyMonitor; отчет пишется в файл
+    constexpr char LATENCY_VARIABLE[] = "CALC_LATENCY";
+    const QString LATENCY_REPORT_FILE = "calculator_latency.json";
+    // Непустая переменная (кроме "0") включает Tracer с начала main(); трасса Chrome
+    constexpr char TRACE_VARIABLE[] = "CALC_TRACE";
+    const QString TRACE_FILE = "calculator_trace.json";
     
     const QString ERROR_DIVISION_BY_ZERO = "Ошибка: деление на 0";
     const QString ERROR_INVALID_INPUT = "Ошибка: неверный ввод";
     const QString ERROR_OVERFLOW = "Ошибка: переполнение";
     const QString ERROR_SQRT_NEGATIVE = "Ошибка: корень из отрицательного числа";
+    const QString ERROR_UNKNOWN_OPERATION = "Неизвестная операция";
+    const QString ERROR_INSUFFICIENT_DATA = "Недостаточно данных для вычисления";
     
     const QString DECIMAL_SEPARATOR = ".";
     const QString ZERO_WITH_DECIMAL = "0.";
@@ -0,0 +1,441 @@
+#include "calculatorsession.h"
+#include "calculationhistory.h"
+#include "calculatorconfig.h"
+#include "displayformatter.h"
+#include "errormessages.h"
+#include "inputvalidator.h"
+#include "memorymanager.h"
+
+CalculatorSession::CalculatorSession(CalculationHistory* history, MemoryManager* memory,
+                                     QObject* parent)
+    : QObject(parent)
+    , m_history(history)
+    , m_memory(memory)
+    , m_operatorClicked(false)
+    , m_resultDisplayed(false)
+    , m_entryCount(0)
+{
+}
+
+bool CalculatorSession::press(Key key)
+{
+    switch (key) {
+        case Key::Digit0:
+        case Key::Digit1:
+        case Key::Digit2:
+        case Key::Digit3:
+        case Key::Digit4:
+        case Key::Digit5:
+        case Key::Digit6:
+        case Key::Digit7:
+        case Key::Digit8:
+        case Key::Digit9:
+            return inputDigit(QChar('0' + (static_cast<int>(key) - static_cast<int>(Key::Digit0))));
+
+        case Key::DecimalPoint:
+            return inputDecimalPoint();
+
+        case Key::Add:
+            return inputOperator(CalcHandler::Operation::Add);
+        case Key::Subtract:
+            return inputOperator(CalcHandler::Operation::Subtract);
+        case Key::Multiply:
+            return inputOperator(CalcHandler::Operation::Multiply);
+        case Key::Divide:
+            return inputOperator(CalcHandler::Operation::Divide);
+
+        case Key::Equals:
+            return equals();
+
+        case Key::Percent:
+            return applyUnaryOperation(CalcHandler::Operation::Percent);
+        case Key::Negate:
+            return applyUnaryOperation(CalcHandler::Operation::Negate);
+        case Key::Square:
+            return applyUnaryOperation(CalcHandler::Operation::Square);
+        case Key::SquareRoot:
+            return applyUnaryOperation(CalcHandler::Operation::SquareRoot);
+        case Key::Reciprocal:
+            return applyUnaryOperation(CalcHandler::Operation::Reciprocal);
+
+        case Key::Backspace:
+            return backspace();
+
+        case Key::Clear:
+            reset();
+            return true;
+
+        case Key::ClearEntry:
+            setDisplayText(QString());
+            m_resultDisplayed = false;
+            return true;
+
+        case Key::MemoryAdd:
+        case Key::MemorySubtract:
+        case Key::MemoryRecall:
+        case Key::MemoryClear:
+        case Key::MemoryStore:
+            return applyToMemory(key);
+    }
+    return false;
+}
+
+void CalculatorSession::showValue(double value)
+{
+    setDisplayText(DisplayFormatter::formatNumber(value, CalculatorConfig::MAX_DIGIT_LENGTH));
+    m_resultDisplayed = true;
+}
+
+void CalculatorSession::reset()
+{
+    setDisplayText(QString());
+    m_calcHandler.clear();
+    m_lastExpression.clear();
+    m_operatorClicked = false;
+    m_resultDisplayed = false;
+}
+
+const QString& CalculatorSession::displayText() const
+{
+    return m_display;
+}
+
+bool CalculatorSession::isResultDisplayed() const
+{
+    return m_resultDisplayed;
+}
+
+bool CalculatorSession::isOperatorPending() const
+{
+    return m_operatorClicked;
+}
+
+quint64 CalculatorSession::entryCount() const
+{
+    return m_entryCount;
+}
+
+CalculationHistory* CalculatorSession::history() const
+{
+    return m_history;
+}
+
+MemoryManager* CalculatorSession::memory() const
+{
+    return m_memory;
+}
+
+void CalculatorSession::setHistory(CalculationHistory* history)
+{
+    m_history = history;
+}
+
+void CalculatorSession::setMemory(MemoryManager* memory)
+{
+    m_memory = memory;
+}
+
+CalculatorSession::Key CalculatorSession::digitKey(int digit)
+{
+    Q_ASSERT(digit >= 0 && digit <= 9);
+    return static_cast<Key>(static_cast<int>(Key::Digit0) + digit);
+}
+
+bool CalculatorSession::keyFromChar(QChar c, Key& key)
+{
+    if (c >= QChar('0') && c <= QChar('9')) {
+        key = digitKey(c.unicode() - '0');
+        return true;
+    }
+    if (c == '.' || c == ',') {
+        key = Key::DecimalPoint;
+        return true;
+    }
+    if (c == '=') {
+        key = Key::Equals;
+        return true;
+    }
+
+    switch (CalcHandler::operationFromChar(c)) {
+        case CalcHandler::Operation::Add:
+            key = Key::Add;
+            return true;
+        case CalcHandler::Operation::Subtract:
+            key = Key::Subtract;
+            return true;
+        case CalcHandler::Operation::Multiply:
+            key = Key::Multiply;
+            return true;
+        case CalcHandler::Operation::Divide:
+            key = Key::Divide;
+            return true;
+        case CalcHandler::Operation::Percent:
+            key = Key::Percent;
+            return true;
+        default:
+            return false;
+    }
+}
+
+bool CalculatorSession::inputDigit(QChar digit)
+{
+    startNewEntry();
+    if (!InputValidator::canAddDigit(m_display, CalculatorConfig::MAX_DIGIT_LENGTH)) {
+        return false;
+    }
+
+    QString displayText = m_display;
+    displayText.append(digit);
+    setDisplayText(displayText);
+    return true;
+}
+
+bool CalculatorSession::inputDecimalPoint()
+{
+    startNewEntry();
+    if (!InputValidator::canAddDecimalPoint(m_display, CalculatorConfig::MAX_DIGIT_LENGTH)) {
+        return false;
+    }
+
+    if (m_display.isEmpty()) {
+        setDisplayText(CalculatorConfig::ZERO_WITH_DECIMAL);
+    } else {
+        setDisplayText(m_display + CalculatorConfig::DECIMAL_SEPARATOR);
+    }
+    return true;
+}
+
+bool CalculatorSession::inputOperator(CalcHandler::Operation op)
+{
+    const bool wasOperatorClicked = m_operatorClicked;
+    QString displayText = m_display;
+    // Текст разбирается один раз; повторно - только если вычисление сменило дисплей
+    bool ok = false;
+    double value = 0.0;
+    if (InputValidator::isNotEmpty(displayText)) {
+        value = DisplayFormatter::toDouble(displayText, &ok);
+        if (!ok) {
+            showError(CalculatorConfig::ERROR_INVALID_INPUT);
+            return false;
+        }
+    }
+
+    // Цепочка "5 + 3 +": сначала вычисляется отложенная операция
+    if (m_calcHandler.hasStoredValue()
+        && !m_operatorClicked
+        && !m_resultDisplayed
+        && m_calcHandler.currentOperation() != CalcHandler::Operation::None) {
+        if (InputValidator::isNotEmpty(displayText)) {
+            performCalculation();
+            if (m_display != displayText) {
+                displayText = m_display;
+                value = DisplayFormatter::toDouble(displayText, &ok);
+            }
+        }
+    }
+
+    if (!wasOperatorClicked && InputValidator::isNotEmpty(displayText)) {
+        if (!ok) {
+            showError(CalculatorConfig::ERROR_INVALID_INPUT);
+            return false;
+        }
+        m_calcHandler.setOperand(value);
+        m_lastExpression = displayText;
+    }
+
+    m_calcHandler.setOperation(op);
+
+    if (!m_lastExpression.isEmpty()) {
+        // Повторный оператор заменяет предыдущий: " + " -> " × "
+        if (wasOperatorClicked && m_lastExpression.size() >= 3) {
+            m_lastExpression.chop(3);
+        }
+        m_lastExpression += QChar(' ');
+        m_lastExpression += CalcHandler::operationToString(op);
+        m_lastExpression += QChar(' ');
+    }
+
+    m_operatorClicked = true;
+    m_resultDisplayed = false;
+    return true;
+}
+
+bool CalculatorSession::equals()
+{
+    if (!m_calcHandler.hasStoredValue()
+        || m_calcHandler.currentOperation() == CalcHandler::Operation::None
+        || m_display.isEmpty()) {
+        return false;
+    }
+
+    performCalculation();
+    return true;
+}
+
+void CalculatorSession::performCalculation()
+{
+    if (m_display.isEmpty()) {
+        return;
+    }
+
+    const QString displayText = DisplayFormatter::removeTrailingDecimal(m_display);
+
+    bool ok = false;
+    const double operand = DisplayFormatter::toDouble(displayText, &ok);
+    if (!ok) {
+        showError(CalculatorConfig::ERROR_INVALID_INPUT);
+        return;
+    }
+    const double storedValue = m_calcHandler.storedValue();
+    const CalcHandler::Operation op = m_calcHandler.currentOperation();
+
+    const CalcHandler::CalculationResult result =
+        m_calcHandler.performBinaryOperation(storedValue, operand, op);
+
+    if (result.success()) {
+        setDisplayText(DisplayFormatter::formatNumber(
+            result.value, CalculatorConfig::MAX_DIGIT_LENGTH));
+
+        if (m_history) {
+            HistoryEntry entry;
+            entry.expression = m_lastExpression + displayText;
+            entry.lhs = storedValue;
+            entry.operation = op;
+            entry.rhs = operand;
+            entry.result = result.value;
+            entry.resultPrecision = CalculatorConfig::MAX_DIGIT_LENGTH;
+            m_history->addEntry(entry);
+            ++m_entryCount;
+        }
+        m_lastExpression.clear();
+
+        m_resultDisplayed = true;
+    } else {
+        showError(ErrorMessages::text(result.error));
+    }
+
+    m_operatorClicked = false;
+}
+
+bool CalculatorSession::applyUnaryOperation(CalcHandler::Operation op)
+{
+    if (m_display.isEmpty()) {
+        return false;
+    }
+
+    double value = 0.0;
+    if (!displayValue(value)) {
+        return false;
+    }
+    const CalcHandler::CalculationResult result =
+        m_calcHandler.applyUnaryOperation(op, value);
+
+    m_operatorClicked = false;
+    if (!result.success()) {
+        showError(ErrorMessages::text(result.error));
+        return false;
+    }
+
+    const QString operandText = m_display;
+    setDisplayText(DisplayFormatter::formatNumber(
+        result.value, CalculatorConfig::MAX_DIGIT_LENGTH));
+
+    if (m_history) {
+        HistoryEntry entry;
+        entry.expression = QString("%1(%2)")
+            .arg(CalcHandler::operationToString(op))
+            .arg(operandText);
+        entry.lhs = value;
+        entry.operation = op;
+        entry.result = result.value;
+        entry.resultPrecision = CalculatorConfig::MAX_DIGIT_LENGTH;
+        m_history->addEntry(entry);
+        ++m_entryCount;
+    }
+
+    m_resultDisplayed = true;
+    return true;
+}
+
+bool CalculatorSession::backspace()
+{
+    if (m_display.isEmpty()) {
+        return false;
+    }
+    setDisplayText(m_display.left(m_display.size() - 1));
+    return true;
+}
+
+bool CalculatorSession::applyToMemory(Key key)
+{
+    if (!m_memory) {
+        return false;
+    }
+
+    switch (key) {
+        case Key::MemoryRecall:
+            if (!m_memory->hasValue()) {
+                return false;
+            }
+            showValue(m_memory->recall());
+            return true;
+
+        case Key::MemoryClear:
+            m_memory->clear();
+            return true;
+
+        default:
+            break;
+    }
+
+    // M+, M-, MS берут число с дисплея
+    if (m_display.isEmpty()) {
+        return false;
+    }
+    double value = 0.0;
+    if (!displayValue(value)) {
+        return false;
+    }
+
+    if (key == Key::MemoryAdd) {
+        m_memory->add(value);
+    } else if (key == Key::MemorySubtract) {
+        m_memory->subtract(value);
+    } else {
+        m_memory->store(value);
+        m_memory->addToList(value);
+    }
+    return true;
+}
+
+bool CalculatorSession::displayValue(double& value)
+{
+    bool ok = false;
+    value = DisplayFormatter::toDouble(m_display, &ok);
+    if (!ok) {
+        showError(CalculatorConfig::ERROR_INVALID_INPUT);
+    }
+    return ok;
+}
+
+void CalculatorSession::startNewEntry()
+{
+    if (m_operatorClicked || m_resultDisplayed) {
+        m_display.clear();
+        m_operatorClicked = false;
+        m_resultDisplayed = false;
+    }
+}
+
+void CalculatorSession::setDisplayText(const QString& text)
+{
+    m_display = text;
+    emit displayChanged(m_display);
+}
+
+void CalculatorSession::showError(const QString& errorMessage)
+{
+    setDisplayText(errorMessage);
+    m_resultDisplayed = true;
+    emit errorOccurred(errorMessage);
+}
@@ -0,0 +1,123 @@
+#ifndef CALCULATORSESSION_H
+#define CALCULATORSESSION_H
+
+#include <QChar>
+#include <QObject>
+#include <QString>
+#include "calchandler.h"
+
+class CalculationHistory;
+class MemoryManager;
+
+// Логика клавиатуры калькулятора без виджетов: нажатия клавиш меняют текст
+// дисплея, завершенные вычисления уходят в историю. Текст дисплея хранится здесь,
+// окно только показывает его (displayChanged) и анимирует ошибки (errorOccurred).
+// Поэтому ввод можно прогонять, проверять и воспроизводить без QApplication.
+//
+// Сеанс легкий: CalcHandler хранится по значению, а для новых прогонов сеанс
+// переиспользуется через reset(). История и память необязательны
+class CalculatorSession : public QObject
+{
+    Q_OBJECT
+
+public:
+    enum class Key {
+        Digit0,
+        Digit1,
+        Digit2,
+        Digit3,
+        Digit4,
+        Digit5,
+        Digit6,
+        Digit7,
+        Digit8,
+        Digit9,
+        DecimalPoint,
+        Add,
+        Subtract,
+        Multiply,
+        Divide,
+        Equals,
+        Percent,
+        Negate,
+        Square,
+        SquareRoot,
+        Reciprocal,
+        Backspace,
+        Clear,
+        ClearEntry,
+        MemoryAdd,
+        MemorySubtract,
+        MemoryRecall,
+        MemoryClear,
+        MemoryStore
+    };
+
+public:
+    explicit CalculatorSession(CalculationHistory* history = nullptr,
+                               MemoryManager* memory = nullptr,
+                               QObject* parent = nullptr);
+    ~CalculatorSession() override = default;
+
+public:
+    // false - нажатие ничего не сделало: лимит цифр, пустой дисплей,
+    // нет операции для "=", пустая или отсутствующая память
+    bool press(Key key);
+    // Значение как готовый результат (например, выбранное из списка памяти)
+    void showValue(double value);
+    // Начальное состояние: пустой дисплей, нет операнда и операции
+    void reset();
+
+public:
+    const QString& displayText() const;
+    bool isResultDisplayed() const;
+    bool isOperatorPending() const;
+    // Сколько записей сеанс добавил в историю за все время; reset() не обнуляет
+    quint64 entryCount() const;
+    CalculationHistory* history() const;
+    MemoryManager* memory() const;
+    void setHistory(CalculationHistory* history);
+    void setMemory(MemoryManager* memory);
+
+public:
+    static Key digitKey(int digit);
+    // Клавиатурный символ: цифры, '.', ',', + - * / x × ÷, '=', '%'.
+    // false - символ не соответствует клавише
+    static bool keyFromChar(QChar c, Key& key);
+
+signals:
+    // Новый текст дисплея
+    void displayChanged(const QString& text);
+    // Вычисление или разбор не удались; текст ошибки уже на дисплее
+    void errorOccurred(const QString& message);
+
+private:
+    bool inputDigit(QChar digit);
+    bool inputDecimalPoint();
+    bool inputOperator(CalcHandler::Operation op);
+    bool equals();
+    void performCalculation();
+    bool applyUnaryOperation(CalcHandler::Operation op);
+    bool backspace();
+    bool applyToMemory(Key key);
+    // Число на дисплее; при ошибке разбора показывает ее и возвращает false
+    bool displayValue(double& value);
+    // Начинает новое число, если на дисплее оператор или результат
+    void startNewEntry();
+
+    void setDisplayText(const QString& text);
+    void showError(const QString& errorMessage);
+
+private:
+    CalcHandler m_calcHandler;
+    CalculationHistory* m_history;
+    MemoryManager* m_memory;
+
+    QString m_display;
+    bool m_operatorClicked;  // Был ли нажат оператор
+    bool m_resultDisplayed;  // Отображен ли результат
+    QString m_lastExpression; // Последнее выражение для истории
+    quint64 m_entryCount;
+};
+
+#endif // CALCULATORSESSION_H
@@ -0,0 +1,919 @@
+#include "decimal.h"
+#include "numberformatter.h"
+#include "numberparser.h"
+#include <algorithm>
+#include <climits>
+#include <cmath>
+
+namespace {
+
+typedef Decimal::Limbs Limbs;
+
+const quint64 BASE = Decimal::LIMB_BASE;
+const int LIMB_DIGITS = Decimal::LIMB_DIGITS;
+
+// Граница показателя, после которой разбор строки считается ошибкой
+const int MAX_EXPONENT = INT_MAX / 4;
+
+// Порог порядка, с которого toString переходит к экспоненциальной записи
+const int MAX_PLAIN_EXPONENT = 21;
+const int MIN_PLAIN_EXPONENT = -7;
+
+const quint32 POW10[10] = {
+    1u, 10u, 100u, 1000u, 10000u, 100000u, 1000000u, 10000000u, 100000000u, 1000000000u
+};
+
+// Рабочий буфер для промежуточных результатов умножения
+typedef QVarLengthArray<quint32, 64> Scratch;
+
+int limbDigits(quint32 limb)
+{
+    int digits = 1;
+    while (digits < LIMB_DIGITS && limb >= POW10[digits]) {
+        ++digits;
+    }
+    return digits;
+}
+
+void trim(Limbs& limbs)
+{
+    while (!limbs.isEmpty() && limbs[limbs.size() - 1] == 0) {
+        limbs.removeLast();
+    }
+}
+
+int digitCount(const Limbs& limbs)
+{
+    if (limbs.isEmpty()) {
+        return 0;
+    }
+    return (limbs.size() - 1) * LIMB_DIGITS + limbDigits(limbs[limbs.size() - 1]);
+}
+
+int compareMagnitudes(const Limbs& lhs, const Limbs& rhs)
+{
+    if (lhs.size() != rhs.size()) {
+        return lhs.size() < rhs.size() ? -1 : 1;
+    }
+    for (int i = lhs.size() - 1; i >= 0; --i) {
+        if (lhs[i] != rhs[i]) {
+            return lhs[i] < rhs[i] ? -1 : 1;
+        }
+    }
+    return 0;
+}
+
+// dst += src; dst должен вмещать результат, перенос за пределы dstSize недопустим
+void addRaw(quint32* dst, int dstSize, const quint32* src, int srcSize)
+{
+    quint64 carry = 0;
+    int i = 0;
+    for (; i < srcSize; ++i) {
+        const quint64 sum = quint64(dst[i]) + src[i] + carry;
+        dst[i] = quint32(sum % BASE);
+        carry = sum / BASE;
+    }
+    for (; carry && i < dstSize; ++i) {
+        const quint64 sum = quint64(dst[i]) + carry;
+        dst[i] = quint32(sum % BASE);
+        carry = sum / BASE;
+    }
+    Q_ASSERT(carry == 0);
+}
+
+// dst -= src при dst >= src
+void subtractRaw(quint32* dst, int dstSize, const quint32* src, int srcSize)
+{
+    qint64 borrow = 0;
+    int i = 0;
+    for (; i < srcSize; ++i) {
+        qint64 difference = qint64(dst[i]) - src[i] - borrow;
+        borrow = difference < 0;
+        dst[i] = quint32(borrow ? difference + qint64(BASE) : difference);
+    }
+    for (; borrow && i < dstSize; ++i) {
+        qint64 difference = qint64(dst[i]) - borrow;
+        borrow = difference < 0;
+        dst[i] = quint32(borrow ? difference + qint64(BASE) : difference);
+    }
+    Q_ASSERT(borrow == 0);
+}
+
+void addInPlace(Limbs& dst, const Limbs& src)
+{
+    if (dst.size() < src.size()) {
+        const int oldSize = dst.size();
+        dst.resize(src.size());
+        for (int i = oldSize; i < dst.size(); ++i) {
+            dst[i] = 0;
+        }
+    }
+    dst.append(0);
+    addRaw(dst.data(), dst.size(), src.constData(), src.size());
+    trim(dst);
+}
+
+void subtractInPlace(Limbs& dst, const Limbs& src)
+{
+    subtractRaw(dst.data(), dst.size(), src.constData(), src.size());
+    trim(dst);
+}
+
+void multiplySmall(Limbs& limbs, quint32 factor, quint32 addend = 0)
+{
+    quint64 carry = addend;
+    for (int i = 0; i < limbs.size(); ++i) {
+        const quint64 product = quint64(limbs[i]) * factor + carry;
+        limbs[i] = quint32(product % BASE);
+        carry = product / BASE;
+    }
+    if (carry) {
+        limbs.append(quint32(carry));
+    }
+    trim(limbs);
+}
+
+quint32 divideSmall(Limbs& limbs, quint32 divisor)
+{
+    quint64 remainder = 0;
+    for (int i = limbs.size() - 1; i >= 0; --i) {
+        const quint64 current = remainder * BASE + limbs[i];
+        limbs[i] = quint32(current / divisor);
+        remainder = current % divisor;
+    }
+    trim(limbs);
+    return quint32(remainder);
+}
+
+void multiplyPow10(Limbs& limbs, int power)
+{
+    if (limbs.isEmpty() || power <= 0) {
+        return;
+    }
+    const int shift = power / LIMB_DIGITS;
+    if (shift > 0) {
+        limbs.insert(0, shift, 0);
+    }
+    if (power % LIMB_DIGITS) {
+        multiplySmall(limbs, POW10[power % LIMB_DIGITS]);
+    }
+}
+
+// Отбросить count младших цифр; true, если среди них были ненулевые
+bool dropDigits(Limbs& limbs, int count)
+{
+    bool sticky = false;
+    const int whole = qMin(count / LIMB_DIGITS, limbs.size());
+    for (int i = 0; i < whole; ++i) {
+        sticky = sticky || limbs[i] != 0;
+    }
+    if (whole > 0) {
+        limbs.remove(0, whole);
+    }
+    if (count % LIMB_DIGITS && !limbs.isEmpty()) {
+        sticky = divideSmall(limbs, POW10[count % LIMB_DIGITS]) != 0 || sticky;
+    }
+    return sticky;
+}
+
+void multiplySchoolbook(const quint32* lhs, int lhsSize, const quint32* rhs, int rhsSize,
+                        quint32* out)
+{
+    for (int i = 0; i < lhsSize; ++i) {
+        const quint64 factor = lhs[i];
+        if (factor == 0) {
+            continue;
+        }
+        quint64 carry = 0;
+        for (int j = 0; j < rhsSize; ++j) {
+            const quint64 value = out[i + j] + factor * rhs[j] + carry;
+            out[i + j] = quint32(value % BASE);
+            carry = value / BASE;
+        }
+        out[i + rhsSize] = quint32(carry);
+    }
+}
+
+// out размером lhsSize + rhsSize должен быть заполнен нулями
+void multiplyRaw(const quint32* lhs, int lhsSize, const quint32* rhs, int rhsSize, quint32* out)
+{
+    if (lhsSize < rhsSize) {
+        qSwap(lhs, rhs);
+        qSwap(lhsSize, rhsSize);
+    }
+    if (rhsSize < Decimal::KARATSUBA_THRESHOLD) {
+        multiplySchoolbook(lhs, lhsSize, rhs, rhsSize, out);
+        return;
+    }
+
+    // Несбалансированные операнды: длинный режется на куски длины короткого
+    if (lhsSize >= 2 * rhsSize) {
+        Scratch chunk(2 * rhsSize);
+        for (int offset = 0; offset < lhsSize; offset += rhsSize) {
+            const int chunkSize = qMin(rhsSize, lhsSize - offset);
+            std::fill(chunk.data(), chunk.data() + chunkSize + rhsSize, 0u);
+            multiplyRaw(lhs + offset, chunkSize, rhs, rhsSize, chunk.data());
+            addRaw(out + offset, lhsSize + rhsSize - offset, chunk.constData(), chunkSize + rhsSize);
+        }
+        return;
+    }
+
+    // Карацуба: (a1*B^m + a0)(b1*B^m + b0) = z2*B^2m + z1*B^m + z0,
+    // z1 = (a0 + a1)(b0 + b1) - z0 - z2
+    const int half = lhsSize / 2;
+    const quint32* lhsHigh = lhs + half;
+    const quint32* rhsHigh = rhs + half;
+    const int lhsHighSize = lhsSize - half;
+    const int rhsHighSize = rhsSize - half;
+
+    multiplyRaw(lhs, half, rhs, half, out);
+    multiplyRaw(lhsHigh, lhsHighSize, rhsHigh, rhsHighSize, out + 2 * half);
+
+    const int lhsSumSize = lhsHighSize + 1;
+    const int rhsSumSize = qMax(half, rhsHighSize) + 1;
+    Scratch lhsSum(lhsSumSize);
+    Scratch rhsSum(rhsSumSize);
+    std::fill(lhsSum.data(), lhsSum.data() + lhsSumSize, 0u);
+    std::fill(rhsSum.data(), rhsSum.data() + rhsSumSize, 0u);
+    std::copy(lhsHigh, lhsHigh + lhsHighSize, lhsSum.data());
+    addRaw(lhsSum.data(), lhsSumSize, lhs, half);
+    std::copy(rhs, rhs + half, rhsSum.data());
+    addRaw(rhsSum.data(), rhsSumSize, rhsHigh, rhsHighSize);
+
+    Scratch middle(lhsSumSize + rhsSumSize);
+    std::fill(middle.data(), middle.data() + middle.size(), 0u);
+    multiplyRaw(lhsSum.constData(), lhsSumSize, rhsSum.constData(), rhsSumSize, middle.data());
+    subtractRaw(middle.data(), middle.size(), out, 2 * half);
+    subtractRaw(middle.data(), middle.size(), out + 2 * half, lhsHighSize + rhsHighSize);
+
+    // Старшие конечности middle после вычитания равны нулю
+    int middleSize = middle.size();
+    while (middleSize > 0 && middle[middleSize - 1] == 0) {
+        --middleSize;
+    }
+    addRaw(out + half, lhsSize + rhsSize - half, middle.constData(), middleSize);
+}
+
+Limbs multiplyLimbs(const Limbs& lhs, const Limbs& rhs)
+{
+    Limbs product;
+    if (lhs.isEmpty() || rhs.isEmpty()) {
+        return product;
+    }
+    product.resize(lhs.size() + rhs.size());
+    std::fill(product.data(), product.data() + product.size(), 0u);
+    multiplyRaw(lhs.constData(), lhs.size(), rhs.constData(), rhs.size(), product.data());
+    trim(product);
+    return product;
+}
+
+// Деление столбиком (Кнут, алгоритм D) в основании 10^9
+void divideLimbs(const Limbs& dividend, const Limbs& divisor, Limbs& quotient, Limbs& remainder)
+{
+    Q_ASSERT(!divisor.isEmpty());
+
+    if (compareMagnitudes(dividend, divisor) < 0) {
+        quotient.clear();
+        remainder = dividend;
+        return;
+    }
+
+    if (divisor.size() == 1) {
+        quotient = dividend;
+        const quint32 rest = divideSmall(quotient, divisor[0]);
+        remainder.clear();
+        if (rest) {
+            remainder.append(rest);
+        }
+        return;
+    }
+
+    // Нормализация: старшая конечность делителя не меньше BASE / 2
+    const quint32 factor = quint32(BASE / (quint64(divisor[divisor.size() - 1]) + 1));
+    Limbs v = divisor;
+    Limbs u = dividend;
+    if (factor > 1) {
+        multiplySmall(v, factor);
+        multiplySmall(u, factor);
+    }
+    if (u.size() == dividend.size()) {
+        u.append(0);
+    }
+
+    const int n = v.size();
+    const int m = u.size() - n - 1;
+    const quint64 vTop = v[n - 1];
+    const quint64 vNext = v[n - 2];
+
+    quotient.resize(m + 1);
+    for (int j = m; j >= 0; --j) {
+        const quint64 numerator = quint64(u[j + n]) * BASE + u[j + n - 1];
+        quint64 estimate = numerator / vTop;
+        quint64 rest = numerator % vTop;
+        while (estimate >= BASE || estimate * vNext > rest * BASE + u[j + n - 2]) {
+            --estimate;
+            rest += vTop;
+            if (rest >= BASE) {
+                break;
+            }
+        }
+
+        // u[j..j+n] -= estimate * v
+        quint64 carry = 0;
+        qint64 borrow = 0;
+        for (int i = 0; i < n; ++i) {
+            const quint64 product = estimate * v[i] + carry;
+            carry = product / BASE;
+            qint64 difference = qint64(u[i + j]) - qint64(product % BASE) - borrow;
+            borrow = difference < 0;
+            u[i + j] = quint32(borrow ? difference + qint64(BASE) : difference);
+        }
+        qint64 top = qint64(u[j + n]) - qint64(carry) - borrow;
+
+        // Оценка оказалась на единицу больше: вернуть делитель
+        if (top < 0) {
+            --estimate;
+            quint64 addCarry = 0;
+            for (int i = 0; i < n; ++i) {
+                const quint64 sum = quint64(u[i + j]) + v[i] + addCarry;
+                u[i + j] = quint32(sum % BASE);
+                addCarry = sum / BASE;
+            }
+            top += qint64(addCarry);
+        }
+        u[j + n] = quint32(top);
+        quotient[j] = quint32(estimate);
+    }
+    trim(quotient);
+
+    u.resize(n);
+    trim(u);
+    if (factor > 1) {
+        divideSmall(u, factor);
+    }
+    remainder = u;
+}
+
+// Целый квадратный корень методом Ньютона: floor(sqrt(value))
+Limbs integerSquareRoot(const Limbs& value)
+{
+    if (value.isEmpty()) {
+        return value;
+    }
+
+    // Начальное приближение сверху: 10^ceil(digits / 2)
+    Limbs root;
+    root.append(1);
+    multiplyPow10(root, (digitCount(value) + 1) / 2);
+
+    Limbs quotient;
+    Limbs remainder;
+    for (;;) {
+        divideLimbs(value, root, quotient, remainder);
+        addInPlace(quotient, root);
+        divideSmall(quotient, 2);
+        if (compareMagnitudes(quotient, root) >= 0) {
+            return root;
+        }
+        root = quotient;
+    }
+}
+
+// Дописать к коэффициенту ненулевую цифру ниже точности, чтобы округление
+// учитывало отброшенный ненулевой остаток
+void appendSticky(Limbs& limbs, int& exponent)
+{
+    multiplySmall(limbs, 10, 1);
+    --exponent;
+}
+
+} // namespace
+
+Decimal::Decimal()
+    : m_exponent(0)
+    , m_negative(false)
+{
+}
+
+Decimal::Decimal(qint64 value)
+    : m_exponent(0)
+    , m_negative(value < 0)
+{
+    quint64 magnitude = m_negative ? quint64(0) - quint64(value) : quint64(value);
+    while (magnitude) {
+        m_limbs.append(quint32(magnitude % BASE));
+        magnitude /= BASE;
+    }
+    normalize();
+}
+
+Decimal::Decimal(const Limbs& limbs, int exponent, bool negative)
+    : m_limbs(limbs)
+    , m_exponent(exponent)
+    , m_negative(negative)
+{
+    normalize();
+}
+
+Decimal Decimal::fromString(const QString& text, bool* ok)
+{
+    const QByteArray latin = text.trimmed().toLatin1();
+    return fromUtf8(latin.constData(), latin.constData() + latin.size(), ok);
+}
+
+Decimal Decimal::fromUtf8(const char* begin, const char* end, bool* ok)
+{
+    if (ok) {
+        *ok = false;
+    }
+
+    const char* pos = begin;
+    bool negative = false;
+    if (pos < end && (*pos == '+' || *pos == '-')) {
+        negative = *pos == '-';
+        ++pos;
+    }
+
+    // Цифры коэффициента собираются без точки, ведущие нули пропускаются
+    QVarLengthArray<char, 64> digits;
+    int fractionDigits = 0;
+    int totalDigits = 0;
+    bool seenPoint = false;
+    for (; pos < end; ++pos) {
+        const char c = *pos;
+        if (c >= '0' && c <= '9') {
+            ++totalDigits;
+            if (seenPoint) {
+                ++fractionDigits;
+            }
+            if (c != '0' || !digits.isEmpty()) {
+                digits.append(c);
+            }
+        } else if (c == '.' && !seenPoint) {
+            seenPoint = true;
+        } else {
+            break;
+        }
+    }
+    if (totalDigits == 0) {
+        return Decimal();
+    }
+
+    qint64 exponent = 0;
+    if (pos < end && (*pos == 'e' || *pos == 'E')) {
+        ++pos;
+        bool exponentNegative = false;
+        if (pos < end && (*pos == '+' || *pos == '-')) {
+            exponentNegative = *pos == '-';
+            ++pos;
+        }
+        if (pos == end || *pos < '0' || *pos > '9') {
+            return Decimal();
+        }
+        for (; pos < end && *pos >= '0' && *pos <= '9'; ++pos) {
+            exponent = exponent * 10 + (*pos - '0');
+            if (exponent > MAX_EXPONENT) {
+                return Decimal();
+            }
+        }
+        if (exponentNegative) {
+            exponent = -exponent;
+        }
+    }
+    if (pos != end) {
+        return Decimal();
+    }
+
+    Limbs limbs;
+    for (int high = digits.size(); high > 0; high -= LIMB_DIGITS) {
+        const int low = qMax(0, high - LIMB_DIGITS);
+        quint32 limb = 0;
+        for (int i = low; i < high; ++i) {
+            limb = limb * 10 + quint32(digits[i] - '0');
+        }
+        limbs.append(limb);
+    }
+
+    if (ok) {
+        *ok = true;
+    }
+    return Decimal(limbs, int(exponent - fractionDigits), negative);
+}
+
+Decimal Decimal::fromDouble(double value, bool* ok)
+{
+    NumberFormatter::Digits digits;
+    if (!NumberFormatter::shortestDigits(value, digits)) {
+        if (ok) {
+            *ok = false;
+        }
+        return Decimal();
+    }
+    if (ok) {
+        *ok = true;
+    }
+    const Decimal result = scaled(Decimal(static_cast<qint64>(digits.significand)),
+                                  digits.exponent);
+    return digits.negative ? result.negated() : result;
+}
+
+QString Decimal::toString() const
+{
+    if (isZero()) {
+        return QString("0");
+    }
+
+    QByteArray digits;
+    digits.reserve(m_limbs.size() * LIMB_DIGITS);
+    digits.append(QByteArray::number(m_limbs[m_limbs.size() - 1]));
+    for (int i = m_limbs.size() - 2; i >= 0; --i) {
+        const QByteArray limb = QByteArray::number(m_limbs[i]);
+        digits.append(QByteArray(LIMB_DIGITS - limb.size(), '0'));
+        digits.append(limb);
+    }
+
+    const int adjusted = adjustedExponent();
+    QByteArray text;
+    if (m_negative) {
+        text.append('-');
+    }
+
+    if (m_exponent >= 0 && adjusted < MAX_PLAIN_EXPONENT) {
+        text.append(digits);
+        text.append(QByteArray(m_exponent, '0'));
+    } else if (m_exponent < 0 && adjusted >= MIN_PLAIN_EXPONENT) {
+        if (adjusted >= 0) {
+            text.append(digits.left(adjusted + 1));
+            text.append('.');
+            text.append(digits.mid(adjusted + 1));
+        } else {
+            text.append("0.");
+            text.append(QByteArray(-adjusted - 1, '0'));
+            text.append(digits);
+        }
+    } else {
+        // Экспоненциальная запись в стиле формата 'g': 1.5e+25
+        text.append(digits.left(1));
+        if (digits.size() > 1) {
+            text.append('.');
+            text.append(digits.mid(1));
+        }
+        text.append(adjusted < 0 ? "e-" : "e+");
+        text.append(QByteArray::number(qAbs(adjusted)));
+    }
+    return QString::fromLatin1(text);
+}
+
+double Decimal::toDouble() const
+{
+    if (isZero()) {
+        return 0.0;
+    }
+
+    // Старшие 19 цифр коэффициента; хвост нужен, только если он влияет на округление
+    quint64 significand = 0;
+    int digits = 0;
+    int dropped = 0;
+    bool truncated = false;
+    for (int i = m_limbs.size() - 1; i >= 0; --i) {
+        const quint32 limb = m_limbs[i];
+        const int count = i == m_limbs.size() - 1 ? limbDigits(limb) : LIMB_DIGITS;
+        const int taken = qMin(count, NumberParser::MAX_SIGNIFICANT_DIGITS - digits);
+        const quint32 divisor = POW10[count - taken];
+        significand = significand * POW10[taken] + limb / divisor;
+        truncated = truncated || limb % divisor != 0;
+        digits += taken;
+        dropped += count - taken;
+    }
+
+    double value = 0.0;
+    if (NumberParser::decimalToDouble(significand, m_exponent + dropped, m_negative, truncated, value)) {
+        return value;
+    }
+
+    // Коэффициент и показатель в научной записи; разбор Qt округляет корректно
+    QByteArray text;
+    if (m_negative) {
+        text.append('-');
+    }
+    text.append(QByteArray::number(m_limbs[m_limbs.size() - 1]));
+    for (int i = m_limbs.size() - 2; i >= 0; --i) {
+        const QByteArray limb = QByteArray::number(m_limbs[i]);
+        text.append(QByteArray(LIMB_DIGITS - limb.size(), '0'));
+        text.append(limb);
+    }
+    text.append('e');
+    text.append(QByteArray::number(m_exponent));
+    return text.toDouble();
+}
+
+bool Decimal::isZero() const
+{
+    return m_limbs.isEmpty();
+}
+
+bool Decimal::isNegative() const
+{
+    return m_negative;
+}
+
+int Decimal::exponent() const
+{
+    return m_exponent;
+}
+
+int Decimal::digitCount() const
+{
+    return ::digitCount(m_limbs);
+}
+
+int Decimal::adjustedExponent() const
+{
+    return isZero() ? m_exponent : m_exponent + digitCount() - 1;
+}
+
+const Decimal::Limbs& Decimal::limbs() const
+{
+    return m_limbs;
+}
+
+Decimal Decimal::negated() const
+{
+    Decimal result = *this;
+    result.m_negative = !m_negative && !isZero();
+    return result;
+}
+
+Decimal Decimal::abs() const
+{
+    Decimal result = *this;
+    result.m_negative = false;
+    return result;
+}
+
+Decimal Decimal::rounded(const DecimalContext& context) const
+{
+    Decimal result = *this;
+    result.roundTo(context);
+    return result;
+}
+
+Decimal Decimal::add(const Decimal& lhs, const Decimal& rhs, const DecimalContext& context)
+{
+    return addMagnitudes(lhs, rhs, false, context);
+}
+
+Decimal Decimal::subtract(const Decimal& lhs, const Decimal& rhs, const DecimalContext& context)
+{
+    return addMagnitudes(lhs, rhs, true, context);
+}
+
+Decimal Decimal::addMagnitudes(const Decimal& lhs, const Decimal& rhs, bool subtract,
+                               const DecimalContext& context)
+{
+    const Decimal right = subtract ? rhs.negated() : rhs;
+    if (lhs.isZero()) {
+        return right.rounded(context);
+    }
+    if (right.isZero()) {
+        return lhs.rounded(context);
+    }
+
+    const Decimal* large = &lhs;
+    const Decimal* small = &right;
+    if (small->adjustedExponent() > large->adjustedExponent()) {
+        qSwap(large, small);
+    }
+
+    // Слагаемое целиком ниже точности и младшей цифры большего влияет только
+    // на округление: заменяем его единицей в том же диапазоне, чтобы не
+    // выравнивать коэффициенты на миллионы цифр (1e1000000 + 1)
+    Decimal tiny;
+    const int limit = qMin(large->m_exponent, large->adjustedExponent() - context.digits);
+    if (small->adjustedExponent() < limit - 2) {
+        Limbs one;
+        one.append(1);
+        tiny = Decimal(one, limit - 2, small->m_negative);
+        small = &tiny;
+    }
+
+    const int exponent = qMin(large->m_exponent, small->m_exponent);
+    Limbs largeLimbs = large->m_limbs;
+    Limbs smallLimbs = small->m_limbs;
+    multiplyPow10(largeLimbs, large->m_exponent - exponent);
+    multiplyPow10(smallLimbs, small->m_exponent - exponent);
+
+    Decimal result;
+    if (large->m_negative == small->m_negative) {
+        addInPlace(largeLimbs, smallLimbs);
+        result = Decimal(largeLimbs, exponent, large->m_negative);
+    } else {
+        const int order = compareMagnitudes(largeLimbs, smallLimbs);
+        if (order == 0) {
+            return Decimal();
+        }
+        if (order > 0) {
+            subtractInPlace(largeLimbs, smallLimbs);
+            result = Decimal(largeLimbs, exponent, large->m_negative);
+        } else {
+            subtractInPlace(smallLimbs, largeLimbs);
+            result = Decimal(smallLimbs, exponent, small->m_negative);
+        }
+    }
+    result.roundTo(context);
+    return result;
+}
+
+Decimal Decimal::multiply(const Decimal& lhs, const Decimal& rhs, const DecimalContext& context)
+{
+    if (lhs.isZero() || rhs.isZero()) {
+        return Decimal();
+    }
+    Decimal result(multiplyLimbs(lhs.m_limbs, rhs.m_limbs),
+                   lhs.m_exponent + rhs.m_exponent,
+                   lhs.m_negative != rhs.m_negative);
+    result.roundTo(context);
+    return result;
+}
+
+Decimal Decimal::divide(const Decimal& lhs, const Decimal& rhs, const DecimalContext& context)
+{
+    Q_ASSERT(!rhs.isZero());
+    if (lhs.isZero() || rhs.isZero()) {
+        return Decimal();
+    }
+
+    // Делимое сдвигается так, чтобы частное имело не меньше digits + 1 цифр
+    const int shift = qMax(0, context.digits + 1 - lhs.digitCount() + rhs.digitCount());
+    Limbs dividend = lhs.m_limbs;
+    multiplyPow10(dividend, shift);
+
+    Limbs quotient;
+    Limbs remainder;
+    divideLimbs(dividend, rhs.m_limbs, quotient, remainder);
+
+    int exponent = lhs.m_exponent - rhs.m_exponent - shift;
+    if (!remainder.isEmpty()) {
+        appendSticky(quotient, exponent);
+    }
+
+    Decimal result(quotient, exponent, lhs.m_negative != rhs.m_negative);
+    result.roundTo(context);
+    return result;
+}
+
+Decimal Decimal::squareRoot(const Decimal& value, const DecimalContext& context)
+{
+    Q_ASSERT(!value.isNegative());
+    if (value.isZero() || value.isNegative()) {
+        return Decimal();
+    }
+
+    // Коэффициент сдвигается до 2 * (digits + 1) цифр с четным показателем,
+    // тогда целый корень дает digits + 1 верных цифр
+    int shift = qMax(0, 2 * (context.digits + 1) - value.digitCount());
+    if ((value.m_exponent - shift) % 2 != 0) {
+        ++shift;
+    }
+    Limbs radicand = value.m_limbs;
+    multiplyPow10(radicand, shift);
+
+    Limbs root = integerSquareRoot(radicand);
+    int exponent = (value.m_exponent - shift) / 2;
+    if (compareMagnitudes(multiplyLimbs(root, root), radicand) != 0) {
+        appendSticky(root, exponent);
+    }
+
+    Decimal result(root, exponent, false);
+    result.roundTo(context);
+    return result;
+}
+
+Decimal Decimal::scaled(const Decimal& value, int power)
+{
+    Decimal result = value;
+    if (!result.isZero()) {
+        result.m_exponent += power;
+    }
+    return result;
+}
+
+int Decimal::compare(const Decimal& lhs, const Decimal& rhs)
+{
+    if (lhs.isZero() || rhs.isZero() || lhs.m_negative != rhs.m_negative) {
+        const int left = lhs.isZero() ? 0 : (lhs.m_negative ? -1 : 1);
+        const int right = rhs.isZero() ? 0 : (rhs.m_negative ? -1 : 1);
+        return left < right ? -1 : (left > right ? 1 : 0);
+    }
+
+    int order = 0;
+    if (lhs.adjustedExponent() != rhs.adjustedExponent()) {
+        order = lhs.adjustedExponent() < rhs.adjustedExponent() ? -1 : 1;
+    } else {
+        // Одинаковый порядок: выравнивание ограничено разницей длин коэффициентов
+        const int exponent = qMin(lhs.m_exponent, rhs.m_exponent);
+        Limbs left = lhs.m_limbs;
+        Limbs right = rhs.m_limbs;
+        multiplyPow10(left, lhs.m_exponent - exponent);
+        multiplyPow10(right, rhs.m_exponent - exponent);
+        order = compareMagnitudes(left, right);
+    }
+    return lhs.m_negative ? -order : order;
+}
+
+bool Decimal::operator==(const Decimal& other) const
+{
+    return compare(*this, other) == 0;
+}
+
+bool Decimal::operator!=(const Decimal& other) const
+{
+    return compare(*this, other) != 0;
+}
+
+bool Decimal::operator<(const Decimal& other) const
+{
+    return compare(*this, other) < 0;
+}
+
+void Decimal::normalize()
+{
+    trim(m_limbs);
+    if (m_limbs.isEmpty()) {
+        m_exponent = 0;
+        m_negative = false;
+        return;
+    }
+
+    // Хвостовые нули переносятся в показатель
+    int zeroLimbs = 0;
+    while (m_limbs[zeroLimbs] == 0) {
+        ++zeroLimbs;
+    }
+    if (zeroLimbs > 0) {
+        m_limbs.remove(0, zeroLimbs);
+        m_exponent += zeroLimbs * LIMB_DIGITS;
+    }
+    int zeroDigits = 0;
+    while (zeroDigits < LIMB_DIGITS - 1 && m_limbs[0] % POW10[zeroDigits + 1] == 0) {
+        ++zeroDigits;
+    }
+    if (zeroDigits > 0) {
+        divideSmall(m_limbs, POW10[zeroDigits]);
+        m_exponent += zeroDigits;
+    }
+}
+
+void Decimal::roundTo(const DecimalContext& context)
+{
+    const int excess = ::digitCount(m_limbs) - context.digits;
+    if (excess <= 0) {
+        normalize();
+        return;
+    }
+
+    // Отбрасываем excess цифр: старшая из них решает округление, остальные - "липкие"
+    const bool sticky = dropDigits(m_limbs, excess - 1);
+    const quint32 roundingDigit = divideSmall(m_limbs, 10);
+    m_exponent += excess;
+
+    const bool inexact = roundingDigit != 0 || sticky;
+    const bool aboveHalf = roundingDigit > 5 || (roundingDigit == 5 && sticky);
+    const bool exactHalf = roundingDigit == 5 && !sticky;
+    const bool odd = !m_limbs.isEmpty() && (m_limbs[0] & 1);
+
+    bool roundUp = false;
+    switch (context.rounding) {
+        case DecimalRounding::HalfEven:
+            roundUp = aboveHalf || (exactHalf && odd);
+            break;
+        case DecimalRounding::HalfUp:
+            roundUp = aboveHalf || exactHalf;
+            break;
+        case DecimalRounding::HalfDown:
+            roundUp = aboveHalf;
+            break;
+        case DecimalRounding::Up:
+            roundUp = inexact;
+            break;
+        case DecimalRounding::Down:
+            roundUp = false;
+            break;
+        case DecimalRounding::Ceiling:
+            roundUp = inexact && !m_negative;
+            break;
+        case DecimalRounding::Floor:
+            roundUp = inexact && m_negative;
+            break;
+    }
+
+    if (roundUp) {
+        multiplySmall(m_limbs, 1, 1);
+        // 999 -> 1000: лишняя цифра всегда ноль
+        if (::digitCount(m_limbs) > context.digits) {
+            divideSmall(m_limbs, 10);
+            ++m_exponent;
+        }
+    }
+    normalize();
+}
@@ -0,0 +1,107 @@
+#ifndef DECIMAL_H
+#define DECIMAL_H
+
+#include <QByteArray>
+#include <QString>
+#include <QVarLengthArray>
+#include <QtGlobal>
+
+// Режимы округления в терминах General Decimal Arithmetic
+enum class DecimalRounding {
+    HalfEven,   // к ближайшему, половина - к четному (банковское)
+    HalfUp,     // к ближайшему, половина - от нуля
+    HalfDown,   // к ближайшему, половина - к нулю
+    Up,         // от нуля
+    Down,       // к нулю (отбрасывание)
+    Ceiling,    // к +бесконечности
+    Floor       // к -бесконечности
+};
+
+// Точность (число значащих цифр) и режим округления результатов
+struct DecimalContext {
+    int digits;
+    DecimalRounding rounding;
+
+    static const int DEFAULT_DIGITS = 34;
+
+    DecimalContext(int digits = DEFAULT_DIGITS,
+                   DecimalRounding rounding = DecimalRounding::HalfEven)
+        : digits(qMax(1, digits)), rounding(rounding) {}
+};
+
+// Десятичное число произвольной точности: (-1)^sign * coefficient * 10^exponent.
+// Коэффициент хранится конечностями по 10^9 (младшая первая) в буфере
+// на 4 конечности (36 цифр), поэтому типичные числа не выделяют память в куче.
+// Хранится в нормализованном виде: без хвостовых нулей, ноль всегда положителен.
+// Точные операции (сложение, умножение) округляются к контексту, деление и
+// корень вычисляются с точностью контекста и корректным округлением.
+class Decimal
+{
+public:
+    typedef QVarLengthArray<quint32, 4> Limbs;
+
+    static const quint32 LIMB_BASE = 1000000000u;
+    static const int LIMB_DIGITS = 9;
+
+public:
+    Decimal();
+    Decimal(qint64 value);
+
+public:
+    static Decimal fromString(const QString& text, bool* ok = nullptr);
+    static Decimal fromUtf8(const char* begin, const char* end, bool* ok = nullptr);
+    // Кратчайшее десятичное представление double (0.1 -> 0.1, а не 0.1000000000000000055...)
+    static Decimal fromDouble(double value, bool* ok = nullptr);
+
+    QString toString() const;
+    double toDouble() const;
+
+public:
+    bool isZero() const;
+    bool isNegative() const;
+    int exponent() const;
+    int digitCount() const;
+    // Порядок старшей цифры: 123.45 -> 2
+    int adjustedExponent() const;
+    const Limbs& limbs() const;
+
+    Decimal negated() const;
+    Decimal abs() const;
+    Decimal rounded(const DecimalContext& context) const;
+
+public:
+    static Decimal add(const Decimal& lhs, const Decimal& rhs, const DecimalContext& context);
+    static Decimal subtract(const Decimal& lhs, const Decimal& rhs, const DecimalContext& context);
+    static Decimal multiply(const Decimal& lhs, const Decimal& rhs, const DecimalContext& context);
+    // Делитель не должен быть нулем (проверяется вызывающей стороной)
+    static Decimal divide(const Decimal& lhs, const Decimal& rhs, const DecimalContext& context);
+    // Аргумент не должен быть отрицательным
+    static Decimal squareRoot(const Decimal& value, const DecimalContext& context);
+    // Умножение на 10^power без округления
+    static Decimal scaled(const Decimal& value, int power);
+
+    static int compare(const Decimal& lhs, const Decimal& rhs);
+
+public:
+    bool operator==(const Decimal& other) const;
+    bool operator!=(const Decimal& other) const;
+    bool operator<(const Decimal& other) const;
+
+public:
+    // Порог (в конечностях), с которого умножение переходит на алгоритм Карацубы
+    static const int KARATSUBA_THRESHOLD = 32;
+
+private:
+    Decimal(const Limbs& limbs, int exponent, bool negative);
+    static Decimal addMagnitudes(const Decimal& lhs, const Decimal& rhs, bool subtract,
+                                 const DecimalContext& context);
+    void normalize();
+    void roundTo(const DecimalContext& context);
+
+private:
+    Limbs m_limbs;
+    int m_exponent;
+    bool m_negative;
+};
+
+#endif // DECIMAL_H
@@ -1,10 +1,24 @@
 #include "displayformatter.h"
 #include "calculatorconfig.h"
+#include "numberformatter.h"
+#include "numberparser.h"
+#include "tracer.h"
 #include <QLocale>
 
+static_assert(CalculatorConfig::NUMBER_FORMAT == 'g',
+              "NumberFormatter::formatGeneral реализует только формат 'g'");
+
 QString DisplayFormatter::formatNumber(double value, int maxDigits)
 {
-    return QString::number(value, CalculatorConfig::NUMBER_FORMAT, maxDigits);
+    const TraceSpan span("format", "DisplayFormatter::formatNumber");
+    if (maxDigits > NumberFormatter::MAX_FAST_PRECISION) {
+        return QString::number(value, CalculatorConfig::NUMBER_FORMAT, maxDigits);
+    }
+
+    // Тот же вывод, что и у QString::number(value, 'g', maxDigits), без промежуточных строк
+    QChar buffer[NumberFormatter::BUFFER_SIZE];
+    const int length = NumberFormatter::formatGeneral(value, maxDigits, buffer);
+    return QString(buffer, length);
 }
 
 bool DisplayFormatter::isValidNumber(const QString& text)
@@ -14,13 +28,15 @@ bool DisplayFormatter::isValidNumber(const QString& text)
     }
     
     bool ok = false;
-    text.toDouble(&ok);
+    NumberParser::toDouble(text, &ok);
     return ok;
 }
 
 double DisplayFormatter::toDouble(const QString& text, bool* ok)
 {
-    return text.toDouble(ok);
+    const TraceSpan span("format", "DisplayFormatter::toDouble");
+    // Разбор без локали и выделений памяти, результат совпадает с QString::toDouble
+    return NumberParser::toDouble(text, ok);
 }
 
 QString DisplayFormatter::removeTrailingDecimal(const QString& text)
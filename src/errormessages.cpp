@@ -0,0 +1,23 @@
+#include "errormessages.h"
+#include "calculatorconfig.h"
+
+QString ErrorMessages::text(CalcHandler::Error error)
+{
+    switch (error) {
+        case CalcHandler::Error::None:
+            return QString();
+        case CalcHandler::Error::DivisionByZero:
+            return CalculatorConfig::ERROR_DIVISION_BY_ZERO;
+        case CalcHandler::Error::NegativeRoot:
+            return CalculatorConfig::ERROR_SQRT_NEGATIVE;
+        case CalcHandler::Error::Overflow:
+            return CalculatorConfig::ERROR_OVERFLOW;
+        case CalcHandler::Error::UnknownOperation:
+            return CalculatorConfig::ERROR_UNKNOWN_OPERATION;
+        case CalcHandler::Error::InsufficientData:
+            return CalculatorConfig::ERROR_INSUFFICIENT_DATA;
+        case CalcHandler::Error::InvalidInput:
+            return CalculatorConfig::ERROR_INVALID_INPUT;
+    }
+    return CalculatorConfig::ERROR_INVALID_INPUT;
+}
@@ -0,0 +1,19 @@
+#ifndef ERRORMESSAGES_H
+#define ERRORMESSAGES_H
+
+#include <QString>
+#include "calchandler.h"
+
+// Таблица сообщений для кодов ошибок CalcHandler.
+// Используется только при выводе результата пользователю,
+// вычисления оперируют исключительно кодами.
+class ErrorMessages
+{
+public:
+    static QString text(CalcHandler::Error error);
+
+private:
+    ErrorMessages() = default;
+};
+
+#endif // ERRORMESSAGES_H
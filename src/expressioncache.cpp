@@ -0,0 +1,192 @@
+#include "expressioncache.h"
+#include "expressioncompiler.h"
+#include "numberparser.h"
+
+namespace {
+
+// Служебные расходы QCache и QHash на один элемент (оценка)
+const int ENTRY_OVERHEAD = 64;
+
+inline bool isDigit(QChar c)
+{
+    return c >= '0' && c <= '9';
+}
+
+inline bool isSpace(QChar c)
+{
+    return c == ' ' || c == '\t'
+        || c == '\r' || c == '\n';
+}
+
+// Символы, из которых складываются имена функций и литералы; '#' - литерал в ключе
+inline bool isWordChar(QChar c)
+{
+    return c.isLetter() || isDigit(c) || c == '.' || c == '#';
+}
+
+// "x" без "²" - знак умножения, а не часть имени
+inline bool isMultiplicationX(const QChar* pos, const QChar* end)
+{
+    return *pos == 'x' && (pos + 1 == end || pos[1] != QChar(0x00B2));
+}
+
+// Функция "1/x(" начинается с цифры, но литералом не является
+bool isReciprocalFunction(const QChar* pos, const QChar* end)
+{
+    if (end - pos < 3 || pos[0] != '1' || pos[1] != '/'
+        || pos[2] != 'x') {
+        return false;
+    }
+    pos += 3;
+    while (pos < end && isSpace(*pos)) {
+        ++pos;
+    }
+    return pos < end && *pos == '(';
+}
+
+// Литерал по тем же правилам, что и в ExpressionCompiler, без промежуточной копии
+const QChar* scanNumber(const QChar* pos, const QChar* end, double& value)
+{
+    bool ok = false;
+    const QChar* next = NumberParser::parsePrefix(pos, end, value, &ok);
+    if (!ok) {
+        value = 0.0;
+    }
+    return next;
+}
+
+} // namespace
+
+ExpressionCache::ExpressionCache(int memoryBudget)
+    : m_programs(memoryBudget)
+    , m_stats{0, 0, 0}
+{
+}
+
+bool ExpressionCache::program(const QString& text, ExpressionProgram& program,
+                              QVector<double>& operands)
+{
+    normalize(text, m_key, operands);
+
+    if (const ExpressionProgram* cached = m_programs.object(m_key)) {
+        ++m_stats.hits;
+        program = *cached;
+        return true;
+    }
+
+    ++m_stats.misses;
+    if (!ExpressionCompiler::compile(text, program)) {
+        return false;
+    }
+
+    // Кэшируем, только если разметка литералов совпала со слотами компилятора
+    if (program.operands() != operands) {
+        operands = program.operands();
+        return true;
+    }
+
+    const int before = m_programs.size();
+    if (m_programs.insert(m_key, new ExpressionProgram(program), cost(m_key, program))) {
+        m_stats.evictions += before + 1 - m_programs.size();
+    }
+    return true;
+}
+
+CalcHandler::CalculationResult ExpressionCache::evaluate(const QString& text)
+{
+    ExpressionProgram compiled;
+    QVector<double> operands;
+    if (!program(text, compiled, operands)) {
+        return {0.0, CalcHandler::Error::InvalidInput};
+    }
+    return compiled.evaluate(operands.constData());
+}
+
+void ExpressionCache::setMemoryBudget(int bytes)
+{
+    const int before = m_programs.size();
+    m_programs.setMaxCost(bytes);
+    m_stats.evictions += before - m_programs.size();
+}
+
+int ExpressionCache::memoryBudget() const
+{
+    return m_programs.maxCost();
+}
+
+int ExpressionCache::memoryUsage() const
+{
+    return m_programs.totalCost();
+}
+
+int ExpressionCache::size() const
+{
+    return m_programs.size();
+}
+
+void ExpressionCache::clear()
+{
+    m_programs.clear();
+}
+
+ExpressionCache::Statistics ExpressionCache::statistics() const
+{
+    return m_stats;
+}
+
+void ExpressionCache::resetStatistics()
+{
+    m_stats = Statistics{0, 0, 0};
+}
+
+void ExpressionCache::normalize(const QString& text, QString& key, QVector<double>& operands)
+{
+    key.clear();
+    operands.clear();
+
+    const QChar* pos = text.constData();
+    const QChar* end = pos + text.size();
+    while (pos < end) {
+        const QChar c = *pos;
+        if (isSpace(c)) {
+            while (pos < end && isSpace(*pos)) {
+                ++pos;
+            }
+            // Пробел внутри имени ("sq rt") компилятор не принимает: в ключе
+            // он остается разделителем, иначе такой текст попал бы в "sqrt(#)"
+            if (pos < end && !key.isEmpty() && isWordChar(key.at(key.size() - 1))
+                && isWordChar(*pos) && !isMultiplicationX(pos, end)) {
+                key.append(' ');
+            }
+        } else if (isReciprocalFunction(pos, end)) {
+            key.append("1/x");
+            pos += 3;
+        } else if (isDigit(c) || (c == '.' && pos + 1 < end && isDigit(pos[1]))) {
+            double value = 0.0;
+            pos = scanNumber(pos, end, value);
+            operands.append(value);
+            key.append('#');
+        } else if (c == QChar(0x00D7) || c == '*' || isMultiplicationX(pos, end)) {
+            key.append('*');
+            ++pos;
+        } else if (c == QChar(0x00F7)) {
+            key.append('/');
+            ++pos;
+        } else if (c == QChar(0x2212)) {
+            key.append('-');
+            ++pos;
+        } else {
+            key.append(c);
+            ++pos;
+        }
+    }
+}
+
+int ExpressionCache::cost(const QString& key, const ExpressionProgram& program)
+{
+    return ENTRY_OVERHEAD
+        + static_cast<int>(sizeof(ExpressionProgram))
+        + key.size() * static_cast<int>(sizeof(QChar))
+        + program.instructions().size() * static_cast<int>(sizeof(ExpressionProgram::Instruction))
+        + program.operandCount() * static_cast<int>(sizeof(double));
+}
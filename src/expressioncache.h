@@ -0,0 +1,59 @@
+#ifndef EXPRESSIONCACHE_H
+#define EXPRESSIONCACHE_H
+
+#include <QCache>
+#include <QString>
+#include <QVector>
+#include "expressionprogram.h"
+
+// LRU-кэш скомпилированных выражений с бюджетом памяти в байтах.
+// Ключ - нормализованный текст: без пробелов, с единым написанием операторов
+// и с литералами, замененными на слоты ("2 × 3 + 1" и "5*7+4" -> "#*#+#").
+// Поэтому формулы, отличающиеся только числами, разделяют одну программу,
+// а числа конкретного текста подставляются при вычислении.
+// Не потокобезопасен.
+class ExpressionCache
+{
+public:
+    struct Statistics {
+        qint64 hits;
+        qint64 misses;
+        qint64 evictions;
+    };
+
+    static const int DEFAULT_MEMORY_BUDGET = 1 << 20;
+
+public:
+    explicit ExpressionCache(int memoryBudget = DEFAULT_MEMORY_BUDGET);
+
+public:
+    // Программа для text и литералы text в порядке слотов. false - синтаксическая ошибка.
+    // Результат вычисляется через program.evaluate(operands.constData()).
+    bool program(const QString& text, ExpressionProgram& program, QVector<double>& operands);
+    CalcHandler::CalculationResult evaluate(const QString& text);
+
+public:
+    void setMemoryBudget(int bytes);
+    int memoryBudget() const;
+    int memoryUsage() const;
+    int size() const;
+    void clear();
+
+public:
+    Statistics statistics() const;
+    void resetStatistics();
+
+public:
+    // Нормализованный ключ и литералы текста
+    static void normalize(const QString& text, QString& key, QVector<double>& operands);
+
+private:
+    static int cost(const QString& key, const ExpressionProgram& program);
+
+private:
+    QCache<QString, ExpressionProgram> m_programs;
+    Statistics m_stats;
+    QString m_key;
+};
+
+#endif // EXPRESSIONCACHE_H
@@ -0,0 +1,400 @@
+#include "expressioncompiler.h"
+#include "numberparser.h"
+#include <QVarLengthArray>
+
+namespace {
+
+const uint END_OF_TEXT = 0;
+
+// Глубина вложенности скобок и префиксных операторов
+const int MAX_NESTING = 256;
+
+// Символы выражения в кодах Unicode
+const uint MINUS_SIGN = 0x2212;        // −
+const uint MULTIPLICATION_SIGN = 0xD7; // ×
+const uint DIVISION_SIGN = 0xF7;       // ÷
+const uint SQUARE_ROOT = 0x221A;       // √
+const uint SUPERSCRIPT_TWO = 0xB2;     // ²
+const uint PLUS_MINUS = 0xB1;          // ±
+
+struct Function {
+    uint name[5];
+    CalcHandler::Operation operation;
+};
+
+// Имена функций в формате истории; "sqrt" раньше "sqr", чтобы сравнение было жадным
+const Function FUNCTIONS[] = {
+    { { SQUARE_ROOT }, CalcHandler::Operation::SquareRoot },
+    { { 's', 'q', 'r', 't' }, CalcHandler::Operation::SquareRoot },
+    { { 'x', SUPERSCRIPT_TWO }, CalcHandler::Operation::Square },
+    { { 's', 'q', 'r' }, CalcHandler::Operation::Square },
+    { { PLUS_MINUS }, CalcHandler::Operation::Negate },
+    { { 'n', 'e', 'g' }, CalcHandler::Operation::Negate },
+    { { '1', '/', 'x' }, CalcHandler::Operation::Reciprocal },
+    { { 'i', 'n', 'v' }, CalcHandler::Operation::Reciprocal },
+    { { '%' }, CalcHandler::Operation::Percent },
+    { { 'p', 'c', 't' }, CalcHandler::Operation::Percent }
+};
+
+// Чтение QString посимвольно
+class Utf16Reader
+{
+public:
+    Utf16Reader(const QChar* begin, const QChar* end)
+        : m_begin(begin), m_pos(begin), m_end(end) {}
+
+    uint peek() const { return m_pos < m_end ? m_pos->unicode() : END_OF_TEXT; }
+    void advance() { ++m_pos; }
+    int position() const { return static_cast<int>(m_pos - m_begin); }
+    void reset(int position) { m_pos = m_begin + position; }
+
+private:
+    const QChar* m_begin;
+    const QChar* m_pos;
+    const QChar* m_end;
+};
+
+// Чтение UTF-8 с декодированием на лету. Некорректные последовательности
+// превращаются в символ, не входящий в грамматику.
+class Utf8Reader
+{
+public:
+    Utf8Reader(const char* begin, const char* end)
+        : m_begin(begin), m_pos(begin), m_end(end) {}
+
+    uint peek() const
+    {
+        if (m_pos >= m_end) {
+            return END_OF_TEXT;
+        }
+        const uchar lead = static_cast<uchar>(*m_pos);
+        if (lead < 0x80) {
+            return lead;
+        }
+        const int length = sequenceLength();
+        if (length == 0 || m_end - m_pos < length) {
+            return 0xFFFD;
+        }
+        uint code = lead & (0xFF >> (length + 1));
+        for (int i = 1; i < length; ++i) {
+            code = (code << 6) | (static_cast<uchar>(m_pos[i]) & 0x3F);
+        }
+        return code;
+    }
+
+    void advance()
+    {
+        const int length = sequenceLength();
+        m_pos += length > 0 && m_end - m_pos >= length ? length : 1;
+    }
+
+    int position() const { return static_cast<int>(m_pos - m_begin); }
+    void reset(int position) { m_pos = m_begin + position; }
+
+private:
+    int sequenceLength() const
+    {
+        const uchar lead = static_cast<uchar>(*m_pos);
+        if (lead < 0x80) return 1;
+        if ((lead & 0xE0) == 0xC0) return 2;
+        if ((lead & 0xF0) == 0xE0) return 3;
+        if ((lead & 0xF8) == 0xF0) return 4;
+        return 0;
+    }
+
+    const char* m_begin;
+    const char* m_pos;
+    const char* m_end;
+};
+
+inline bool isDigit(uint c)
+{
+    return c >= '0' && c <= '9';
+}
+
+// Рекурсивный спуск, генерирующий байткод в обратной польской записи
+template<typename Reader>
+class Parser
+{
+public:
+    Parser(Reader reader, ExpressionProgram& program)
+        : m_reader(reader), m_program(program), m_nesting(0), m_errorPosition(-1) {}
+
+    bool parse()
+    {
+        m_program.clear();
+        skipSpaces();
+        if (m_reader.peek() == END_OF_TEXT) {
+            return fail();
+        }
+        if (!parseExpression()) {
+            return false;
+        }
+        skipSpaces();
+        if (m_reader.peek() != END_OF_TEXT) {
+            return fail();
+        }
+        return true;
+    }
+
+    int errorPosition() const { return m_errorPosition; }
+
+private:
+    bool parseExpression()
+    {
+        if (!parseTerm()) {
+            return false;
+        }
+        for (;;) {
+            skipSpaces();
+            const uint c = m_reader.peek();
+            CalcHandler::Operation op;
+            if (c == '+') {
+                op = CalcHandler::Operation::Add;
+            } else if (c == '-' || c == MINUS_SIGN) {
+                op = CalcHandler::Operation::Subtract;
+            } else {
+                return true;
+            }
+            m_reader.advance();
+            if (!parseTerm()) {
+                return false;
+            }
+            m_program.appendOperation(op);
+        }
+    }
+
+    bool parseTerm()
+    {
+        if (!parseUnary()) {
+            return false;
+        }
+        for (;;) {
+            skipSpaces();
+            const uint c = m_reader.peek();
+            CalcHandler::Operation op;
+            if (c == '*' || c == 'x' || c == MULTIPLICATION_SIGN) {
+                op = CalcHandler::Operation::Multiply;
+            } else if (c == '/' || c == DIVISION_SIGN) {
+                op = CalcHandler::Operation::Divide;
+            } else {
+                return true;
+            }
+            m_reader.advance();
+            if (!parseUnary()) {
+                return false;
+            }
+            m_program.appendOperation(op);
+        }
+    }
+
+    bool parseUnary()
+    {
+        skipSpaces();
+        const uint c = m_reader.peek();
+        CalcHandler::Operation op = CalcHandler::Operation::None;
+        if (c == '-' || c == MINUS_SIGN || c == PLUS_MINUS) {
+            op = CalcHandler::Operation::Negate;
+        } else if (c == SQUARE_ROOT) {
+            op = CalcHandler::Operation::SquareRoot;
+        } else if (c != '+') {
+            return parsePostfix();
+        }
+
+        if (++m_nesting > MAX_NESTING) {
+            return fail();
+        }
+        m_reader.advance();
+        if (!parseUnary()) {
+            return false;
+        }
+        --m_nesting;
+
+        // Унарный плюс ничего не генерирует
+        if (op != CalcHandler::Operation::None) {
+            m_program.appendOperation(op);
+        }
+        return true;
+    }
+
+    bool parsePostfix()
+    {
+        if (!parsePrimary()) {
+            return false;
+        }
+        for (;;) {
+            skipSpaces();
+            const uint c = m_reader.peek();
+            if (c == SUPERSCRIPT_TWO) {
+                m_program.appendOperation(CalcHandler::Operation::Square);
+            } else if (c == '%') {
+                m_program.appendOperation(CalcHandler::Operation::Percent);
+            } else {
+                return true;
+            }
+            m_reader.advance();
+        }
+    }
+
+    bool parsePrimary()
+    {
+        skipSpaces();
+
+        CalcHandler::Operation function = CalcHandler::Operation::None;
+        if (parseFunctionName(function) || m_reader.peek() == '(') {
+            if (++m_nesting > MAX_NESTING) {
+                return fail();
+            }
+            m_reader.advance();
+            if (!parseExpression()) {
+                return false;
+            }
+            skipSpaces();
+            if (m_reader.peek() != ')') {
+                return fail();
+            }
+            m_reader.advance();
+            --m_nesting;
+
+            if (function != CalcHandler::Operation::None) {
+                m_program.appendOperation(function);
+            }
+            return true;
+        }
+
+        return parseNumber();
+    }
+
+    // Имя функции считается совпавшим, только если за ним следует "("
+    bool parseFunctionName(CalcHandler::Operation& op)
+    {
+        const int start = m_reader.position();
+        for (const Function& function : FUNCTIONS) {
+            int i = 0;
+            while (i < 5 && function.name[i] != 0 && m_reader.peek() == function.name[i]) {
+                m_reader.advance();
+                ++i;
+            }
+            if (i > 0 && (i == 5 || function.name[i] == 0)) {
+                skipSpaces();
+                if (m_reader.peek() == '(') {
+                    op = function.operation;
+                    return true;
+                }
+            }
+            m_reader.reset(start);
+        }
+        return false;
+    }
+
+    bool parseNumber()
+    {
+        // Число без знака: знак разбирается как унарный оператор
+        QVarLengthArray<char, 64> text;
+        const int start = m_reader.position();
+
+        int digits = 0;
+        while (isDigit(m_reader.peek())) {
+            text.append(static_cast<char>(m_reader.peek()));
+            m_reader.advance();
+            ++digits;
+        }
+        if (m_reader.peek() == '.') {
+            text.append('.');
+            m_reader.advance();
+            while (isDigit(m_reader.peek())) {
+                text.append(static_cast<char>(m_reader.peek()));
+                m_reader.advance();
+                ++digits;
+            }
+        }
+        if (digits == 0) {
+            m_reader.reset(start);
+            return fail();
+        }
+
+        if (m_reader.peek() == 'e' || m_reader.peek() == 'E') {
+            const int exponentStart = m_reader.position();
+            const int mantissaLength = text.size();
+            text.append('e');
+            m_reader.advance();
+            if (m_reader.peek() == '+' || m_reader.peek() == '-') {
+                text.append(static_cast<char>(m_reader.peek()));
+                m_reader.advance();
+            }
+            if (isDigit(m_reader.peek())) {
+                while (isDigit(m_reader.peek())) {
+                    text.append(static_cast<char>(m_reader.peek()));
+                    m_reader.advance();
+                }
+            } else {
+                // "e" без цифр не относится к числу
+                text.resize(mantissaLength);
+                m_reader.reset(exponentStart);
+            }
+        }
+
+        // Разбор без локали, с тем же округлением, что и в интерактивном режиме
+        bool ok = false;
+        const double value = NumberParser::toDouble(text.constData(), text.constData() + text.size(), &ok);
+        if (!ok) {
+            m_reader.reset(start);
+            return fail();
+        }
+
+        m_program.appendOperand(value);
+        return true;
+    }
+
+    void skipSpaces()
+    {
+        for (;;) {
+            const uint c = m_reader.peek();
+            if (c != ' ' && c != '\t' && c != '\r' && c != '\n') {
+                return;
+            }
+            m_reader.advance();
+        }
+    }
+
+    bool fail()
+    {
+        if (m_errorPosition < 0) {
+            m_errorPosition = m_reader.position();
+        }
+        m_program.clear();
+        return false;
+    }
+
+private:
+    Reader m_reader;
+    ExpressionProgram& m_program;
+    int m_nesting;
+    int m_errorPosition;
+};
+
+template<typename Reader>
+bool compileWith(Reader reader, ExpressionProgram& program, int* errorPosition)
+{
+    Parser<Reader> parser(reader, program);
+    const bool ok = parser.parse();
+    if (errorPosition) {
+        *errorPosition = ok ? -1 : parser.errorPosition();
+    }
+    return ok;
+}
+
+} // namespace
+
+bool ExpressionCompiler::compile(const QString& text, ExpressionProgram& program,
+                                 int* errorPosition)
+{
+    return compileWith(Utf16Reader(text.constData(), text.constData() + text.size()),
+                       program, errorPosition);
+}
+
+bool ExpressionCompiler::compile(const char* begin, const char* end, ExpressionProgram& program,
+                                 int* errorPosition)
+{
+    return compileWith(Utf8Reader(begin, end), program, errorPosition);
+}
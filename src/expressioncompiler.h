@@ -0,0 +1,30 @@
+#ifndef EXPRESSIONCOMPILER_H
+#define EXPRESSIONCOMPILER_H
+
+#include <QString>
+#include "expressionprogram.h"
+
+// Компилятор выражений в ExpressionProgram.
+// Грамматика (по убыванию приоритета):
+//   первичное   число | (выражение) | функция(выражение)
+//   постфиксные x² ("²") и процент ("%")
+//   префиксные  унарный минус ("-", "−", "±") и корень ("√")
+//   умножение   "*", "x", "×" и деление "/", "÷"
+//   сложение    "+" и вычитание "-", "−"
+// Функции повторяют формат истории: √(...), sqrt, x²(...), sqr, ±(...), neg,
+// 1/x(...), inv, %(...), pct. Например "3 + 4 × 2 ÷ (1 − 5)²" дает 3.5.
+class ExpressionCompiler
+{
+public:
+    // При ошибке возвращает false, errorPosition - смещение ошибки в символах
+    static bool compile(const QString& text, ExpressionProgram& program,
+                        int* errorPosition = nullptr);
+    // Вариант для UTF-8 без преобразования в QString, errorPosition - в байтах
+    static bool compile(const char* begin, const char* end, ExpressionProgram& program,
+                        int* errorPosition = nullptr);
+
+private:
+    ExpressionCompiler() = default;
+};
+
+#endif // EXPRESSIONCOMPILER_H
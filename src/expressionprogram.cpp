@@ -0,0 +1,151 @@
+#include "expressionprogram.h"
+#include <QVarLengthArray>
+
+ExpressionProgram::ExpressionProgram()
+    : m_depth(0)
+    , m_stackDepth(0)
+{
+}
+
+void ExpressionProgram::appendOperand(double value)
+{
+    Instruction instruction;
+    instruction.operation = CalcHandler::Operation::None;
+    instruction.operand = m_operands.size();
+    m_code.append(instruction);
+    m_operands.append(value);
+
+    ++m_depth;
+    m_stackDepth = qMax(m_stackDepth, m_depth);
+}
+
+void ExpressionProgram::appendOperation(CalcHandler::Operation op)
+{
+    Instruction instruction;
+    instruction.operation = op;
+    instruction.operand = 0;
+    m_code.append(instruction);
+
+    // Бинарная операция снимает два значения и кладет одно
+    if (isBinaryOperation(op)) {
+        --m_depth;
+    }
+}
+
+void ExpressionProgram::clear()
+{
+    m_code.clear();
+    m_operands.clear();
+    m_depth = 0;
+    m_stackDepth = 0;
+}
+
+bool ExpressionProgram::isValid() const
+{
+    return !m_code.isEmpty() && m_depth == 1;
+}
+
+int ExpressionProgram::operandCount() const
+{
+    return m_operands.size();
+}
+
+int ExpressionProgram::stackDepth() const
+{
+    return m_stackDepth;
+}
+
+const QVector<double>& ExpressionProgram::operands() const
+{
+    return m_operands;
+}
+
+const QVector<ExpressionProgram::Instruction>& ExpressionProgram::instructions() const
+{
+    return m_code;
+}
+
+CalcHandler::CalculationResult ExpressionProgram::evaluate() const
+{
+    return evaluate(m_operands.constData());
+}
+
+CalcHandler::CalculationResult ExpressionProgram::evaluate(const double* operands) const
+{
+    if (!isValid()) {
+        return {0.0, CalcHandler::Error::InsufficientData};
+    }
+
+    // Глубина стека известна после компиляции, для типичных формул хватает буфера на стеке
+    QVarLengthArray<double, 32> stack(m_stackDepth);
+    double* top = stack.data();
+
+    for (const Instruction& instruction : m_code) {
+        const CalcHandler::Operation op = instruction.operation;
+        if (op == CalcHandler::Operation::None) {
+            *top++ = operands[instruction.operand];
+            continue;
+        }
+
+        CalcHandler::CalculationResult result;
+        if (isBinaryOperation(op)) {
+            --top;
+            result = CalcHandler::computeBinary(top[-1], top[0], op);
+        } else {
+            result = CalcHandler::computeUnary(op, top[-1]);
+        }
+
+        if (!result.success()) {
+            return result;
+        }
+        top[-1] = result.value;
+    }
+
+    return {stack[0], CalcHandler::Error::None};
+}
+
+CalcResult<Decimal> ExpressionProgram::evaluate(const DecimalContext& context) const
+{
+    if (!isValid()) {
+        return {Decimal(), CalcHandler::Error::InsufficientData};
+    }
+
+    QVarLengthArray<Decimal, 8> stack(m_stackDepth);
+    Decimal* top = stack.data();
+
+    for (const Instruction& instruction : m_code) {
+        const CalcHandler::Operation op = instruction.operation;
+        if (op == CalcHandler::Operation::None) {
+            bool ok = false;
+            *top++ = Decimal::fromDouble(m_operands[instruction.operand], &ok);
+            // Литерал вне диапазона double разобран как бесконечность
+            if (!ok) {
+                return {Decimal(), CalcHandler::Error::Overflow};
+            }
+            continue;
+        }
+
+        CalcResult<Decimal> result;
+        if (isBinaryOperation(op)) {
+            --top;
+            result = CalcEngine<Decimal>::computeBinary(top[-1], top[0], op, context);
+        } else {
+            result = CalcEngine<Decimal>::computeUnary(op, top[-1], context);
+        }
+
+        if (!result.success()) {
+            return result;
+        }
+        top[-1] = result.value;
+    }
+
+    return {stack[0], CalcHandler::Error::None};
+}
+
+bool ExpressionProgram::isBinaryOperation(CalcHandler::Operation op)
+{
+    return op == CalcHandler::Operation::Add
+        || op == CalcHandler::Operation::Subtract
+        || op == CalcHandler::Operation::Multiply
+        || op == CalcHandler::Operation::Divide;
+}
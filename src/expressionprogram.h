@@ -0,0 +1,54 @@
+#ifndef EXPRESSIONPROGRAM_H
+#define EXPRESSIONPROGRAM_H
+
+#include <QVector>
+#include "calchandler.h"
+
+// Скомпилированное выражение: стековый байткод над CalcHandler::Operation.
+// Числовые литералы вынесены в слоты операндов, поэтому программу можно
+// вычислять повторно с другими значениями без повторного разбора текста.
+class ExpressionProgram
+{
+public:
+    struct Instruction {
+        CalcHandler::Operation operation;   // None - загрузка операнда на стек
+        int operand;                        // индекс слота для загрузки
+    };
+
+public:
+    ExpressionProgram();
+
+public:
+    // Построение программы (используется ExpressionCompiler)
+    void appendOperand(double value);
+    void appendOperation(CalcHandler::Operation op);
+    void clear();
+
+public:
+    bool isValid() const;
+    int operandCount() const;
+    int stackDepth() const;
+    const QVector<double>& operands() const;
+    const QVector<Instruction>& instructions() const;
+
+public:
+    // Вычисление с литералами из исходного текста
+    CalcHandler::CalculationResult evaluate() const;
+    // Вычисление с подставленными операндами: массив из operandCount() значений
+    CalcHandler::CalculationResult evaluate(const double* operands) const;
+    // Вычисление в Decimal с точностью context: промежуточные результаты не сводятся
+    // к double. Литералы берутся в кратчайшем десятичном виде, поэтому записи
+    // до 15 значащих цифр передаются точно
+    CalcResult<Decimal> evaluate(const DecimalContext& context) const;
+
+public:
+    static bool isBinaryOperation(CalcHandler::Operation op);
+
+private:
+    QVector<Instruction> m_code;
+    QVector<double> m_operands;
+    int m_depth;
+    int m_stackDepth;
+};
+
+#endif // EXPRESSIONPROGRAM_H
@@ -0,0 +1,954 @@
+#include "historyarchive.h"
+#include "calculatorconfig.h"
+#include "historyjournal.h"
+#include "numberformatter.h"
+#include "numberparser.h"
+#include "logcategories.h"
+#include <QHash>
+#include <QStringList>
+#include <QTextStream>
+#include <QtAlgorithms>
+#include <QtEndian>
+#include <algorithm>
+#include <cstring>
+
+const char HistoryArchive::MAGIC[4] = { 'C', 'H', 'A', 'R' };
+
+namespace {
+
+// Столбцы в нагрузке блока, в порядке записи
+enum ColumnSlot {
+    TimestampSlot,
+    LhsSlot,
+    RhsSlot,
+    ResultSlot,
+    OperationSlot,
+    PrecisionSlot,
+    DictionarySlot,
+    ExpressionSlot,
+    SLOT_COUNT
+};
+
+// Перед каждым столбцом: длина и CRC-32 данных (quint32)
+const int COLUMN_HEADER_SIZE = 8;
+
+quint64 lowBits(int count)
+{
+    return count == 64 ? ~quint64(0) : (quint64(1) << count) - 1;
+}
+
+// Биты пишутся старшими вперед
+class BitWriter
+{
+public:
+    explicit BitWriter(QByteArray& out)
+        : m_out(out)
+        , m_bits(0)
+        , m_used(0)
+    {
+    }
+
+    // Младшие count (1..64) бит value
+    void write(quint64 value, int count)
+    {
+        while (count > 0) {
+            const int room = 64 - m_used;
+            const int take = qMin(room, count);
+            m_bits |= ((value >> (count - take)) & lowBits(take)) << (room - take);
+            m_used += take;
+            count -= take;
+            if (m_used == 64) {
+                char word[8];
+                qToBigEndian<quint64>(m_bits, word);
+                m_out.append(word, sizeof(word));
+                m_bits = 0;
+                m_used = 0;
+            }
+        }
+    }
+
+    void finish()
+    {
+        char word[8];
+        qToBigEndian<quint64>(m_bits, word);
+        m_out.append(word, (m_used + 7) / 8);
+        m_bits = 0;
+        m_used = 0;
+    }
+
+private:
+    QByteArray& m_out;
+    quint64 m_bits;
+    int m_used;
+};
+
+// Каждое чтение - одна невыровненная загрузка 8 байт с позиции бита
+class BitReader
+{
+public:
+    BitReader(const char* data, int size)
+        : m_data(reinterpret_cast<const uchar*>(data))
+        , m_size(size)
+        , m_pos(0)
+    {
+    }
+
+    // count от 1 до 64
+    quint64 read(int count)
+    {
+        if (count > 56) {
+            const quint64 high = read(count - 32);
+            return (high << 32) | read(32);
+        }
+        const quint64 value = peek(count);
+        m_pos += count;
+        return value;
+    }
+
+    // Следующие count (1..56) бит без сдвига позиции; за концом данных - нули
+    quint64 peek(int count) const
+    {
+        const int byte = int(m_pos >> 3);
+        quint64 word;
+        if (byte + 8 <= m_size) {
+            word = qFromBigEndian<quint64>(m_data + byte);
+        } else {
+            uchar tail[8] = {};
+            if (byte < m_size) {
+                std::memcpy(tail, m_data + byte, size_t(m_size - byte));
+            }
+            word = qFromBigEndian<quint64>(tail);
+        }
+        return (word << (m_pos & 7)) >> (64 - count);
+    }
+
+    void skip(int count)
+    {
+        m_pos += count;
+    }
+
+    bool overrun() const
+    {
+        return m_pos > qint64(m_size) * 8;
+    }
+
+private:
+    const uchar* m_data;
+    int m_size;
+    qint64 m_pos;
+};
+
+quint64 zigzag(qint64 value)
+{
+    return (quint64(value) << 1) ^ quint64(value >> 63);
+}
+
+qint64 unzigzag(quint64 value)
+{
+    return qint64(value >> 1) ^ -qint64(value & 1);
+}
+
+quint64 doubleBits(double value)
+{
+    quint64 bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    return bits;
+}
+
+double bitsDouble(quint64 bits)
+{
+    double value;
+    std::memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+// Ширины разности разностей времени (zigzag) после префиксов 10, 110, 1110;
+// после 1111 - все 64 бита. Время в миллисекундах, поэтому корзины шире, чем у Gorilla
+const int TIMESTAMP_WIDTHS[] = { 8, 16, 32 };
+
+// Разность разностей 0 - бит 0, иначе префикс корзины и значение.
+// Разности считаются по модулю 2^64, так что переполнение qint64 не страшно
+void encodeTimestamps(const QVector<HistoryEntry>& entries, QByteArray& out)
+{
+    BitWriter bits(out);
+    quint64 previous = 0;
+    quint64 previousDelta = 0;
+    for (const HistoryEntry& entry : entries) {
+        const quint64 delta = quint64(entry.timestamp) - previous;
+        const quint64 value = zigzag(qint64(delta - previousDelta));
+        previous = quint64(entry.timestamp);
+        previousDelta = delta;
+        if (value == 0) {
+            bits.write(0, 1);
+            continue;
+        }
+
+        int bucket = 0;
+        while (bucket < 3 && value > lowBits(TIMESTAMP_WIDTHS[bucket])) {
+            ++bucket;
+        }
+        // Префикс: bucket + 1 единиц и ноль, у последней корзины - четыре единицы
+        if (bucket < 3) {
+            bits.write(lowBits(bucket + 1) << 1, bucket + 2);
+            bits.write(value, TIMESTAMP_WIDTHS[bucket]);
+        } else {
+            bits.write(0xF, 4);
+            bits.write(value, 64);
+        }
+    }
+    bits.finish();
+}
+
+bool decodeTimestamps(const char* data, int size, int count, qint64* timestamps)
+{
+    BitReader bits(data, size);
+    quint64 previous = 0;
+    quint64 previousDelta = 0;
+    for (int i = 0; i < count; ++i) {
+        int bucket = 0;
+        while (bucket < 4 && bits.read(1) != 0) {
+            ++bucket;
+        }
+        if (bucket > 0) {
+            const quint64 value = bits.read(bucket < 4 ? TIMESTAMP_WIDTHS[bucket - 1] : 64);
+            previousDelta += quint64(unzigzag(value));
+        }
+        previous += previousDelta;
+        timestamps[i] = qint64(previous);
+    }
+    return !bits.overrun();
+}
+
+// Повтор предыдущего значения - бит 0. Иначе 10 и значащие биты XOR в окне
+// предыдущего значения, если они в нем помещаются, или 11, ведущие нули (6 бит),
+// длина - 1 (6 бит) и значащие биты. Первое значение сравнивается с нулем
+void encodeDoubles(const QVector<HistoryEntry>& entries, double HistoryEntry::*field,
+                   QByteArray& out)
+{
+    BitWriter bits(out);
+    quint64 previous = 0;
+    int windowLeading = -1;
+    int windowTrailing = 0;
+    for (const HistoryEntry& entry : entries) {
+        const quint64 value = doubleBits(entry.*field);
+        const quint64 difference = value ^ previous;
+        previous = value;
+        if (difference == 0) {
+            bits.write(0, 1);
+            continue;
+        }
+
+        const int leading = int(qCountLeadingZeroBits(difference));
+        const int trailing = int(qCountTrailingZeroBits(difference));
+        if (windowLeading >= 0 && leading >= windowLeading && trailing >= windowTrailing) {
+            bits.write(2, 2);
+            bits.write(difference >> windowTrailing, 64 - windowLeading - windowTrailing);
+        } else {
+            const int meaningful = 64 - leading - trailing;
+            bits.write(3, 2);
+            bits.write(quint64(leading), 6);
+            bits.write(quint64(meaningful - 1), 6);
+            bits.write(difference >> trailing, meaningful);
+            windowLeading = leading;
+            windowTrailing = trailing;
+        }
+    }
+    bits.finish();
+}
+
+bool decodeDoubles(const char* data, int size, int count, double* values)
+{
+    BitReader bits(data, size);
+    quint64 previous = 0;
+    int windowLeading = -1;
+    int windowTrailing = 0;
+    for (int i = 0; i < count; ++i) {
+        // Управляющие биты и заголовок окна - одной загрузкой
+        const quint64 head = bits.peek(14);
+        if ((head >> 13) == 0) {
+            bits.skip(1);
+        } else if ((head >> 12) == 2) {
+            if (windowLeading < 0) {
+                return false;
+            }
+            bits.skip(2);
+            previous ^= bits.read(64 - windowLeading - windowTrailing) << windowTrailing;
+        } else {
+            windowLeading = int((head >> 6) & 0x3F);
+            const int meaningful = int(head & 0x3F) + 1;
+            windowTrailing = 64 - windowLeading - meaningful;
+            if (windowTrailing < 0) {
+                return false;
+            }
+            bits.skip(14);
+            previous ^= bits.read(meaningful) << windowTrailing;
+        }
+        values[i] = bitsDouble(previous);
+    }
+    return !bits.overrun();
+}
+
+int bitWidth(quint32 maxValue)
+{
+    return maxValue == 0 ? 0 : 32 - int(qCountLeadingZeroBits(maxValue));
+}
+
+// [ширина: 1 байт][значения по ширине бит]; нулевая ширина - все значения нули
+template<typename T>
+void packValues(const T* values, int count, QByteArray& out)
+{
+    quint32 maxValue = 0;
+    for (int i = 0; i < count; ++i) {
+        maxValue = qMax(maxValue, quint32(values[i]));
+    }
+    const int width = bitWidth(maxValue);
+    out.append(static_cast<char>(width));
+    if (width == 0) {
+        return;
+    }
+    BitWriter bits(out);
+    for (int i = 0; i < count; ++i) {
+        bits.write(values[i], width);
+    }
+    bits.finish();
+}
+
+template<typename T>
+bool unpackValues(const char* data, int size, int count, T* values)
+{
+    if (size < 1) {
+        return false;
+    }
+    const int width = static_cast<uchar>(data[0]);
+    if (width > int(sizeof(T) * 8)) {
+        return false;
+    }
+    if (width == 0) {
+        std::fill(values, values + count, T(0));
+        return size == 1;
+    }
+    BitReader bits(data + 1, size - 1);
+    for (int i = 0; i < count; ++i) {
+        values[i] = T(bits.read(width));
+    }
+    return !bits.overrun();
+}
+
+// Словарь выражений блока в порядке первого появления и номера в нем
+void encodeExpressions(const QVector<HistoryEntry>& entries, QByteArray& dictionary,
+                       QByteArray& codes)
+{
+    QHash<QString, quint32> numbers;
+    QVector<quint32> values;
+    values.reserve(entries.size());
+    QByteArray strings;
+    for (const HistoryEntry& entry : entries) {
+        auto it = numbers.constFind(entry.expression);
+        if (it == numbers.constEnd()) {
+            it = numbers.insert(entry.expression, quint32(numbers.size()));
+            const QByteArray text = entry.expression.toUtf8();
+            HistoryJournal::appendVarint(quint64(text.size()), strings);
+            strings.append(text);
+        }
+        values.append(it.value());
+    }
+    HistoryJournal::appendVarint(quint64(numbers.size()), dictionary);
+    dictionary.append(strings);
+    packValues(values.constData(), values.size(), codes);
+}
+
+bool decodeDictionary(const char* data, int size, QVector<QString>& dictionary)
+{
+    const char* pos = data;
+    const char* end = data + size;
+    quint64 count;
+    // Каждая строка занимает хотя бы байт длины
+    if (!HistoryJournal::readVarint(pos, end, count) || count > quint64(end - pos)) {
+        return false;
+    }
+    dictionary.resize(int(count));
+    for (QString& text : dictionary) {
+        quint64 length;
+        if (!HistoryJournal::readVarint(pos, end, length) || length == 0
+            || length > quint64(end - pos)) {
+            return false;
+        }
+        text = QString::fromUtf8(pos, int(length));
+        pos += length;
+    }
+    return pos == end;
+}
+
+// Строка текстового файла: результат, который выглядит ровно как записанный
+// с точностью истории, отделяется от выражения
+HistoryEntry entryFromLine(const QString& line)
+{
+    HistoryEntry entry;
+    entry.expression = line;
+    const int separator = line.lastIndexOf(" = ");
+    if (separator < 0) {
+        return entry;
+    }
+
+    const QChar* tail = line.constData() + separator + 3;
+    const QChar* end = line.constData() + line.size();
+    bool ok = false;
+    const double result = NumberParser::toDouble(tail, end, &ok);
+    if (!ok) {
+        return entry;
+    }
+    entry.result = result;
+
+    QChar buffer[NumberFormatter::BUFFER_SIZE];
+    const int length = NumberFormatter::formatGeneral(
+        result, CalculatorConfig::HISTORY_RESULT_PRECISION, buffer);
+    if (separator > 0 && length == end - tail
+        && std::equal(buffer, buffer + length, tail)) {
+        entry.expression = line.left(separator);
+        entry.resultPrecision = CalculatorConfig::HISTORY_RESULT_PRECISION;
+    }
+    return entry;
+}
+
+} // namespace
+
+HistoryEntry HistoryArchive::Block::entry(int index) const
+{
+    HistoryEntry entry;
+    entry.expression = dictionary.at(int(expressions.at(index)));
+    entry.lhs = lhs.at(index);
+    entry.rhs = rhs.at(index);
+    entry.result = results.at(index);
+    entry.timestamp = timestamps.at(index);
+    entry.operation = static_cast<CalcOperation>(operations.at(index));
+    entry.resultPrecision = precisions.at(index);
+    return entry;
+}
+
+HistoryArchive::Writer::Writer(int blockSize)
+    : m_blockSize(qMax(blockSize, 1))
+    , m_count(0)
+    , m_offset(0)
+    , m_failed(false)
+{
+}
+
+HistoryArchive::Writer::~Writer()
+{
+    if (m_file) {
+        m_file->cancelWriting();
+    }
+}
+
+bool HistoryArchive::Writer::open(const QString& filename)
+{
+    m_file.reset(new QSaveFile(filename));
+    m_pending.clear();
+    m_index.clear();
+    m_count = 0;
+    m_failed = false;
+    if (!m_file->open(QIODevice::WriteOnly)) {
+        qCWarning(lcStorage) << "Не удалось открыть архив истории для записи:" << filename;
+        m_file.reset();
+        return false;
+    }
+
+    char header[HEADER_SIZE];
+    std::memcpy(header, MAGIC, sizeof(MAGIC));
+    qToLittleEndian<quint16>(VERSION, header + 4);
+    qToLittleEndian<quint16>(0, header + 6);
+    m_failed = m_file->write(header, sizeof(header)) != qint64(sizeof(header));
+    m_offset = HEADER_SIZE;
+    m_pending.reserve(m_blockSize);
+    return !m_failed;
+}
+
+void HistoryArchive::Writer::append(const HistoryEntry& entry)
+{
+    Q_ASSERT(m_file);
+    if (entry.expression.isEmpty()) {
+        return;
+    }
+    m_pending.append(entry);
+    ++m_count;
+    if (m_pending.size() == m_blockSize) {
+        writeBlock();
+    }
+}
+
+bool HistoryArchive::Writer::commit()
+{
+    if (!m_file) {
+        return false;
+    }
+    if (!m_pending.isEmpty()) {
+        writeBlock();
+    }
+
+    char footer[FOOTER_SIZE];
+    qToLittleEndian<quint64>(quint64(m_offset), footer);
+    qToLittleEndian<quint64>(quint64(m_count), footer + 8);
+    qToLittleEndian<quint32>(quint32(m_index.size() / INDEX_ENTRY_SIZE), footer + 16);
+    qToLittleEndian<quint32>(HistoryJournal::crc32(m_index.constData(), m_index.size()),
+                             footer + 20);
+    std::memcpy(footer + 24, MAGIC, sizeof(MAGIC));
+    qToLittleEndian<quint16>(VERSION, footer + 28);
+    qToLittleEndian<quint16>(0, footer + 30);
+
+    const bool written = !m_failed
+        && m_file->write(m_index) == m_index.size()
+        && m_file->write(footer, sizeof(footer)) == qint64(sizeof(footer))
+        && m_file->commit();
+    if (!written) {
+        qCWarning(lcStorage) << "Не удалось записать архив истории:" << m_file->fileName();
+        m_file->cancelWriting();
+    }
+    m_file.reset();
+    m_pending.clear();
+    m_index.clear();
+    return written;
+}
+
+qint64 HistoryArchive::Writer::count() const
+{
+    return m_count;
+}
+
+void HistoryArchive::Writer::writeBlock()
+{
+    qint64 minTimestamp = m_pending.first().timestamp;
+    qint64 maxTimestamp = minTimestamp;
+    QVector<quint8> operations(m_pending.size());
+    QVector<quint8> precisions(m_pending.size());
+    for (int i = 0; i < m_pending.size(); ++i) {
+        const HistoryEntry& entry = m_pending.at(i);
+        minTimestamp = qMin(minTimestamp, entry.timestamp);
+        maxTimestamp = qMax(maxTimestamp, entry.timestamp);
+        operations[i] = static_cast<quint8>(entry.operation);
+        precisions[i] = entry.resultPrecision;
+    }
+
+    QByteArray columns[SLOT_COUNT];
+    encodeTimestamps(m_pending, columns[TimestampSlot]);
+    encodeDoubles(m_pending, &HistoryEntry::lhs, columns[LhsSlot]);
+    encodeDoubles(m_pending, &HistoryEntry::rhs, columns[RhsSlot]);
+    encodeDoubles(m_pending, &HistoryEntry::result, columns[ResultSlot]);
+    packValues(operations.constData(), operations.size(), columns[OperationSlot]);
+    packValues(precisions.constData(), precisions.size(), columns[PrecisionSlot]);
+    encodeExpressions(m_pending, columns[DictionarySlot], columns[ExpressionSlot]);
+
+    m_buffer.resize(BLOCK_HEADER_SIZE);
+    for (const QByteArray& column : columns) {
+        char header[COLUMN_HEADER_SIZE];
+        qToLittleEndian<quint32>(quint32(column.size()), header);
+        qToLittleEndian<quint32>(HistoryJournal::crc32(column.constData(), column.size()),
+                                 header + 4);
+        m_buffer.append(header, sizeof(header));
+        m_buffer.append(column);
+    }
+    char* header = m_buffer.data();
+    qToLittleEndian<quint32>(quint32(m_buffer.size() - BLOCK_HEADER_SIZE), header);
+    qToLittleEndian<quint32>(quint32(m_pending.size()), header + 4);
+
+    char position[INDEX_ENTRY_SIZE];
+    qToLittleEndian<quint64>(quint64(m_offset), position);
+    qToLittleEndian<quint64>(quint64(m_count - m_pending.size()), position + 8);
+    qToLittleEndian<qint64>(minTimestamp, position + 16);
+    qToLittleEndian<qint64>(maxTimestamp, position + 24);
+    m_index.append(position, sizeof(position));
+
+    if (!m_failed && m_file->write(m_buffer) != m_buffer.size()) {
+        m_failed = true;
+    }
+    m_offset += m_buffer.size();
+    m_pending.clear();
+}
+
+HistoryArchive::HistoryArchive()
+    : m_map(nullptr)
+    , m_data(nullptr)
+    , m_indexOffset(0)
+    , m_count(0)
+    , m_blockCount(0)
+    , m_currentBlock(-1)
+    , m_position(0)
+{
+}
+
+HistoryArchive::~HistoryArchive()
+{
+    close();
+}
+
+bool HistoryArchive::open(const QString& filename)
+{
+    close();
+
+    m_file.setFileName(filename);
+    if (!m_file.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+
+    const qint64 size = m_file.size();
+    m_map = size > 0 ? m_file.map(0, size) : nullptr;
+    if (m_map) {
+        if (attach(reinterpret_cast<const char*>(m_map), size)) {
+            return true;
+        }
+    } else {
+        m_copy = m_file.readAll();
+        m_file.close();
+        if (attach(m_copy.constData(), m_copy.size())) {
+            return true;
+        }
+    }
+
+    qCWarning(lcStorage) << "Файл не является архивом истории:" << filename;
+    close();
+    return false;
+}
+
+bool HistoryArchive::open(const QByteArray& data)
+{
+    close();
+    m_copy = data;
+    if (attach(m_copy.constData(), m_copy.size())) {
+        return true;
+    }
+    close();
+    return false;
+}
+
+void HistoryArchive::close()
+{
+    if (m_map) {
+        m_file.unmap(m_map);
+        m_map = nullptr;
+    }
+    m_file.close();
+    m_copy.clear();
+    m_data = nullptr;
+    m_indexOffset = 0;
+    m_count = 0;
+    m_blockCount = 0;
+    m_current = Block();
+    m_currentBlock = -1;
+    m_position = 0;
+}
+
+bool HistoryArchive::isOpen() const
+{
+    return m_data != nullptr;
+}
+
+qint64 HistoryArchive::count() const
+{
+    return m_count;
+}
+
+int HistoryArchive::blockCount() const
+{
+    return m_blockCount;
+}
+
+qint64 HistoryArchive::blockFirstEntry(int block) const
+{
+    Q_ASSERT(block >= 0 && block < m_blockCount);
+    return qint64(qFromLittleEndian<quint64>(indexEntry(block) + 8));
+}
+
+int HistoryArchive::blockOf(qint64 index) const
+{
+    Q_ASSERT(index >= 0 && index < m_count);
+    int low = 0;
+    int high = m_blockCount - 1;
+    while (low < high) {
+        const int middle = low + (high - low + 1) / 2;
+        if (blockFirstEntry(middle) <= index) {
+            low = middle;
+        } else {
+            high = middle - 1;
+        }
+    }
+    return low;
+}
+
+bool HistoryArchive::readBlock(int block, Block& out, int columns) const
+{
+    Q_ASSERT(block >= 0 && block < m_blockCount);
+    const qint64 first = blockFirstEntry(block);
+    const qint64 last = block + 1 < m_blockCount ? blockFirstEntry(block + 1) : m_count;
+    const qint64 offset = qint64(qFromLittleEndian<quint64>(indexEntry(block)));
+    const int count = int(last - first);
+
+    // Смещения и номера записей проверены в attach(), здесь - только сам блок
+    const char* header = m_data + offset;
+    const quint32 payloadSize = qFromLittleEndian<quint32>(header);
+    bool valid = payloadSize <= quint64(m_indexOffset - offset - BLOCK_HEADER_SIZE)
+        && qFromLittleEndian<quint32>(header + 4) == quint32(count)
+        // Каждая запись занимает хотя бы бит в столбцах чисел
+        && quint64(count) <= quint64(payloadSize) * 8;
+
+    const char* data[SLOT_COUNT] = {};
+    int sizes[SLOT_COUNT] = {};
+    quint32 checksums[SLOT_COUNT] = {};
+    const char* pos = header + BLOCK_HEADER_SIZE;
+    const char* end = pos + (valid ? payloadSize : 0);
+    for (int slot = 0; valid && slot < SLOT_COUNT; ++slot) {
+        if (end - pos < COLUMN_HEADER_SIZE) {
+            valid = false;
+            break;
+        }
+        const quint32 size = qFromLittleEndian<quint32>(pos);
+        checksums[slot] = qFromLittleEndian<quint32>(pos + 4);
+        pos += COLUMN_HEADER_SIZE;
+        if (size > quint64(end - pos)) {
+            valid = false;
+            break;
+        }
+        data[slot] = pos;
+        sizes[slot] = int(size);
+        pos += size;
+    }
+    // Контрольная сумма проверяется только у разбираемых столбцов
+    const auto intact = [&](int slot) {
+        return HistoryJournal::crc32(data[slot], sizes[slot]) == checksums[slot];
+    };
+
+    // Векторы сохраняют память между блоками
+    out.firstEntry = first;
+    out.count = count;
+    out.timestamps.resize((columns & Timestamps) ? count : 0);
+    out.lhs.resize((columns & Operands) ? count : 0);
+    out.rhs.resize((columns & Operands) ? count : 0);
+    out.results.resize((columns & Results) ? count : 0);
+    out.operations.resize((columns & Operations) ? count : 0);
+    out.precisions.resize((columns & Operations) ? count : 0);
+    out.expressions.resize((columns & Expressions) ? count : 0);
+    if (!(columns & Expressions)) {
+        out.dictionary.clear();
+    }
+
+    if (valid && (columns & Timestamps)) {
+        valid = intact(TimestampSlot)
+            && decodeTimestamps(data[TimestampSlot], sizes[TimestampSlot], count,
+                                out.timestamps.data());
+    }
+    if (valid && (columns & Operands)) {
+        valid = intact(LhsSlot) && intact(RhsSlot)
+            && decodeDoubles(data[LhsSlot], sizes[LhsSlot], count, out.lhs.data())
+            && decodeDoubles(data[RhsSlot], sizes[RhsSlot], count, out.rhs.data());
+    }
+    if (valid && (columns & Results)) {
+        valid = intact(ResultSlot)
+            && decodeDoubles(data[ResultSlot], sizes[ResultSlot], count, out.results.data());
+    }
+    if (valid && (columns & Operations)) {
+        valid = intact(OperationSlot) && intact(PrecisionSlot)
+            && unpackValues(data[OperationSlot], sizes[OperationSlot], count,
+                            out.operations.data())
+            && unpackValues(data[PrecisionSlot], sizes[PrecisionSlot], count,
+                            out.precisions.data());
+        for (int i = 0; valid && i < count; ++i) {
+            valid = out.operations.at(i) <= static_cast<quint8>(CalcOperation::Reciprocal)
+                && out.precisions.at(i) + 12 <= NumberFormatter::BUFFER_SIZE;
+        }
+    }
+    if (valid && (columns & Expressions)) {
+        valid = intact(DictionarySlot) && intact(ExpressionSlot)
+            && decodeDictionary(data[DictionarySlot], sizes[DictionarySlot], out.dictionary)
+            && unpackValues(data[ExpressionSlot], sizes[ExpressionSlot], count,
+                            out.expressions.data());
+        const quint32 dictionarySize = quint32(out.dictionary.size());
+        for (int i = 0; valid && i < count; ++i) {
+            valid = out.expressions.at(i) < dictionarySize;
+        }
+    }
+
+    if (!valid) {
+        qCWarning(lcStorage) << "Архив истории: поврежден блок" << block << "в" << m_file.fileName();
+        out = Block();
+        out.firstEntry = first;
+    }
+    return valid;
+}
+
+bool HistoryArchive::seek(qint64 index)
+{
+    if (index < 0 || index > m_count) {
+        return false;
+    }
+    m_position = index;
+    return true;
+}
+
+bool HistoryArchive::seekTime(qint64 timestamp)
+{
+    for (int block = 0; block < m_blockCount; ++block) {
+        // Блок целиком раньше искомого времени - его не нужно разбирать
+        if (qFromLittleEndian<qint64>(indexEntry(block) + 24) < timestamp) {
+            continue;
+        }
+        if (m_currentBlock != block) {
+            m_currentBlock = -1;
+            if (!readBlock(block, m_current)) {
+                return false;
+            }
+            m_currentBlock = block;
+        }
+        for (int i = 0; i < m_current.timestamps.size(); ++i) {
+            if (m_current.timestamps.at(i) >= timestamp) {
+                m_position = m_current.firstEntry + i;
+                return true;
+            }
+        }
+    }
+    m_position = m_count;
+    return false;
+}
+
+qint64 HistoryArchive::position() const
+{
+    return m_position;
+}
+
+bool HistoryArchive::next(HistoryEntry& entry)
+{
+    if (m_position >= m_count) {
+        return false;
+    }
+    if (m_currentBlock < 0 || m_position < m_current.firstEntry
+        || m_position >= m_current.firstEntry + m_current.count) {
+        const int block = blockOf(m_position);
+        m_currentBlock = -1;
+        if (!readBlock(block, m_current)) {
+            return false;
+        }
+        m_currentBlock = block;
+    }
+    entry = m_current.entry(int(m_position - m_current.firstEntry));
+    ++m_position;
+    return true;
+}
+
+bool HistoryArchive::isArchive(const QString& filename)
+{
+    QFile file(filename);
+    if (!file.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+    char header[HEADER_SIZE];
+    return file.read(header, HEADER_SIZE) == HEADER_SIZE
+        && std::memcmp(header, MAGIC, sizeof(MAGIC)) == 0
+        && qFromLittleEndian<quint16>(header + 4) == VERSION;
+}
+
+bool HistoryArchive::importText(const QString& textFile, const QString& archiveFile,
+                                int blockSize)
+{
+    QFile file(textFile);
+    if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) {
+        qCWarning(lcStorage) << "Не удалось открыть файл для чтения:" << textFile;
+        return false;
+    }
+    QStringList lines;
+    QTextStream in(&file);
+    while (!in.atEnd()) {
+        const QString line = in.readLine().trimmed();
+        if (!line.isEmpty()) {
+            lines.append(line);
+        }
+    }
+    file.close();
+
+    // В файле новые строки первыми, в архиве - последними
+    Writer writer(blockSize);
+    if (!writer.open(archiveFile)) {
+        return false;
+    }
+    for (int i = lines.size() - 1; i >= 0; --i) {
+        writer.append(entryFromLine(lines.at(i)));
+    }
+    return writer.commit();
+}
+
+bool HistoryArchive::exportText(const QString& archiveFile, const QString& textFile)
+{
+    HistoryArchive archive;
+    if (!archive.open(archiveFile)) {
+        return false;
+    }
+    QSaveFile file(textFile);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Text)) {
+        qCWarning(lcStorage) << "Не удалось открыть файл для записи:" << textFile;
+        return false;
+    }
+
+    // Блоки с конца: в памяти всегда только один
+    QTextStream out(&file);
+    Block block;
+    for (int i = archive.blockCount() - 1; i >= 0; --i) {
+        if (!archive.readBlock(i, block)) {
+            file.cancelWriting();
+            return false;
+        }
+        for (int row = block.count - 1; row >= 0; --row) {
+            out << block.entry(row).text() << "\n";
+        }
+    }
+    out.flush();
+    return file.commit();
+}
+
+bool HistoryArchive::attach(const char* data, qint64 size)
+{
+    if (size < HEADER_SIZE + FOOTER_SIZE || std::memcmp(data, MAGIC, sizeof(MAGIC)) != 0
+        || qFromLittleEndian<quint16>(data + 4) != VERSION) {
+        return false;
+    }
+
+    const char* footer = data + size - FOOTER_SIZE;
+    const quint64 indexOffset = qFromLittleEndian<quint64>(footer);
+    const quint64 count = qFromLittleEndian<quint64>(footer + 8);
+    const quint32 blockCount = qFromLittleEndian<quint32>(footer + 16);
+    // Хвост пишется последним: оборванный или чужой файл сюда не проходит
+    if (std::memcmp(footer + 24, MAGIC, sizeof(MAGIC)) != 0
+        || indexOffset < quint64(HEADER_SIZE) || indexOffset > quint64(size - FOOTER_SIZE)
+        || quint64(size - FOOTER_SIZE) - indexOffset != quint64(blockCount) * INDEX_ENTRY_SIZE
+        || (blockCount == 0) != (count == 0)) {
+        return false;
+    }
+    const char* index = data + indexOffset;
+    if (HistoryJournal::crc32(index, int(blockCount) * INDEX_ENTRY_SIZE)
+        != qFromLittleEndian<quint32>(footer + 20)) {
+        return false;
+    }
+
+    // Блоки идут подряд, и в каждом есть записи: дальше индексу можно доверять
+    quint64 previousOffset = 0;
+    quint64 previousFirst = 0;
+    for (quint32 block = 0; block < blockCount; ++block) {
+        const char* position = index + qint64(block) * INDEX_ENTRY_SIZE;
+        const quint64 offset = qFromLittleEndian<quint64>(position);
+        const quint64 first = qFromLittleEndian<quint64>(position + 8);
+        const bool ordered = block == 0
+            ? offset == quint64(HEADER_SIZE) && first == 0
+            : offset > previousOffset && first > previousFirst;
+        if (!ordered || offset + BLOCK_HEADER_SIZE > indexOffset || first >= count) {
+            return false;
+        }
+        previousOffset = offset;
+        previousFirst = first;
+    }
+
+    m_data = data;
+    m_indexOffset = qint64(indexOffset);
+    m_count = qint64(count);
+    m_blockCount = int(blockCount);
+    return true;
+}
+
+const char* HistoryArchive::indexEntry(int block) const
+{
+    return m_data + m_indexOffset + qint64(block) * INDEX_ENTRY_SIZE;
+}
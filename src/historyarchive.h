@@ -0,0 +1,158 @@
+#ifndef HISTORYARCHIVE_H
+#define HISTORYARCHIVE_H
+
+#include <QByteArray>
+#include <QFile>
+#include <QSaveFile>
+#include <QScopedPointer>
+#include <QString>
+#include <QVector>
+#include "calculationhistory.h"
+
+// Архив истории для долгого хранения: записи лежат блоками по столбцам.
+// Заголовок 8 байт (сигнатура, версия, резерв), затем блоки, индекс блоков и хвост
+// 32 байта: смещение индекса (quint64), число записей (quint64), число блоков (quint32),
+// CRC-32 индекса (quint32), сигнатура, версия, резерв. Числа little-endian.
+//
+// Блок: [длина нагрузки: quint32][записей: quint32], нагрузка - столбцы
+// [длина: quint32][CRC-32: quint32][данные] в порядке списка ниже:
+// - время - разность разностей соседних записей: неизменная разность - 1 бит,
+//   иначе префикс корзины и значение в 8, 16, 32 или 64 битах;
+// - lhs, rhs, результат - сжатие Gorilla: XOR с предыдущим значением, повтор - 1 бит,
+//   иначе значащие биты XOR с числом ведущих и хвостовых нулей;
+// - операция, затем точность - упакованы в минимальное для блока число бит;
+// - выражения - словарь блока (varint длина + UTF-8), затем номера в нем, упакованные в биты.
+//
+// Индекс на блок: смещение, номер первой записи, наименьшее и наибольшее время -
+// по нему seek() и seekTime() сразу переходят к нужному блоку. Файл отображается
+// в память, блок разбирается целиком за один проход по каждому столбцу, а readBlock()
+// разбирает и проверяет только запрошенные столбцы: подсчет по результатам
+// не трогает строки.
+// 0 - самая старая запись
+class HistoryArchive
+{
+public:
+    enum Column {
+        Timestamps = 0x01,
+        Operands = 0x02,
+        Results = 0x04,
+        Operations = 0x08,
+        Expressions = 0x10,
+        AllColumns = 0x1F
+    };
+
+    // Разобранные столбцы одного блока. Столбцы, не запрошенные в readBlock(), пусты
+    struct Block {
+        qint64 firstEntry = 0;
+        int count = 0;
+        QVector<qint64> timestamps;
+        QVector<double> lhs;
+        QVector<double> rhs;
+        QVector<double> results;
+        QVector<quint8> operations;
+        QVector<quint8> precisions;
+        // Строки словаря разделяются всеми записями блока с тем же выражением
+        QVector<QString> dictionary;
+        QVector<quint32> expressions;
+
+        // Требует всех столбцов
+        HistoryEntry entry(int index) const;
+    };
+
+    // Пишет архив по мере добавления записей: в памяти только текущий блок и индекс.
+    // Файл заменяется целиком при commit(), до этого прежний архив не тронут
+    class Writer
+    {
+    public:
+        explicit Writer(int blockSize = DEFAULT_BLOCK_SIZE);
+        ~Writer();
+
+    public:
+        bool open(const QString& filename);
+        // Записи - от старых к новым
+        void append(const HistoryEntry& entry);
+        // Дописывает последний блок, индекс и хвост. false - файл не записан
+        bool commit();
+        qint64 count() const;
+
+    private:
+        void writeBlock();
+
+    private:
+        const int m_blockSize;
+        QScopedPointer<QSaveFile> m_file;
+        QVector<HistoryEntry> m_pending;
+        QByteArray m_buffer;
+        QByteArray m_index;
+        qint64 m_count;
+        qint64 m_offset;
+        bool m_failed;
+    };
+
+public:
+    HistoryArchive();
+    ~HistoryArchive();
+
+public:
+    // Отображает файл в память (если не выходит - читает целиком) и проверяет индекс
+    bool open(const QString& filename);
+    bool open(const QByteArray& data);
+    void close();
+    bool isOpen() const;
+
+    qint64 count() const;
+    int blockCount() const;
+    qint64 blockFirstEntry(int block) const;
+    // Блок с записью index
+    int blockOf(qint64 index) const;
+    // false - блок поврежден; столбцы - сочетание Column
+    bool readBlock(int block, Block& out, int columns = AllColumns) const;
+
+public:
+    // Последовательное чтение: позиция - номер следующей записи для next()
+    bool seek(qint64 index);
+    // Первая по порядку запись со временем не раньше timestamp; false - такой нет
+    bool seekTime(qint64 timestamp);
+    qint64 position() const;
+    // false - записи кончились или блок поврежден
+    bool next(HistoryEntry& entry);
+
+public:
+    static bool isArchive(const QString& filename);
+    // Текстовый файл истории (новые строки первыми, как пишет saveToFile) в архив.
+    // Результат, записанный с точностью истории, отделяется от выражения,
+    // чтобы одинаковые выражения попадали в словарь
+    static bool importText(const QString& textFile, const QString& archiveFile,
+                           int blockSize = DEFAULT_BLOCK_SIZE);
+    // Архив в текстовый файл истории, новые строки первыми
+    static bool exportText(const QString& archiveFile, const QString& textFile);
+
+public:
+    static const char MAGIC[4];
+    static const quint16 VERSION = 1;
+    static const int HEADER_SIZE = 8;
+    static const int FOOTER_SIZE = 32;
+    static const int BLOCK_HEADER_SIZE = 8;
+    static const int INDEX_ENTRY_SIZE = 32;
+    static const int DEFAULT_BLOCK_SIZE = 4096;
+
+private:
+    bool attach(const char* data, qint64 size);
+    const char* indexEntry(int block) const;
+
+private:
+    QFile m_file;
+    uchar* m_map;
+    QByteArray m_copy;
+    const char* m_data;
+    qint64 m_indexOffset;
+    qint64 m_count;
+    int m_blockCount;
+
+    // Блок, из которого читает next()
+    Block m_current;
+    int m_currentBlock;
+    qint64 m_position;
+};
+
+#endif // HISTORYARCHIVE_H
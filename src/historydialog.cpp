@@ -1,5 +1,6 @@
 #include "historydialog.h"
 #include "calculationhistory.h"
+#include "historymodel.h"
 #include <QApplication>
 #include <QClipboard>
 #include <QMessageBox>
@@ -7,9 +8,12 @@
 HistoryDialog::HistoryDialog(CalculationHistory* history, QWidget *parent)
     : QDialog(parent)
     , m_history(history)
+    , m_model(new HistoryModel(history, this))
 {
     setupUi();
-    loadHistory();
+    updateCount();
+    // Список обновляется моделью построчно, здесь только счетчик и кнопка
+    connect(m_history, &CalculationHistory::historyChanged, this, &HistoryDialog::updateCount);
 }
 
 void HistoryDialog::setupUi()
@@ -22,9 +26,12 @@ void HistoryDialog::setupUi()
     m_countLabel = new QLabel(this);
     mainLayout->addWidget(m_countLabel);
     
-    m_listWidget = new QListWidget(this);
-    m_listWidget->setAlternatingRowColors(true);
-    mainLayout->addWidget(m_listWidget);
+    m_listView = new QListView(this);
+    m_listView->setModel(m_model);
+    m_listView->setUniformItemSizes(true);
+    m_listView->setAlternatingRowColors(true);
+    m_listView->setEditTriggers(QAbstractItemView::NoEditTriggers);
+    mainLayout->addWidget(m_listView);
     
     QLabel* hintLabel = new QLabel("Двойной клик - копировать в буфер обмена", this);
     hintLabel->setStyleSheet("color: gray; font-size: 10px;");
@@ -43,24 +50,14 @@ void HistoryDialog::setupUi()
     
     connect(m_clearButton, &QPushButton::clicked, this, &HistoryDialog::onClearClicked);
     connect(m_closeButton, &QPushButton::clicked, this, &HistoryDialog::onCloseClicked);
-    connect(m_listWidget, &QListWidget::itemDoubleClicked, this, &HistoryDialog::onItemDoubleClicked);
+    connect(m_listView, &QListView::doubleClicked, this, &HistoryDialog::onItemDoubleClicked);
 }
 
-void HistoryDialog::loadHistory()
+void HistoryDialog::updateCount()
 {
-    m_listWidget->clear();
-    
-    QStringList history = m_history->getAll();
-    
-    for (const QString& entry : history) {
-        m_listWidget->addItem(entry);
-    }
-    
-    m_countLabel->setText(QString("Всего записей: %1").arg(history.size()));
-    
-    if (history.isEmpty()) {
-        m_clearButton->setEnabled(false);
-    }
+    const int count = m_history->count();
+    m_countLabel->setText(QString("Всего записей: %1").arg(count));
+    m_clearButton->setEnabled(count > 0);
 }
 
 void HistoryDialog::onClearClicked()
@@ -78,7 +75,6 @@ void HistoryDialog::onClearClicked()
     
     if (msgBox.clickedButton() == yesButton) {
         m_history->clear();
-        loadHistory();
     }
 }
 
@@ -87,10 +83,10 @@ void HistoryDialog::onCloseClicked()
     accept();
 }
 
-void HistoryDialog::onItemDoubleClicked(QListWidgetItem* item)
+void HistoryDialog::onItemDoubleClicked(const QModelIndex& index)
 {
-    if (item) {
-        QString text = item->text();
+    if (index.isValid()) {
+        QString text = index.data().toString();
         QApplication::clipboard()->setText(text);
         
         QMessageBox::information(this, "Скопировано", 
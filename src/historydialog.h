@@ -2,13 +2,14 @@
 #define HISTORYDIALOG_H
 
 #include <QDialog>
-#include <QListWidget>
+#include <QListView>
 #include <QPushButton>
 #include <QVBoxLayout>
 #include <QHBoxLayout>
 #include <QLabel>
 
 class CalculationHistory;
+class HistoryModel;
 
 // Диалоговое окно для отображения истории вычислений
 class HistoryDialog : public QDialog
@@ -22,15 +23,16 @@ public:
 private slots:
     void onClearClicked();
     void onCloseClicked();
-    void onItemDoubleClicked(QListWidgetItem* item);
+    void onItemDoubleClicked(const QModelIndex& index);
+    void updateCount();
 
 private:
     void setupUi();
-    void loadHistory();
 
 private:
     CalculationHistory* m_history;
-    QListWidget* m_listWidget;
+    HistoryModel* m_model;
+    QListView* m_listView;
     QPushButton* m_clearButton;
     QPushButton* m_closeButton;
     QLabel* m_countLabel;
@@ -0,0 +1,457 @@
+#include "historyindex.h"
+#include "numberparser.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace {
+
+// Самая длинная n-грамма в индексе
+const int MAX_GRAM_LENGTH = 3;
+// Меньше этого мертвые номера не вычищаются
+const quint32 MIN_PURGE_SERIALS = 4096;
+
+quint64 gramKey(const QChar* chars, int length)
+{
+    quint64 key = quint64(length) << 48;
+    for (int i = 0; i < length; ++i) {
+        key |= quint64(chars[i].unicode()) << (16 * i);
+    }
+    return key;
+}
+
+// Биты double, упорядоченные как сами числа: у отрицательных инвертируются все,
+// у положительных - только знак
+quint64 orderedBits(double value)
+{
+    quint64 bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    return (bits >> 63) ? ~bits : bits | (quint64(1) << 63);
+}
+
+quint16 resultBucket(double value)
+{
+    return quint16(orderedBits(value) >> 48);
+}
+
+// Один из списков, которым должна принадлежать запись. Обход идет от новых записей
+// к старым, поэтому граница бинарного поиска end только сдвигается к началу
+struct Source {
+    const quint32* serials;
+    int size;
+    // Если задано - значение записи должно лежать в [low, high]
+    const double* values;
+    double low;
+    double high;
+    int end;
+
+    bool accepts(int position) const
+    {
+        return !values || (values[position] >= low && values[position] <= high);
+    }
+
+    // Первая позиция в [0, end) с номером не меньше serial. Кандидаты идут подряд,
+    // поэтому поиск галопом от end обычно затрагивает несколько соседних элементов
+    int seek(quint32 serial) const
+    {
+        int high = end;
+        int step = 1;
+        while (high - step >= 0 && serials[high - step] >= serial) {
+            high -= step;
+            step *= 2;
+        }
+        const int low = qMax(0, high - step);
+        return int(std::lower_bound(serials + low, serials + high, serial) - serials);
+    }
+};
+
+Source makeSource(const QVector<quint32>& serials, const double* values = nullptr,
+                  double low = 0.0, double high = 0.0)
+{
+    Source source;
+    source.serials = serials.constData();
+    source.size = serials.size();
+    source.values = values;
+    source.low = low;
+    source.high = high;
+    source.end = serials.size();
+    return source;
+}
+
+} // namespace
+
+bool HistoryQuery::isEmpty() const
+{
+    return text.isEmpty() && std::isnan(minResult) && std::isnan(maxResult)
+        && operation == CalcOperation::None;
+}
+
+HistoryQuery HistoryQuery::parse(const QString& text)
+{
+    HistoryQuery query;
+    const QString trimmed = text.trimmed();
+    const int separator = trimmed.indexOf("..");
+    if (separator >= 0) {
+        const QString low = trimmed.left(separator).trimmed();
+        const QString high = trimmed.mid(separator + 2).trimmed();
+        bool lowOk = true;
+        bool highOk = true;
+        const double lowValue = low.isEmpty() ? std::numeric_limits<double>::quiet_NaN()
+                                              : NumberParser::toDouble(low, &lowOk);
+        const double highValue = high.isEmpty() ? std::numeric_limits<double>::quiet_NaN()
+                                                : NumberParser::toDouble(high, &highOk);
+        if (lowOk && highOk && !(low.isEmpty() && high.isEmpty())) {
+            query.minResult = lowValue;
+            query.maxResult = highValue;
+            return query;
+        }
+    }
+    query.text = trimmed;
+    return query;
+}
+
+HistoryIndex::HistoryIndex(CalculationHistory* history, QObject* parent)
+    : QObject(parent)
+    , m_history(history)
+    , m_built(false)
+    , m_firstSerial(0)
+    , m_nextSerial(0)
+    , m_purgedSerial(0)
+{
+    connect(m_history, &CalculationHistory::entriesAdded,
+            this, &HistoryIndex::onEntriesAdded);
+    connect(m_history, &CalculationHistory::entriesEvicted,
+            this, &HistoryIndex::onEntriesEvicted);
+    connect(m_history, &CalculationHistory::historyReset,
+            this, &HistoryIndex::onHistoryReset);
+}
+
+QVector<int> HistoryIndex::search(const HistoryQuery& query, int limit)
+{
+    QVector<int> rows;
+    if (limit == 0) {
+        return rows;
+    }
+    if (!m_built) {
+        build();
+    }
+
+    QVector<Source> sources;
+    const QString text = foldCase(query.text.constData(), query.text.size());
+    if (!text.isEmpty()) {
+        // Запрос до трех символов сам является n-граммой, длиннее - набор триграмм
+        QVector<quint64> grams;
+        const int length = qMin(text.size(), MAX_GRAM_LENGTH);
+        collectGrams(text, length, length, grams);
+        for (quint64 key : grams) {
+            QHash<quint64, Postings>::const_iterator it = m_grams.constFind(key);
+            if (it == m_grams.constEnd()) {
+                return rows;
+            }
+            sources.append(makeSource(it.value()));
+        }
+    }
+
+    if (query.operation != CalcOperation::None) {
+        QHash<int, ValuePostings>::const_iterator it = m_operations.constFind(int(query.operation));
+        if (it == m_operations.constEnd()) {
+            return rows;
+        }
+        const ValuePostings& postings = it.value();
+        if (std::isnan(query.rhs)) {
+            sources.append(makeSource(postings.serials));
+        } else {
+            sources.append(makeSource(postings.serials, postings.values.constData(),
+                                      query.rhs, query.rhs));
+        }
+    }
+
+    // Корзины диапазона сливаются в один список; значения проверяются точно,
+    // поэтому крайние корзины могут выходить за границы
+    Postings inRange;
+    if (!std::isnan(query.minResult) || !std::isnan(query.maxResult)) {
+        double low = std::isnan(query.minResult) ? -std::numeric_limits<double>::infinity()
+                                                 : query.minResult;
+        double high = std::isnan(query.maxResult) ? std::numeric_limits<double>::infinity()
+                                                  : query.maxResult;
+        if (low > high) {
+            return rows;
+        }
+        // -0 и +0 равны, но лежат в разных корзинах
+        if (low == 0.0) {
+            low = -0.0;
+        }
+        if (high == 0.0) {
+            high = 0.0;
+        }
+        const quint16 lastBucket = resultBucket(high);
+        for (QMap<quint16, ValuePostings>::const_iterator it = m_results.lowerBound(resultBucket(low));
+             it != m_results.constEnd() && it.key() <= lastBucket; ++it) {
+            const ValuePostings& postings = it.value();
+            const int first = int(std::lower_bound(postings.serials.constBegin(),
+                                                   postings.serials.constEnd(), m_firstSerial)
+                                  - postings.serials.constBegin());
+            for (int i = first; i < postings.serials.size(); ++i) {
+                if (postings.values[i] >= low && postings.values[i] <= high) {
+                    inRange.append(postings.serials[i]);
+                }
+            }
+        }
+        if (inRange.isEmpty()) {
+            return rows;
+        }
+        std::sort(inRange.begin(), inRange.end());
+        sources.append(makeSource(inRange));
+    }
+
+    const int total = m_history->count();
+    if (sources.isEmpty()) {
+        const int size = limit < 0 ? total : qMin(total, limit);
+        rows.reserve(size);
+        for (int row = 0; row < size; ++row) {
+            rows.append(row);
+        }
+        return rows;
+    }
+
+    // Кандидаты перебираются по самому короткому списку, остальные проверяются поиском
+    int driver = 0;
+    for (int i = 1; i < sources.size(); ++i) {
+        if (sources[i].size < sources[driver].size) {
+            driver = i;
+        }
+    }
+    const Source& candidates = sources[driver];
+    // Триграммы не гарантируют порядок, длинная подстрока проверяется по тексту
+    const bool verify = text.size() > MAX_GRAM_LENGTH;
+
+    for (int i = candidates.size - 1; i >= 0; --i) {
+        const quint32 serial = candidates.serials[i];
+        if (serial < m_firstSerial) {
+            break;
+        }
+        if (!candidates.accepts(i)) {
+            continue;
+        }
+
+        bool matched = true;
+        for (int s = 0; s < sources.size() && matched; ++s) {
+            if (s == driver) {
+                continue;
+            }
+            Source& source = sources[s];
+            const int position = source.seek(serial);
+            matched = position < source.end && source.serials[position] == serial
+                   && source.accepts(position);
+            source.end = position;
+        }
+
+        const int row = int(m_nextSerial - 1 - serial);
+        if (!matched || row >= total
+            || (verify && !containsText(m_history->entryAt(row), text))) {
+            continue;
+        }
+        rows.append(row);
+        if (limit > 0 && rows.size() >= limit) {
+            break;
+        }
+    }
+    return rows;
+}
+
+bool HistoryIndex::isBuilt() const
+{
+    return m_built;
+}
+
+bool HistoryIndex::matches(const HistoryQuery& query, const HistoryEntry& entry)
+{
+    if (!query.text.isEmpty()
+        && !containsText(entry, foldCase(query.text.constData(), query.text.size()))) {
+        return false;
+    }
+    if (query.operation != CalcOperation::None
+        && (entry.operation != query.operation
+            || (!std::isnan(query.rhs) && entry.rhs != query.rhs))) {
+        return false;
+    }
+    // Запись без числового результата не входит ни в один диапазон
+    if (!std::isnan(query.minResult) || !std::isnan(query.maxResult)) {
+        if (std::isnan(entry.result)
+            || (!std::isnan(query.minResult) && entry.result < query.minResult)
+            || (!std::isnan(query.maxResult) && entry.result > query.maxResult)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void HistoryIndex::onEntriesAdded(int count)
+{
+    if (!m_built) {
+        return;
+    }
+    // Номера не должны переполниться: проще перестроить при следующем поиске
+    if (m_nextSerial > std::numeric_limits<quint32>::max() - quint32(count)) {
+        clearIndex();
+        return;
+    }
+    for (int i = count - 1; i >= 0; --i) {
+        insert(m_nextSerial++, m_history->entryAt(i));
+    }
+}
+
+void HistoryIndex::onEntriesEvicted(int count)
+{
+    if (!m_built) {
+        return;
+    }
+    m_firstSerial += quint32(count);
+    const quint32 live = m_nextSerial - m_firstSerial;
+    if (m_firstSerial - m_purgedSerial > qMax(live, MIN_PURGE_SERIALS)) {
+        purge();
+    }
+}
+
+void HistoryIndex::onHistoryReset()
+{
+    clearIndex();
+}
+
+void HistoryIndex::build()
+{
+    clearIndex();
+    const int total = m_history->count();
+    for (int i = total - 1; i >= 0; --i) {
+        insert(m_nextSerial++, m_history->entryAt(i));
+    }
+    m_built = true;
+}
+
+void HistoryIndex::clearIndex()
+{
+    m_built = false;
+    m_firstSerial = 0;
+    m_nextSerial = 0;
+    m_purgedSerial = 0;
+    m_grams.clear();
+    m_operations.clear();
+    m_results.clear();
+}
+
+void HistoryIndex::insert(quint32 serial, const HistoryEntry& entry)
+{
+    m_gramBuffer.clear();
+    collectGrams(foldCase(entry.expression.constData(), indexedLength(entry)),
+                 1, MAX_GRAM_LENGTH, m_gramBuffer);
+    for (quint64 key : m_gramBuffer) {
+        m_grams[key].append(serial);
+    }
+
+    if (entry.operation != CalcOperation::None) {
+        ValuePostings& postings = m_operations[int(entry.operation)];
+        postings.serials.append(serial);
+        postings.values.append(entry.rhs);
+    }
+    if (!std::isnan(entry.result)) {
+        ValuePostings& postings = m_results[resultBucket(entry.result)];
+        postings.serials.append(serial);
+        postings.values.append(entry.result);
+    }
+}
+
+void HistoryIndex::purge()
+{
+    QHash<quint64, Postings>::iterator gram = m_grams.begin();
+    while (gram != m_grams.end()) {
+        purge(gram.value(), m_firstSerial);
+        if (gram.value().isEmpty()) {
+            gram = m_grams.erase(gram);
+        } else {
+            ++gram;
+        }
+    }
+    QHash<int, ValuePostings>::iterator operation = m_operations.begin();
+    while (operation != m_operations.end()) {
+        purge(operation.value());
+        if (operation.value().serials.isEmpty()) {
+            operation = m_operations.erase(operation);
+        } else {
+            ++operation;
+        }
+    }
+    QMap<quint16, ValuePostings>::iterator bucket = m_results.begin();
+    while (bucket != m_results.end()) {
+        purge(bucket.value());
+        if (bucket.value().serials.isEmpty()) {
+            bucket = m_results.erase(bucket);
+        } else {
+            ++bucket;
+        }
+    }
+    m_purgedSerial = m_firstSerial;
+}
+
+void HistoryIndex::purge(ValuePostings& postings) const
+{
+    const int size = postings.serials.size();
+    purge(postings.serials, m_firstSerial);
+    postings.values.remove(0, size - postings.serials.size());
+}
+
+void HistoryIndex::purge(Postings& serials, quint32 firstSerial)
+{
+    const int dead = int(std::lower_bound(serials.constBegin(), serials.constEnd(), firstSerial)
+                         - serials.constBegin());
+    serials.remove(0, dead);
+}
+
+QString HistoryIndex::foldCase(const QChar* chars, int length)
+{
+    QString folded(length, Qt::Uninitialized);
+    QChar* out = folded.data();
+    for (int i = 0; i < length; ++i) {
+        out[i] = chars[i].toLower();
+    }
+    return folded;
+}
+
+int HistoryIndex::indexedLength(const HistoryEntry& entry)
+{
+    if (entry.resultPrecision != 0) {
+        return entry.expression.size();
+    }
+    // Готовая строка "5 + 3 = 8": результат ищется по числу, а не по тексту
+    const int separator = entry.expression.lastIndexOf(" = ");
+    return separator >= 0 ? separator : entry.expression.size();
+}
+
+bool HistoryIndex::containsText(const HistoryEntry& entry, const QString& text)
+{
+    const QChar* chars = entry.expression.constData();
+    const QChar* pattern = text.constData();
+    const int last = indexedLength(entry) - text.size();
+    for (int i = 0; i <= last; ++i) {
+        int matched = 0;
+        while (matched < text.size() && chars[i + matched].toLower() == pattern[matched]) {
+            ++matched;
+        }
+        if (matched == text.size()) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void HistoryIndex::collectGrams(const QString& text, int minLength, int maxLength,
+                                QVector<quint64>& grams)
+{
+    const QChar* chars = text.constData();
+    for (int length = minLength; length <= maxLength; ++length) {
+        for (int i = 0; i + length <= text.size(); ++i) {
+            grams.append(gramKey(chars + i, length));
+        }
+    }
+    std::sort(grams.begin(), grams.end());
+    grams.erase(std::unique(grams.begin(), grams.end()), grams.end());
+}
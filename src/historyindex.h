@@ -0,0 +1,104 @@
+#ifndef HISTORYINDEX_H
+#define HISTORYINDEX_H
+
+#include <QHash>
+#include <QMap>
+#include <QObject>
+#include <QVector>
+#include <limits>
+#include "calculationhistory.h"
+
+// Условия поиска по истории; запись должна подходить под все заданные условия
+struct HistoryQuery {
+    // Подстрока выражения (левой части записи) без учета регистра; пустая - любое
+    QString text;
+    // Границы результата включительно; NaN - граница не задана
+    double minResult = std::numeric_limits<double>::quiet_NaN();
+    double maxResult = std::numeric_limits<double>::quiet_NaN();
+    // None - любая операция
+    CalcOperation operation = CalcOperation::None;
+    // Правый операнд заданной операции ("деление на 12"); NaN - любой
+    double rhs = std::numeric_limits<double>::quiet_NaN();
+
+    bool isEmpty() const;
+
+    // Текст поля поиска: "a..b", "a.." или "..b" - диапазон результата,
+    // все остальное - подстрока выражения
+    static HistoryQuery parse(const QString& text);
+};
+
+// Индекс для поиска по истории. Текст выражения раскладывается на n-граммы
+// длиной 1-3 символа: запрос до трех символов - одна выборка списка, длиннее -
+// пересечение триграмм с проверкой кандидатов. Результаты разложены по корзинам
+// (знак, порядок и 4 старших бита мантиссы), операции - по спискам с правым операндом.
+//
+// Списки хранят сквозные номера записей по возрастанию. Новая запись дописывается
+// в конец списков, вытеснение только сдвигает номер самой старой живой записи,
+// а мертвые номера вычищаются разом, когда их становится больше живых.
+// Индекс строится при первом поиске, а после загрузки или очистки истории -
+// при следующем, поэтому ленивая загрузка журнала не разбирает снимок заранее
+class HistoryIndex : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit HistoryIndex(CalculationHistory* history, QObject* parent = nullptr);
+
+public:
+    // Индексы подходящих записей (0 - самая новая) по возрастанию, не больше limit
+    // (отрицательный - без ограничения)
+    QVector<int> search(const HistoryQuery& query, int limit = -1);
+    bool isBuilt() const;
+
+public:
+    // Подходит ли одна запись под query - те же условия, что в search(), но без индекса.
+    // Для проверки нескольких новых записей это дешевле повторного поиска
+    static bool matches(const HistoryQuery& query, const HistoryEntry& entry);
+
+private slots:
+    void onEntriesAdded(int count);
+    void onEntriesEvicted(int count);
+    void onHistoryReset();
+
+private:
+    typedef QVector<quint32> Postings;
+    // Номера записей и значение (операнд или результат) в параллельных массивах
+    struct ValuePostings {
+        Postings serials;
+        QVector<double> values;
+    };
+
+private:
+    void build();
+    void clearIndex();
+    void insert(quint32 serial, const HistoryEntry& entry);
+    void purge();
+    void purge(ValuePostings& postings) const;
+    static void purge(Postings& serials, quint32 firstSerial);
+
+    // Регистр сводится посимвольно, чтобы длина и позиции текста не менялись
+    static QString foldCase(const QChar* chars, int length);
+    // Длина начала expression, по которому ищется запись: выражение без результата
+    static int indexedLength(const HistoryEntry& entry);
+    // Есть ли text (уже в нижнем регистре) в искомой части записи
+    static bool containsText(const HistoryEntry& entry, const QString& text);
+    // Различные n-граммы text длиной от minLength до maxLength, отсортированные
+    static void collectGrams(const QString& text, int minLength, int maxLength,
+                             QVector<quint64>& grams);
+
+private:
+    CalculationHistory* m_history;
+    bool m_built;
+    // Самая старая живая запись и номер следующей; индекс в истории - m_nextSerial - 1 - номер
+    quint32 m_firstSerial;
+    quint32 m_nextSerial;
+    // Номера меньше этого уже вычищены из списков
+    quint32 m_purgedSerial;
+    QHash<quint64, Postings> m_grams;
+    QHash<int, ValuePostings> m_operations;
+    // Корзины упорядочены как числа, диапазон - непрерывный отрезок карты
+    QMap<quint16, ValuePostings> m_results;
+    QVector<quint64> m_gramBuffer;
+};
+
+#endif // HISTORYINDEX_H
@@ -0,0 +1,89 @@
+#include "historyitemdelegate.h"
+#include "historymodel.h"
+#include <QFontMetrics>
+#include <QPainter>
+
+namespace {
+
+// Отступы и размеры прежнего HistoryItemWidget
+const int HORIZONTAL_MARGIN = 15;
+const int VERTICAL_MARGIN = 10;
+const int LINE_SPACING = 5;
+const int ITEM_SPACING = 5;
+const int CORNER_RADIUS = 5;
+const int EXPRESSION_POINT_SIZE = 12;
+const int RESULT_POINT_SIZE = 18;
+const QColor EXPRESSION_COLOR(0x88, 0x88, 0x88);
+const QColor HOVER_COLOR(128, 128, 128, 26);
+
+} // namespace
+
+HistoryItemDelegate::HistoryItemDelegate(QObject* parent)
+    : QStyledItemDelegate(parent)
+{
+}
+
+void HistoryItemDelegate::paint(QPainter* painter, const QStyleOptionViewItem& option,
+                                const QModelIndex& index) const
+{
+    const QRect itemRect = option.rect.adjusted(0, 0, 0, -ITEM_SPACING);
+
+    painter->save();
+    if (option.state & QStyle::State_MouseOver) {
+        painter->setRenderHint(QPainter::Antialiasing);
+        painter->setPen(Qt::NoPen);
+        painter->setBrush(HOVER_COLOR);
+        painter->drawRoundedRect(itemRect, CORNER_RADIUS, CORNER_RADIUS);
+    }
+
+    const QRect content = itemRect.adjusted(HORIZONTAL_MARGIN, VERTICAL_MARGIN,
+                                            -HORIZONTAL_MARGIN, -VERTICAL_MARGIN);
+    const QFont smallFont = expressionFont(option.font);
+    const QFont largeFont = resultFont(option.font);
+    const QFontMetrics smallMetrics(smallFont);
+    const QFontMetrics largeMetrics(largeFont);
+
+    // Длинное выражение обрезается слева: важнее его конец рядом с результатом
+    const QRect expressionRect(content.left(), content.top(), content.width(),
+                               smallMetrics.height());
+    painter->setFont(smallFont);
+    painter->setPen(EXPRESSION_COLOR);
+    painter->drawText(expressionRect, Qt::AlignRight | Qt::AlignVCenter,
+                      smallMetrics.elidedText(index.data(HistoryModel::ExpressionRole).toString(),
+                                              Qt::ElideLeft, content.width()));
+
+    const QRect resultRect(content.left(), expressionRect.bottom() + 1 + LINE_SPACING,
+                           content.width(), largeMetrics.height());
+    painter->setFont(largeFont);
+    painter->setPen(option.palette.color(QPalette::Text));
+    painter->drawText(resultRect, Qt::AlignRight | Qt::AlignVCenter,
+                      largeMetrics.elidedText(index.data(HistoryModel::ResultRole).toString(),
+                                              Qt::ElideRight, content.width()));
+    painter->restore();
+}
+
+QSize HistoryItemDelegate::sizeHint(const QStyleOptionViewItem& option,
+                                    const QModelIndex& index) const
+{
+    Q_UNUSED(index);
+    // Высота не зависит от текста: при setUniformItemSizes список считает ее один раз
+    const int height = 2 * VERTICAL_MARGIN + QFontMetrics(expressionFont(option.font)).height()
+                     + LINE_SPACING + QFontMetrics(resultFont(option.font)).height()
+                     + ITEM_SPACING;
+    return QSize(option.rect.width(), height);
+}
+
+QFont HistoryItemDelegate::expressionFont(const QFont& base)
+{
+    QFont font = base;
+    font.setPointSize(EXPRESSION_POINT_SIZE);
+    return font;
+}
+
+QFont HistoryItemDelegate::resultFont(const QFont& base)
+{
+    QFont font = base;
+    font.setPointSize(RESULT_POINT_SIZE);
+    font.setBold(true);
+    return font;
+}
@@ -0,0 +1,26 @@
+#ifndef HISTORYITEMDELEGATE_H
+#define HISTORYITEMDELEGATE_H
+
+#include <QStyledItemDelegate>
+
+// Отрисовка записи истории в списке: выражение серым над крупным результатом.
+// Подсветка под курсором берется из состояния строки (State_MouseOver),
+// поэтому отдельный виджет и стиль на каждую запись не нужны
+class HistoryItemDelegate : public QStyledItemDelegate
+{
+    Q_OBJECT
+
+public:
+    explicit HistoryItemDelegate(QObject* parent = nullptr);
+
+public:
+    void paint(QPainter* painter, const QStyleOptionViewItem& option,
+               const QModelIndex& index) const override;
+    QSize sizeHint(const QStyleOptionViewItem& option, const QModelIndex& index) const override;
+
+private:
+    static QFont expressionFont(const QFont& base);
+    static QFont resultFont(const QFont& base);
+};
+
+#endif // HISTORYITEMDELEGATE_H
@@ -0,0 +1,511 @@
+#include "historyjournal.h"
+#include "calculationhistory.h"
+#include "numberformatter.h"
+#include "logcategories.h"
+#include <QElapsedTimer>
+#include <QSaveFile>
+#include <QThread>
+#include <QtEndian>
+#include <cstring>
+
+#ifdef Q_OS_WIN
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+const char HistoryJournal::MAGIC[4] = { 'C', 'H', 'J', 'L' };
+
+namespace {
+
+// Таблицы CRC-32 для отраженного полинома 0xEDB88320: values[0] - побайтовая,
+// values[k] - вклад байта, за которым идут еще k байт (восемь байт за шаг)
+struct CrcTable {
+    quint32 values[8][256];
+
+    CrcTable()
+    {
+        for (quint32 i = 0; i < 256; ++i) {
+            quint32 crc = i;
+            for (int bit = 0; bit < 8; ++bit) {
+                crc = (crc & 1) ? (crc >> 1) ^ 0xEDB88320u : crc >> 1;
+            }
+            values[0][i] = crc;
+        }
+        for (int k = 1; k < 8; ++k) {
+            for (quint32 i = 0; i < 256; ++i) {
+                values[k][i] = (values[k - 1][i] >> 8) ^ values[0][values[k - 1][i] & 0xFF];
+            }
+        }
+    }
+};
+
+const CrcTable& crcTable()
+{
+    static const CrcTable table;
+    return table;
+}
+
+void appendHeader(quint16 generation, QByteArray& out)
+{
+    char header[HistoryJournal::HEADER_SIZE];
+    std::memcpy(header, HistoryJournal::MAGIC, sizeof(HistoryJournal::MAGIC));
+    qToLittleEndian<quint16>(HistoryJournal::VERSION, header + 4);
+    qToLittleEndian<quint16>(generation, header + 6);
+    out.append(header, sizeof(header));
+}
+
+bool hasHeader(const char* data, qint64 size)
+{
+    return size >= HistoryJournal::HEADER_SIZE
+        && std::memcmp(data, HistoryJournal::MAGIC, sizeof(HistoryJournal::MAGIC)) == 0
+        && qFromLittleEndian<quint16>(data + 4) == HistoryJournal::VERSION;
+}
+
+void appendDouble(char*& pos, double value)
+{
+    quint64 bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    qToLittleEndian<quint64>(bits, pos);
+    pos += sizeof(bits);
+}
+
+double readDouble(const char*& pos)
+{
+    const quint64 bits = qFromLittleEndian<quint64>(pos);
+    pos += sizeof(bits);
+    double value;
+    std::memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+bool decodePayload(const char* payload, int size, HistoryEntry& entry)
+{
+    const char* pos = payload;
+    entry.timestamp = qFromLittleEndian<qint64>(pos);
+    pos += sizeof(qint64);
+    entry.lhs = readDouble(pos);
+    entry.rhs = readDouble(pos);
+    entry.result = readDouble(pos);
+    const quint8 operation = static_cast<quint8>(*pos++);
+    if (operation > static_cast<quint8>(CalcOperation::Reciprocal)) {
+        return false;
+    }
+    entry.operation = static_cast<CalcOperation>(operation);
+    entry.resultPrecision = static_cast<quint8>(*pos++);
+    if (entry.resultPrecision + 12 > NumberFormatter::BUFFER_SIZE) {
+        return false;
+    }
+    entry.expression = QString::fromUtf8(pos, size - HistoryJournal::FIXED_PAYLOAD_SIZE);
+    return !entry.expression.isEmpty();
+}
+
+} // namespace
+
+// Фоновый поток записи: весь ввод-вывод журнала после open() идет в нем
+class HistoryJournal::Writer : public QThread
+{
+public:
+    explicit Writer(HistoryJournal* journal)
+        : m_journal(journal)
+    {
+    }
+
+protected:
+    void run() override
+    {
+        m_journal->writerLoop();
+    }
+
+private:
+    HistoryJournal* m_journal;
+};
+
+HistoryJournal::HistoryJournal()
+    : m_hasSnapshot(false)
+    , m_generation(0)
+    , m_snapshotGeneration(0)
+    , m_stopping(false)
+    , m_requested(0)
+    , m_completed(0)
+{
+}
+
+HistoryJournal::~HistoryJournal()
+{
+    close();
+}
+
+bool HistoryJournal::open(const QString& filename, const Options& options)
+{
+    close();
+
+    m_file.setFileName(filename);
+    if (!m_file.open(QIODevice::ReadWrite)) {
+        qCWarning(lcStorage) << "Не удалось открыть журнал истории:" << filename;
+        return false;
+    }
+
+    if (m_file.size() == 0) {
+        m_generation = 0;
+        QByteArray header;
+        appendHeader(m_generation, header);
+        m_file.write(header);
+        m_file.flush();
+    } else {
+        char header[HEADER_SIZE];
+        if (m_file.read(header, HEADER_SIZE) != HEADER_SIZE || !hasHeader(header, HEADER_SIZE)) {
+            qCWarning(lcStorage) << "Файл не является журналом истории:" << filename;
+            m_file.close();
+            return false;
+        }
+        m_generation = qFromLittleEndian<quint16>(header + 6);
+    }
+    m_file.seek(m_file.size());
+
+    m_options = options;
+    m_writer.reset(new Writer(this));
+    m_writer->start();
+    return true;
+}
+
+void HistoryJournal::close()
+{
+    if (!m_writer) {
+        return;
+    }
+
+    {
+        QMutexLocker locker(&m_mutex);
+        m_stopping = true;
+        m_wakeUp.wakeOne();
+    }
+    m_writer->wait();
+    m_writer.reset();
+    m_file.close();
+
+    m_pending.clear();
+    m_snapshot.clear();
+    m_hasSnapshot = false;
+    m_stopping = false;
+}
+
+bool HistoryJournal::isOpen() const
+{
+    return !m_writer.isNull();
+}
+
+QString HistoryJournal::fileName() const
+{
+    return m_file.fileName();
+}
+
+void HistoryJournal::append(const HistoryEntry& entry)
+{
+    if (!m_writer) {
+        return;
+    }
+
+    QMutexLocker locker(&m_mutex);
+    appendFrame(entry, m_pending);
+}
+
+void HistoryJournal::compact(const QByteArray& snapshot)
+{
+    if (!m_writer) {
+        return;
+    }
+
+    // Поколение выдается сразу: следующее сжатие получит новое, даже если
+    // этот снимок еще не записан. Журнал переходит на него только вместе со снимком
+    QMutexLocker locker(&m_mutex);
+    m_snapshot = snapshot;
+    m_hasSnapshot = true;
+    m_snapshotGeneration = ++m_generation;
+    m_pending.clear();
+    m_wakeUp.wakeOne();
+}
+
+void HistoryJournal::flush()
+{
+    if (!m_writer) {
+        return;
+    }
+
+    QMutexLocker locker(&m_mutex);
+    const quint64 target = ++m_requested;
+    m_wakeUp.wakeOne();
+    while (m_completed < target) {
+        m_done.wait(&m_mutex);
+    }
+}
+
+quint16 HistoryJournal::generation() const
+{
+    return m_generation;
+}
+
+bool HistoryJournal::isJournal(const QString& filename)
+{
+    QFile file(filename);
+    if (!file.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+    char header[HEADER_SIZE];
+    return file.read(header, HEADER_SIZE) == HEADER_SIZE && hasHeader(header, HEADER_SIZE);
+}
+
+QString HistoryJournal::snapshotFileName(const QString& journalFileName)
+{
+    return journalFileName + ".snapshot";
+}
+
+bool HistoryJournal::replay(const QString& filename, RingBuffer<HistoryEntry>& entries,
+                            int* recordCount, quint16* generation)
+{
+    QFile file(filename);
+    const bool writable = file.open(QIODevice::ReadWrite);
+    if (!writable && !file.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+
+    const QByteArray data = file.readAll();
+    if (!hasHeader(data.constData(), data.size())) {
+        return false;
+    }
+
+    const char* begin = data.constData();
+    qint64 offset = HEADER_SIZE;
+    int records = 0;
+    for (;;) {
+        HistoryEntry entry;
+        const qint64 frameSize = decodeFrame(begin + offset, data.size() - offset, entry);
+        if (frameSize == 0) {
+            break;
+        }
+        entries.append(entry);
+        ++records;
+        offset += frameSize;
+    }
+
+    // Запись, прерванная сбоем, оставляет оборванный кадр - он и все после него отбрасываются
+    if (offset < data.size()) {
+        qCWarning(lcStorage) << "Журнал истории: отброшен поврежденный хвост"
+                 << data.size() - offset << "байт в" << filename;
+        if (writable) {
+            file.resize(offset);
+        }
+    }
+
+    if (recordCount) {
+        *recordCount = records;
+    }
+    if (generation) {
+        *generation = qFromLittleEndian<quint16>(begin + 6);
+    }
+    return true;
+}
+
+quint32 HistoryJournal::crc32(const char* data, int size)
+{
+    const quint32 (*table)[256] = crcTable().values;
+    const uchar* bytes = reinterpret_cast<const uchar*>(data);
+    quint32 crc = 0xFFFFFFFFu;
+    int i = 0;
+    for (; i + 8 <= size; i += 8) {
+        const quint32 low = crc ^ qFromLittleEndian<quint32>(bytes + i);
+        const quint32 high = qFromLittleEndian<quint32>(bytes + i + 4);
+        crc = table[7][low & 0xFF] ^ table[6][(low >> 8) & 0xFF]
+            ^ table[5][(low >> 16) & 0xFF] ^ table[4][low >> 24]
+            ^ table[3][high & 0xFF] ^ table[2][(high >> 8) & 0xFF]
+            ^ table[1][(high >> 16) & 0xFF] ^ table[0][high >> 24];
+    }
+    for (; i < size; ++i) {
+        crc = table[0][(crc ^ bytes[i]) & 0xFF] ^ (crc >> 8);
+    }
+    return crc ^ 0xFFFFFFFFu;
+}
+
+void HistoryJournal::appendVarint(quint64 value, QByteArray& out)
+{
+    char bytes[10];
+    int length = 0;
+    while (value >= 0x80) {
+        bytes[length++] = static_cast<char>((value & 0x7F) | 0x80);
+        value >>= 7;
+    }
+    bytes[length++] = static_cast<char>(value);
+    out.append(bytes, length);
+}
+
+bool HistoryJournal::readVarint(const char*& pos, const char* end, quint64& value)
+{
+    value = 0;
+    for (int shift = 0; shift < 64 && pos < end; shift += 7) {
+        const uchar byte = static_cast<uchar>(*pos++);
+        value |= quint64(byte & 0x7F) << shift;
+        if (!(byte & 0x80)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void HistoryJournal::appendFrame(const HistoryEntry& entry, QByteArray& out)
+{
+    const QByteArray expression = entry.expression.toUtf8();
+    const int length = FIXED_PAYLOAD_SIZE + expression.size();
+
+    const int start = out.size();
+    out.resize(start + FRAME_HEADER_SIZE + length);
+    char* frame = out.data() + start;
+    char* pos = frame + FRAME_HEADER_SIZE;
+
+    qToLittleEndian<qint64>(entry.timestamp, pos);
+    pos += sizeof(qint64);
+    appendDouble(pos, entry.lhs);
+    appendDouble(pos, entry.rhs);
+    appendDouble(pos, entry.result);
+    *pos++ = static_cast<char>(entry.operation);
+    *pos++ = static_cast<char>(entry.resultPrecision);
+    std::memcpy(pos, expression.constData(), expression.size());
+
+    qToLittleEndian<quint32>(quint32(length), frame);
+    qToLittleEndian<quint32>(crc32(frame + FRAME_HEADER_SIZE, length), frame + 4);
+}
+
+qint64 HistoryJournal::decodeFrame(const char* data, qint64 available, HistoryEntry& entry)
+{
+    if (available < FRAME_HEADER_SIZE) {
+        return 0;
+    }
+    const quint32 length = qFromLittleEndian<quint32>(data);
+    const quint32 checksum = qFromLittleEndian<quint32>(data + 4);
+    if (length < quint32(FIXED_PAYLOAD_SIZE) || length > quint32(MAX_PAYLOAD_SIZE)
+        || length > quint64(available - FRAME_HEADER_SIZE)) {
+        return 0;
+    }
+
+    const char* payload = data + FRAME_HEADER_SIZE;
+    if (crc32(payload, int(length)) != checksum || !decodePayload(payload, int(length), entry)) {
+        return 0;
+    }
+    return FRAME_HEADER_SIZE + qint64(length);
+}
+
+void HistoryJournal::writerLoop()
+{
+    QElapsedTimer sinceSync;
+    sinceSync.start();
+    bool unsynced = false;
+    bool failed = false;
+
+    QMutexLocker locker(&m_mutex);
+    for (;;) {
+        // После неудачной записи повтор не раньше, чем через flushInterval
+        if (!m_stopping && (failed || (!m_hasSnapshot && m_requested == m_completed))) {
+            m_wakeUp.wait(&m_mutex, m_options.flushInterval);
+        }
+
+        QByteArray batch;
+        batch.swap(m_pending);
+        QByteArray snapshot;
+        snapshot.swap(m_snapshot);
+        const quint16 generation = m_snapshotGeneration;
+        const bool hasSnapshot = m_hasSnapshot;
+        m_hasSnapshot = false;
+        const quint64 requested = m_requested;
+        const bool forced = m_stopping || requested != m_completed;
+        const bool stopping = m_stopping;
+        locker.unlock();
+
+        bool written = true;
+        if (hasSnapshot || !batch.isEmpty()) {
+            written = writeBatch(snapshot, hasSnapshot, generation, batch);
+            unsynced = true;
+        }
+        if (unsynced && (forced || sinceSync.elapsed() >= m_options.syncInterval)) {
+            syncFile(m_file);
+            unsynced = false;
+            sinceSync.restart();
+        }
+
+        locker.relock();
+        failed = !written;
+        // Снимок и кадры остаются в очереди, пока снимок и заголовок журнала не записаны
+        // вместе. Если за это время пришло новое сжатие, его снимок уже включает их
+        if (failed && !m_hasSnapshot) {
+            if (hasSnapshot) {
+                m_snapshot.swap(snapshot);
+                m_snapshotGeneration = generation;
+                m_hasSnapshot = true;
+            }
+            batch.append(m_pending);
+            m_pending.swap(batch);
+        }
+        m_completed = requested;
+        m_done.wakeAll();
+        if (stopping) {
+            if (failed) {
+                qCWarning(lcStorage) << "Журнал истории закрыт, последние записи не сохранены:"
+                                     << m_file.fileName();
+            }
+            return;
+        }
+    }
+}
+
+bool HistoryJournal::writeBatch(const QByteArray& snapshot, bool hasSnapshot,
+                                quint16 generation, const QByteArray& batch)
+{
+    if (hasSnapshot) {
+        // Сначала снимок с новым поколением, потом пустой журнал того же поколения.
+        // Сбой между шагами оставит журнал старого поколения - его записи уже в снимке
+        const QString filename = m_file.fileName();
+        QSaveFile file(snapshotFileName(filename));
+        if (!file.open(QIODevice::WriteOnly) || file.write(snapshot) != snapshot.size()
+            || !file.commit()) {
+            qCWarning(lcStorage) << "Не удалось записать снимок истории:" << file.fileName();
+            return false;
+        }
+
+        QByteArray header;
+        appendHeader(generation, header);
+        if (!m_file.isOpen() && !m_file.open(QIODevice::ReadWrite)) {
+            qCWarning(lcStorage) << "Не удалось переоткрыть журнал истории:" << filename;
+            return false;
+        }
+        if (!m_file.resize(0) || !m_file.seek(0) || m_file.write(header) != header.size()) {
+            qCWarning(lcStorage) << "Не удалось сжать журнал истории:" << filename;
+            return false;
+        }
+    }
+
+    if (!batch.isEmpty()) {
+        if (!m_file.isOpen()) {
+            qCWarning(lcStorage) << "Не удалось дописать журнал истории:" << m_file.fileName();
+            return false;
+        }
+        const qint64 end = m_file.pos();
+        if (m_file.write(batch) != batch.size() || !m_file.flush()) {
+            qCWarning(lcStorage) << "Не удалось дописать журнал истории:" << m_file.fileName();
+            // Часть кадров могла попасть в файл: повтор допишет пачку с того же места
+            m_file.resize(end);
+            m_file.seek(end);
+            return false;
+        }
+    }
+    return m_file.flush();
+}
+
+bool HistoryJournal::syncFile(QFile& file)
+{
+    if (!file.isOpen()) {
+        return false;
+    }
+#ifdef Q_OS_WIN
+    return _commit(file.handle()) == 0;
+#else
+    return ::fsync(file.handle()) == 0;
+#endif
+}
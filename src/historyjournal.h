@@ -0,0 +1,120 @@
+#ifndef HISTORYJOURNAL_H
+#define HISTORYJOURNAL_H
+
+#include <QByteArray>
+#include <QFile>
+#include <QMutex>
+#include <QScopedPointer>
+#include <QString>
+#include <QWaitCondition>
+
+struct HistoryEntry;
+template<typename T> class RingBuffer;
+
+// Журнал истории только на дописывание. После 8-байтового заголовка (сигнатура, версия,
+// поколение) идут кадры [длина нагрузки: quint32][CRC-32 нагрузки: quint32][нагрузка],
+// числа little-endian. Нагрузка: время (qint64), lhs, rhs, result (double),
+// операция и точность (quint8), затем текст выражения в UTF-8.
+//
+// append() только кодирует запись в буфер; в файл буфер уходит пачками из фонового
+// потока раз в flushInterval, fsync - не чаще раза в syncInterval. Поэтому поток
+// вызывающей стороны на диске не блокируется, а сбой теряет не больше одного интервала.
+//
+// Сжатие переносит все живые записи в снимок (HistorySnapshot) рядом с журналом
+// и начинает журнал заново со следующим поколением. Журнал, чье поколение
+// не совпадает со снимком, остался от прерванного сжатия и уже вошел в снимок.
+class HistoryJournal
+{
+public:
+    struct Options {
+        Options() : flushInterval(200), syncInterval(1000) {}
+
+        // Период записи накопленных кадров в файл, мс
+        int flushInterval;
+        // Период fsync, мс; 0 - после каждой пачки
+        int syncInterval;
+    };
+
+public:
+    HistoryJournal();
+    // Дописывает буфер и синхронизирует файл
+    ~HistoryJournal();
+
+public:
+    // Открывает файл для дописывания, при отсутствии создает пустой журнал.
+    // Содержимое не читается - для восстановления есть replay()
+    bool open(const QString& filename, const Options& options = Options());
+    void close();
+    bool isOpen() const;
+    QString fileName() const;
+
+    void append(const HistoryEntry& entry);
+    // Записывает снимок (HistorySnapshot::serialize с поколением generation() + 1)
+    // и очищает журнал. Кадры, добавленные раньше, в журнал уже не попадут -
+    // они должны входить в снимок. Вся запись - в фоновом потоке
+    void compact(const QByteArray& snapshot);
+    // Синхронно дописывает буфер и вызывает fsync
+    void flush();
+    // Поколение журнала; меняется при каждом сжатии
+    quint16 generation() const;
+
+public:
+    static bool isJournal(const QString& filename);
+    // Снимок, который сжатие пишет рядом с журналом
+    static QString snapshotFileName(const QString& journalFileName);
+    // Читает все целые кадры в entries; оборванный или поврежденный хвост отрезается
+    // от файла. false - файл не открывается или это не журнал
+    static bool replay(const QString& filename, RingBuffer<HistoryEntry>& entries,
+                       int* recordCount = nullptr, quint16* generation = nullptr);
+
+public:
+    // CRC-32 (IEEE 802.3, как в zlib)
+    static quint32 crc32(const char* data, int size);
+    // Беззнаковое целое LEB128: по 7 бит в байте, младшие первыми
+    static void appendVarint(quint64 value, QByteArray& out);
+    // false - число оборвано концом данных или длиннее 64 бит
+    static bool readVarint(const char*& pos, const char* end, quint64& value);
+    static void appendFrame(const HistoryEntry& entry, QByteArray& out);
+    // Разбирает кадр в начале data. Возвращает размер кадра или 0,
+    // если кадр оборван, поврежден или не помещается в available байт
+    static qint64 decodeFrame(const char* data, qint64 available, HistoryEntry& entry);
+
+public:
+    static const char MAGIC[4];
+    static const quint16 VERSION = 1;
+    static const int HEADER_SIZE = 8;
+    static const int FRAME_HEADER_SIZE = 8;
+    static const int FIXED_PAYLOAD_SIZE = 34;
+    // Кадр длиннее - признак повреждения, а не настоящая запись
+    static const int MAX_PAYLOAD_SIZE = 1 << 20;
+
+private:
+    class Writer;
+    friend class Writer;
+
+    void writerLoop();
+    bool writeBatch(const QByteArray& snapshot, bool hasSnapshot, quint16 generation,
+                    const QByteArray& batch);
+    static bool syncFile(QFile& file);
+
+private:
+    QFile m_file;
+    Options m_options;
+    QScopedPointer<Writer> m_writer;
+
+    // Состояние, общее с фоновым потоком
+    QMutex m_mutex;
+    QWaitCondition m_wakeUp;
+    QWaitCondition m_done;
+    QByteArray m_pending;
+    QByteArray m_snapshot;
+    bool m_hasSnapshot;
+    // Последнее выданное поколение и поколение заголовка, который пишется со снимком
+    quint16 m_generation;
+    quint16 m_snapshotGeneration;
+    bool m_stopping;
+    quint64 m_requested;
+    quint64 m_completed;
+};
+
+#endif // HISTORYJOURNAL_H
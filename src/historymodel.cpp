@@ -0,0 +1,187 @@
+#include "historymodel.h"
+#include "numberformatter.h"
+#include <algorithm>
+
+HistoryModel::HistoryModel(CalculationHistory* history, QObject* parent)
+    : QAbstractListModel(parent)
+    , m_history(history)
+    , m_rowCount(history->count())
+    , m_filtered(false)
+    , m_historyCount(history->count())
+    , m_cachedRow(-1)
+{
+    connect(m_history, &CalculationHistory::entriesAdded,
+            this, &HistoryModel::onEntriesAdded);
+    connect(m_history, &CalculationHistory::entriesEvicted,
+            this, &HistoryModel::onEntriesEvicted);
+    connect(m_history, &CalculationHistory::historyReset,
+            this, &HistoryModel::onHistoryReset);
+}
+
+int HistoryModel::rowCount(const QModelIndex& parent) const
+{
+    if (parent.isValid()) {
+        return 0;
+    }
+    return m_rowCount;
+}
+
+QVariant HistoryModel::data(const QModelIndex& index, int role) const
+{
+    if (!index.isValid() || index.row() >= m_rowCount) {
+        return QVariant();
+    }
+
+    const HistoryEntry& entry = entryAt(index.row());
+    switch (role) {
+    case Qt::DisplayRole:
+        return entry.text();
+    case ExpressionRole:
+    case ResultRole: {
+        QString expression, result;
+        if (entry.resultPrecision == 0) {
+            splitText(entry.expression, expression, result);
+        } else if (role == ResultRole) {
+            QChar buffer[NumberFormatter::BUFFER_SIZE];
+            const int length = NumberFormatter::formatGeneral(entry.result, entry.resultPrecision,
+                                                              buffer);
+            result = QString(buffer, length);
+        } else {
+            expression = entry.expression;
+        }
+        return role == ExpressionRole ? expression : result;
+    }
+    case TimestampRole:
+        return entry.timestamp;
+    default:
+        return QVariant();
+    }
+}
+
+QHash<int, QByteArray> HistoryModel::roleNames() const
+{
+    QHash<int, QByteArray> names = QAbstractListModel::roleNames();
+    names.insert(ExpressionRole, "expression");
+    names.insert(ResultRole, "result");
+    names.insert(TimestampRole, "timestamp");
+    return names;
+}
+
+void HistoryModel::setFilter(const QVector<int>& rows)
+{
+    beginResetModel();
+    m_filtered = true;
+    m_rows = rows;
+    m_rowCount = m_rows.size();
+    m_cachedRow = -1;
+    endResetModel();
+}
+
+void HistoryModel::insertFilterRows(const QVector<int>& rows, int limit)
+{
+    if (!m_filtered) {
+        return;
+    }
+    if (!rows.isEmpty()) {
+        beginInsertRows(QModelIndex(), 0, rows.size() - 1);
+        QVector<int> merged;
+        merged.reserve(rows.size() + m_rows.size());
+        merged += rows;
+        merged += m_rows;
+        m_rows.swap(merged);
+        m_rowCount = m_rows.size();
+        m_cachedRow = -1;
+        endInsertRows();
+    }
+    if (limit >= 0 && m_rows.size() > limit) {
+        beginRemoveRows(QModelIndex(), limit, m_rows.size() - 1);
+        m_rows.resize(limit);
+        m_rowCount = limit;
+        m_cachedRow = -1;
+        endRemoveRows();
+    }
+}
+
+void HistoryModel::clearFilter()
+{
+    beginResetModel();
+    m_filtered = false;
+    m_rows.clear();
+    m_rowCount = m_history->count();
+    m_cachedRow = -1;
+    endResetModel();
+}
+
+bool HistoryModel::isFiltered() const
+{
+    return m_filtered;
+}
+
+void HistoryModel::splitText(const QString& text, QString& expression, QString& result)
+{
+    // Формат: "5 + 3 = 8" или "√(16) = 4"
+    const int equalPos = text.lastIndexOf(" = ");
+    if (equalPos != -1) {
+        expression = text.left(equalPos);
+        result = text.mid(equalPos + 3);
+    } else {
+        expression = text;
+        result.clear();
+    }
+}
+
+void HistoryModel::onEntriesAdded(int count)
+{
+    m_historyCount += count;
+    if (m_filtered) {
+        // Строки показывают те же записи, меняются только их индексы в истории
+        for (int& row : m_rows) {
+            row += count;
+        }
+        return;
+    }
+    beginInsertRows(QModelIndex(), 0, count - 1);
+    m_rowCount += count;
+    m_cachedRow = -1;
+    endInsertRows();
+}
+
+void HistoryModel::onEntriesEvicted(int count)
+{
+    m_historyCount -= count;
+    if (m_filtered) {
+        const int kept = int(std::lower_bound(m_rows.constBegin(), m_rows.constEnd(),
+                                              m_historyCount) - m_rows.constBegin());
+        if (kept < m_rows.size()) {
+            beginRemoveRows(QModelIndex(), kept, m_rows.size() - 1);
+            m_rows.resize(kept);
+            m_rowCount = kept;
+            m_cachedRow = -1;
+            endRemoveRows();
+        }
+        return;
+    }
+    beginRemoveRows(QModelIndex(), m_rowCount - count, m_rowCount - 1);
+    m_rowCount -= count;
+    m_cachedRow = -1;
+    endRemoveRows();
+}
+
+void HistoryModel::onHistoryReset()
+{
+    beginResetModel();
+    m_rows.clear();
+    m_historyCount = m_history->count();
+    m_rowCount = m_filtered ? 0 : m_historyCount;
+    m_cachedRow = -1;
+    endResetModel();
+}
+
+const HistoryEntry& HistoryModel::entryAt(int row) const
+{
+    if (row != m_cachedRow) {
+        m_cachedEntry = m_history->entryAt(m_filtered ? m_rows.at(row) : row);
+        m_cachedRow = row;
+    }
+    return m_cachedEntry;
+}
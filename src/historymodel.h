@@ -0,0 +1,74 @@
+#ifndef HISTORYMODEL_H
+#define HISTORYMODEL_H
+
+#include <QAbstractListModel>
+#include <QVector>
+#include "calculationhistory.h"
+
+// Модель истории для представлений: строка 0 - самая новая запись.
+// Строки не копируются в модель, а читаются из CalculationHistory по запросу,
+// поэтому представление с делегатом обращается только к видимым строкам.
+// Изменения истории приходят как вставка сверху и удаление снизу, без сброса модели
+class HistoryModel : public QAbstractListModel
+{
+    Q_OBJECT
+
+public:
+    enum Roles {
+        // Левая часть записи: "5 + 3"
+        ExpressionRole = Qt::UserRole + 1,
+        // Результат текстом: "8"
+        ResultRole,
+        // Время записи, мс с начала эпохи UTC
+        TimestampRole
+    };
+
+public:
+    explicit HistoryModel(CalculationHistory* history, QObject* parent = nullptr);
+
+public:
+    int rowCount(const QModelIndex& parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex& index, int role = Qt::DisplayRole) const override;
+    QHash<int, QByteArray> roleNames() const override;
+
+public:
+    // Показывать только записи rows - индексы истории по возрастанию, например
+    // из HistoryIndex::search(). Пока фильтр задан, новые записи в модель сами не попадают:
+    // строки сдвигаются вслед за историей, а вытесненные удаляются
+    void setFilter(const QVector<int>& rows);
+    // Добавляет в начало фильтра подошедшие новые записи rows (индексы по возрастанию,
+    // новее уже показанных) вставкой строк, без сброса модели. Строки сверх limit
+    // (отрицательный - без ограничения) удаляются снизу
+    void insertFilterRows(const QVector<int>& rows, int limit = -1);
+    void clearFilter();
+    bool isFiltered() const;
+
+public:
+    // "5 + 3 = 8" -> "5 + 3" и "8"; без " = " вся строка - выражение
+    static void splitText(const QString& text, QString& expression, QString& result);
+
+private slots:
+    void onEntriesAdded(int count);
+    void onEntriesEvicted(int count);
+    void onHistoryReset();
+
+private:
+    const HistoryEntry& entryAt(int row) const;
+
+private:
+    CalculationHistory* m_history;
+    // Число строк, о котором знает представление. История меняется раньше,
+    // чем приходит сигнал, поэтому между begin*Rows и end*Rows модель
+    // отвечает прежним числом строк, а не count() истории
+    int m_rowCount;
+    bool m_filtered;
+    QVector<int> m_rows;
+    // Записей в истории по уже полученным сигналам: индексы m_rows отсчитываются от нее
+    int m_historyCount;
+    // Делегат запрашивает несколько ролей одной строки подряд: последняя
+    // строка кэшируется, чтобы запись из снимка не декодировалась на каждую роль
+    mutable int m_cachedRow;
+    mutable HistoryEntry m_cachedEntry;
+};
+
+#endif // HISTORYMODEL_H
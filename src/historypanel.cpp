@@ -1,63 +1,33 @@
 #include "historypanel.h"
+#include "calculatorconfig.h"
+#include "historyindex.h"
+#include "historyitemdelegate.h"
+#include "historymodel.h"
+#include "tracer.h"
 #include <QMessageBox>
-#include <QMouseEvent>
 #include <QApplication>
 #include <QClipboard>
 
-// HistoryItemWidget - виджет для одной записи
-HistoryItemWidget::HistoryItemWidget(const QString& expression, const QString& result, QWidget* parent)
-    : QWidget(parent)
-{
-    QVBoxLayout* layout = new QVBoxLayout(this);
-    layout->setContentsMargins(15, 10, 15, 10);
-    layout->setSpacing(5);
-    
-    m_expressionLabel = new QLabel(expression, this);
-    m_expressionLabel->setAlignment(Qt::AlignRight);
-    m_expressionLabel->setStyleSheet("color: #888; font-size: 12pt;");
-    
-    m_resultLabel = new QLabel(result, this);
-    m_resultLabel->setAlignment(Qt::AlignRight);
-    m_resultLabel->setStyleSheet("font-size: 18pt; font-weight: bold;");
-    
-    layout->addWidget(m_expressionLabel);
-    layout->addWidget(m_resultLabel);
-    
-    setCursor(Qt::PointingHandCursor);
-    setStyleSheet("HistoryItemWidget { background-color: transparent; border-radius: 5px; }");
-}
-
-void HistoryItemWidget::mousePressEvent(QMouseEvent* event)
-{
-    if (event->button() == Qt::LeftButton) {
-        emit clicked();
-    }
-    QWidget::mousePressEvent(event);
-}
-
-void HistoryItemWidget::enterEvent(QEvent* event)
-{
-    setStyleSheet("HistoryItemWidget { background-color: rgba(128, 128, 128, 0.1); border-radius: 5px; }");
-    QWidget::enterEvent(event);
-}
-
-void HistoryItemWidget::leaveEvent(QEvent* event)
-{
-    setStyleSheet("HistoryItemWidget { background-color: transparent; border-radius: 5px; }");
-    QWidget::leaveEvent(event);
-}
-
 // HistoryPanel - боковая панель
 HistoryPanel::HistoryPanel(CalculationHistory* history, QWidget* parent)
     : QWidget(parent)
     , m_history(history)
+    , m_model(new HistoryModel(history, this))
+    , m_index(new HistoryIndex(history, this))
     , m_isVisible(false)
+    , m_searchStale(false)
 {
     setupUi();
     setFixedWidth(300);
     hide();
     
-    // Автоматически обновлять панель при изменении истории
+    // Строки обновляет модель, панели остается переключать надпись "Пусто"
+    // и дополнять найденное. Модель подключена раньше: к сигналу панели
+    // ее строки уже сдвинуты
+    connect(m_history, &CalculationHistory::entriesAdded,
+            this, &HistoryPanel::onEntriesAdded);
+    connect(m_history, &CalculationHistory::historyReset,
+            this, &HistoryPanel::onHistoryReset);
     connect(m_history, &CalculationHistory::historyChanged,
             this, &HistoryPanel::updateHistory);
 }
@@ -73,20 +43,27 @@ void HistoryPanel::setupUi()
     m_titleLabel->setStyleSheet("font-size: 16pt; font-weight: bold;");
     m_mainLayout->addWidget(m_titleLabel);
     
-    // Область прокрутки
-    m_scrollArea = new QScrollArea(this);
-    m_scrollArea->setWidgetResizable(true);
-    m_scrollArea->setHorizontalScrollBarPolicy(Qt::ScrollBarAlwaysOff);
-    m_scrollArea->setFrameShape(QFrame::NoFrame);
-    
-    m_scrollContent = new QWidget();
-    m_scrollLayout = new QVBoxLayout(m_scrollContent);
-    m_scrollLayout->setContentsMargins(0, 0, 0, 0);
-    m_scrollLayout->setSpacing(5);
-    m_scrollLayout->addStretch();
-    
-    m_scrollArea->setWidget(m_scrollContent);
-    m_mainLayout->addWidget(m_scrollArea);
+    // Поиск: подстрока выражения или диапазон результата
+    m_searchEdit = new QLineEdit(this);
+    m_searchEdit->setPlaceholderText("Поиск: √, ÷ 12, 1e6..2e6");
+    m_searchEdit->setClearButtonEnabled(true);
+    m_mainLayout->addWidget(m_searchEdit);
+    
+    // Список записей: новые сверху, высота строк одинакова
+    m_listView = new QListView(this);
+    m_listView->setModel(m_model);
+    m_listView->setItemDelegate(new HistoryItemDelegate(m_listView));
+    m_listView->setUniformItemSizes(true);
+    m_listView->setSelectionMode(QAbstractItemView::NoSelection);
+    m_listView->setEditTriggers(QAbstractItemView::NoEditTriggers);
+    m_listView->setVerticalScrollMode(QAbstractItemView::ScrollPerPixel);
+    m_listView->setHorizontalScrollBarPolicy(Qt::ScrollBarAlwaysOff);
+    m_listView->setFrameShape(QFrame::NoFrame);
+    // Подсветка под курсором: делегат получает State_MouseOver
+    m_listView->setMouseTracking(true);
+    m_listView->viewport()->setAttribute(Qt::WA_Hover);
+    m_listView->viewport()->setCursor(Qt::PointingHandCursor);
+    m_mainLayout->addWidget(m_listView);
     
     // Надпись "Пусто"
     m_emptyLabel = new QLabel("История пуста", this);
@@ -100,72 +77,79 @@ void HistoryPanel::setupUi()
     m_mainLayout->addWidget(m_clearButton);
     
     connect(m_clearButton, &QPushButton::clicked, this, &HistoryPanel::onClearClicked);
+    connect(m_listView, &QListView::clicked, this, &HistoryPanel::onItemClicked);
+    connect(m_searchEdit, &QLineEdit::textChanged, this, &HistoryPanel::onSearchChanged);
     
     updateHistory();
 }
 
 void HistoryPanel::updateHistory()
 {
-    // Очистить текущие элементы
-    QLayoutItem* item;
-    while ((item = m_scrollLayout->takeAt(0)) != nullptr) {
-        if (item->widget()) {
-            item->widget()->deleteLater();
-        }
-        delete item;
-    }
-    
-    QStringList history = m_history->getAll();
-    
-    if (history.isEmpty()) {
-        m_emptyLabel->show();
-        m_scrollArea->hide();
-        m_clearButton->setEnabled(false);
-    } else {
-        m_emptyLabel->hide();
-        m_scrollArea->show();
-        m_clearButton->setEnabled(true);
-        
-        // Добавить элементы истории (в обратном порядке - новые сверху)
-        for (int i = history.size() - 1; i >= 0; --i) {
-            addHistoryItem(history.at(i));
+    const TraceSpan span("ui", "HistoryPanel::updateHistory");
+    const bool empty = m_model->rowCount() == 0;
+    m_emptyLabel->setText(m_model->isFiltered() ? "Ничего не найдено" : "История пуста");
+    m_emptyLabel->setVisible(empty);
+    m_listView->setVisible(!empty);
+    m_clearButton->setEnabled(m_history->count() > 0);
+}
+
+void HistoryPanel::applySearch()
+{
+    m_searchStale = false;
+    m_query = HistoryQuery::parse(m_searchEdit->text());
+    if (m_query.isEmpty()) {
+        if (m_model->isFiltered()) {
+            m_model->clearFilter();
         }
+        return;
     }
-    
-    m_scrollLayout->addStretch();
+    m_model->setFilter(m_index->search(m_query, CalculatorConfig::HISTORY_SEARCH_LIMIT));
 }
 
-void HistoryPanel::addHistoryItem(const QString& fullExpression)
+void HistoryPanel::onSearchChanged()
 {
-    QString expression, result;
-    parseExpression(fullExpression, expression, result);
-    
-    HistoryItemWidget* item = new HistoryItemWidget(expression, result, m_scrollContent);
-    
-    connect(item, &HistoryItemWidget::clicked, this, [result]() {
-        QApplication::clipboard()->setText(result);
-    });
-    
-    m_scrollLayout->insertWidget(0, item);
+    applySearch();
+    updateHistory();
 }
 
-void HistoryPanel::parseExpression(const QString& fullExpression, QString& expression, QString& result)
+void HistoryPanel::onEntriesAdded(int count)
 {
-    // Формат: "5 + 3 = 8" или "√(16) = 4"
-    int equalPos = fullExpression.lastIndexOf(" = ");
-    
-    if (equalPos != -1) {
-        expression = fullExpression.left(equalPos);
-        result = fullExpression.mid(equalPos + 3);
+    if (!m_model->isFiltered()) {
+        return;
+    }
+    if (!m_isVisible) {
+        m_searchStale = true;
+        return;
+    }
+    // Найденное уже упорядочено, новые записи - над ним: проверяются только они
+    QVector<int> rows;
+    for (int row = 0; row < count && rows.size() < CalculatorConfig::HISTORY_SEARCH_LIMIT; ++row) {
+        if (HistoryIndex::matches(m_query, m_history->entryAt(row))) {
+            rows.append(row);
+        }
+    }
+    m_model->insertFilterRows(rows, CalculatorConfig::HISTORY_SEARCH_LIMIT);
+}
+
+void HistoryPanel::onHistoryReset()
+{
+    // Модель при сбросе с фильтром остается пустой: загруженное ищется заново
+    if (!m_model->isFiltered()) {
+        return;
+    }
+    if (m_isVisible) {
+        applySearch();
     } else {
-        expression = fullExpression;
-        result = "";
+        m_searchStale = true;
     }
 }
 
 void HistoryPanel::show()
 {
     m_isVisible = true;
+    if (m_searchStale) {
+        applySearch();
+    }
     updateHistory();
     QWidget::show();
 }
@@ -200,3 +184,8 @@ void HistoryPanel::onClearClicked()
         updateHistory();
     }
 }
+
+void HistoryPanel::onItemClicked(const QModelIndex& index)
+{
+    QApplication::clipboard()->setText(index.data(HistoryModel::ResultRole).toString());
+}
@@ -4,33 +4,20 @@
 #include <QWidget>
 #include <QVBoxLayout>
 #include <QLabel>
+#include <QLineEdit>
+#include <QListView>
 #include <QPushButton>
-#include <QScrollArea>
 #include <QPropertyAnimation>
 #include "calculationhistory.h"
+#include "historyindex.h"
 
-// Виджет для отображения одной записи истории
-class HistoryItemWidget : public QWidget
-{
-    Q_OBJECT
-
-public:
-    explicit HistoryItemWidget(const QString& expression, const QString& result, QWidget* parent = nullptr);
-
-signals:
-    void clicked();
-
-protected:
-    void mousePressEvent(QMouseEvent* event) override;
-    void enterEvent(QEvent* event) override;
-    void leaveEvent(QEvent* event) override;
-
-private:
-    QLabel* m_expressionLabel;
-    QLabel* m_resultLabel;
-};
+class HistoryModel;
 
-// Боковая панель истории
+// Боковая панель истории. Записи показывает QListView поверх HistoryModel:
+// рисуются только видимые строки, виджетов на каждую запись нет.
+// Поле поиска фильтрует список по HistoryIndex при каждом изменении текста.
+// Новые записи проверяются по запросу по одной и вставляются в найденное;
+// пока панель скрыта, поиск откладывается до show()
 class HistoryPanel : public QWidget
 {
     Q_OBJECT
@@ -49,22 +36,30 @@ signals:
 
 private slots:
     void onClearClicked();
+    void onItemClicked(const QModelIndex& index);
+    void onSearchChanged();
+    void onEntriesAdded(int count);
+    void onHistoryReset();
 
 private:
     void setupUi();
-    void addHistoryItem(const QString& fullExpression);
-    void parseExpression(const QString& fullExpression, QString& expression, QString& result);
+    void applySearch();
 
 private:
     CalculationHistory* m_history;
+    HistoryModel* m_model;
+    HistoryIndex* m_index;
     QVBoxLayout* m_mainLayout;
-    QScrollArea* m_scrollArea;
-    QWidget* m_scrollContent;
-    QVBoxLayout* m_scrollLayout;
+    QLineEdit* m_searchEdit;
+    QListView* m_listView;
     QPushButton* m_clearButton;
     QLabel* m_titleLabel;
     QLabel* m_emptyLabel;
     bool m_isVisible;
+    // Запрос, по которому отфильтрована модель
+    HistoryQuery m_query;
+    // История менялась, пока панель была скрыта: найденное устарело
+    bool m_searchStale;
 };
 
 #endif // HISTORYPANEL_H
@@ -0,0 +1,200 @@
+#include "historysnapshot.h"
+#include "calculationhistory.h"
+#include "historyjournal.h"
+#include "logcategories.h"
+#include <QtEndian>
+#include <cstring>
+
+const char HistorySnapshot::MAGIC[4] = { 'C', 'H', 'S', 'N' };
+
+namespace {
+
+const int INDEX_ENTRY_SIZE = 8;
+
+} // namespace
+
+HistorySnapshot::HistorySnapshot()
+    : m_map(nullptr)
+    , m_data(nullptr)
+    , m_size(0)
+    , m_indexOffset(0)
+    , m_count(0)
+    , m_generation(0)
+{
+}
+
+HistorySnapshot::~HistorySnapshot()
+{
+    close();
+}
+
+bool HistorySnapshot::open(const QString& filename)
+{
+    close();
+
+    m_file.setFileName(filename);
+    if (!m_file.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+
+    const qint64 size = m_file.size();
+    m_map = size > 0 ? m_file.map(0, size) : nullptr;
+    if (m_map) {
+        if (attach(reinterpret_cast<const char*>(m_map), size)) {
+            return true;
+        }
+    } else {
+        m_copy = m_file.readAll();
+        m_file.close();
+        if (attach(m_copy.constData(), m_copy.size())) {
+            return true;
+        }
+    }
+
+    qCWarning(lcStorage) << "Файл не является снимком истории:" << filename;
+    close();
+    return false;
+}
+
+bool HistorySnapshot::open(const QByteArray& data)
+{
+    close();
+    m_copy = data;
+    if (attach(m_copy.constData(), m_copy.size())) {
+        return true;
+    }
+    close();
+    return false;
+}
+
+void HistorySnapshot::close()
+{
+    if (m_map) {
+        m_file.unmap(m_map);
+        m_map = nullptr;
+    }
+    m_file.close();
+    m_copy.clear();
+    m_data = nullptr;
+    m_size = 0;
+    m_indexOffset = 0;
+    m_count = 0;
+    m_generation = 0;
+}
+
+bool HistorySnapshot::isOpen() const
+{
+    return m_data != nullptr;
+}
+
+int HistorySnapshot::count() const
+{
+    return m_count;
+}
+
+quint16 HistorySnapshot::generation() const
+{
+    return m_generation;
+}
+
+bool HistorySnapshot::entryAt(int index, HistoryEntry& entry) const
+{
+    Q_ASSERT(index >= 0 && index < m_count);
+    const qint64 offset = frameOffset(index);
+    if (offset < 0
+        || HistoryJournal::decodeFrame(m_data + offset, m_indexOffset - offset, entry) == 0) {
+        qCWarning(lcStorage) << "Снимок истории: повреждена запись" << index << "в" << m_file.fileName();
+        return false;
+    }
+    return true;
+}
+
+QByteArray HistorySnapshot::frames(int first, int last) const
+{
+    Q_ASSERT(first >= 0 && first <= last && last <= m_count);
+    if (first == last) {
+        return QByteArray();
+    }
+    const qint64 begin = frameOffset(first);
+    const qint64 end = last == m_count ? m_indexOffset : frameOffset(last);
+    if (begin < 0 || end < begin) {
+        return QByteArray();
+    }
+    return QByteArray(m_data + begin, int(end - begin));
+}
+
+bool HistorySnapshot::isSnapshot(const QString& filename)
+{
+    QFile file(filename);
+    if (!file.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+    char header[HEADER_SIZE];
+    return file.read(header, HEADER_SIZE) == HEADER_SIZE
+        && std::memcmp(header, MAGIC, sizeof(MAGIC)) == 0
+        && qFromLittleEndian<quint16>(header + 4) == VERSION;
+}
+
+QByteArray HistorySnapshot::serialize(quint16 generation, const QByteArray& frames, int count)
+{
+    QByteArray out;
+    out.reserve(HEADER_SIZE + frames.size() + count * INDEX_ENTRY_SIZE);
+    out.resize(HEADER_SIZE);
+    out.append(frames);
+
+    // Индекс строится по длинам кадров: кадры уже проверены при кодировании
+    const char* begin = frames.constData();
+    int offset = 0;
+    int written = 0;
+    char position[INDEX_ENTRY_SIZE];
+    while (frames.size() - offset >= HistoryJournal::FRAME_HEADER_SIZE && written < count) {
+        qToLittleEndian<quint64>(quint64(HEADER_SIZE + offset), position);
+        out.append(position, sizeof(position));
+        offset += HistoryJournal::FRAME_HEADER_SIZE
+                + int(qFromLittleEndian<quint32>(begin + offset));
+        ++written;
+    }
+    Q_ASSERT(written == count && offset == frames.size());
+
+    char* header = out.data();
+    std::memcpy(header, MAGIC, sizeof(MAGIC));
+    qToLittleEndian<quint16>(VERSION, header + 4);
+    qToLittleEndian<quint16>(generation, header + 6);
+    qToLittleEndian<quint32>(quint32(written), header + 8);
+    qToLittleEndian<quint32>(0, header + 12);
+    qToLittleEndian<quint64>(quint64(HEADER_SIZE + frames.size()), header + 16);
+    return out;
+}
+
+bool HistorySnapshot::attach(const char* data, qint64 size)
+{
+    if (size < HEADER_SIZE || std::memcmp(data, MAGIC, sizeof(MAGIC)) != 0
+        || qFromLittleEndian<quint16>(data + 4) != VERSION) {
+        return false;
+    }
+
+    const quint32 count = qFromLittleEndian<quint32>(data + 8);
+    const quint64 indexOffset = qFromLittleEndian<quint64>(data + 16);
+    // Индекс - последнее в файле; обрезанный или чужой файл сюда не проходит
+    if (indexOffset < quint64(HEADER_SIZE) || indexOffset > quint64(size)
+        || quint64(size) - indexOffset != quint64(count) * INDEX_ENTRY_SIZE) {
+        return false;
+    }
+
+    m_data = data;
+    m_size = size;
+    m_indexOffset = qint64(indexOffset);
+    m_count = int(count);
+    m_generation = qFromLittleEndian<quint16>(data + 6);
+    return true;
+}
+
+qint64 HistorySnapshot::frameOffset(int index) const
+{
+    const quint64 offset = qFromLittleEndian<quint64>(
+        m_data + m_indexOffset + qint64(index) * INDEX_ENTRY_SIZE);
+    if (offset < quint64(HEADER_SIZE) || offset >= quint64(m_indexOffset)) {
+        return -1;
+    }
+    return qint64(offset);
+}
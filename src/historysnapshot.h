@@ -0,0 +1,67 @@
+#ifndef HISTORYSNAPSHOT_H
+#define HISTORYSNAPSHOT_H
+
+#include <QByteArray>
+#include <QFile>
+#include <QString>
+
+struct HistoryEntry;
+
+// Снимок истории, который пишет сжатие журнала. Заголовок 24 байта: сигнатура,
+// версия, поколение (quint16), число записей (quint32), резерв (quint32), смещение
+// индекса (quint64). Дальше кадры в формате журнала и индекс - смещения кадров
+// от начала файла (quint64 на запись), числа little-endian.
+//
+// Файл отображается в память целиком, но ничего не разбирается при открытии:
+// запись декодируется в entryAt() по индексу, и с диска подкачиваются только
+// страницы, к которым обратились. Поэтому открытие не зависит от длины истории.
+// Тот же формат в памяти служит архивом истории между сжатиями журнала.
+class HistorySnapshot
+{
+public:
+    HistorySnapshot();
+    ~HistorySnapshot();
+
+public:
+    // Отображает файл в память (если не выходит - читает целиком) и проверяет заголовок
+    bool open(const QString& filename);
+    // Снимок, собранный serialize(); данные разделяются, а не копируются
+    bool open(const QByteArray& data);
+    void close();
+    bool isOpen() const;
+
+    int count() const;
+    quint16 generation() const;
+
+    // 0 - самая старая запись. false - кадр поврежден
+    bool entryAt(int index, HistoryEntry& entry) const;
+    // Кадры записей [first, last) как есть, для нового снимка
+    QByteArray frames(int first, int last) const;
+
+public:
+    static bool isSnapshot(const QString& filename);
+    // Собирает файл снимка из count кадров подряд
+    static QByteArray serialize(quint16 generation, const QByteArray& frames, int count);
+
+public:
+    static const char MAGIC[4];
+    static const quint16 VERSION = 1;
+    static const int HEADER_SIZE = 24;
+
+private:
+    bool attach(const char* data, qint64 size);
+    qint64 frameOffset(int index) const;
+
+private:
+    QFile m_file;
+    uchar* m_map;
+    // Содержимое снимка, если он не отображен из файла
+    QByteArray m_copy;
+    const char* m_data;
+    qint64 m_size;
+    qint64 m_indexOffset;
+    int m_count;
+    quint16 m_generation;
+};
+
+#endif // HISTORYSNAPSHOT_H
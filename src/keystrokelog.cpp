@@ -0,0 +1,389 @@
+#include "keystrokelog.h"
+#include "calculationhistory.h"
+#include "historyjournal.h"
+#include "memorymanager.h"
+
+#include <QtEndian>
+#include <cstring>
+
+const char KeystrokeLog::MAGIC[4] = { 'C', 'K', 'E', 'Y' };
+
+namespace {
+
+// Буфер записи уходит в файл не реже, чем при этом размере
+const int RECORDER_BUFFER_SIZE = 4096;
+
+void appendDouble(double value, QByteArray& out)
+{
+    quint64 bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    char bytes[8];
+    qToLittleEndian<quint64>(bits, bytes);
+    out.append(bytes, sizeof(bytes));
+}
+
+void appendText(const QString& text, QByteArray& out)
+{
+    const QByteArray utf8 = text.toUtf8();
+    HistoryJournal::appendVarint(quint64(utf8.size()), out);
+    out.append(utf8);
+}
+
+// -1 - событие оборвано, 0 - поврежден текст, 1 - прочитан
+int readText(const char*& pos, const char* end, QString& text)
+{
+    quint64 length = 0;
+    if (!HistoryJournal::readVarint(pos, end, length)) {
+        return -1;
+    }
+    if (length > quint64(KeystrokeLog::MAX_TEXT_SIZE)) {
+        return 0;
+    }
+    if (length > quint64(end - pos)) {
+        return -1;
+    }
+    text = QString::fromUtf8(pos, int(length));
+    pos += length;
+    return 1;
+}
+
+QString describe(const KeystrokeLog::Event& check)
+{
+    return QString("\"%1\", записей: %2, \"%3\"")
+        .arg(check.display)
+        .arg(check.entries)
+        .arg(check.expression);
+}
+
+} // namespace
+
+KeystrokeLog::Recorder::Recorder()
+    : m_session(nullptr)
+    , m_entriesBefore(0)
+    , m_lastTime(0)
+{
+}
+
+KeystrokeLog::Recorder::~Recorder()
+{
+    close();
+}
+
+bool KeystrokeLog::Recorder::open(const QString& filename, const CalculatorSession* session)
+{
+    close();
+    m_file.setFileName(filename);
+    if (!m_file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        return false;
+    }
+
+    m_session = session;
+    m_entriesBefore = session->entryCount();
+    m_lastTime = 0;
+    m_clock.start();
+
+    char header[HEADER_SIZE];
+    std::memcpy(header, MAGIC, sizeof(MAGIC));
+    qToLittleEndian<quint16>(VERSION, header + 4);
+    qToLittleEndian<quint16>(0, header + 6);
+    m_buffer.append(header, HEADER_SIZE);
+
+    // MR в начале записи должен вспомнить то же, что и при прогоне
+    Event memory;
+    memory.type = EventType::Memory;
+    memory.value = session->memory() ? session->memory()->value() : 0.0;
+    append(memory);
+    flush();
+    return true;
+}
+
+void KeystrokeLog::Recorder::close()
+{
+    if (!m_file.isOpen()) {
+        return;
+    }
+    recordCheck();
+    flush();
+    m_file.close();
+    m_session = nullptr;
+}
+
+bool KeystrokeLog::Recorder::isOpen() const
+{
+    return m_file.isOpen();
+}
+
+void KeystrokeLog::Recorder::recordKey(CalculatorSession::Key key)
+{
+    if (!m_file.isOpen()) {
+        return;
+    }
+    Event event;
+    event.key = key;
+    append(event);
+}
+
+void KeystrokeLog::Recorder::recordValue(double value)
+{
+    if (!m_file.isOpen()) {
+        return;
+    }
+    Event event;
+    event.type = EventType::Value;
+    event.value = value;
+    append(event);
+}
+
+void KeystrokeLog::Recorder::recordCheck()
+{
+    if (!m_file.isOpen()) {
+        return;
+    }
+    append(checkpoint(*m_session, m_entriesBefore));
+    flush();
+}
+
+void KeystrokeLog::Recorder::append(const Event& event)
+{
+    Event timed = event;
+    timed.time = qMax(m_clock.elapsed(), m_lastTime);
+    appendEvent(timed, m_lastTime, m_buffer);
+    m_lastTime = timed.time;
+    if (m_buffer.size() >= RECORDER_BUFFER_SIZE) {
+        flush();
+    }
+}
+
+void KeystrokeLog::Recorder::flush()
+{
+    if (m_buffer.isEmpty()) {
+        return;
+    }
+    m_file.write(m_buffer);
+    m_file.flush();
+    m_buffer.clear();
+}
+
+KeystrokeLog::KeystrokeLog()
+{
+}
+
+bool KeystrokeLog::load(const QString& filename)
+{
+    QFile file(filename);
+    if (!file.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+    return decode(file.readAll());
+}
+
+bool KeystrokeLog::decode(const QByteArray& data)
+{
+    m_events.clear();
+    if (data.size() < HEADER_SIZE
+        || std::memcmp(data.constData(), MAGIC, sizeof(MAGIC)) != 0
+        || qFromLittleEndian<quint16>(data.constData() + 4) != VERSION) {
+        return false;
+    }
+
+    const char* pos = data.constData() + HEADER_SIZE;
+    const char* const end = data.constData() + data.size();
+    qint64 time = 0;
+    while (pos < end) {
+        Event event;
+        const quint8 tag = static_cast<quint8>(*pos++);
+        if (tag <= quint8(CalculatorSession::Key::MemoryStore)) {
+            event.type = EventType::Key;
+            event.key = static_cast<CalculatorSession::Key>(tag);
+        } else if (tag == VALUE_TAG) {
+            event.type = EventType::Value;
+        } else if (tag == CHECK_TAG) {
+            event.type = EventType::Check;
+        } else if (tag == MEMORY_TAG) {
+            event.type = EventType::Memory;
+        } else {
+            m_events.clear();
+            return false;
+        }
+
+        quint64 delta = 0;
+        if (!HistoryJournal::readVarint(pos, end, delta)) {
+            break;
+        }
+        time += qint64(delta);
+        event.time = time;
+
+        if (event.type == EventType::Value || event.type == EventType::Memory) {
+            if (end - pos < 8) {
+                break;
+            }
+            const quint64 bits = qFromLittleEndian<quint64>(pos);
+            std::memcpy(&event.value, &bits, sizeof(bits));
+            pos += 8;
+        } else if (event.type == EventType::Check) {
+            int status = readText(pos, end, event.display);
+            if (status > 0 && !HistoryJournal::readVarint(pos, end, event.entries)) {
+                status = -1;
+            }
+            if (status > 0) {
+                status = readText(pos, end, event.expression);
+            }
+            if (status < 0) {
+                break;
+            }
+            if (status == 0) {
+                m_events.clear();
+                return false;
+            }
+        }
+        m_events.append(event);
+    }
+    return true;
+}
+
+bool KeystrokeLog::save(const QString& filename) const
+{
+    QFile file(filename);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        return false;
+    }
+    const QByteArray data = encode();
+    return file.write(data) == data.size();
+}
+
+QByteArray KeystrokeLog::encode() const
+{
+    QByteArray data;
+    data.reserve(HEADER_SIZE + m_events.size() * 3);
+    char header[HEADER_SIZE];
+    std::memcpy(header, MAGIC, sizeof(MAGIC));
+    qToLittleEndian<quint16>(VERSION, header + 4);
+    qToLittleEndian<quint16>(0, header + 6);
+    data.append(header, HEADER_SIZE);
+
+    qint64 time = 0;
+    for (const Event& event : m_events) {
+        appendEvent(event, time, data);
+        time = qMax(time, event.time);
+    }
+    return data;
+}
+
+const QVector<KeystrokeLog::Event>& KeystrokeLog::events() const
+{
+    return m_events;
+}
+
+int KeystrokeLog::count() const
+{
+    return m_events.size();
+}
+
+void KeystrokeLog::append(const Event& event)
+{
+    m_events.append(event);
+}
+
+void KeystrokeLog::clear()
+{
+    m_events.clear();
+}
+
+KeystrokeLog::ReplayResult KeystrokeLog::replay(CalculatorSession& session) const
+{
+    ReplayResult result;
+    session.reset();
+    const quint64 entriesBefore = session.entryCount();
+    const bool checkHistory = session.history() != nullptr;
+
+    for (int i = 0; i < m_events.size(); ++i) {
+        const Event& event = m_events.at(i);
+        switch (event.type) {
+            case EventType::Key:
+                session.press(event.key);
+                ++result.keys;
+                break;
+
+            case EventType::Value:
+                session.showValue(event.value);
+                break;
+
+            case EventType::Memory:
+                if (session.memory()) {
+                    session.memory()->store(event.value);
+                }
+                break;
+
+            case EventType::Check: {
+                ++result.checks;
+                const Event actual = checkpoint(session, entriesBefore);
+                bool same = actual.display == event.display;
+                if (checkHistory) {
+                    same = same && actual.entries == event.entries
+                        && actual.expression == event.expression;
+                }
+                if (!same) {
+                    result.failedEvent = i;
+                    result.expected = describe(event);
+                    result.actual = describe(actual);
+                    return result;
+                }
+                break;
+            }
+        }
+    }
+    return result;
+}
+
+bool KeystrokeLog::isKeystrokeLog(const QString& filename)
+{
+    QFile file(filename);
+    if (!file.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+    char header[HEADER_SIZE];
+    return file.read(header, HEADER_SIZE) == HEADER_SIZE
+        && std::memcmp(header, MAGIC, sizeof(MAGIC)) == 0
+        && qFromLittleEndian<quint16>(header + 4) == VERSION;
+}
+
+KeystrokeLog::Event KeystrokeLog::checkpoint(const CalculatorSession& session,
+                                             quint64 entriesBefore)
+{
+    Event check;
+    check.type = EventType::Check;
+    check.display = session.displayText();
+    check.entries = session.entryCount() - entriesBefore;
+    const CalculationHistory* history = session.history();
+    if (check.entries > 0 && history && history->count() > 0) {
+        check.expression = history->entryAt(0).expression;
+    }
+    return check;
+}
+
+void KeystrokeLog::appendEvent(const Event& event, qint64 previousTime, QByteArray& out)
+{
+    switch (event.type) {
+        case EventType::Key:
+            out.append(static_cast<char>(event.key));
+            break;
+        case EventType::Value:
+            out.append(static_cast<char>(VALUE_TAG));
+            break;
+        case EventType::Check:
+            out.append(static_cast<char>(CHECK_TAG));
+            break;
+        case EventType::Memory:
+            out.append(static_cast<char>(MEMORY_TAG));
+            break;
+    }
+    HistoryJournal::appendVarint(quint64(qMax<qint64>(event.time - previousTime, 0)), out);
+
+    if (event.type == EventType::Value || event.type == EventType::Memory) {
+        appendDouble(event.value, out);
+    } else if (event.type == EventType::Check) {
+        appendText(event.display, out);
+        HistoryJournal::appendVarint(event.entries, out);
+        appendText(event.expression, out);
+    }
+}
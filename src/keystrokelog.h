@@ -0,0 +1,136 @@
+#ifndef KEYSTROKELOG_H
+#define KEYSTROKELOG_H
+
+#include <QByteArray>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QString>
+#include <QVector>
+#include "calculatorsession.h"
+
+// Журнал нажатий для воспроизведения ошибок и замеров на реальном вводе.
+// Заголовок 8 байт (сигнатура, версия, резерв), затем события подряд. Событие
+// начинается с байта типа:
+// - 0x00..0x7F - клавиша (значение CalculatorSession::Key), затем время;
+// - 0x80 - значение из списка памяти: время, затем double little-endian;
+// - 0x81 - проверка: время, текст дисплея (varint длина + UTF-8), число записей,
+//   которые сеанс добавил в историю с начала записи (varint), и выражение самой
+//   новой из них (varint длина + UTF-8, пусто, если записей не было);
+// - 0x82 - значение памяти в начале записи: время, затем double.
+// Время - varint разность в мс с предыдущим событием, поэтому нажатие обычно
+// занимает 2-3 байта.
+//
+// Проверки записываются там, где на дисплее результат или ошибка, и в конце;
+// replay() прогоняет события через сеанс без пауз и сверяет их
+class KeystrokeLog
+{
+public:
+    enum class EventType {
+        Key,
+        Value,
+        Check,
+        Memory
+    };
+
+    struct Event {
+        EventType type = EventType::Key;
+        // мс от начала записи
+        qint64 time = 0;
+        CalculatorSession::Key key = CalculatorSession::Key::Clear;
+        // Для Value и Memory
+        double value = 0.0;
+        // Только для проверок
+        QString display;
+        quint64 entries = 0;
+        QString expression;
+    };
+
+    struct ReplayResult {
+        int keys = 0;
+        int checks = 0;
+        // Номер события-проверки, которая не совпала; -1 - совпали все
+        int failedEvent = -1;
+        QString expected;
+        QString actual;
+
+        bool passed() const { return failedEvent < 0; }
+    };
+
+    // Пишет журнал во время работы окна. Буфер уходит в файл на проверках,
+    // при заполнении и при закрытии, поэтому сбой теряет только последние нажатия
+    class Recorder
+    {
+    public:
+        Recorder();
+        ~Recorder();
+
+    public:
+        // Файл перезаписывается. Проверки берут состояние session, он должен
+        // жить до close()
+        bool open(const QString& filename, const CalculatorSession* session);
+        // Записывает итоговую проверку и закрывает файл
+        void close();
+        bool isOpen() const;
+
+        void recordKey(CalculatorSession::Key key);
+        void recordValue(double value);
+        void recordCheck();
+
+    private:
+        void append(const Event& event);
+        void flush();
+
+    private:
+        QFile m_file;
+        const CalculatorSession* m_session;
+        quint64 m_entriesBefore;
+        QByteArray m_buffer;
+        QElapsedTimer m_clock;
+        qint64 m_lastTime;
+    };
+
+public:
+    KeystrokeLog();
+
+public:
+    // Оборванное последнее событие отбрасывается: файл мог остаться от сбоя.
+    // false - не журнал нажатий или неизвестный тип события
+    bool load(const QString& filename);
+    bool decode(const QByteArray& data);
+    bool save(const QString& filename) const;
+    QByteArray encode() const;
+
+    const QVector<Event>& events() const;
+    int count() const;
+    void append(const Event& event);
+    void clear();
+
+public:
+    // События по порядку, без пауз. Сеанс сбрасывается перед прогоном, память сеанса
+    // получает записанное значение; записи истории сверяются, только если у сеанса
+    // есть история. Прогон останавливается
+    // на первой несовпавшей проверке
+    ReplayResult replay(CalculatorSession& session) const;
+
+public:
+    static bool isKeystrokeLog(const QString& filename);
+    // Проверка для текущего состояния сеанса; entriesBefore - его entryCount()
+    // в начале записи или прогона
+    static Event checkpoint(const CalculatorSession& session, quint64 entriesBefore);
+    static void appendEvent(const Event& event, qint64 previousTime, QByteArray& out);
+
+public:
+    static const char MAGIC[4];
+    static const quint16 VERSION = 1;
+    static const int HEADER_SIZE = 8;
+    static const quint8 VALUE_TAG = 0x80;
+    static const quint8 CHECK_TAG = 0x81;
+    static const quint8 MEMORY_TAG = 0x82;
+    // Событие длиннее - признак повреждения
+    static const int MAX_TEXT_SIZE = 1 << 16;
+
+private:
+    QVector<Event> m_events;
+};
+
+#endif // KEYSTROKELOG_H
@@ -0,0 +1,153 @@
+#include "latencyhistogram.h"
+
+#include <QJsonArray>
+#include <QtAlgorithms>
+#include <cmath>
+
+// Передаются по ссылке (qBound, QCOMPARE), нужны определения
+const qint64 LatencyHistogram::MAX_VALUE;
+const int LatencyHistogram::BUCKET_COUNT;
+
+LatencyHistogram::LatencyHistogram()
+    : m_counts(BUCKET_COUNT, 0)
+    , m_count(0)
+    , m_min(0)
+    , m_max(0)
+    , m_sum(0.0)
+{
+}
+
+void LatencyHistogram::record(qint64 value)
+{
+    value = qBound<qint64>(0, value, MAX_VALUE);
+    ++m_counts[bucketIndex(value)];
+    if (m_count == 0 || value < m_min) {
+        m_min = value;
+    }
+    if (value > m_max) {
+        m_max = value;
+    }
+    ++m_count;
+    m_sum += double(value);
+}
+
+void LatencyHistogram::merge(const LatencyHistogram& other)
+{
+    if (other.m_count == 0) {
+        return;
+    }
+    quint64* counts = m_counts.data();
+    const quint64* otherCounts = other.m_counts.constData();
+    for (int i = 0; i < BUCKET_COUNT; ++i) {
+        counts[i] += otherCounts[i];
+    }
+    m_min = m_count == 0 ? other.m_min : qMin(m_min, other.m_min);
+    m_max = qMax(m_max, other.m_max);
+    m_count += other.m_count;
+    m_sum += other.m_sum;
+}
+
+void LatencyHistogram::reset()
+{
+    m_counts.fill(0);
+    m_count = 0;
+    m_min = 0;
+    m_max = 0;
+    m_sum = 0.0;
+}
+
+qint64 LatencyHistogram::count() const
+{
+    return m_count;
+}
+
+qint64 LatencyHistogram::min() const
+{
+    return m_min;
+}
+
+qint64 LatencyHistogram::max() const
+{
+    return m_max;
+}
+
+double LatencyHistogram::mean() const
+{
+    return m_count > 0 ? m_sum / double(m_count) : 0.0;
+}
+
+qint64 LatencyHistogram::valueAtPercentile(double percentile) const
+{
+    if (m_count == 0) {
+        return 0;
+    }
+    percentile = qBound(0.0, percentile, 100.0);
+    const qint64 target = qMax<qint64>(1, qint64(std::ceil(percentile / 100.0 * double(m_count))));
+
+    qint64 seen = 0;
+    for (int i = 0; i < BUCKET_COUNT; ++i) {
+        seen += qint64(m_counts.at(i));
+        if (seen >= target) {
+            // Граница корзины не выходит за наблюдавшийся диапазон
+            return qBound(m_min, bucketHighest(i), m_max);
+        }
+    }
+    return m_max;
+}
+
+QJsonObject LatencyHistogram::toJson() const
+{
+    QJsonObject json;
+    json.insert("count", m_count);
+    json.insert("min", m_min);
+    json.insert("max", m_max);
+    json.insert("mean", mean());
+    json.insert("p50", valueAtPercentile(50.0));
+    json.insert("p90", valueAtPercentile(90.0));
+    json.insert("p99", valueAtPercentile(99.0));
+    json.insert("p999", valueAtPercentile(99.9));
+
+    QJsonArray buckets;
+    for (int i = 0; i < BUCKET_COUNT; ++i) {
+        if (m_counts.at(i) != 0) {
+            QJsonArray bucket;
+            bucket.append(bucketLowest(i));
+            bucket.append(qint64(m_counts.at(i)));
+            buckets.append(bucket);
+        }
+    }
+    json.insert("buckets", buckets);
+    return json;
+}
+
+int LatencyHistogram::bucketIndex(qint64 value)
+{
+    const quint64 v = quint64(qBound<qint64>(0, value, MAX_VALUE));
+    if (v < quint64(2 * SUB_BUCKET_COUNT)) {
+        return int(v);
+    }
+    // Старший бит задает степень двойки, следующие SUB_BUCKET_BITS - корзину в ней
+    const int exponent = 63 - int(qCountLeadingZeroBits(v));
+    const int shift = exponent - SUB_BUCKET_BITS;
+    return 2 * SUB_BUCKET_COUNT + (exponent - SUB_BUCKET_BITS - 1) * SUB_BUCKET_COUNT
+        + int(v >> shift) - SUB_BUCKET_COUNT;
+}
+
+qint64 LatencyHistogram::bucketLowest(int index)
+{
+    if (index < 2 * SUB_BUCKET_COUNT) {
+        return index;
+    }
+    const int offset = index - 2 * SUB_BUCKET_COUNT;
+    const int shift = offset / SUB_BUCKET_COUNT + 1;
+    return qint64(SUB_BUCKET_COUNT + offset % SUB_BUCKET_COUNT) << shift;
+}
+
+qint64 LatencyHistogram::bucketHighest(int index)
+{
+    if (index < 2 * SUB_BUCKET_COUNT) {
+        return index;
+    }
+    const int shift = (index - 2 * SUB_BUCKET_COUNT) / SUB_BUCKET_COUNT + 1;
+    return bucketLowest(index) + (Q_INT64_C(1) << shift) - 1;
+}
@@ -0,0 +1,57 @@
+#ifndef LATENCYHISTOGRAM_H
+#define LATENCYHISTOGRAM_H
+
+#include <QJsonObject>
+#include <QVector>
+
+// Гистограмма задержек в духе HdrHistogram: значения до 256 считаются точно,
+// дальше каждая степень двойки делится на 128 равных корзин, поэтому процентили
+// отличаются от точных не больше чем на 1/128 (0.8%) при любом масштабе.
+// Значения - целые неотрицательные (LatencyMonitor пишет наносекунды), больше
+// MAX_VALUE (~68 с в нс) считаются равными MAX_VALUE.
+//
+// record() - одно сложение без выделений: все корзины (30 КБ) создаются сразу
+class LatencyHistogram
+{
+public:
+    LatencyHistogram();
+
+public:
+    void record(qint64 value);
+    void merge(const LatencyHistogram& other);
+    void reset();
+
+    qint64 count() const;
+    qint64 min() const;
+    qint64 max() const;
+    double mean() const;
+    // Наибольшее значение корзины, в которую попадает percentile процентов записей
+    // (0..100). 0 - если записей нет
+    qint64 valueAtPercentile(double percentile) const;
+
+    // count, min, max, mean, p50, p90, p99, p99.9 и непустые корзины
+    // [нижняя граница, число записей]
+    QJsonObject toJson() const;
+
+public:
+    static int bucketIndex(qint64 value);
+    static qint64 bucketLowest(int index);
+    static qint64 bucketHighest(int index);
+
+public:
+    static const int SUB_BUCKET_BITS = 7;
+    static const int SUB_BUCKET_COUNT = 1 << SUB_BUCKET_BITS;
+    static const int VALUE_BITS = 36;
+    static const qint64 MAX_VALUE = (Q_INT64_C(1) << VALUE_BITS) - 1;
+    static const int BUCKET_COUNT = 2 * SUB_BUCKET_COUNT
+        + (VALUE_BITS - SUB_BUCKET_BITS - 1) * SUB_BUCKET_COUNT;
+
+private:
+    QVector<quint64> m_counts;
+    qint64 m_count;
+    qint64 m_min;
+    qint64 m_max;
+    double m_sum;
+};
+
+#endif // LATENCYHISTOGRAM_H
@@ -0,0 +1,203 @@
+#include "latencymonitor.h"
+#include "calculatorconfig.h"
+#include "logcategories.h"
+
+#include <QEvent>
+#include <QFontDatabase>
+#include <QJsonObject>
+#include <QSaveFile>
+
+LatencyMonitor::LatencyMonitor(QLabel* display, QObject* parent)
+    : QObject(parent)
+    , m_display(display)
+    , m_hasCurrent(false)
+    , m_overlay(nullptr)
+{
+    m_clock.start();
+    m_current.type = InputType::Digit;
+    m_current.start = 0;
+    m_pending.reserve(16);
+    m_display->installEventFilter(this);
+
+    m_overlayTimer.setInterval(500);
+    connect(&m_overlayTimer, &QTimer::timeout, this, &LatencyMonitor::updateOverlay);
+}
+
+LatencyMonitor::~LatencyMonitor()
+{
+    delete m_overlay;
+}
+
+void LatencyMonitor::inputStarted(InputType type)
+{
+    m_current.type = type;
+    m_current.start = m_clock.nsecsElapsed();
+    m_hasCurrent = true;
+    m_textBefore = m_display->text();
+}
+
+void LatencyMonitor::inputFinished()
+{
+    if (!m_hasCurrent) {
+        return;
+    }
+    m_hasCurrent = false;
+    // QLabel не перерисовывается, если текст тот же
+    if (m_display->text() != m_textBefore) {
+        m_pending.append(m_current);
+    }
+    m_textBefore.clear();
+}
+
+const LatencyHistogram& LatencyMonitor::histogram(InputType type) const
+{
+    return m_histograms[static_cast<int>(type)];
+}
+
+void LatencyMonitor::reset()
+{
+    for (LatencyHistogram& histogram : m_histograms) {
+        histogram.reset();
+    }
+    m_pending.clear();
+    updateOverlay();
+}
+
+QJsonDocument LatencyMonitor::toJson() const
+{
+    QJsonObject inputs;
+    for (int i = 0; i < INPUT_TYPE_COUNT; ++i) {
+        inputs.insert(typeName(static_cast<InputType>(i)), m_histograms[i].toJson());
+    }
+    QJsonObject root;
+    root.insert("unit", QString("ns"));
+    root.insert("inputs", inputs);
+    return QJsonDocument(root);
+}
+
+bool LatencyMonitor::dumpJson(const QString& filename) const
+{
+    QSaveFile file(filename);
+    if (!file.open(QIODevice::WriteOnly)) {
+        return false;
+    }
+    file.write(toJson().toJson(QJsonDocument::Indented));
+    return file.commit();
+}
+
+bool LatencyMonitor::isOverlayVisible() const
+{
+    return m_overlay && m_overlay->isVisible();
+}
+
+void LatencyMonitor::toggleOverlay()
+{
+    if (isOverlayVisible()) {
+        m_overlayTimer.stop();
+        m_overlay->hide();
+        return;
+    }
+
+    if (!m_overlay) {
+        // Отдельное окно: его обновления не вызывают перерисовку дисплея под ним.
+        // Без родителя - удаляется монитором
+        m_overlay = new QLabel(nullptr, Qt::ToolTip | Qt::FramelessWindowHint);
+        m_overlay->setAttribute(Qt::WA_ShowWithoutActivating);
+        m_overlay->setAttribute(Qt::WA_TransparentForMouseEvents);
+        m_overlay->setFont(QFontDatabase::systemFont(QFontDatabase::FixedFont));
+        m_overlay->setStyleSheet("background: rgba(0, 0, 0, 180); color: #9f9; padding: 4px;");
+    }
+    updateOverlay();
+    m_overlay->show();
+    m_overlayTimer.start();
+}
+
+void LatencyMonitor::dumpReport()
+{
+    if (dumpJson(CalculatorConfig::LATENCY_REPORT_FILE)) {
+        qCInfo(lcUi) << "Задержки записаны в" << CalculatorConfig::LATENCY_REPORT_FILE;
+    } else {
+        qCWarning(lcUi) << "Не удалось записать" << CalculatorConfig::LATENCY_REPORT_FILE;
+    }
+}
+
+LatencyMonitor::InputType LatencyMonitor::inputType(CalculatorSession::Key key)
+{
+    typedef CalculatorSession::Key Key;
+    switch (key) {
+        case Key::Add:
+        case Key::Subtract:
+        case Key::Multiply:
+        case Key::Divide:
+            return InputType::Operator;
+        case Key::Equals:
+            return InputType::Equals;
+        case Key::Percent:
+        case Key::Negate:
+        case Key::Square:
+        case Key::SquareRoot:
+        case Key::Reciprocal:
+            return InputType::Unary;
+        case Key::MemoryAdd:
+        case Key::MemorySubtract:
+        case Key::MemoryRecall:
+        case Key::MemoryClear:
+        case Key::MemoryStore:
+            return InputType::Memory;
+        case Key::Backspace:
+        case Key::Clear:
+        case Key::ClearEntry:
+            return InputType::Edit;
+        default:
+            return InputType::Digit;
+    }
+}
+
+QString LatencyMonitor::typeName(InputType type)
+{
+    switch (type) {
+        case InputType::Digit: return "digit";
+        case InputType::Operator: return "operator";
+        case InputType::Equals: return "equals";
+        case InputType::Unary: return "unary";
+        case InputType::Memory: return "memory";
+        case InputType::Edit: return "edit";
+    }
+    return QString();
+}
+
+bool LatencyMonitor::eventFilter(QObject* watched, QEvent* event)
+{
+    // Время берется, когда событие перерисовки дошло до дисплея: основная часть
+    // задержки - ожидание в очереди и сжатие обновлений, а не сама отрисовка текста
+    if (watched == m_display && event->type() == QEvent::Paint && !m_pending.isEmpty()) {
+        const qint64 now = m_clock.nsecsElapsed();
+        for (const Pending& pending : m_pending) {
+            m_histograms[static_cast<int>(pending.type)].record(now - pending.start);
+        }
+        m_pending.clear();
+    }
+    return QObject::eventFilter(watched, event);
+}
+
+void LatencyMonitor::updateOverlay()
+{
+    if (!m_overlay) {
+        return;
+    }
+
+    QString text = QString("%1 %2 %3 %4 %5  мс")
+                       .arg("", -9).arg("n", 6).arg("p50", 7).arg("p99", 7).arg("max", 7);
+    for (int i = 0; i < INPUT_TYPE_COUNT; ++i) {
+        const LatencyHistogram& histogram = m_histograms[i];
+        text += QString("\n%1 %2 %3 %4 %5")
+                    .arg(typeName(static_cast<InputType>(i)), -9)
+                    .arg(histogram.count(), 6)
+                    .arg(histogram.valueAtPercentile(50.0) / 1e6, 7, 'f', 2)
+                    .arg(histogram.valueAtPercentile(99.0) / 1e6, 7, 'f', 2)
+                    .arg(histogram.max() / 1e6, 7, 'f', 2);
+    }
+    m_overlay->setText(text);
+    m_overlay->adjustSize();
+    m_overlay->move(m_display->mapToGlobal(QPoint(0, m_display->height())));
+}
@@ -0,0 +1,91 @@
+#ifndef LATENCYMONITOR_H
+#define LATENCYMONITOR_H
+
+#include <QElapsedTimer>
+#include <QJsonDocument>
+#include <QLabel>
+#include <QObject>
+#include <QTimer>
+#include <QVector>
+#include "calculatorsession.h"
+#include "latencyhistogram.h"
+
+// Задержка от нажатия до перерисовки дисплея, отдельно по видам ввода.
+// Окно отмечает начало и конец обработки нажатия; если текст дисплея изменился,
+// время до ближайшего события Paint дисплея уходит в гистограмму вида ввода.
+// Нажатия, которые успели до одной перерисовки, показаны одним кадром и получают
+// каждое свою задержку до него.
+//
+// Монитор создается, только если задана переменная CALC_LATENCY: выключенный
+// замер стоит окну одной проверки указателя на нажатие, фильтр событий
+// на дисплей не ставится
+class LatencyMonitor : public QObject
+{
+    Q_OBJECT
+
+public:
+    enum class InputType {
+        Digit,  // и десятичная точка
+        Operator,
+        Equals,
+        Unary,
+        Memory,
+        Edit    // ⌫, C, CE
+    };
+    static const int INPUT_TYPE_COUNT = 6;
+
+public:
+    explicit LatencyMonitor(QLabel* display, QObject* parent = nullptr);
+    ~LatencyMonitor() override;
+
+public:
+    void inputStarted(InputType type);
+    // Нажатие без изменения текста не перерисовывает дисплей и не учитывается
+    void inputFinished();
+
+    const LatencyHistogram& histogram(InputType type) const;
+    void reset();
+    // Гистограммы всех видов ввода, значения в наносекундах
+    QJsonDocument toJson() const;
+    bool dumpJson(const QString& filename) const;
+    bool isOverlayVisible() const;
+
+public slots:
+    // Окно поверх дисплея с p50/p99 по видам ввода, обновляется дважды в секунду
+    void toggleOverlay();
+    // Пишет отчет в CalculatorConfig::LATENCY_REPORT_FILE
+    void dumpReport();
+
+public:
+    static InputType inputType(CalculatorSession::Key key);
+    static QString typeName(InputType type);
+
+protected:
+    bool eventFilter(QObject* watched, QEvent* event) override;
+
+private slots:
+    void updateOverlay();
+
+private:
+    struct Pending {
+        InputType type;
+        qint64 start;
+    };
+
+private:
+    QLabel* m_display;
+    QElapsedTimer m_clock;
+    LatencyHistogram m_histograms[INPUT_TYPE_COUNT];
+
+    // Нажатие в обработке и текст дисплея до него
+    Pending m_current;
+    bool m_hasCurrent;
+    QString m_textBefore;
+    // Нажатия, ждущие перерисовки
+    QVector<Pending> m_pending;
+
+    QLabel* m_overlay;
+    QTimer m_overlayTimer;
+};
+
+#endif // LATENCYMONITOR_H
@@ -0,0 +1,7 @@
+#include "logcategories.h"
+
+Q_LOGGING_CATEGORY(lcMemory, "calc.memory", QtInfoMsg)
+Q_LOGGING_CATEGORY(lcHistory, "calc.history", QtInfoMsg)
+Q_LOGGING_CATEGORY(lcStorage, "calc.storage", QtInfoMsg)
+Q_LOGGING_CATEGORY(lcTheme, "calc.theme", QtInfoMsg)
+Q_LOGGING_CATEGORY(lcUi, "calc.ui", QtInfoMsg)
@@ -0,0 +1,18 @@
+#ifndef LOGCATEGORIES_H
+#define LOGCATEGORIES_H
+
+#include <QLoggingCategory>
+
+// Категории журнала калькулятора. Отладочные сообщения выключены по умолчанию:
+// qCDebug выключенной категории - одна проверка флага, поток QDebug не создается.
+// Включаются правилами Qt, например QT_LOGGING_RULES="calc.memory.debug=true"
+// или "calc.*.debug=true". Информация и предупреждения включены.
+//
+// Уровни, вырезаемые при сборке, задает CALC_LOG_LEVEL в CMake
+Q_DECLARE_LOGGING_CATEGORY(lcMemory)   // calc.memory: M+, M-, MR, MS, список памяти
+Q_DECLARE_LOGGING_CATEGORY(lcHistory)  // calc.history: история вычислений
+Q_DECLARE_LOGGING_CATEGORY(lcStorage)  // calc.storage: журнал, снимок и архив истории
+Q_DECLARE_LOGGING_CATEGORY(lcTheme)    // calc.theme: темы оформления
+Q_DECLARE_LOGGING_CATEGORY(lcUi)       // calc.ui: окно, буфер обмена, отчеты
+
+#endif // LOGCATEGORIES_H
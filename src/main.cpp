@@ -1,10 +1,27 @@
 #include "mainwindow.h"
+#include "asynclogger.h"
+#include "calculatorconfig.h"
+#include "tracer.h"
 
 #include <QApplication>
 #include <QIcon>
+#include <QTimer>
 
 int main(int argc, char *argv[])
 {
+    // Сообщения оформляются и выводятся в фоновом потоке. Логгер создается первым
+    // и удаляется последним: сообщения деструкторов окна тоже доходят до вывода
+    AsyncLogger logger;
+    logger.install();
+
+    // Трасса включается до QApplication, чтобы в нее попал весь запуск
+    const QByteArray trace = qgetenv(CalculatorConfig::TRACE_VARIABLE);
+    if (!trace.isEmpty() && trace != "0") {
+        Tracer::setEnabled(true);
+        Tracer::setThreadName("main");
+    }
+    const qint64 startup = Tracer::now();
+
     QApplication a(argc, argv);
     
     // Установить иконку приложения
@@ -12,5 +29,12 @@ int main(int argc, char *argv[])
     
     MainWindow w;
     w.show();
+
+    // Первая итерация цикла событий рисует окно: запуск заканчивается после нее
+    if (Tracer::isEnabled()) {
+        QTimer::singleShot(0, [startup]() {
+            Tracer::record("startup", "main", startup, Tracer::now() - startup);
+        });
+    }
     return a.exec();
 }
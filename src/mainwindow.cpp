@@ -1,9 +1,7 @@
 #include "mainwindow.h"
 #include "./ui_mainwindow.h"
-#include "calchandler.h"
 #include "calculatorconfig.h"
-#include "displayformatter.h"
-#include "inputvalidator.h"
+#include "calculatorsession.h"
 #include "calculationhistory.h"
 #include "historydialog.h"
 #include "historypanel.h"
@@ -11,25 +9,36 @@
 #include "memorydropdowndialog.h"
 #include "uianimations.h"
 #include "thememanager.h"
+#include "tracer.h"
+#include "logcategories.h"
 
-#include <QDebug>
 #include <QApplication>
 #include <QClipboard>
+#include <QFile>
 #include <QHBoxLayout>
+#include <QShortcut>
 
 MainWindow::MainWindow(QWidget *parent)
     : QMainWindow(parent)
     , ui(new Ui::MainWindow)
-    , m_calcHandler(new CalcHandler(this))
+    , m_persistence(new PersistenceWorker(PersistenceWorker::DEFAULT_DEBOUNCE_INTERVAL, this))
     , m_history(new CalculationHistory(this))
     , m_memory(new MemoryManager(this))
+    , m_session(new CalculatorSession(m_history, m_memory, this))
     , m_themeManager(new ThemeManager(this))
     , m_historyPanel(nullptr)
-    , m_operatorClicked(false)
-    , m_resultDisplayed(false)
+    , m_latency(nullptr)
 {
+    const TraceSpan span("startup", "MainWindow::MainWindow");
+    m_history->setPersistenceWorker(m_persistence);
+    m_themeManager->setPersistenceWorker(m_persistence);
+    
     setupUi();
-    m_history->loadFromFile("calculator_history.txt");
+    if (!QFile::exists(CalculatorConfig::HISTORY_JOURNAL_FILE)
+        && QFile::exists(CalculatorConfig::HISTORY_TEXT_FILE)) {
+        m_history->loadFromFile(CalculatorConfig::HISTORY_TEXT_FILE);
+    }
+    m_history->openJournal(CalculatorConfig::HISTORY_JOURNAL_FILE);
     
     connect(m_memory, &MemoryManager::memoryChanged, 
             this, &MainWindow::onMemoryChanged);
@@ -38,19 +47,53 @@ MainWindow::MainWindow(QWidget *parent)
             this, &MainWindow::onThemeChanged);
     
     m_themeManager->loadThemePreference();
+
+    const QString keystrokeLog = QString::fromLocal8Bit(
+        qgetenv(CalculatorConfig::KEYSTROKE_LOG_VARIABLE));
+    if (!keystrokeLog.isEmpty() && !m_keystrokes.open(keystrokeLog, m_session)) {
+        qCWarning(lcUi) << "Не удалось открыть журнал нажатий:" << keystrokeLog;
+    }
+
+    const QByteArray latency = qgetenv(CalculatorConfig::LATENCY_VARIABLE);
+    if (!latency.isEmpty() && latency != "0") {
+        m_latency = new LatencyMonitor(ui->displayRes, this);
+        connect(new QShortcut(QKeySequence("Ctrl+Shift+L"), this), &QShortcut::activated,
+                m_latency, &LatencyMonitor::toggleOverlay);
+        connect(new QShortcut(QKeySequence("Ctrl+Shift+J"), this), &QShortcut::activated,
+                m_latency, &LatencyMonitor::dumpReport);
+    }
+
+    if (Tracer::isEnabled()) {
+        connect(new QShortcut(QKeySequence("Ctrl+Shift+P"), this), &QShortcut::activated,
+                this, &MainWindow::onDumpTraceRequested);
+    }
 }
 
 MainWindow::~MainWindow()
 {
-    m_history->saveToFile("calculator_history.txt");
+    if (m_latency) {
+        m_latency->dumpReport();
+    }
+    m_keystrokes.close();
+    // Записи уже в журнале: остается дописать буфер. Запись идет в фоне,
+    // а ждать ее приходится только здесь, когда окно уже закрыто
+    m_history->closeJournal();
     m_themeManager->saveThemePreference();
+    m_persistence->flush();
+    m_history->setPersistenceWorker(nullptr);
+    m_themeManager->setPersistenceWorker(nullptr);
     delete ui;
+    // После flush(): в трассе есть и фоновые записи на диск
+    if (Tracer::isEnabled()) {
+        onDumpTraceRequested();
+    }
 }
 
 void MainWindow::setupUi()
 {
+    const TraceSpan span("startup", "MainWindow::setupUi");
     ui->setupUi(this);
-    clearDisplay();
+    ui->displayRes->setText(m_session->displayText());
     
     // Создать боковую панель истории
     m_historyPanel = new HistoryPanel(m_history, this);
@@ -78,6 +121,11 @@ void MainWindow::setupUi()
 
 void MainWindow::connectSignals()
 {
+    connect(m_session, &CalculatorSession::displayChanged,
+            ui->displayRes, &QLabel::setText);
+    connect(m_session, &CalculatorSession::errorOccurred,
+            this, &MainWindow::onSessionError);
+
     connect(ui->groupNums,
             static_cast<void (QButtonGroup::*)(QAbstractButton*)>(&QButtonGroup::buttonClicked),
             this, &MainWindow::onNumberButtonClicked);
@@ -113,51 +161,24 @@ void MainWindow::connectSignals()
 
 void MainWindow::onNumberButtonClicked(QAbstractButton *button)
 {
-    handleDigitInput(button->text());
+    CalculatorSession::Key key;
+    if (CalculatorSession::keyFromChar(button->text().at(0), key)) {
+        handleDigitInput(key);
+    }
 }
 
-void MainWindow::handleDigitInput(const QString& digit)
+void MainWindow::handleDigitInput(CalculatorSession::Key digit)
 {
-    QString displayText = getDisplayText();
-    
-    if (m_operatorClicked || m_resultDisplayed) {
-        displayText.clear();
-        m_operatorClicked = false;
-        m_resultDisplayed = false;
-    }
-    
-    if (!InputValidator::canAddDigit(displayText, CalculatorConfig::MAX_DIGIT_LENGTH)) {
-        qDebug() << "Достигнут лимит символов";
+    if (!press(digit)) {
+        qCDebug(lcUi) << "Достигнут лимит символов";
         UIAnimations::shake(ui->displayRes, 300);
         UIAnimations::flashError(ui->displayRes, 200);
-        return;
     }
-    
-    displayText.append(digit);
-    setDisplayText(displayText);
 }
 
 void MainWindow::onDecimalPointClicked()
 {
-    QString displayText = getDisplayText();
-
-    if (m_operatorClicked || m_resultDisplayed) {
-        displayText.clear();
-        m_operatorClicked = false;
-        m_resultDisplayed = false;
-    }
-    
-    if (!InputValidator::canAddDecimalPoint(displayText, CalculatorConfig::MAX_DIGIT_LENGTH)) {
-        return;
-    }
-    
-    if (displayText.isEmpty()) {
-        displayText = CalculatorConfig::ZERO_WITH_DECIMAL;
-    } else {
-        displayText.append(CalculatorConfig::DECIMAL_SEPARATOR);
-    }
-    
-    setDisplayText(displayText);
+    press(CalculatorSession::Key::DecimalPoint);
 }
 
 void MainWindow::onOperatorButtonClicked(QAbstractButton *button)
@@ -167,149 +188,55 @@ void MainWindow::onOperatorButtonClicked(QAbstractButton *button)
 
 void MainWindow::handleOperatorInput(QChar operatorChar)
 {
-    const bool wasOperatorClicked = m_operatorClicked;
-    QString displayText = getDisplayText();
-    if (InputValidator::isNotEmpty(displayText) && !DisplayFormatter::isValidNumber(displayText)) {
-        showError(CalculatorConfig::ERROR_INVALID_INPUT);
-        return;
-    }
-    
-    if (m_calcHandler->hasStoredValue()
-        && !m_operatorClicked
-        && !m_resultDisplayed
-        && m_calcHandler->currentOperation() != CalcHandler::Operation::None) {
-        if (InputValidator::isNotEmpty(displayText)) {
-            performCalculation();
-            displayText = getDisplayText();
-        }
+    CalculatorSession::Key key;
+    if (CalculatorSession::keyFromChar(operatorChar, key)) {
+        press(key);
     }
-    
-    if (!wasOperatorClicked && InputValidator::isNotEmpty(displayText)) {
-        bool ok = false;
-        double value = DisplayFormatter::toDouble(displayText, &ok);
-        if (!ok) {
-            showError(CalculatorConfig::ERROR_INVALID_INPUT);
-            return;
-        }
-        m_calcHandler->setOperand(value);
-        m_lastExpression = displayText;
-    }
-    
-    CalcHandler::Operation op = CalcHandler::operationFromChar(operatorChar);
-    m_calcHandler->setOperation(op);
-    
-    if (!m_lastExpression.isEmpty()) {
-        if (wasOperatorClicked && m_lastExpression.size() >= 3) {
-            m_lastExpression.chop(3);
-        }
-        m_lastExpression += QString(" %1 ").arg(operatorChar);
-    }
-    
-    m_operatorClicked = true;
-    m_resultDisplayed = false;
 }
 
 void MainWindow::onEqualClicked()
 {
-    if (!m_calcHandler->hasStoredValue()) {
-        return;
-    }
-
-    if (m_calcHandler->currentOperation() == CalcHandler::Operation::None) {
-        return;
-    }
-    
-    performCalculation();
-}
-
-void MainWindow::performCalculation()
-{
-    QString displayText = getDisplayText();
-    
-    if (displayText.isEmpty()) {
-        return;
-    }
-    
-    displayText = DisplayFormatter::removeTrailingDecimal(displayText);
-    
-    bool ok = false;
-    double operand = DisplayFormatter::toDouble(displayText, &ok);
-    if (!ok) {
-        showError(CalculatorConfig::ERROR_INVALID_INPUT);
-        return;
-    }
-    double storedValue = m_calcHandler->storedValue();
-    CalcHandler::Operation op = m_calcHandler->currentOperation();
-    
-    CalcHandler::CalculationResult result = 
-        m_calcHandler->performBinaryOperation(storedValue, operand, op);
-    
-    if (result.success) {
-        QString formattedResult = DisplayFormatter::formatNumber(
-            result.value, CalculatorConfig::MAX_DIGIT_LENGTH);
-        setDisplayText(formattedResult);
-        
-        QString fullExpression = m_lastExpression + displayText + " = " + formattedResult;
-        m_history->addEntry(fullExpression);
-        m_lastExpression.clear();
-        
-        m_resultDisplayed = true;
-    } else {
-        showError(result.errorMessage);
-    }
-    
-    m_operatorClicked = false;
+    press(CalculatorSession::Key::Equals);
 }
 
 void MainWindow::onPercentClicked()
 {
-    applyUnaryOperation(CalcHandler::Operation::Percent);
+    press(CalculatorSession::Key::Percent);
 }
 
 void MainWindow::onSignToggleClicked()
 {
-    applyUnaryOperation(CalcHandler::Operation::Negate);
+    press(CalculatorSession::Key::Negate);
 }
 
 void MainWindow::onSquareClicked()
 {
-    applyUnaryOperation(CalcHandler::Operation::Square);
+    press(CalculatorSession::Key::Square);
 }
 
 void MainWindow::onSqrtClicked()
 {
-    applyUnaryOperation(CalcHandler::Operation::SquareRoot);
+    press(CalculatorSession::Key::SquareRoot);
 }
 
 void MainWindow::onReciprocalClicked()
 {
-    applyUnaryOperation(CalcHandler::Operation::Reciprocal);
+    press(CalculatorSession::Key::Reciprocal);
 }
 
 void MainWindow::onDeleteClicked()
 {
-    QString displayText = getDisplayText();
-    
-    if (displayText.isEmpty()) {
-        return;
-    }
-    
-    displayText.chop(1);
-    setDisplayText(displayText);
+    press(CalculatorSession::Key::Backspace);
 }
 
 void MainWindow::onClearClicked()
 {
-    clearDisplay();
-    m_calcHandler->clear();
-    m_operatorClicked = false;
-    m_resultDisplayed = false;
+    press(CalculatorSession::Key::Clear);
 }
 
 void MainWindow::onClearEntryClicked()
 {
-    clearDisplay();
-    m_resultDisplayed = false;
+    press(CalculatorSession::Key::ClearEntry);
 }
 
 void MainWindow::onCopyClicked()
@@ -318,7 +245,7 @@ void MainWindow::onCopyClicked()
     if (!text.isEmpty()) {
         QApplication::clipboard()->setText(text);
         UIAnimations::flashSuccess(ui->displayRes, 200);
-        qDebug() << "Скопировано в буфер обмена:" << text;
+        qCDebug(lcUi) << "Скопировано в буфер обмена:" << text;
     }
 }
 
@@ -335,83 +262,45 @@ void MainWindow::onHistoryClicked()
 
 void MainWindow::onMemoryAddClicked()
 {
-    QString displayText = getDisplayText();
-    if (displayText.isEmpty()) {
-        return;
-    }
-    
-    bool ok = false;
-    double value = DisplayFormatter::toDouble(displayText, &ok);
-    if (!ok) {
-        showError(CalculatorConfig::ERROR_INVALID_INPUT);
-        return;
+    if (press(CalculatorSession::Key::MemoryAdd)) {
+        qCDebug(lcMemory) << "M+: Добавлено" << m_session->displayText() << "к памяти";
     }
-    m_memory->add(value);
-    qDebug() << "M+: Добавлено" << value << "к памяти";
 }
 
 void MainWindow::onMemorySubtractClicked()
 {
-    QString displayText = getDisplayText();
-    if (displayText.isEmpty()) {
-        return;
+    if (press(CalculatorSession::Key::MemorySubtract)) {
+        qCDebug(lcMemory) << "M-: Вычтено" << m_session->displayText() << "из памяти";
     }
-    
-    bool ok = false;
-    double value = DisplayFormatter::toDouble(displayText, &ok);
-    if (!ok) {
-        showError(CalculatorConfig::ERROR_INVALID_INPUT);
-        return;
-    }
-    m_memory->subtract(value);
-    qDebug() << "M-: Вычтено" << value << "из памяти";
 }
 
 void MainWindow::onMemoryRecallClicked()
 {
-    if (!m_memory->hasValue()) {
-        qDebug() << "MR: Память пуста";
+    if (!press(CalculatorSession::Key::MemoryRecall)) {
+        qCDebug(lcMemory) << "MR: Память пуста";
         return;
     }
-    
-    double value = m_memory->recall();
-    QString formattedValue = DisplayFormatter::formatNumber(
-        value, CalculatorConfig::MAX_DIGIT_LENGTH);
-    setDisplayText(formattedValue);
-    
-    m_resultDisplayed = true;
-    qDebug() << "MR: Вспомнено" << value;
+    qCDebug(lcMemory) << "MR: Вспомнено" << m_memory->recall();
 }
 
 void MainWindow::onMemoryClearClicked()
 {
-    m_memory->clear();
-    qDebug() << "MC: Память очищена";
+    press(CalculatorSession::Key::MemoryClear);
+    qCDebug(lcMemory) << "MC: Память очищена";
 }
 
 void MainWindow::onMemoryStoreClicked()
 {
-    QString displayText = getDisplayText();
-    if (displayText.isEmpty()) {
-        return;
-    }
-    
-    bool ok = false;
-    double value = DisplayFormatter::toDouble(displayText, &ok);
-    if (!ok) {
-        showError(CalculatorConfig::ERROR_INVALID_INPUT);
-        return;
+    if (press(CalculatorSession::Key::MemoryStore)) {
+        UIAnimations::flashSuccess(ui->displayRes, 200);
+        qCDebug(lcMemory) << "MS: Сохранено в память:" << m_memory->recall();
     }
-    m_memory->store(value);
-    m_memory->addToList(value);
-    UIAnimations::flashSuccess(ui->displayRes, 200);
-    qDebug() << "MS: Сохранено в память:" << value;
 }
 
 void MainWindow::onMemoryDropdownClicked()
 {
     if (m_memory->listSize() == 0) {
-        qDebug() << "M˅: Список памяти пуст";
+        qCDebug(lcMemory) << "M˅: Список памяти пуст";
         UIAnimations::shake(ui->displayRes, 300);
         UIAnimations::flashError(ui->displayRes, 200);
         return;
@@ -425,17 +314,27 @@ void MainWindow::onMemoryDropdownClicked()
 
 void MainWindow::onMemoryValueSelected(double value)
 {
-    QString formattedValue = DisplayFormatter::formatNumber(
-        value, CalculatorConfig::MAX_DIGIT_LENGTH);
-    setDisplayText(formattedValue);
-    m_resultDisplayed = true;
-    qDebug() << "Выбрано значение из списка памяти:" << value;
+    m_keystrokes.recordValue(value);
+    if (m_latency) {
+        m_latency->inputStarted(LatencyMonitor::InputType::Memory);
+    }
+    m_session->showValue(value);
+    if (m_latency) {
+        m_latency->inputFinished();
+    }
+    m_keystrokes.recordCheck();
+    qCDebug(lcMemory) << "Выбрано значение из списка памяти:" << value;
+}
+
+void MainWindow::onSessionError()
+{
+    UIAnimations::flashError(ui->displayRes);
 }
 
 void MainWindow::onMemoryChanged(bool hasValue)
 {
     // Обновить индикатор памяти в UI (если есть)
-    qDebug() << "Память изменена. Есть значение:" << hasValue;
+    qCDebug(lcMemory) << "Память изменена. Есть значение:" << hasValue;
 }
 
 void MainWindow::onToggleThemeClicked()
@@ -446,104 +345,80 @@ void MainWindow::onToggleThemeClicked()
         : ThemeManager::Theme::Light;
     
     m_themeManager->setTheme(newTheme);
-    qDebug() << "Тема переключена на:" << ThemeManager::themeName(newTheme);
+    qCDebug(lcTheme) << "Тема переключена на:" << ThemeManager::themeName(newTheme);
 }
 
 void MainWindow::onThemeChanged(ThemeManager::Theme theme)
 {
-    qDebug() << "Применена тема:" << ThemeManager::themeName(theme);
-}
-
-QString MainWindow::getDisplayText() const
-{
-    return ui->displayRes->text();
-}
-
-void MainWindow::setDisplayText(const QString& text)
-{
-    ui->displayRes->setText(text);
+    qCDebug(lcTheme) << "Применена тема:" << ThemeManager::themeName(theme);
+    // Сохраняется сразу, а не при выходе: запись в фоне и сливается с соседними
+    m_themeManager->saveThemePreference();
 }
 
-void MainWindow::clearDisplay()
+void MainWindow::onDumpTraceRequested()
 {
-    ui->displayRes->clear();
+    if (Tracer::writeJson(CalculatorConfig::TRACE_FILE)) {
+        qCInfo(lcUi) << "Трасса записана в" << CalculatorConfig::TRACE_FILE
+                 << "(" << Tracer::eventCount() << "событий)";
+    } else {
+        qCWarning(lcUi) << "Не удалось записать" << CalculatorConfig::TRACE_FILE;
+    }
 }
 
-void MainWindow::showError(const QString& errorMessage)
+QString MainWindow::getDisplayText() const
 {
-    setDisplayText(errorMessage);
-    UIAnimations::flashError(ui->displayRes);
-    m_resultDisplayed = true;
+    return m_session->displayText();
 }
 
-void MainWindow::applyUnaryOperation(CalcHandler::Operation op)
+bool MainWindow::press(CalculatorSession::Key key)
 {
-    QString displayText = getDisplayText();
-    if (displayText.isEmpty()) {
-        return;
+    m_keystrokes.recordKey(key);
+    if (m_latency) {
+        m_latency->inputStarted(LatencyMonitor::inputType(key));
     }
-
-    bool ok = false;
-    double value = DisplayFormatter::toDouble(displayText, &ok);
-    if (!ok) {
-        showError(CalculatorConfig::ERROR_INVALID_INPUT);
-        return;
+    const bool accepted = m_session->press(key);
+    if (m_latency) {
+        m_latency->inputFinished();
     }
-    CalcHandler::CalculationResult result =
-        m_calcHandler->applyUnaryOperation(op, value);
-
-    if (result.success) {
-        QString formattedResult = DisplayFormatter::formatNumber(
-            result.value, CalculatorConfig::MAX_DIGIT_LENGTH);
-        setDisplayText(formattedResult);
-        
-        QString operationName = CalcHandler::operationToString(op);
-        QString fullExpression = QString("%1(%2) = %3")
-            .arg(operationName)
-            .arg(displayText)
-            .arg(formattedResult);
-        m_history->addEntry(fullExpression);
-        
-        m_operatorClicked = false;
-        m_resultDisplayed = true;
-    } else {
-        showError(result.errorMessage);
-        m_operatorClicked = false;
+    // Результат или ошибка на дисплее - точка сверки при воспроизведении
+    if (m_session->isResultDisplayed()) {
+        m_keystrokes.recordCheck();
     }
+    return accepted;
 }
 
 void MainWindow::keyPressEvent(QKeyEvent *event)
 {
     switch (event->key()) {
         case Qt::Key_0:
-            handleDigitInput("0");
+            handleDigitInput(CalculatorSession::digitKey(0));
             break;
         case Qt::Key_1:
-            handleDigitInput("1");
+            handleDigitInput(CalculatorSession::digitKey(1));
             break;
         case Qt::Key_2:
-            handleDigitInput("2");
+            handleDigitInput(CalculatorSession::digitKey(2));
             break;
         case Qt::Key_3:
-            handleDigitInput("3");
+            handleDigitInput(CalculatorSession::digitKey(3));
             break;
         case Qt::Key_4:
-            handleDigitInput("4");
+            handleDigitInput(CalculatorSession::digitKey(4));
             break;
         case Qt::Key_5:
-            handleDigitInput("5");
+            handleDigitInput(CalculatorSession::digitKey(5));
             break;
         case Qt::Key_6:
-            handleDigitInput("6");
+            handleDigitInput(CalculatorSession::digitKey(6));
             break;
         case Qt::Key_7:
-            handleDigitInput("7");
+            handleDigitInput(CalculatorSession::digitKey(7));
             break;
         case Qt::Key_8:
-            handleDigitInput("8");
+            handleDigitInput(CalculatorSession::digitKey(8));
             break;
         case Qt::Key_9:
-            handleDigitInput("9");
+            handleDigitInput(CalculatorSession::digitKey(9));
             break;
         
         case Qt::Key_Plus:
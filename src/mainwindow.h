@@ -6,19 +6,22 @@
 #include <QKeyEvent>
 #include <QClipboard>
 #include <QHBoxLayout>
-#include "calchandler.h"
+#include "calculatorsession.h"
+#include "keystrokelog.h"
+#include "latencymonitor.h"
 #include "calculationhistory.h"
 #include "memorymanager.h"
 #include "thememanager.h"
 #include "historypanel.h"
+#include "persistenceworker.h"
 
 QT_BEGIN_NAMESPACE
 namespace Ui { class MainWindow; }
 QT_END_NAMESPACE
 
 // Главное окно калькулятора
-// Отвечает только за UI-логику: обработку событий кнопок и клавиатуры,
-// обновление дисплея. Вся бизнес-логика в CalcHandler.
+// Отвечает только за UI-логику: переводит кнопки и клавиатуру в нажатия
+// CalculatorSession, показывает ее дисплей и анимирует ошибки.
 class MainWindow : public QMainWindow
 {
     Q_OBJECT
@@ -63,43 +66,41 @@ private slots:
     void onMemoryDropdownClicked();
     void onMemoryChanged(bool hasValue);
     void onMemoryValueSelected(double value);
+    void onSessionError();
 
 private slots:
     // Управление темой
     void onToggleThemeClicked();
     void onThemeChanged(ThemeManager::Theme theme);
 
+private slots:
+    // Трасса Tracer в CalculatorConfig::TRACE_FILE (Ctrl+Shift+P и при выходе)
+    void onDumpTraceRequested();
+
 private:
     // Инициализация
     void setupUi();
     void connectSignals();
 
 private:
-    // Работа с дисплеем
+    // Делегирование в CalculatorSession; нажатия попадают в журнал, если он включен
     QString getDisplayText() const;
-    void setDisplayText(const QString& text);
-    void clearDisplay();
-    void showError(const QString& errorMessage);
-
-private:
-    // Делегирование в бизнес-логику
-    void performCalculation();
-    void handleDigitInput(const QString& digit);
+    bool press(CalculatorSession::Key key);
+    void handleDigitInput(CalculatorSession::Key digit);
     void handleOperatorInput(QChar operatorChar);
-    void applyUnaryOperation(CalcHandler::Operation op);
-
-private:
-    bool m_operatorClicked;  // Был ли нажат оператор
-    bool m_resultDisplayed;  // Отображен ли результат
-    QString m_lastExpression; // Последнее выражение для истории
 
 private:
     Ui::MainWindow *ui;
-    CalcHandler *m_calcHandler;
+    // Создается первым: остальные объекты ставят в него записи на диск
+    PersistenceWorker *m_persistence;
     CalculationHistory *m_history;
     MemoryManager *m_memory;
+    CalculatorSession *m_session;
     ThemeManager *m_themeManager;
     HistoryPanel *m_historyPanel;
+    KeystrokeLog::Recorder m_keystrokes;
+    // nullptr, если замер задержек выключен
+    LatencyMonitor *m_latency;
 };
 
 #endif // MAINWINDOW_H
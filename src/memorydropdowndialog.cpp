@@ -1,9 +1,9 @@
 #include "memorydropdowndialog.h"
 #include "displayformatter.h"
 #include "calculatorconfig.h"
+#include "logcategories.h"
 #include <QHBoxLayout>
 #include <QLabel>
-#include <QDebug>
 
 MemoryDropdownDialog::MemoryDropdownDialog(MemoryManager* memory, QWidget* parent)
     : QDialog(parent)
@@ -71,7 +71,7 @@ void MemoryDropdownDialog::onItemDoubleClicked(QListWidgetItem* item)
     
     if (row >= 0 && row < memoryList.size()) {
         double value = memoryList.at(row);
-        qDebug() << "Выбрано значение из списка:" << value;
+        qCDebug(lcMemory) << "Выбрано значение из списка:" << value;
         emit valueSelected(value);
         accept();
     }
@@ -80,7 +80,7 @@ void MemoryDropdownDialog::onItemDoubleClicked(QListWidgetItem* item)
 void MemoryDropdownDialog::onClearAllClicked()
 {
     m_memory->clearList();
-    qDebug() << "Весь список памяти очищен";
+    qCDebug(lcMemory) << "Весь список памяти очищен";
 }
 
 void MemoryDropdownDialog::onDeleteClicked()
@@ -88,7 +88,7 @@ void MemoryDropdownDialog::onDeleteClicked()
     int currentRow = m_listWidget->currentRow();
     if (currentRow >= 0) {
         m_memory->removeFromList(currentRow);
-        qDebug() << "Удален элемент из списка:" << currentRow;
+        qCDebug(lcMemory) << "Удален элемент из списка:" << currentRow;
     }
 }
 
@@ -118,5 +118,5 @@ void MemoryDropdownDialog::updateList()
         m_listWidget->addItem(item);
     }
     
-    qDebug() << "Список памяти обновлен. Элементов:" << memoryList.size();
+    qCDebug(lcMemory) << "Список памяти обновлен. Элементов:" << memoryList.size();
 }
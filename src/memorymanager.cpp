@@ -1,5 +1,5 @@
 #include "memorymanager.h"
-#include <QDebug>
+#include "logcategories.h"
 #include <cmath>
 
 MemoryManager::MemoryManager(QObject *parent)
@@ -11,34 +11,34 @@ MemoryManager::MemoryManager(QObject *parent)
 void MemoryManager::add(double value)
 {
     m_memory += value;
-    qDebug() << "M+:" << value << "-> Память:" << m_memory;
+    qCDebug(lcMemory) << "M+:" << value << "-> Память:" << m_memory;
     notifyChange();
 }
 
 void MemoryManager::subtract(double value)
 {
     m_memory -= value;
-    qDebug() << "M-:" << value << "-> Память:" << m_memory;
+    qCDebug(lcMemory) << "M-:" << value << "-> Память:" << m_memory;
     notifyChange();
 }
 
 double MemoryManager::recall() const
 {
-    qDebug() << "MR: Вспомнить" << m_memory;
+    qCDebug(lcMemory) << "MR: Вспомнить" << m_memory;
     return m_memory;
 }
 
 void MemoryManager::clear()
 {
     m_memory = 0.0;
-    qDebug() << "MC: Память очищена";
+    qCDebug(lcMemory) << "MC: Память очищена";
     notifyChange();
 }
 
 void MemoryManager::store(double value)
 {
     m_memory = value;
-    qDebug() << "MS: Сохранено в память:" << value;
+    qCDebug(lcMemory) << "MS: Сохранено в память:" << value;
     notifyChange();
 }
 
@@ -56,11 +56,11 @@ void MemoryManager::addToList(double value)
 {
     if (m_memoryList.size() >= MAX_MEMORY_ITEMS) {
         m_memoryList.removeLast();
-        qDebug() << "Список памяти полон, удален последний элемент";
+        qCDebug(lcMemory) << "Список памяти полон, удален последний элемент";
     }
     
     m_memoryList.prepend(value);
-    qDebug() << "Добавлено в список памяти:" << value << "Размер списка:" << m_memoryList.size();
+    qCDebug(lcMemory) << "Добавлено в список памяти:" << value << "Размер списка:" << m_memoryList.size();
     notifyListChange();
 }
 
@@ -73,10 +73,10 @@ void MemoryManager::recallFromList(int index)
 {
     if (index >= 0 && index < m_memoryList.size()) {
         m_memory = m_memoryList.at(index);
-        qDebug() << "Вспомнить из списка [" << index << "]:" << m_memory;
+        qCDebug(lcMemory) << "Вспомнить из списка [" << index << "]:" << m_memory;
         notifyChange();
     } else {
-        qDebug() << "Ошибка: неверный индекс" << index;
+        qCWarning(lcMemory) << "Ошибка: неверный индекс" << index;
     }
 }
 
@@ -85,17 +85,17 @@ void MemoryManager::removeFromList(int index)
     if (index >= 0 && index < m_memoryList.size()) {
         double removed = m_memoryList.at(index);
         m_memoryList.removeAt(index);
-        qDebug() << "Удалено из списка [" << index << "]:" << removed;
+        qCDebug(lcMemory) << "Удалено из списка [" << index << "]:" << removed;
         notifyListChange();
     } else {
-        qDebug() << "Ошибка: неверный индекс" << index;
+        qCWarning(lcMemory) << "Ошибка: неверный индекс" << index;
     }
 }
 
 void MemoryManager::clearList()
 {
     m_memoryList.clear();
-    qDebug() << "Список памяти очищен";
+    qCDebug(lcMemory) << "Список памяти очищен";
     notifyListChange();
 }
 
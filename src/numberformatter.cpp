@@ -0,0 +1,967 @@
+#include "numberformatter.h"
+#include <QByteArray>
+#include <QString>
+#include <cstring>
+#include <limits>
+
+// Schubfach: R. Giulietti, "The Schubfach way to render doubles" (2020).
+// Значение c * 2^q умножается на 10^-k (126-битная таблица ниже) с округлением
+// к нечетному, после чего среди кандидатов s*10^k и (s+1)*10^k, а при s >= 100 -
+// и среди более коротких s'*10^(k+1), выбирается тот, что лежит в интервале округления.
+
+namespace {
+
+const int K_MIN = -324;
+const int K_MAX = 292;
+const int Q_MIN = -1074;
+const quint64 C_MIN = Q_UINT64_C(1) << 52;
+const quint64 MASK_63 = (Q_UINT64_C(1) << 63) - 1;
+const quint64 SIGNIFICAND_MASK = C_MIN - 1;
+const int EXPONENT_MASK = 0x7ff;
+// Раскладка formatShortest: как 'g' с 17 значащими цифрами
+const int SHORTEST_LAYOUT_PRECISION = 17;
+
+// g(k) = floor(10^-k * 2^(125 - floor(log2(10^-k)))) + 1 для k = K_MIN..K_MAX,
+// разбитое на старшие и младшие 63 бита: {g >> 63, g & MASK_63}
+const quint64 POW10_TABLE[K_MAX - K_MIN + 1][2] = {
+    {Q_UINT64_C(0x4f0cedc95a718dd4), Q_UINT64_C(0x5b01e8b09aa0d1b5)},
+    {Q_UINT64_C(0x7e7b160ef71c1621), Q_UINT64_C(0x119ca780f767b5ee)},
+    {Q_UINT64_C(0x652f44d8c5b011b4), Q_UINT64_C(0x0e16ec672c52f7f2)},
+    {Q_UINT64_C(0x50f29d7a37c00e29), Q_UINT64_C(0x581256b8f0425ff5)},
+    {Q_UINT64_C(0x40c21794f96671ba), Q_UINT64_C(0x79a84560c0351991)},
+    {Q_UINT64_C(0x679cf287f570b5f7), Q_UINT64_C(0x75da089acd21c281)},
+    {Q_UINT64_C(0x52e3f5399126f7f9), Q_UINT64_C(0x44ae6d48a41b0201)},
+    {Q_UINT64_C(0x424ff76140ebf994), Q_UINT64_C(0x36f1f106e9af34cd)},
+    {Q_UINT64_C(0x6a198bcece465c20), Q_UINT64_C(0x57e981a4a918547b)},
+    {Q_UINT64_C(0x54e13ca571d1e34d), Q_UINT64_C(0x2cbace1d541376c9)},
+    {Q_UINT64_C(0x43e763b78e4182a4), Q_UINT64_C(0x23c8a4e44342c56e)},
+    {Q_UINT64_C(0x6ca56c58e39c043a), Q_UINT64_C(0x060dd4a06b9e08b0)},
+    {Q_UINT64_C(0x56eabd13e9499cfb), Q_UINT64_C(0x1e7176e6bc7e6d59)},
+    {Q_UINT64_C(0x458897432107b0c8), Q_UINT64_C(0x7ec12bebc9febde1)},
+    {Q_UINT64_C(0x6f40f20501a5e7a7), Q_UINT64_C(0x7e01dfdfa9979635)},
+    {Q_UINT64_C(0x5900c19d9aeb1fb9), Q_UINT64_C(0x4b34b319547944f7)},
+    {Q_UINT64_C(0x4733ce17af227fc7), Q_UINT64_C(0x55c3c27aa9fa9d93)},
+    {Q_UINT64_C(0x71ec7cf2b1d0cc72), Q_UINT64_C(0x560603f7765dc8ea)},
+    {Q_UINT64_C(0x5b2397288e40a38e), Q_UINT64_C(0x7804cff92b7e3a55)},
+    {Q_UINT64_C(0x48e945ba0b66e93f), Q_UINT64_C(0x13370cc755fe9511)},
+    {Q_UINT64_C(0x74a86f90123e41fe), Q_UINT64_C(0x51f1ae0bbcca881b)},
+    {Q_UINT64_C(0x5d538c7341cb67fe), Q_UINT64_C(0x74c1580963d539af)},
+    {Q_UINT64_C(0x4aa93d29016f8665), Q_UINT64_C(0x43cde0078310faf3)},
+    {Q_UINT64_C(0x77752ea8024c0a3c), Q_UINT64_C(0x0616333f381b2b1e)},
+    {Q_UINT64_C(0x5f90f22001d66e96), Q_UINT64_C(0x3811c298f9af55b1)},
+    {Q_UINT64_C(0x4c73f4e667debede), Q_UINT64_C(0x600e35472e25de28)},
+    {Q_UINT64_C(0x7a532170a6313164), Q_UINT64_C(0x3349eed849d6303f)},
+    {Q_UINT64_C(0x61dc1ac084f42783), Q_UINT64_C(0x42a18be03b11c033)},
+    {Q_UINT64_C(0x4e49af006a5cec69), Q_UINT64_C(0x1bb46fe695a7ccf5)},
+    {Q_UINT64_C(0x7d42b19a43c7e0a8), Q_UINT64_C(0x2c53e63dbc3fae55)},
+    {Q_UINT64_C(0x64355ae1cfd31a20), Q_UINT64_C(0x237651cafcffbeaa)},
+    {Q_UINT64_C(0x502aaf1b0ca8e1b3), Q_UINT64_C(0x35f8416f30cc9888)},
+    {Q_UINT64_C(0x402225af3d53e7c2), Q_UINT64_C(0x5e603458f3d6e06d)},
+    {Q_UINT64_C(0x669d0918621fd937), Q_UINT64_C(0x4a3386f4b957cd7b)},
+    {Q_UINT64_C(0x52173a79e8197a92), Q_UINT64_C(0x6e8f9f2a2ddfd796)},
+    {Q_UINT64_C(0x41ac2ec7ece12edb), Q_UINT64_C(0x720c7f54f17fdfab)},
+    {Q_UINT64_C(0x69137e0cae3517c6), Q_UINT64_C(0x1ce0cbbb1bffcc45)},
+    {Q_UINT64_C(0x540f980a24f74638), Q_UINT64_C(0x171a3c95afffd69e)},
+    {Q_UINT64_C(0x433facd4ea5f6b60), Q_UINT64_C(0x127b63aaf3331218)},
+    {Q_UINT64_C(0x6b991487dd657899), Q_UINT64_C(0x6a5f05de51eb5026)},
+    {Q_UINT64_C(0x5614106cb11dfa14), Q_UINT64_C(0x5518d17ea7ef7352)},
+    {Q_UINT64_C(0x44dcd9f08db194dd), Q_UINT64_C(0x2a7a41321ff2c2a8)},
+    {Q_UINT64_C(0x6e2e2980e2b5bafb), Q_UINT64_C(0x5d906850331e043f)},
+    {Q_UINT64_C(0x5824ee00b55e2f2f), Q_UINT64_C(0x647386a68f4b3699)},
+    {Q_UINT64_C(0x4683f19a2ab1bf59), Q_UINT64_C(0x36c2d21ed908f87b)},
+    {Q_UINT64_C(0x70d31c29dde93228), Q_UINT64_C(0x579e1cfe280e5a5d)},
+    {Q_UINT64_C(0x5a427cee4b20f4ed), Q_UINT64_C(0x2c7e7d98200b7b7e)},
+    {Q_UINT64_C(0x483530bea280c3f1), Q_UINT64_C(0x09fecae019a2c932)},
+    {Q_UINT64_C(0x73884dfdd0ce064e), Q_UINT64_C(0x43314499c29e0eb6)},
+    {Q_UINT64_C(0x5c6d0b3173d8050b), Q_UINT64_C(0x4f5a9d47cee4d891)},
+    {Q_UINT64_C(0x49f0d5c129799da2), Q_UINT64_C(0x72aee4397250ad41)},
+    {Q_UINT64_C(0x764e22cea8c295d1), Q_UINT64_C(0x377e39f583b44868)},
+    {Q_UINT64_C(0x5ea4e8a553cede41), Q_UINT64_C(0x12cb61913629d387)},
+    {Q_UINT64_C(0x4bb72084430be500), Q_UINT64_C(0x756f8140f8217605)},
+    {Q_UINT64_C(0x792500d39e796e67), Q_UINT64_C(0x6f18cece59cf233c)},
+    {Q_UINT64_C(0x60ea670fb1fabeb9), Q_UINT64_C(0x3f470bd847d8e8fd)},
+    {Q_UINT64_C(0x4d885272f4c89894), Q_UINT64_C(0x329f3cad064720ca)},
+    {Q_UINT64_C(0x7c0d50b7ee0dc0ed), Q_UINT64_C(0x37652de1a3a50143)},
+    {Q_UINT64_C(0x633dda2cbe716724), Q_UINT64_C(0x2c50f1814fb73436)},
+    {Q_UINT64_C(0x4f64ae8a31f45283), Q_UINT64_C(0x3d0d8e010c92902b)},
+    {Q_UINT64_C(0x7f077da9e986ea6b), Q_UINT64_C(0x7b48e334e0ea8045)},
+    {Q_UINT64_C(0x659f97bb2138bb89), Q_UINT64_C(0x49071c2a4d88669d)},
+    {Q_UINT64_C(0x514c796280fa2fa1), Q_UINT64_C(0x20d27ceea46d1ee4)},
+    {Q_UINT64_C(0x4109fab533fb594d), Q_UINT64_C(0x670eca58838a7f1d)},
+    {Q_UINT64_C(0x680ff788532bc216), Q_UINT64_C(0x0b4add5a6c10cb62)},
+    {Q_UINT64_C(0x533ff939dc2301ab), Q_UINT64_C(0x22a24aaebcda3c4e)},
+    {Q_UINT64_C(0x4299942e49b59aef), Q_UINT64_C(0x354ea22563e1c9d8)},
+    {Q_UINT64_C(0x6a8f537d42bc2b18), Q_UINT64_C(0x554a9d089fcfa95a)},
+    {Q_UINT64_C(0x553f75fdcefcef46), Q_UINT64_C(0x776ee406e63fbaae)},
+    {Q_UINT64_C(0x4432c4cb0bfd8c38), Q_UINT64_C(0x5f8be99f1e996225)},
+    {Q_UINT64_C(0x6d1e07ab466279f4), Q_UINT64_C(0x327975cb64289d08)},
+    {Q_UINT64_C(0x574b3955d1e86190), Q_UINT64_C(0x28612b091ced4a6d)},
+    {Q_UINT64_C(0x45d5c777db204e0d), Q_UINT64_C(0x06b4226db0bdd524)},
+    {Q_UINT64_C(0x6fbc72595e9a167b), Q_UINT64_C(0x24536a491ac95506)},
+    {Q_UINT64_C(0x59638eade54811fc), Q_UINT64_C(0x1d0f883a7bd44405)},
+    {Q_UINT64_C(0x4782d88b1dd34196), Q_UINT64_C(0x4a72d361fca9d004)},
+    {Q_UINT64_C(0x726af411c952028a), Q_UINT64_C(0x43eaebcffaa94cd3)},
+    {Q_UINT64_C(0x5b88c3416ddb353b), Q_UINT64_C(0x4fef230cc88770a9)},
+    {Q_UINT64_C(0x493a35cdf17c2a96), Q_UINT64_C(0x0cbf4f3d6d3926ee)},
+    {Q_UINT64_C(0x7529efafe8c6aa89), Q_UINT64_C(0x61321862485b717c)},
+    {Q_UINT64_C(0x5dbb262653d22207), Q_UINT64_C(0x675b46b506af8dfd)},
+    {Q_UINT64_C(0x4afc1e850fdb4e6c), Q_UINT64_C(0x52af6bc405593e64)},
+    {Q_UINT64_C(0x77f9ca6e7fc54a47), Q_UINT64_C(0x377f12d33bc1fd6d)},
+    {Q_UINT64_C(0x5ffb085866376e9f), Q_UINT64_C(0x45ff42429634cabd)},
+    {Q_UINT64_C(0x4cc8d379eb5f8bb2), Q_UINT64_C(0x6b329b68782a3bcb)},
+    {Q_UINT64_C(0x7adaebf64565ac51), Q_UINT64_C(0x2b842bda59dd2c77)},
+    {Q_UINT64_C(0x6248bcc5045156a7), Q_UINT64_C(0x3c69bcaeae4a89f9)},
+    {Q_UINT64_C(0x4ea0970403744552), Q_UINT64_C(0x6387ca25583ba194)},
+    {Q_UINT64_C(0x7dcdbe6cd253a21e), Q_UINT64_C(0x05a6103bc05f68ed)},
+    {Q_UINT64_C(0x64a498570ea94e7e), Q_UINT64_C(0x37b80cfc99e5ed8a)},
+    {Q_UINT64_C(0x5083ad1272210b98), Q_UINT64_C(0x2c933d96e184be08)},
+    {Q_UINT64_C(0x40695741f4e73c79), Q_UINT64_C(0x7075cadf1ad09807)},
+    {Q_UINT64_C(0x670ef2032171fa5c), Q_UINT64_C(0x4d8944982ae759a4)},
+    {Q_UINT64_C(0x52725b35b45b2eb0), Q_UINT64_C(0x3e076a135585e150)},
+    {Q_UINT64_C(0x41f515c49048f226), Q_UINT64_C(0x64d2bb42aad1810d)},
+    {Q_UINT64_C(0x698822d41a0e503e), Q_UINT64_C(0x07b7920444826815)},
+    {Q_UINT64_C(0x546ce8a9ae71d9cb), Q_UINT64_C(0x1fc60e69d0685344)},
+    {Q_UINT64_C(0x438a53baf1f4ae3c), Q_UINT64_C(0x196b3ebb0d20429d)},
+    {Q_UINT64_C(0x6c1085f7e9877d2d), Q_UINT64_C(0x0f11fdf815006a94)},
+    {Q_UINT64_C(0x56739e5fee05fdbd), Q_UINT64_C(0x58db319344005543)},
+    {Q_UINT64_C(0x45294b7ff19e6497), Q_UINT64_C(0x60af5adc3666aa9c)},
+    {Q_UINT64_C(0x6ea878ccb5ca3a8c), Q_UINT64_C(0x344bc4938a3dddc7)},
+    {Q_UINT64_C(0x5886c70a2b082ed6), Q_UINT64_C(0x5d096a0fa1cb17d2)},
+    {Q_UINT64_C(0x46d238d4ef39bf12), Q_UINT64_C(0x173abb3fb4a27975)},
+    {Q_UINT64_C(0x71505aee4b8f981d), Q_UINT64_C(0x0b912b992103f588)},
+    {Q_UINT64_C(0x5aa6af25093face4), Q_UINT64_C(0x0940efadb4032ad3)},
+    {Q_UINT64_C(0x488558ea6dcc8a50), Q_UINT64_C(0x07672624900288a9)},
+    {Q_UINT64_C(0x74088e43e2e0dd4c), Q_UINT64_C(0x723ea36db337410e)},
+    {Q_UINT64_C(0x5cd3a5031be71770), Q_UINT64_C(0x5b654f8af5c5cda5)},
+    {Q_UINT64_C(0x4a42ea68e31f45f3), Q_UINT64_C(0x62b772d5916b0aeb)},
+    {Q_UINT64_C(0x76d1770e38320986), Q_UINT64_C(0x0458b7bc1bde77dd)},
+    {Q_UINT64_C(0x5f0df8d82cf4d46b), Q_UINT64_C(0x1d13c630164b9318)},
+    {Q_UINT64_C(0x4c0b2d79bd90a9ef), Q_UINT64_C(0x30dc9e8cdea2dc13)},
+    {Q_UINT64_C(0x79ab7bf5fc1aa97f), Q_UINT64_C(0x0160fdae31049351)},
+    {Q_UINT64_C(0x6155fcc4c9aeedff), Q_UINT64_C(0x1ab3fe24f403a90e)},
+    {Q_UINT64_C(0x4dde63d0a158be65), Q_UINT64_C(0x6229981d9002eda5)},
+    {Q_UINT64_C(0x7c97061a9bc130a2), Q_UINT64_C(0x69dc2695b337e2a1)},
+    {Q_UINT64_C(0x63ac04e2163426e8), Q_UINT64_C(0x54b01ede28f9821b)},
+    {Q_UINT64_C(0x4fbcd0b4de901f20), Q_UINT64_C(0x43c018b1ba6134e2)},
+    {Q_UINT64_C(0x7f9481216419cb67), Q_UINT64_C(0x1f99c11c5d68549d)},
+    {Q_UINT64_C(0x6610674de9ae3c52), Q_UINT64_C(0x4c7b00e37ded107e)},
+    {Q_UINT64_C(0x51a6b90b21583042), Q_UINT64_C(0x09fc00b5fe574065)},
+    {Q_UINT64_C(0x41522da2811359ce), Q_UINT64_C(0x3b3000919845cd1d)},
+    {Q_UINT64_C(0x68837c3734ebc2e3), Q_UINT64_C(0x784ccdb5c06fae95)},
+    {Q_UINT64_C(0x539c635f5d8968b6), Q_UINT64_C(0x2d0a3e2b00595877)},
+    {Q_UINT64_C(0x42e382b2b13aba2b), Q_UINT64_C(0x3da1cb5599e11393)},
+    {Q_UINT64_C(0x6b059deab52ac378), Q_UINT64_C(0x629c7888f634ec1e)},
+    {Q_UINT64_C(0x559e17eef755692d), Q_UINT64_C(0x3549fa072b5d89b1)},
+    {Q_UINT64_C(0x447e798bf91120f1), Q_UINT64_C(0x1107fb38ef7e07c1)},
+    {Q_UINT64_C(0x6d9728dff4e834b5), Q_UINT64_C(0x01a65ec17f300c68)},
+    {Q_UINT64_C(0x57ac20b32a535d5d), Q_UINT64_C(0x4e1eb23465c009ed)},
+    {Q_UINT64_C(0x46234d5c21dc4ab1), Q_UINT64_C(0x24e55b5d1e333b24)},
+    {Q_UINT64_C(0x70387bc69c93aab5), Q_UINT64_C(0x216ef894fd1ec506)},
+    {Q_UINT64_C(0x59c6c96bb076222a), Q_UINT64_C(0x4df2607730e56a6c)},
+    {Q_UINT64_C(0x47d23abc8d2b4e88), Q_UINT64_C(0x3e5b805f5a5121f0)},
+    {Q_UINT64_C(0x72e9f79415121740), Q_UINT64_C(0x63c59a322a1b697f)},
+    {Q_UINT64_C(0x5bee5fa9aa74df67), Q_UINT64_C(0x03047b5b54e2bacc)},
+    {Q_UINT64_C(0x498b7fbaeec3e5ec), Q_UINT64_C(0x0269fc4910b5623d)},
+    {Q_UINT64_C(0x75abff917e063cac), Q_UINT64_C(0x6a432d41b45569fb)},
+    {Q_UINT64_C(0x5e2332dacb38308a), Q_UINT64_C(0x21cf5767c37787fc)},
+    {Q_UINT64_C(0x4b4f5be23c2cf3a1), Q_UINT64_C(0x67d912b9692c6cca)},
+    {Q_UINT64_C(0x787ef969f9e185cf), Q_UINT64_C(0x595b5128a8471476)},
+    {Q_UINT64_C(0x60659454c7e79e3f), Q_UINT64_C(0x6115da86ed05a9f8)},
+    {Q_UINT64_C(0x4d1e1043d31fb1cc), Q_UINT64_C(0x4dab1538bd9e2193)},
+    {Q_UINT64_C(0x7b634d3951cc4fad), Q_UINT64_C(0x62ab552795c9cf52)},
+    {Q_UINT64_C(0x62b5d7610e3d0c8b), Q_UINT64_C(0x0222aa86116e3f75)},
+    {Q_UINT64_C(0x4ef7df80d830d6d5), Q_UINT64_C(0x4e822204dabe992a)},
+    {Q_UINT64_C(0x7e59659af38157bc), Q_UINT64_C(0x17369cd49130f510)},
+    {Q_UINT64_C(0x65145148c2cddfc9), Q_UINT64_C(0x5f5ee3dd40f3f740)},
+    {Q_UINT64_C(0x50dd0dd3cf0b196e), Q_UINT64_C(0x1918b64a9a5cc5cd)},
+    {Q_UINT64_C(0x40b0d7dca5a27abe), Q_UINT64_C(0x4746f83baeb09e3e)},
+    {Q_UINT64_C(0x678159610903f797), Q_UINT64_C(0x253e59f91780fd2f)},
+    {Q_UINT64_C(0x52cde11a6d9cc612), Q_UINT64_C(0x50feae60df9a6426)},
+    {Q_UINT64_C(0x423e4daebe1704db), Q_UINT64_C(0x5a65584d7faeb685)},
+    {Q_UINT64_C(0x69fd4917968b3af9), Q_UINT64_C(0x10a226e265e4573b)},
+    {Q_UINT64_C(0x54caa0dfaba29594), Q_UINT64_C(0x0d4e8581eb1d1295)},
+    {Q_UINT64_C(0x43d54d7fbc821143), Q_UINT64_C(0x243ed134bc174211)},
+    {Q_UINT64_C(0x6c887bff94034ed2), Q_UINT64_C(0x06cae85460253682)},
+    {Q_UINT64_C(0x56d396661002a574), Q_UINT64_C(0x6bd586a9e6842b9b)},
+    {Q_UINT64_C(0x457611eb40021df7), Q_UINT64_C(0x09779eee52035616)},
+    {Q_UINT64_C(0x6f234fdeccd02ff1), Q_UINT64_C(0x5bf297e3b66bbcef)},
+    {Q_UINT64_C(0x58e90cb23d73598e), Q_UINT64_C(0x165bacb62b8963f3)},
+    {Q_UINT64_C(0x4720d6f4fdf5e13e), Q_UINT64_C(0x451623c4efa11cc2)},
+    {Q_UINT64_C(0x71ce24bb2fefceca), Q_UINT64_C(0x3b569fa17f682e03)},
+    {Q_UINT64_C(0x5b0b5095bff30bd5), Q_UINT64_C(0x15dee61acc535803)},
+    {Q_UINT64_C(0x48d5da11665c0977), Q_UINT64_C(0x2b18b8157042accf)},
+    {Q_UINT64_C(0x74895ce8a3c6758b), Q_UINT64_C(0x5e8df355806aae18)},
+    {Q_UINT64_C(0x5d3ab0ba1c9ec46f), Q_UINT64_C(0x653e5c4466bbbe7a)},
+    {Q_UINT64_C(0x4a955a2e7d4bd059), Q_UINT64_C(0x3765169d1efc9861)},
+    {Q_UINT64_C(0x77555d172edfb3c2), Q_UINT64_C(0x256e8a94fe60f3cf)},
+    {Q_UINT64_C(0x5f777dac257fc301), Q_UINT64_C(0x6abed543feb3f63f)},
+    {Q_UINT64_C(0x4c5f97bceacc9c01), Q_UINT64_C(0x3bcbddcffef65e99)},
+    {Q_UINT64_C(0x7a328c6177adc668), Q_UINT64_C(0x5fac961997f0975b)},
+    {Q_UINT64_C(0x61c209e792f16b86), Q_UINT64_C(0x7fbd44e1465a12af)},
+    {Q_UINT64_C(0x4e34d4b9425abc6b), Q_UINT64_C(0x7fca9d810514dbbf)},
+    {Q_UINT64_C(0x7d21545b9d5dfa46), Q_UINT64_C(0x32ddc8ce6e87c5ff)},
+    {Q_UINT64_C(0x641aa9e2e44b2e9e), Q_UINT64_C(0x5be4a0a525396b32)},
+    {Q_UINT64_C(0x501554b5836f587e), Q_UINT64_C(0x7cb6e6ea842def5c)},
+    {Q_UINT64_C(0x4011109135f2ad32), Q_UINT64_C(0x30925255368b25e3)},
+    {Q_UINT64_C(0x6681b41b89844850), Q_UINT64_C(0x4db6ea21f0dea304)},
+    {Q_UINT64_C(0x52015ce2d469d373), Q_UINT64_C(0x57c5881b2718826a)},
+    {Q_UINT64_C(0x419ab0b576bb0f8f), Q_UINT64_C(0x5fd139af527a01ef)},
+    {Q_UINT64_C(0x68f781225791b27f), Q_UINT64_C(0x4c81f5e550c3364a)},
+    {Q_UINT64_C(0x53f9341b79415b99), Q_UINT64_C(0x239b2b1dda35c508)},
+    {Q_UINT64_C(0x432dc3492dcde2e1), Q_UINT64_C(0x02e288e4ae916a6d)},
+    {Q_UINT64_C(0x6b7c6ba849496b01), Q_UINT64_C(0x516a74a1174f10ae)},
+    {Q_UINT64_C(0x55fd22ed076def34), Q_UINT64_C(0x4121f6e745d8da25)},
+    {Q_UINT64_C(0x44ca82573924bf5d), Q_UINT64_C(0x1a8192529e4714eb)},
+    {Q_UINT64_C(0x6e10d08b8ea1322e), Q_UINT64_C(0x5d9c1d50fd3e87dd)},
+    {Q_UINT64_C(0x580d73a2d880f4f2), Q_UINT64_C(0x17b01773fdcb9fe4)},
+    {Q_UINT64_C(0x4671294f139a5d8e), Q_UINT64_C(0x4626792997d61984)},
+    {Q_UINT64_C(0x70b50ee4ec2a2f4a), Q_UINT64_C(0x3d0a5b75bfbcf59f)},
+    {Q_UINT64_C(0x5a2a7250bcee8c3b), Q_UINT64_C(0x4a6eaf916630c47f)},
+    {Q_UINT64_C(0x4821f50d63f209c9), Q_UINT64_C(0x21f2260deb5a36cc)},
+    {Q_UINT64_C(0x736988156cb6760e), Q_UINT64_C(0x69837016455d247a)},
+    {Q_UINT64_C(0x5c546cddf091f80b), Q_UINT64_C(0x6e02c011d1175062)},
+    {Q_UINT64_C(0x49dd23e4c074c66f), Q_UINT64_C(0x719bccdb0dac404e)},
+    {Q_UINT64_C(0x762e9fd467213d7f), Q_UINT64_C(0x68f947c4e2ad33b0)},
+    {Q_UINT64_C(0x5e8bb3105280fdff), Q_UINT64_C(0x6d94396a4ef0f627)},
+    {Q_UINT64_C(0x4ba2f5a6a8673199), Q_UINT64_C(0x3e102deea58d91b9)},
+    {Q_UINT64_C(0x7904bc3dda3eb5c2), Q_UINT64_C(0x3019e3176f48e927)},
+    {Q_UINT64_C(0x60d09697e1cbc49b), Q_UINT64_C(0x4014b5ac590720ec)},
+    {Q_UINT64_C(0x4d73abacb4a303af), Q_UINT64_C(0x4cdd5e237a6c1a57)},
+    {Q_UINT64_C(0x7bec45e12104d2b2), Q_UINT64_C(0x47c8969f2a46908a)},
+    {Q_UINT64_C(0x63236b1a80d0a88e), Q_UINT64_C(0x6ca0787f5505406f)},
+    {Q_UINT64_C(0x4f4f88e200a6ed3f), Q_UINT64_C(0x0a19f9ff773766bf)},
+    {Q_UINT64_C(0x7ee5a7d0010b1531), Q_UINT64_C(0x5cf65ccbf1f23dfe)},
+    {Q_UINT64_C(0x6584864000d5aa8e), Q_UINT64_C(0x172b7d6ff4c1cb32)},
+    {Q_UINT64_C(0x5136d1cccd77bba4), Q_UINT64_C(0x78ef978cc3ce3c28)},
+    {Q_UINT64_C(0x40f8a7d70ac62fb7), Q_UINT64_C(0x13f2dfa3cfd83020)},
+    {Q_UINT64_C(0x67f43fbe77a37f8b), Q_UINT64_C(0x398499061959e699)},
+    {Q_UINT64_C(0x5329cc985fb5ffa2), Q_UINT64_C(0x6136e0d1ade18548)},
+    {Q_UINT64_C(0x4287d6e04c91994f), Q_UINT64_C(0x00f8b3daf181376d)},
+    {Q_UINT64_C(0x6a72f166e0e8f54b), Q_UINT64_C(0x1b27862b1c01f247)},
+    {Q_UINT64_C(0x5528c11f1a53f76f), Q_UINT64_C(0x2f52d1bc1667f506)},
+    {Q_UINT64_C(0x44209a7f48432c59), Q_UINT64_C(0x0c424163451ff738)},
+    {Q_UINT64_C(0x6d00f7320d3846f4), Q_UINT64_C(0x7a039bd208332526)},
+    {Q_UINT64_C(0x5733f8f4d76038c3), Q_UINT64_C(0x7b361641a028ea85)},
+    {Q_UINT64_C(0x45c32d90ac4cfa36), Q_UINT64_C(0x2f5e78348020bb9e)},
+    {Q_UINT64_C(0x6f9eaf4de07b29f0), Q_UINT64_C(0x4bca59ed99cdf8fc)},
+    {Q_UINT64_C(0x594bbf71806287f3), Q_UINT64_C(0x563b7b247b0b2d96)},
+    {Q_UINT64_C(0x476fcc5acd1b9ff6), Q_UINT64_C(0x11c92f50626f57ac)},
+    {Q_UINT64_C(0x724c7a2ae1c5ccbd), Q_UINT64_C(0x02db7ee703e55912)},
+    {Q_UINT64_C(0x5b7061bbe7d17097), Q_UINT64_C(0x1be2cbec031de0dc)},
+    {Q_UINT64_C(0x4926b496530df3ac), Q_UINT64_C(0x164f09899c17e716)},
+    {Q_UINT64_C(0x750aba8a1e7cb913), Q_UINT64_C(0x3d4b4275c68ca4f0)},
+    {Q_UINT64_C(0x5da22ed4e530940f), Q_UINT64_C(0x4aa29b916ba3b726)},
+    {Q_UINT64_C(0x4ae825771dc07672), Q_UINT64_C(0x6ee87c74561c9285)},
+    {Q_UINT64_C(0x77d9d58b62cd8a51), Q_UINT64_C(0x3173fa53bcfa8408)},
+    {Q_UINT64_C(0x5fe177a2b5713b74), Q_UINT64_C(0x278ffb7630c869a0)},
+    {Q_UINT64_C(0x4cb45fb55df42f90), Q_UINT64_C(0x1fa662c4f3d387b3)},
+    {Q_UINT64_C(0x7aba32bbc986b280), Q_UINT64_C(0x32a3d13b1fb8d91f)},
+    {Q_UINT64_C(0x622e8efca1388ecd), Q_UINT64_C(0x0ee9742f4c93e0e6)},
+    {Q_UINT64_C(0x4e8ba596e760723d), Q_UINT64_C(0x58bac3590a0fe71e)},
+    {Q_UINT64_C(0x7dac3c24a5671d2f), Q_UINT64_C(0x412ad228101971c9)},
+    {Q_UINT64_C(0x6489c9b6eab8e426), Q_UINT64_C(0x00ef0e8673478e3b)},
+    {Q_UINT64_C(0x506e3af8bbc71ceb), Q_UINT64_C(0x1a58d86b8f6c71c9)},
+    {Q_UINT64_C(0x40582f2d6305b0bc), Q_UINT64_C(0x1513e0560c56c16e)},
+    {Q_UINT64_C(0x66f37eaf04d5e793), Q_UINT64_C(0x3b530089ad579be2)},
+    {Q_UINT64_C(0x525c6558d0ab1fa9), Q_UINT64_C(0x15dc006e2446164f)},
+    {Q_UINT64_C(0x41e384470d55b2ed), Q_UINT64_C(0x5e4999f1b69e783f)},
+    {Q_UINT64_C(0x696c06d81555eb15), Q_UINT64_C(0x7d428fe92430c065)},
+    {Q_UINT64_C(0x54566be0111188de), Q_UINT64_C(0x31020cba835a3384)},
+    {Q_UINT64_C(0x4378564cda746d7e), Q_UINT64_C(0x5a680a2ecf7b5c69)},
+    {Q_UINT64_C(0x6bf3bd47c3ed7bfd), Q_UINT64_C(0x770cdd17b25efa42)},
+    {Q_UINT64_C(0x565c976c9cbdfccb), Q_UINT64_C(0x1270b0dfc1e59502)},
+    {Q_UINT64_C(0x4516df8a16fe63d5), Q_UINT64_C(0x5b8d5a4c9b1e10ce)},
+    {Q_UINT64_C(0x6e8aff4357fd6c89), Q_UINT64_C(0x127bc3adc4fce7b0)},
+    {Q_UINT64_C(0x586f329c466456d4), Q_UINT64_C(0x0ec96957d0ca52f3)},
+    {Q_UINT64_C(0x46bf5bb038504576), Q_UINT64_C(0x3f07877973d50f29)},
+    {Q_UINT64_C(0x71322c4d26e6d58a), Q_UINT64_C(0x31a5a58f1fbb4b75)},
+    {Q_UINT64_C(0x5a8e89d75252446e), Q_UINT64_C(0x5aeaead8e62f6f91)},
+    {Q_UINT64_C(0x487207df750e9d25), Q_UINT64_C(0x2f22557a51bf8c74)},
+    {Q_UINT64_C(0x73e9a63254e42ea2), Q_UINT64_C(0x1836ef2a1c65ad86)},
+    {Q_UINT64_C(0x5cbaeb5b771cf21b), Q_UINT64_C(0x2cf8bf54e3848ad2)},
+    {Q_UINT64_C(0x4a2f22af927d8e7c), Q_UINT64_C(0x23fa32aa4f9d3bdb)},
+    {Q_UINT64_C(0x76b1d118ea627d93), Q_UINT64_C(0x5329eaaa18fb92f8)},
+    {Q_UINT64_C(0x5ef4a74721e86476), Q_UINT64_C(0x0f54bbbb472fa8c6)},
+    {Q_UINT64_C(0x4bf6ec38e7ed1d2b), Q_UINT64_C(0x25dd62fc38f2ed6c)},
+    {Q_UINT64_C(0x798b138e3fe1c845), Q_UINT64_C(0x22fbd1938e517bdf)},
+    {Q_UINT64_C(0x613c0fa4ffe7d36a), Q_UINT64_C(0x4f2fdadc71dac97f)},
+    {Q_UINT64_C(0x4dc9a61d998642bb), Q_UINT64_C(0x58f3157d27e23acc)},
+    {Q_UINT64_C(0x7c75d695c2706ac5), Q_UINT64_C(0x74b82261d969f7ad)},
+    {Q_UINT64_C(0x63917877cec0556b), Q_UINT64_C(0x10934eb4adee5fbe)},
+    {Q_UINT64_C(0x4fa793930bcd1122), Q_UINT64_C(0x4075d8908b251965)},
+    {Q_UINT64_C(0x7f7285b812e1b504), Q_UINT64_C(0x00bc8db411d4f56e)},
+    {Q_UINT64_C(0x65f537c675815d9c), Q_UINT64_C(0x66fd3e29a7dd9125)},
+    {Q_UINT64_C(0x5190f96b91344ae3), Q_UINT64_C(0x6bfdcb54864ada84)},
+    {Q_UINT64_C(0x4140c78940f6a24f), Q_UINT64_C(0x6ffe3c439ea2486a)},
+    {Q_UINT64_C(0x6867a5a867f103b2), Q_UINT64_C(0x7ffd2d38fdd073dc)},
+    {Q_UINT64_C(0x53861e2053273628), Q_UINT64_C(0x6664242d97d9f64a)},
+    {Q_UINT64_C(0x42d1b1b375b8f820), Q_UINT64_C(0x51e9b68adfe191d5)},
+    {Q_UINT64_C(0x6ae91c5255f4c034), Q_UINT64_C(0x1ca924116635b621)},
+    {Q_UINT64_C(0x558749db77f70029), Q_UINT64_C(0x63ba83411e915e81)},
+    {Q_UINT64_C(0x446c3b15f9926687), Q_UINT64_C(0x6962029a7edab201)},
+    {Q_UINT64_C(0x6d79f82328ea3da6), Q_UINT64_C(0x0f03375d97c45001)},
+    {Q_UINT64_C(0x5794c6828721caeb), Q_UINT64_C(0x259c2c4adfd04001)},
+    {Q_UINT64_C(0x46109eced2816f22), Q_UINT64_C(0x5149bd08b30d0001)},
+    {Q_UINT64_C(0x701a97b150cf1837), Q_UINT64_C(0x3542c80deb480001)},
+    {Q_UINT64_C(0x59aedfc10d7279c5), Q_UINT64_C(0x7768a00b22a00001)},
+    {Q_UINT64_C(0x47bf19673df52e37), Q_UINT64_C(0x79208008e8800001)},
+    {Q_UINT64_C(0x72cb5bd86321e38c), Q_UINT64_C(0x5b67334174000001)},
+    {Q_UINT64_C(0x5bd5e313828182d6), Q_UINT64_C(0x7c528f6790000001)},
+    {Q_UINT64_C(0x4977e8dc68679bdf), Q_UINT64_C(0x16a872b940000001)},
+    {Q_UINT64_C(0x758ca7c70d7292fe), Q_UINT64_C(0x5773eac200000001)},
+    {Q_UINT64_C(0x5e0a1fd271287598), Q_UINT64_C(0x45f6556800000001)},
+    {Q_UINT64_C(0x4b3b4ca85a86c47a), Q_UINT64_C(0x04c5112000000001)},
+    {Q_UINT64_C(0x785ee10d5da46d90), Q_UINT64_C(0x07a1b50000000001)},
+    {Q_UINT64_C(0x604be73de4838ad9), Q_UINT64_C(0x52e7c40000000001)},
+    {Q_UINT64_C(0x4d0985cb1d3608ae), Q_UINT64_C(0x0f1fd00000000001)},
+    {Q_UINT64_C(0x7b426fab61f00de3), Q_UINT64_C(0x31cc800000000001)},
+    {Q_UINT64_C(0x629b8c891b267182), Q_UINT64_C(0x5b0a000000000001)},
+    {Q_UINT64_C(0x4ee2d6d415b85ace), Q_UINT64_C(0x7c08000000000001)},
+    {Q_UINT64_C(0x7e37be2022c0914b), Q_UINT64_C(0x1340000000000001)},
+    {Q_UINT64_C(0x64f964e68233a76f), Q_UINT64_C(0x2900000000000001)},
+    {Q_UINT64_C(0x50c783eb9b5c85f2), Q_UINT64_C(0x5400000000000001)},
+    {Q_UINT64_C(0x409f9cbc7c4a04c2), Q_UINT64_C(0x1000000000000001)},
+    {Q_UINT64_C(0x6765c793fa10079d), Q_UINT64_C(0x0000000000000001)},
+    {Q_UINT64_C(0x52b7d2dcc80cd2e4), Q_UINT64_C(0x0000000000000001)},
+    {Q_UINT64_C(0x422ca8b0a00a4250), Q_UINT64_C(0x0000000000000001)},
+    {Q_UINT64_C(0x69e10de76676d080), Q_UINT64_C(0x0000000000000001)},
+    {Q_UINT64_C(0x54b40b1f852bda00), Q_UINT64_C(0x0000000000000001)},
+    {Q_UINT64_C(0x43c33c1937564800), Q_UINT64_C(0x0000000000000001)},
+    {Q_UINT64_C(0x6c6b935b8bbd4000), Q_UINT64_C(0x0000000000000001)},
+    {Q_UINT64_C(0x56bc75e2d6310000), Q_UINT64_C(0x0000000000000001)},
+    {Q_UINT64_C(0x4563918244f40000), Q_UINT64_C(0x0000000000000001)},
+    {Q_UINT64_C(0x6f05b59d3b200000), Q_UINT64_C(0x0000000000000001)},
+    {Q_UINT64_C(0x58d15e1762800000), Q_UINT64_C(0x0000000000000001)},
+    {Q_UINT64_C(0x470de4df82000000), Q_UINT64_C(0x0000000000000001)},
+    {Q_UINT64_C(0x71afd498d0000000), Q_UINT64_C(0x0000000000000001)},
+    {Q_UINT64_C(0x5af3107a40000000), Q_UINT64_C(0x0000000000000001)},
+    {Q_UINT64_C(0x48c2739500000000), Q_UINT64_C(0x0000000000000001)},
+    {Q_UINT64_C(0x746a528800000000), Q_UINT64_C(0x0000000000000001)},
+    {Q_UINT64_C(0x5d21dba000000000), Q_UINT64_C(0x0000000000000001)},
+    {Q_UINT64_C(0x4a817c8000000000), Q_UINT64_C(0x0000000000000001)},
+    {Q_UINT64_C(0x7735940000000000), Q_UINT64_C(0x0000000000000001)},
+    {Q_UINT64_C(0x5f5e100000000000), Q_UINT64_C(0x0000000000000001)},
+    {Q_UINT64_C(0x4c4b400000000000), Q_UINT64_C(0x0000000000000001)},
+    {Q_UINT64_C(0x7a12000000000000), Q_UINT64_C(0x0000000000000001)},
+    {Q_UINT64_C(0x61a8000000000000), Q_UINT64_C(0x0000000000000001)},
+    {Q_UINT64_C(0x4e20000000000000), Q_UINT64_C(0x0000000000000001)},
+    {Q_UINT64_C(0x7d00000000000000), Q_UINT64_C(0x0000000000000001)},
+    {Q_UINT64_C(0x6400000000000000), Q_UINT64_C(0x0000000000000001)},
+    {Q_UINT64_C(0x5000000000000000), Q_UINT64_C(0x0000000000000001)},
+    {Q_UINT64_C(0x4000000000000000), Q_UINT64_C(0x0000000000000001)},
+    {Q_UINT64_C(0x6666666666666666), Q_UINT64_C(0x3333333333333334)},
+    {Q_UINT64_C(0x51eb851eb851eb85), Q_UINT64_C(0x0f5c28f5c28f5c29)},
+    {Q_UINT64_C(0x4189374bc6a7ef9d), Q_UINT64_C(0x5916872b020c49bb)},
+    {Q_UINT64_C(0x68db8bac710cb295), Q_UINT64_C(0x74f0d844d013a92b)},
+    {Q_UINT64_C(0x53e2d6238da3c211), Q_UINT64_C(0x43f3e0370cdc8755)},
+    {Q_UINT64_C(0x431bde82d7b634da), Q_UINT64_C(0x698fe69270b06c44)},
+    {Q_UINT64_C(0x6b5fca6af2bd215e), Q_UINT64_C(0x0f4ca41d811a46d4)},
+    {Q_UINT64_C(0x55e63b88c230e77e), Q_UINT64_C(0x3f70834acdae9f10)},
+    {Q_UINT64_C(0x44b82fa09b5a52cb), Q_UINT64_C(0x4c5a02a23e254c0d)},
+    {Q_UINT64_C(0x6df37f675ef6eadf), Q_UINT64_C(0x2d5cd10396a21347)},
+    {Q_UINT64_C(0x57f5ff85e592557f), Q_UINT64_C(0x3de3da69454e75d3)},
+    {Q_UINT64_C(0x465e6604b7a84465), Q_UINT64_C(0x7e4fe1edd10b9175)},
+    {Q_UINT64_C(0x709709a125da0709), Q_UINT64_C(0x4a19697c81ac1bef)},
+    {Q_UINT64_C(0x5a126e1a84ae6c07), Q_UINT64_C(0x54e1213067bce326)},
+    {Q_UINT64_C(0x480ebe7b9d58566c), Q_UINT64_C(0x43e74dc052fd8285)},
+    {Q_UINT64_C(0x734aca5f6226f0ad), Q_UINT64_C(0x530baf9a1e626a6d)},
+    {Q_UINT64_C(0x5c3bd5191b525a24), Q_UINT64_C(0x426fbfae7eb521f1)},
+    {Q_UINT64_C(0x49c97747490eae83), Q_UINT64_C(0x4ebfcc8b9890e7f4)},
+    {Q_UINT64_C(0x760f253edb4ab0d2), Q_UINT64_C(0x4acc7a78f41b0cba)},
+    {Q_UINT64_C(0x5e72843249088d75), Q_UINT64_C(0x223d2ec729af3d62)},
+    {Q_UINT64_C(0x4b8ed0283a6d3df7), Q_UINT64_C(0x34fdbf05baf29781)},
+    {Q_UINT64_C(0x78e480405d7b9658), Q_UINT64_C(0x54c931a2c4b758cf)},
+    {Q_UINT64_C(0x60b6cd004ac94513), Q_UINT64_C(0x5d6dc14f03c5e0a5)},
+    {Q_UINT64_C(0x4d5f0a66a23a9da9), Q_UINT64_C(0x31249aa59c9e4d51)},
+    {Q_UINT64_C(0x7bcb43d769f762a8), Q_UINT64_C(0x4ea0f76f60fd4882)},
+    {Q_UINT64_C(0x63090312bb2c4eed), Q_UINT64_C(0x254d92bf80caa068)},
+    {Q_UINT64_C(0x4f3a68dbc8f03f24), Q_UINT64_C(0x1dd7a89933d54d20)},
+    {Q_UINT64_C(0x7ec3daf941806506), Q_UINT64_C(0x62f2a75b86221500)},
+    {Q_UINT64_C(0x65697bfa9acd1d9f), Q_UINT64_C(0x025bb91604e810cd)},
+    {Q_UINT64_C(0x51212ffbaf0a7e18), Q_UINT64_C(0x684960de6a5340a4)},
+    {Q_UINT64_C(0x40e7599625a1fe7a), Q_UINT64_C(0x203ab3e521dc33b6)},
+    {Q_UINT64_C(0x67d88f56a29cca5d), Q_UINT64_C(0x19f7863b696052bd)},
+    {Q_UINT64_C(0x5313a5dee87d6eb0), Q_UINT64_C(0x7b2c6b62bab37564)},
+    {Q_UINT64_C(0x42761e4bed31255a), Q_UINT64_C(0x2f56bc4efbc2c450)},
+    {Q_UINT64_C(0x6a5696dfe1e83bc3), Q_UINT64_C(0x655793b192d13a1a)},
+    {Q_UINT64_C(0x5512124cb4b9c969), Q_UINT64_C(0x377942f475742e7b)},
+    {Q_UINT64_C(0x440e750a2a2e3aba), Q_UINT64_C(0x5f9435905df68b96)},
+    {Q_UINT64_C(0x6ce3ee76a9e3912a), Q_UINT64_C(0x65b9ef4d63241289)},
+    {Q_UINT64_C(0x571cbec554b60dbb), Q_UINT64_C(0x6afb25d782834207)},
+    {Q_UINT64_C(0x45b0989ddd5e7163), Q_UINT64_C(0x08c8eb12cecf6806)},
+    {Q_UINT64_C(0x6f80f42fc8971bd1), Q_UINT64_C(0x5adb11b7b14bd9a3)},
+    {Q_UINT64_C(0x5933f68ca078e30e), Q_UINT64_C(0x157c0e2c8dd647b5)},
+    {Q_UINT64_C(0x475cc53d4d2d8271), Q_UINT64_C(0x5dfcd823a4ab6c91)},
+    {Q_UINT64_C(0x722e086215159d82), Q_UINT64_C(0x632e269f6ddf141b)},
+    {Q_UINT64_C(0x5b5806b4ddaae468), Q_UINT64_C(0x4f581ee5f17f4349)},
+    {Q_UINT64_C(0x49133890b1558386), Q_UINT64_C(0x72ace584c1329c3b)},
+    {Q_UINT64_C(0x74eb8db44eef38d7), Q_UINT64_C(0x6aae3c079b842d2a)},
+    {Q_UINT64_C(0x5d893e29d8bf60ac), Q_UINT64_C(0x5558300616035755)},
+    {Q_UINT64_C(0x4ad431bb13cc4d56), Q_UINT64_C(0x7779c004de6912ab)},
+    {Q_UINT64_C(0x77b9e92b52e07bbe), Q_UINT64_C(0x258f99a163db5111)},
+    {Q_UINT64_C(0x5fc7edbc424d2fcb), Q_UINT64_C(0x37a614811caf740d)},
+    {Q_UINT64_C(0x4c9ff163683dbfd5), Q_UINT64_C(0x7951aa00e3bf900b)},
+    {Q_UINT64_C(0x7a998238a6c932ef), Q_UINT64_C(0x754f7667d2cc19ab)},
+    {Q_UINT64_C(0x6214682d523a8f26), Q_UINT64_C(0x2aa5f8530f09ae22)},
+    {Q_UINT64_C(0x4e76b9bddb620c1e), Q_UINT64_C(0x55519375a5a1581b)},
+    {Q_UINT64_C(0x7d8ac2c95f034697), Q_UINT64_C(0x3bb5b8bc3c3559c5)},
+    {Q_UINT64_C(0x646f023ab2690545), Q_UINT64_C(0x7c9160969691149e)},
+    {Q_UINT64_C(0x5058ce955b87376b), Q_UINT64_C(0x16dab3ababa743b2)},
+    {Q_UINT64_C(0x40470baaaf9f5f88), Q_UINT64_C(0x78aef622efb902f5)},
+    {Q_UINT64_C(0x66d812aab29898db), Q_UINT64_C(0x0de4bd04b2c19e54)},
+    {Q_UINT64_C(0x524675555bad4715), Q_UINT64_C(0x57ea30d08f014b76)},
+    {Q_UINT64_C(0x41d1f7777c8a9f44), Q_UINT64_C(0x4654f3da0c01092c)},
+    {Q_UINT64_C(0x694ff258c7443207), Q_UINT64_C(0x23bb1fc346680eac)},
+    {Q_UINT64_C(0x543ff513d29cf4d2), Q_UINT64_C(0x4fc8e635d1ecd88a)},
+    {Q_UINT64_C(0x43665da9754a5d75), Q_UINT64_C(0x263a51c4a7f0ad3b)},
+    {Q_UINT64_C(0x6bd6fc425543c8bb), Q_UINT64_C(0x56c3b607731aaec4)},
+    {Q_UINT64_C(0x5645969b77696d62), Q_UINT64_C(0x789c919f8f488bd0)},
+    {Q_UINT64_C(0x4504787c5f878ab5), Q_UINT64_C(0x46e3a7b2d906d640)},
+    {Q_UINT64_C(0x6e6d8d93cc0c1122), Q_UINT64_C(0x3e390c515b3e239a)},
+    {Q_UINT64_C(0x5857a4763cd6741b), Q_UINT64_C(0x4b60d6a77c31b615)},
+    {Q_UINT64_C(0x46ac8391ca4529af), Q_UINT64_C(0x55e7121f968e2b44)},
+    {Q_UINT64_C(0x711405b6106ea919), Q_UINT64_C(0x0971b698f0e3786d)},
+    {Q_UINT64_C(0x5a766af80d255414), Q_UINT64_C(0x078e2bad8d82c6bd)},
+    {Q_UINT64_C(0x485ebbf9a41ddcdc), Q_UINT64_C(0x6c71bc8ad79bd231)},
+    {Q_UINT64_C(0x73cac65c39c96161), Q_UINT64_C(0x2d82c7448c2c8382)},
+    {Q_UINT64_C(0x5ca23849c7d44de7), Q_UINT64_C(0x3e023903a356cf9b)},
+    {Q_UINT64_C(0x4a1b603b06437185), Q_UINT64_C(0x7e682d9c82abd949)},
+    {Q_UINT64_C(0x76923391a39f1c09), Q_UINT64_C(0x4a4048fa6aac8edb)},
+    {Q_UINT64_C(0x5edb5c7482e5b007), Q_UINT64_C(0x55003a61eef07249)},
+    {Q_UINT64_C(0x4be2b05d35848cd2), Q_UINT64_C(0x773361e7f259f507)},
+    {Q_UINT64_C(0x796ab3c855a0e151), Q_UINT64_C(0x3eb89ca6508fee71)},
+    {Q_UINT64_C(0x6122296d114d810d), Q_UINT64_C(0x7efa16eb73a6585b)},
+    {Q_UINT64_C(0x4db4edf0daa4673e), Q_UINT64_C(0x3261abef8fb846af)},
+    {Q_UINT64_C(0x7c54afe7c43a3eca), Q_UINT64_C(0x1d691318e5f3a44b)},
+    {Q_UINT64_C(0x6376f31fd02e98a1), Q_UINT64_C(0x64540f471e5c836f)},
+    {Q_UINT64_C(0x4f925c1973587a1b), Q_UINT64_C(0x0376729f4b7d35f3)},
+    {Q_UINT64_C(0x7f50935bebc0c35e), Q_UINT64_C(0x38bd84321261efeb)},
+    {Q_UINT64_C(0x65da0f7cbc9a35e5), Q_UINT64_C(0x13cad0280eb4bfef)},
+    {Q_UINT64_C(0x517b3f96fd482b1d), Q_UINT64_C(0x5ca240200bc3ccbf)},
+    {Q_UINT64_C(0x412f66126439bc17), Q_UINT64_C(0x63b50019a3030a33)},
+    {Q_UINT64_C(0x684bd683d38f9359), Q_UINT64_C(0x1f88002904d1a9ea)},
+    {Q_UINT64_C(0x536fdecfdc72dc47), Q_UINT64_C(0x32d3335403daee55)},
+    {Q_UINT64_C(0x42bfe57316c249d2), Q_UINT64_C(0x5bdc291003158b77)},
+    {Q_UINT64_C(0x6acca251be03a951), Q_UINT64_C(0x12f9db4cd1bc1258)},
+    {Q_UINT64_C(0x557081dafe695440), Q_UINT64_C(0x7594af70a7c9a847)},
+    {Q_UINT64_C(0x445a017bfebaa9cd), Q_UINT64_C(0x4476f2c0863aed06)},
+    {Q_UINT64_C(0x6d5ccf2ccac442e2), Q_UINT64_C(0x3a57eacda3917b3c)},
+    {Q_UINT64_C(0x577d728a3bd03581), Q_UINT64_C(0x7b7988a482dac8fd)},
+    {Q_UINT64_C(0x45fdf53b630cf79b), Q_UINT64_C(0x15fad3b6cf156d97)},
+    {Q_UINT64_C(0x6ffcbb923814bf5e), Q_UINT64_C(0x565e1f8ae4ef15be)},
+    {Q_UINT64_C(0x5996fc74f9aa32b2), Q_UINT64_C(0x11e4e608b725aaff)},
+    {Q_UINT64_C(0x47abfd2a6154f55b), Q_UINT64_C(0x27ea51a0928488cc)},
+    {Q_UINT64_C(0x72acc843ceee555e), Q_UINT64_C(0x7310829a84074146)},
+    {Q_UINT64_C(0x5bbd6d030bf1dde5), Q_UINT64_C(0x42739baed005cdd2)},
+    {Q_UINT64_C(0x49645735a327e4b7), Q_UINT64_C(0x4ec2e2f24004a4a8)},
+    {Q_UINT64_C(0x756d5855d1d96df2), Q_UINT64_C(0x4ad16b1d333aa10c)},
+    {Q_UINT64_C(0x5df11377db1457f5), Q_UINT64_C(0x2241227dc2954da3)},
+    {Q_UINT64_C(0x4b2742c648dd132a), Q_UINT64_C(0x4e9a81fe35443e1c)},
+    {Q_UINT64_C(0x783ed13d4161b844), Q_UINT64_C(0x175d9cc9eed39694)},
+    {Q_UINT64_C(0x603240fdcde7c69c), Q_UINT64_C(0x7917b0a18bdc7876)},
+    {Q_UINT64_C(0x4cf500cb0b1fd217), Q_UINT64_C(0x1412f3b46fe39392)},
+    {Q_UINT64_C(0x7b219ade7832e9be), Q_UINT64_C(0x535185ed7fd285b6)},
+    {Q_UINT64_C(0x628148b1f9c25498), Q_UINT64_C(0x42a79e57997537c5)},
+    {Q_UINT64_C(0x4ecdd3c1949b76e0), Q_UINT64_C(0x3552e512e12a9304)},
+    {Q_UINT64_C(0x7e161f9c20f8be33), Q_UINT64_C(0x6eeb081e3510eb39)},
+    {Q_UINT64_C(0x64de7fb01a609829), Q_UINT64_C(0x3f226ce4f740bc2e)},
+    {Q_UINT64_C(0x50b1ffc0151a1354), Q_UINT64_C(0x3281f0b72c33c9be)},
+    {Q_UINT64_C(0x408e66334414dc43), Q_UINT64_C(0x42018d5f568fd498)},
+    {Q_UINT64_C(0x674a3d1ed354939f), Q_UINT64_C(0x1ccf48988a7fba8d)},
+    {Q_UINT64_C(0x52a1ca7f0f76dc7f), Q_UINT64_C(0x30a5d3ad3b99620b)},
+    {Q_UINT64_C(0x421b0865a5f8b065), Q_UINT64_C(0x73b7dc8a96144e6f)},
+    {Q_UINT64_C(0x69c4da3c3cc11a3c), Q_UINT64_C(0x52bfc7442353b0b1)},
+    {Q_UINT64_C(0x549d7b6363cdae96), Q_UINT64_C(0x756639034f7626f4)},
+    {Q_UINT64_C(0x43b12f82b63e2545), Q_UINT64_C(0x4451c735d92b525d)},
+    {Q_UINT64_C(0x6c4eb26abd303ba2), Q_UINT64_C(0x3a1c71efc1deea2e)},
+    {Q_UINT64_C(0x56a55b889759c94e), Q_UINT64_C(0x61b05b2634b254f2)},
+    {Q_UINT64_C(0x45511606df7b0772), Q_UINT64_C(0x1af37c1e908eaa5b)},
+    {Q_UINT64_C(0x6ee8233e325e7250), Q_UINT64_C(0x2b1f2cfdb41776f8)},
+    {Q_UINT64_C(0x58b9b5cb5b7ec1d9), Q_UINT64_C(0x6f4c23fe29ac5f2d)},
+    {Q_UINT64_C(0x46faf7d5e2cbce47), Q_UINT64_C(0x72a34ffe87bd18f1)},
+    {Q_UINT64_C(0x71918c896adfb073), Q_UINT64_C(0x04387ffda5fb5b1b)},
+    {Q_UINT64_C(0x5adad6d4557fc05c), Q_UINT64_C(0x0360666484c915af)},
+    {Q_UINT64_C(0x48af1243779966b0), Q_UINT64_C(0x02b3851d3707448c)},
+    {Q_UINT64_C(0x744b506bf28f0ab3), Q_UINT64_C(0x1dec082ebe720746)},
+    {Q_UINT64_C(0x5d090d2328726ef5), Q_UINT64_C(0x64bcd358985b3905)},
+    {Q_UINT64_C(0x4a6da41c205b8bf7), Q_UINT64_C(0x6a30a913ad15c738)},
+    {Q_UINT64_C(0x7715d36033c5acbf), Q_UINT64_C(0x5d1aa81f7b560b8c)},
+    {Q_UINT64_C(0x5f44a919c3048a32), Q_UINT64_C(0x7daeece5fc44d609)},
+    {Q_UINT64_C(0x4c36edae359d3b5b), Q_UINT64_C(0x7e258a51969d7808)},
+    {Q_UINT64_C(0x79f17c49ef61f893), Q_UINT64_C(0x16a276e8f0fbf33f)},
+    {Q_UINT64_C(0x618dfd07f2b4c6dc), Q_UINT64_C(0x121b9253f3fcc299)},
+    {Q_UINT64_C(0x4e0b30d328909f16), Q_UINT64_C(0x41afa84329970214)},
+    {Q_UINT64_C(0x7cdeb4850db431bd), Q_UINT64_C(0x4f7f739ea8f19ced)},
+    {Q_UINT64_C(0x63e55d373e29c164), Q_UINT64_C(0x3f99294bba5ae3f1)},
+    {Q_UINT64_C(0x4feab0f8fe87cde9), Q_UINT64_C(0x7fadbaa2fb7be98d)},
+    {Q_UINT64_C(0x7fdde7f4ca72e30f), Q_UINT64_C(0x7f7c5dd1925fdc15)},
+    {Q_UINT64_C(0x664b1ff7085be8d9), Q_UINT64_C(0x4c637e4141e649ab)},
+    {Q_UINT64_C(0x51d5b32c06afed7a), Q_UINT64_C(0x704f983434b83aef)},
+    {Q_UINT64_C(0x4177c2899ef32462), Q_UINT64_C(0x26a6135cf6f9c8bf)},
+    {Q_UINT64_C(0x68bf9da8fe51d3d0), Q_UINT64_C(0x3dd685618b294132)},
+    {Q_UINT64_C(0x53cc7e20cb74a973), Q_UINT64_C(0x4b12044e08edcdc2)},
+    {Q_UINT64_C(0x4309fe80a2c3bac2), Q_UINT64_C(0x6f419d0b3a57d7ce)},
+    {Q_UINT64_C(0x6b4330cdd1392ad1), Q_UINT64_C(0x320294dec3bfbfb0)},
+    {Q_UINT64_C(0x55cf5a3e40fa88a7), Q_UINT64_C(0x419baa4bcfcc995a)},
+    {Q_UINT64_C(0x44a5e1cb672ed3b9), Q_UINT64_C(0x1ae2eea30ca3ade1)},
+    {Q_UINT64_C(0x6dd636123eb152c1), Q_UINT64_C(0x77d17dd1add2afcf)},
+    {Q_UINT64_C(0x57de91a832277567), Q_UINT64_C(0x797464a7be42263f)},
+    {Q_UINT64_C(0x464ba7b9c1b92ab9), Q_UINT64_C(0x4790508631ce84ff)},
+    {Q_UINT64_C(0x70790c5c6928445c), Q_UINT64_C(0x0c1a1a704fb0d4cc)},
+    {Q_UINT64_C(0x59fa7049edb9d049), Q_UINT64_C(0x567b4859d95a43d6)},
+    {Q_UINT64_C(0x47fb8d07f161736e), Q_UINT64_C(0x11fc39e17aae9cab)},
+    {Q_UINT64_C(0x732c14d98235857d), Q_UINT64_C(0x032d2968c44a9445)},
+    {Q_UINT64_C(0x5c2343e134f79dfd), Q_UINT64_C(0x4f575453d03ba9d1)},
+    {Q_UINT64_C(0x49b5cfe75d92e4ca), Q_UINT64_C(0x72ac4376402fbb0e)},
+    {Q_UINT64_C(0x75efb30bc8eb07ab), Q_UINT64_C(0x0446d256cd192b49)},
+    {Q_UINT64_C(0x5e595c096d88d2ef), Q_UINT64_C(0x1d0575123dadbc3a)},
+    {Q_UINT64_C(0x4b7ab0078ad3dbf2), Q_UINT64_C(0x4a6ac40e97be302f)},
+    {Q_UINT64_C(0x78c44cd8de1fc650), Q_UINT64_C(0x771139b0f2c9e6b1)},
+    {Q_UINT64_C(0x609d0a4718196b73), Q_UINT64_C(0x78da948d8f07ebc1)},
+    {Q_UINT64_C(0x4d4a6e9f467abc5c), Q_UINT64_C(0x60aedd3e0c065634)},
+    {Q_UINT64_C(0x7baa4a9870c46094), Q_UINT64_C(0x344afb9679a3bd20)},
+    {Q_UINT64_C(0x62eea2138d69e6dd), Q_UINT64_C(0x103bfc78614fca80)},
+    {Q_UINT64_C(0x4f254e760abb1f17), Q_UINT64_C(0x26966393810ca200)},
+    {Q_UINT64_C(0x7ea21723445e9825), Q_UINT64_C(0x2423d2859b476999)},
+    {Q_UINT64_C(0x654e78e9037ee01d), Q_UINT64_C(0x69b642047c392148)},
+    {Q_UINT64_C(0x510b93ed9c658017), Q_UINT64_C(0x6e2b680396941aa0)},
+    {Q_UINT64_C(0x40d60ff149eaccdf), Q_UINT64_C(0x71bc53361210154d)},
+    {Q_UINT64_C(0x67bce64edcaae166), Q_UINT64_C(0x1c6085235019bbae)},
+    {Q_UINT64_C(0x52fd850be3bbe784), Q_UINT64_C(0x7d1a041c40149625)},
+    {Q_UINT64_C(0x42646a6fe9631f9d), Q_UINT64_C(0x4a7b367d0010781d)},
+    {Q_UINT64_C(0x6a3a43e642383295), Q_UINT64_C(0x5d91f0c8001a59c8)},
+    {Q_UINT64_C(0x54fb698501c68ede), Q_UINT64_C(0x17a7f3d3334847d4)},
+    {Q_UINT64_C(0x43fc546a67d20be4), Q_UINT64_C(0x79532975c2a03976)},
+    {Q_UINT64_C(0x6cc6ed770c83463b), Q_UINT64_C(0x0eeb75893766c256)},
+    {Q_UINT64_C(0x57058ac5a39c382f), Q_UINT64_C(0x25892ad42c523512)},
+    {Q_UINT64_C(0x459e089e1c7cf9bf), Q_UINT64_C(0x37a0ef102374f742)},
+    {Q_UINT64_C(0x6f6340fcfa618f98), Q_UINT64_C(0x59017e8038bb2536)},
+    {Q_UINT64_C(0x591c33fd951ad946), Q_UINT64_C(0x7a67986693c8ea91)},
+    {Q_UINT64_C(0x4749c33144157a9f), Q_UINT64_C(0x151fad1edca0bba8)},
+    {Q_UINT64_C(0x720f9eb539bbf765), Q_UINT64_C(0x0832ae97c76792a5)},
+    {Q_UINT64_C(0x5b3fb22a94965f84), Q_UINT64_C(0x068ef21305ec7551)},
+    {Q_UINT64_C(0x48ffc1bbaa11e603), Q_UINT64_C(0x1ed8c1a8d189f774)},
+    {Q_UINT64_C(0x74cc692c434fd66b), Q_UINT64_C(0x4af4690e1c0ff253)},
+    {Q_UINT64_C(0x5d705423690cab89), Q_UINT64_C(0x225d20d816732843)},
+    {Q_UINT64_C(0x4ac0434f873d5607), Q_UINT64_C(0x35174d79ab8f5369)},
+    {Q_UINT64_C(0x779a054c0b955672), Q_UINT64_C(0x21bee25c45b21f0e)},
+    {Q_UINT64_C(0x5fae6aa33c77785b), Q_UINT64_C(0x3498b5169e2818d8)},
+    {Q_UINT64_C(0x4c8b888296c5f9e2), Q_UINT64_C(0x5d46f7454b534713)},
+    {Q_UINT64_C(0x7a78da6a8ad65c9d), Q_UINT64_C(0x7ba4bed545520b52)},
+    {Q_UINT64_C(0x61fa48553bdeb07e), Q_UINT64_C(0x2fb6ff110441a2a8)},
+    {Q_UINT64_C(0x4e61d37763188d31), Q_UINT64_C(0x72f8cc0d9d014eed)},
+    {Q_UINT64_C(0x7d6952589e8daeb6), Q_UINT64_C(0x1e5ae015c80217e1)},
+    {Q_UINT64_C(0x645441e07ed7bef8), Q_UINT64_C(0x1848b344a001acb4)},
+    {Q_UINT64_C(0x504367e6cbdfcbf9), Q_UINT64_C(0x603a2903b3348a2a)},
+    {Q_UINT64_C(0x4035ecb8a3196ffb), Q_UINT64_C(0x002e873628f6d4ee)},
+    {Q_UINT64_C(0x66bcadf43828b32b), Q_UINT64_C(0x19e40b89db2487e3)},
+    {Q_UINT64_C(0x52308b29c686f5bc), Q_UINT64_C(0x14b66fa17c1d3983)},
+    {Q_UINT64_C(0x41c06f549ed25e30), Q_UINT64_C(0x1091f2e7967dc79c)},
+    {Q_UINT64_C(0x6933e554315096b3), Q_UINT64_C(0x341cb7d8f0c93f5f)},
+    {Q_UINT64_C(0x542984435aa6def5), Q_UINT64_C(0x767d5fe0c0a0ff80)},
+    {Q_UINT64_C(0x435469cf7bb8b25e), Q_UINT64_C(0x2b977fe70080cc66)},
+    {Q_UINT64_C(0x6bba42e592c11d63), Q_UINT64_C(0x5f58cca4cd9ae0a3)},
+    {Q_UINT64_C(0x562e9beadbcdb11c), Q_UINT64_C(0x4c470a1d7148b3b6)},
+    {Q_UINT64_C(0x44f216557ca48db0), Q_UINT64_C(0x3d05a1b1276d5c92)},
+    {Q_UINT64_C(0x6e5023bbfaa0e2b3), Q_UINT64_C(0x7b3c35e83f1560e9)},
+    {Q_UINT64_C(0x58401c96621a4ef6), Q_UINT64_C(0x2f635e5365aab3ed)},
+    {Q_UINT64_C(0x4699b0784e7b725e), Q_UINT64_C(0x591c4b75eaeef658)},
+    {Q_UINT64_C(0x70f5e726e3f8b6fd), Q_UINT64_C(0x74fa125644b18a26)},
+    {Q_UINT64_C(0x5a5e5285832d5f31), Q_UINT64_C(0x43fb41de9d5ad4eb)},
+    {Q_UINT64_C(0x484b75379c244c27), Q_UINT64_C(0x4ffc34b2177bdd89)},
+    {Q_UINT64_C(0x73abeebf603a1372), Q_UINT64_C(0x4cc6bab68bf96274)},
+    {Q_UINT64_C(0x5c898bcc4cfb42c2), Q_UINT64_C(0x0a38955ed6611b90)},
+    {Q_UINT64_C(0x4a07a309d72f689b), Q_UINT64_C(0x21c6dde5784dafa7)},
+    {Q_UINT64_C(0x76729e762518a75e), Q_UINT64_C(0x693e2fd58d49190b)},
+    {Q_UINT64_C(0x5ec2185e8413b918), Q_UINT64_C(0x5431bfde0aa0e0d5)},
+    {Q_UINT64_C(0x4bce79e536762dad), Q_UINT64_C(0x29c1664b3bb3e711)},
+    {Q_UINT64_C(0x794a5ca1f0bd15e2), Q_UINT64_C(0x0f9bd6dec5eca4e8)},
+    {Q_UINT64_C(0x61084a1b26fdab1b), Q_UINT64_C(0x2616457f04bd50ba)},
+    {Q_UINT64_C(0x4da03b48ebfe227c), Q_UINT64_C(0x1e783798d09773c8)},
+    {Q_UINT64_C(0x7c33920e46636a60), Q_UINT64_C(0x30c058f480f252d9)},
+    {Q_UINT64_C(0x635c74d8384f884d), Q_UINT64_C(0x0d66ad9067284247)},
+    {Q_UINT64_C(0x4f7d2a469372d370), Q_UINT64_C(0x711ef14052869b6c)},
+    {Q_UINT64_C(0x7f2eaa0a85848581), Q_UINT64_C(0x34fe4ecd50d75f14)},
+    {Q_UINT64_C(0x65beee6ed136d134), Q_UINT64_C(0x2a650bd773df7f43)},
+    {Q_UINT64_C(0x51658b8bda9240f6), Q_UINT64_C(0x551da312c319329c)},
+    {Q_UINT64_C(0x411e093caedb672b), Q_UINT64_C(0x5db14f4235adc217)},
+    {Q_UINT64_C(0x68300ec77e2bd845), Q_UINT64_C(0x7c4ee536bc49368a)},
+    {Q_UINT64_C(0x5359a56c64efe037), Q_UINT64_C(0x7d0bea92303a9208)},
+    {Q_UINT64_C(0x42ae1df050bfe693), Q_UINT64_C(0x173cbba8269541a0)},
+    {Q_UINT64_C(0x6ab02fe6e79970eb), Q_UINT64_C(0x3ec792a6a422029a)},
+    {Q_UINT64_C(0x5559bfebec7ac0bc), Q_UINT64_C(0x3239421ee9b4cee1)},
+    {Q_UINT64_C(0x4447ccbcbd2f0096), Q_UINT64_C(0x5b6101b25490a581)},
+    {Q_UINT64_C(0x6d3fadfac84b3424), Q_UINT64_C(0x2bce691d541aa268)},
+    {Q_UINT64_C(0x576624c8a03c29b6), Q_UINT64_C(0x563eba7ddce21b87)},
+    {Q_UINT64_C(0x45eb50a08030215e), Q_UINT64_C(0x78322ecb171b4939)},
+    {Q_UINT64_C(0x6fdee76733803564), Q_UINT64_C(0x59e9e47824f87527)},
+    {Q_UINT64_C(0x597f1f85c2ccf783), Q_UINT64_C(0x6187e9f9b72d2a86)},
+    {Q_UINT64_C(0x4798e6049bd72c69), Q_UINT64_C(0x346cbb2e2c242205)},
+    {Q_UINT64_C(0x728e3cd42c8b7a42), Q_UINT64_C(0x20adf849e039d007)},
+    {Q_UINT64_C(0x5ba4fd768a092e9b), Q_UINT64_C(0x33be603b19c7d99f)},
+    {Q_UINT64_C(0x4950cac53b3a8baf), Q_UINT64_C(0x42feb3627b0647b3)},
+    {Q_UINT64_C(0x754e113b91f745e5), Q_UINT64_C(0x5197856a5e7072b8)},
+    {Q_UINT64_C(0x5dd80dc941929e51), Q_UINT64_C(0x27ac6abb7ec05bc6)},
+    {Q_UINT64_C(0x4b133e3a9adbb1da), Q_UINT64_C(0x52f05562cbcd1638)},
+    {Q_UINT64_C(0x781ec9f75e2c4fc4), Q_UINT64_C(0x1e4d556adfae89f3)},
+    {Q_UINT64_C(0x6018a192b1bd0c9c), Q_UINT64_C(0x7ea444557fbed4c3)},
+    {Q_UINT64_C(0x4ce0814227ca707d), Q_UINT64_C(0x4bb69d1132ff109c)},
+    {Q_UINT64_C(0x7b00ced03faa4d95), Q_UINT64_C(0x5f8a94e851981a93)},
+    {Q_UINT64_C(0x62670bd9cc883e11), Q_UINT64_C(0x32d543ed0e134875)},
+    {Q_UINT64_C(0x4eb8d647d6d364da), Q_UINT64_C(0x5bddcff0d80f6d2b)},
+    {Q_UINT64_C(0x7df48a0c8aebd491), Q_UINT64_C(0x12fc7fe7c018aeab)},
+    {Q_UINT64_C(0x64c3a1a3a25643a7), Q_UINT64_C(0x28c9ffec99ad5889)},
+    {Q_UINT64_C(0x509c814fb511cfb9), Q_UINT64_C(0x0707fff07af113a1)},
+    {Q_UINT64_C(0x407d343fc40e3fc7), Q_UINT64_C(0x1f39998d2f2742e7)},
+    {Q_UINT64_C(0x672eb9ffa016cc71), Q_UINT64_C(0x7ec28f484b7204a4)},
+    {Q_UINT64_C(0x528bc7ffb345705b), Q_UINT64_C(0x189ba5d36f8e6a1d)},
+    {Q_UINT64_C(0x42096ccc8f6ac048), Q_UINT64_C(0x7a161e42bfa521b1)},
+    {Q_UINT64_C(0x69a8ae1418aacd41), Q_UINT64_C(0x435696d132a1cf81)},
+    {Q_UINT64_C(0x5486f1a9ad557101), Q_UINT64_C(0x1c454574288172ce)},
+    {Q_UINT64_C(0x439f27baf1112734), Q_UINT64_C(0x169dd129ba0128a5)},
+    {Q_UINT64_C(0x6c31d92b1b4ea520), Q_UINT64_C(0x242fb50f9001daa1)},
+    {Q_UINT64_C(0x568e4755af721db3), Q_UINT64_C(0x368c90d940017bb4)},
+    {Q_UINT64_C(0x453e9f77bf8e7e29), Q_UINT64_C(0x120a0d7a999ac95d)},
+    {Q_UINT64_C(0x6eca98bf98e3fd0e), Q_UINT64_C(0x50101590f5c47561)},
+    {Q_UINT64_C(0x58a213cc7a4ffda5), Q_UINT64_C(0x26734473f7d05de8)},
+    {Q_UINT64_C(0x46e80fd6c83ffe1d), Q_UINT64_C(0x6b8f69f65fd9e4b9)},
+    {Q_UINT64_C(0x71734c8ad9fffcfc), Q_UINT64_C(0x45b24323cc8fd45c)},
+    {Q_UINT64_C(0x5ac2a3a247fffd96), Q_UINT64_C(0x6af502830a0ca9e3)},
+    {Q_UINT64_C(0x489bb61b6ccccadf), Q_UINT64_C(0x08c402026e7087e9)},
+    {Q_UINT64_C(0x742c569247ae1164), Q_UINT64_C(0x746cd003e3e73fdb)},
+    {Q_UINT64_C(0x5cf04541d2f1a783), Q_UINT64_C(0x76bd73364fec3315)},
+    {Q_UINT64_C(0x4a59d101758e1f9c), Q_UINT64_C(0x5efdf5c50cbcf5ab)},
+    {Q_UINT64_C(0x76f61b3588e365c7), Q_UINT64_C(0x4b2fefa1adfb22ab)},
+    {Q_UINT64_C(0x5f2b48f7a0b5eb06), Q_UINT64_C(0x08f3261af195b555)},
+    {Q_UINT64_C(0x4c22a0c61a2b226b), Q_UINT64_C(0x20c284e25ade2aab)},
+    {Q_UINT64_C(0x79d1013cf6ab6a45), Q_UINT64_C(0x1ad0d49d5e304444)},
+    {Q_UINT64_C(0x617400fd9222bb6a), Q_UINT64_C(0x48a7107de4f369d0)},
+    {Q_UINT64_C(0x4df6673141b562bb), Q_UINT64_C(0x53b8d9fe50c2bb0d)},
+    {Q_UINT64_C(0x7cbd71e869223792), Q_UINT64_C(0x52c15cca1ad12b48)},
+    {Q_UINT64_C(0x63cac186ba81c60e), Q_UINT64_C(0x75677d6e7bda8906)},
+    {Q_UINT64_C(0x4fd5679efb9b04d8), Q_UINT64_C(0x5dec645863153a6c)},
+    {Q_UINT64_C(0x7fbbd8fe5f5e6e27), Q_UINT64_C(0x497a3a2704eec3df)}
+};
+
+const quint64 POW10[] = {
+    Q_UINT64_C(1), Q_UINT64_C(10), Q_UINT64_C(100), Q_UINT64_C(1000), Q_UINT64_C(10000),
+    Q_UINT64_C(100000), Q_UINT64_C(1000000), Q_UINT64_C(10000000), Q_UINT64_C(100000000),
+    Q_UINT64_C(1000000000), Q_UINT64_C(10000000000), Q_UINT64_C(100000000000),
+    Q_UINT64_C(1000000000000), Q_UINT64_C(10000000000000), Q_UINT64_C(100000000000000),
+    Q_UINT64_C(1000000000000000), Q_UINT64_C(10000000000000000),
+    Q_UINT64_C(100000000000000000), Q_UINT64_C(1000000000000000000)
+};
+
+// floor(e * log10(2)), floor(e * log10(3/4 * 2)), floor(e * log2(10)) для |e| <= 1700
+inline int flog10pow2(int e)
+{
+    return static_cast<int>((qint64(e) * Q_INT64_C(661971961083)) >> 41);
+}
+
+inline int flog10threeQuartersPow2(int e)
+{
+    return static_cast<int>((qint64(e) * Q_INT64_C(661971961083) - Q_INT64_C(274743187321)) >> 41);
+}
+
+inline int flog2pow10(int e)
+{
+    return static_cast<int>((qint64(e) * Q_INT64_C(913124641741)) >> 38);
+}
+
+// Старшие 64 бита произведения 64 x 64
+inline quint64 multiplyHigh(quint64 a, quint64 b)
+{
+#if defined(__SIZEOF_INT128__)
+    __extension__ typedef unsigned __int128 quint128;
+    return static_cast<quint64>((static_cast<quint128>(a) * b) >> 64);
+#else
+    const quint64 aLow = a & 0xffffffffu;
+    const quint64 aHigh = a >> 32;
+    const quint64 bLow = b & 0xffffffffu;
+    const quint64 bHigh = b >> 32;
+    const quint64 lowHigh = aLow * bHigh;
+    const quint64 highLow = aHigh * bLow;
+    const quint64 middle = ((aLow * bLow) >> 32) + (lowHigh & 0xffffffffu) + (highLow & 0xffffffffu);
+    return aHigh * bHigh + (lowHigh >> 32) + (highLow >> 32) + (middle >> 32);
+#endif
+}
+
+// floor(g * cp / 2^127) с округлением к нечетному (младший бит - признак ненулевого остатка)
+inline quint64 roundToOdd(const quint64* g, quint64 cp)
+{
+    const quint64 x1 = multiplyHigh(g[1], cp);
+    const quint64 y0 = g[0] * cp;
+    const quint64 y1 = multiplyHigh(g[0], cp);
+    const quint64 z = (y0 >> 1) + x1;
+    const quint64 vbp = y1 + (z >> 63);
+    return vbp | (((z & MASK_63) + MASK_63) >> 63);
+}
+
+// Кратчайшее десятичное для c * 2^q
+void toDecimal(int q, quint64 c, quint64& significand, int& exponent)
+{
+    const quint64 out = c & 1;
+    const quint64 cb = c << 2;
+    const quint64 cbr = cb + 2;
+    quint64 cbl;
+    int k;
+    // На границе двоичного порядка нижний сосед вдвое ближе
+    if (c != C_MIN || q == Q_MIN) {
+        cbl = cb - 2;
+        k = flog10pow2(q);
+    } else {
+        cbl = cb - 1;
+        k = flog10threeQuartersPow2(q);
+    }
+    const int h = q + flog2pow10(-k) + 2;
+
+    const quint64* g = POW10_TABLE[k - K_MIN];
+    const quint64 vb = roundToOdd(g, cb << h);
+    const quint64 vbl = roundToOdd(g, cbl << h);
+    const quint64 vbr = roundToOdd(g, cbr << h);
+
+    const quint64 s = vb >> 2;
+    if (s >= 100) {
+        // Кандидаты на одну цифру короче
+        const quint64 sp10 = s / 10 * 10;
+        const quint64 tp10 = sp10 + 10;
+        const bool upin = vbl + out <= sp10 << 2;
+        const bool wpin = (tp10 << 2) + out <= vbr;
+        if (upin != wpin) {
+            significand = upin ? sp10 : tp10;
+            exponent = k;
+            return;
+        }
+    }
+
+    const quint64 t = s + 1;
+    const bool uin = vbl + out <= s << 2;
+    const bool win = (t << 2) + out <= vbr;
+    exponent = k;
+    if (uin != win) {
+        significand = uin ? s : t;
+        return;
+    }
+    // Оба в интервале: ближайший, при равенстве - четный
+    const qint64 cmp = static_cast<qint64>(vb - ((s + t) << 1));
+    significand = (cmp < 0 || (cmp == 0 && (s & 1) == 0)) ? s : t;
+}
+
+int digitCount(quint64 value)
+{
+    int count = 1;
+    while (count < 20 && value >= POW10[count]) {
+        ++count;
+    }
+    return count;
+}
+
+void removeTrailingZeros(quint64& significand, int& exponent)
+{
+    if (significand == 0) {
+        return;
+    }
+    while (significand % 10 == 0) {
+        significand /= 10;
+        ++exponent;
+    }
+}
+
+template<typename Char>
+int writeSpecial(const char* text, bool negative, Char* buffer)
+{
+    int length = 0;
+    if (negative) {
+        buffer[length++] = Char('-');
+    }
+    for (; *text; ++text) {
+        buffer[length++] = Char(*text);
+    }
+    return length;
+}
+
+// Раскладка формата 'g': научная запись при порядке старшей цифры < -4 или >= precision.
+// Порядок в научной записи - минимум две цифры со знаком, как у Qt и printf
+template<typename Char>
+int writeDigits(quint64 significand, int exponent, bool negative, int precision, Char* buffer)
+{
+    char digits[20];
+    const int count = digitCount(significand);
+    for (int i = count - 1; i >= 0; --i) {
+        digits[i] = static_cast<char>('0' + significand % 10);
+        significand /= 10;
+    }
+
+    int length = 0;
+    if (negative) {
+        buffer[length++] = Char('-');
+    }
+
+    const int leading = exponent + count - 1;
+    if (leading < -4 || leading >= precision) {
+        buffer[length++] = Char(digits[0]);
+        if (count > 1) {
+            buffer[length++] = Char('.');
+            for (int i = 1; i < count; ++i) {
+                buffer[length++] = Char(digits[i]);
+            }
+        }
+        buffer[length++] = Char('e');
+        buffer[length++] = Char(leading < 0 ? '-' : '+');
+        int power = leading < 0 ? -leading : leading;
+        if (power >= 100) {
+            buffer[length++] = Char('0' + power / 100);
+            power %= 100;
+        }
+        buffer[length++] = Char('0' + power / 10);
+        buffer[length++] = Char('0' + power % 10);
+        return length;
+    }
+
+    if (leading < 0) {
+        buffer[length++] = Char('0');
+        buffer[length++] = Char('.');
+        for (int i = -1; i > leading; --i) {
+            buffer[length++] = Char('0');
+        }
+        for (int i = 0; i < count; ++i) {
+            buffer[length++] = Char(digits[i]);
+        }
+        return length;
+    }
+
+    for (int i = 0; i <= leading; ++i) {
+        buffer[length++] = Char(i < count ? digits[i] : '0');
+    }
+    if (count > leading + 1) {
+        buffer[length++] = Char('.');
+        for (int i = leading + 1; i < count; ++i) {
+            buffer[length++] = Char(digits[i]);
+        }
+    }
+    return length;
+}
+
+template<typename Char>
+int formatShortestTo(double value, Char* buffer)
+{
+    NumberFormatter::Digits digits;
+    if (!NumberFormatter::shortestDigits(value, digits)) {
+        return value != value ? writeSpecial("nan", false, buffer)
+                              : writeSpecial("inf", value < 0, buffer);
+    }
+    return writeDigits(digits.significand, digits.exponent, digits.negative,
+                       SHORTEST_LAYOUT_PRECISION, buffer);
+}
+
+int fallback(double value, int precision, QChar* buffer)
+{
+    const QString text = QString::number(value, 'g', precision);
+    std::memcpy(buffer, text.constData(), text.size() * sizeof(QChar));
+    return text.size();
+}
+
+int fallback(double value, int precision, char* buffer)
+{
+    const QByteArray text = QByteArray::number(value, 'g', precision);
+    std::memcpy(buffer, text.constData(), text.size());
+    return text.size();
+}
+
+template<typename Char>
+int formatGeneralTo(double value, int precision, Char* buffer)
+{
+    if (precision < 1 || precision > NumberFormatter::MAX_FAST_PRECISION) {
+        return fallback(value, precision, buffer);
+    }
+
+    // У субнормальных чисел шаг больше шага precision цифр: короткие цифры не годятся
+    if (value != 0.0 && qAbs(value) < std::numeric_limits<double>::min()) {
+        return fallback(value, precision, buffer);
+    }
+
+    NumberFormatter::Digits digits;
+    if (!NumberFormatter::shortestDigits(value, digits)
+        || (digits.significand == 0 && digits.negative)) {
+        return fallback(value, precision, buffer);
+    }
+
+    // Кратчайшие цифры отличаются от точного значения меньше чем на полшага double,
+    // а шаг precision <= 15 цифр больше шага double. Поэтому округление кратчайших цифр
+    // совпадает с округлением точного значения, кроме точной середины ("...5" ровно
+    // на позиции precision + 1): там все решает знак остатка, и ответ дает Qt
+    quint64 significand = digits.significand;
+    int exponent = digits.exponent;
+    if (digits.digitCount > precision) {
+        const int dropped = digits.digitCount - precision;
+        if (dropped == 1 && significand % 10 == 5) {
+            return fallback(value, precision, buffer);
+        }
+        const quint64 divisor = POW10[dropped];
+        const quint64 remainder = significand % divisor;
+        significand /= divisor;
+        exponent += dropped;
+        if (remainder >= divisor / 2) {
+            ++significand;
+        }
+        removeTrailingZeros(significand, exponent);
+    }
+
+    return writeDigits(significand, exponent, digits.negative, precision, buffer);
+}
+
+} // namespace
+
+bool NumberFormatter::shortestDigits(double value, Digits& digits)
+{
+    quint64 bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+
+    digits.negative = (bits >> 63) != 0;
+    const quint64 t = bits & SIGNIFICAND_MASK;
+    const int bq = static_cast<int>(bits >> 52) & EXPONENT_MASK;
+    if (bq == EXPONENT_MASK) {
+        return false;
+    }
+
+    quint64 significand = 0;
+    int exponent = 0;
+    if (bq != 0) {
+        const int mq = -Q_MIN + 1 - bq;
+        const quint64 c = C_MIN | t;
+        // Целые значения до 2^53 выводятся как есть
+        if (mq > 0 && mq < 53 && ((c >> mq) << mq) == c) {
+            significand = c >> mq;
+        } else {
+            toDecimal(-mq, c, significand, exponent);
+        }
+    } else if (t != 0) {
+        toDecimal(Q_MIN, t, significand, exponent);
+    }
+
+    removeTrailingZeros(significand, exponent);
+    digits.significand = significand;
+    digits.exponent = exponent;
+    digits.digitCount = digitCount(significand);
+    return true;
+}
+
+int NumberFormatter::formatShortest(double value, QChar* buffer)
+{
+    return formatShortestTo(value, buffer);
+}
+
+int NumberFormatter::formatShortest(double value, char* buffer)
+{
+    return formatShortestTo(value, buffer);
+}
+
+int NumberFormatter::formatGeneral(double value, int precision, QChar* buffer)
+{
+    return formatGeneralTo(value, precision, buffer);
+}
+
+int NumberFormatter::formatGeneral(double value, int precision, char* buffer)
+{
+    return formatGeneralTo(value, precision, buffer);
+}
@@ -0,0 +1,46 @@
+#ifndef NUMBERFORMATTER_H
+#define NUMBERFORMATTER_H
+
+#include <QChar>
+#include <QtGlobal>
+
+// Форматирование double без промежуточных строк: результат пишется в буфер
+// вызывающей стороны (UTF-16 для QString или 8 бит для пакетного вывода).
+// Кратчайшие цифры ищутся алгоритмом Schubfach (R. Giulietti): самое короткое
+// десятичное число, которое при разборе дает исходный double, а из равных по длине -
+// ближайшее к нему.
+class NumberFormatter
+{
+public:
+    // Достаточный размер буфера для formatShortest и для formatGeneral с precision <= 17.
+    // При большей точности буфер должен вмещать precision + 12 символов
+    static const int BUFFER_SIZE = 32;
+    // Наибольшая точность, которую formatGeneral обрабатывает без запасного пути
+    static const int MAX_FAST_PRECISION = 15;
+
+    // Кратчайшее представление: value = significand * 10^exponent,
+    // significand без хвостовых нулей, digitCount - число его цифр
+    struct Digits {
+        quint64 significand;
+        int exponent;
+        int digitCount;
+        bool negative;
+    };
+
+public:
+    // false для бесконечности и NaN. Ноль: significand == 0, digitCount == 1
+    static bool shortestDigits(double value, Digits& digits);
+
+    // Кратчайшие цифры в раскладке формата 'g': научная запись при порядке < -4 или >= 17.
+    // 0.1 -> "0.1", 1e21 -> "1e+21", 5e-324 -> "5e-324". Возвращает число записанных символов
+    static int formatShortest(double value, QChar* buffer);
+    static int formatShortest(double value, char* buffer);
+
+    // Совпадает с QString::number(value, 'g', precision): precision значащих цифр,
+    // без хвостовых нулей. При precision вне 1..MAX_FAST_PRECISION, для -0, бесконечности,
+    // NaN и точной середины между соседними округлениями результат берется у Qt
+    static int formatGeneral(double value, int precision, QChar* buffer);
+    static int formatGeneral(double value, int precision, char* buffer);
+};
+
+#endif // NUMBERFORMATTER_H
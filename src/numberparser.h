@@ -0,0 +1,42 @@
+#ifndef NUMBERPARSER_H
+#define NUMBERPARSER_H
+
+#include <QChar>
+#include <QString>
+#include <QtGlobal>
+
+// Разбор десятичных чисел в double за один проход, без выделений памяти и без
+// зависимости от локали. Результат корректно округлен (как у QString::toDouble):
+// до 19 значащих цифр - быстрый путь Клингера или алгоритм Эйзеля-Лемира
+// (D. Lemire, "Number Parsing at a Gigabyte per Second", 2021); длинные мантиссы
+// почти всегда решаются так же, а в редком неоднозначном случае - через Qt.
+class NumberParser
+{
+public:
+    // Вся строка: [пробелы][+|-](цифры[.[цифры]] | .цифры)[(e|E)[+|-]цифры][пробелы],
+    // а также inf и nan. Переполнение дает бесконечность, потеря значимости - ноль,
+    // в обоих случаях ok = false. При ошибке разбора возвращается 0.0
+    static double toDouble(const QChar* begin, const QChar* end, bool* ok = nullptr);
+    static double toDouble(const char* begin, const char* end, bool* ok = nullptr);
+    static double toDouble(const QString& text, bool* ok = nullptr);
+
+    // Число в начале диапазона, без знака и пробелов: цифры[.цифры][e[+|-]цифры].
+    // "e" без цифр порядка в число не входит. Возвращает позицию после числа
+    // или begin, если числа нет; ok = false при переполнении и потере значимости
+    static const QChar* parsePrefix(const QChar* begin, const QChar* end,
+                                    double& value, bool* ok = nullptr);
+    static const char* parsePrefix(const char* begin, const char* end,
+                                   double& value, bool* ok = nullptr);
+
+    // Точное значение significand * 10^exponent, округленное к ближайшему double.
+    // truncated - мантисса содержит только старшие цифры, отброшенный хвост ненулевой.
+    // false только для truncated, когда хвост влияет на округление
+    static bool decimalToDouble(quint64 significand, int exponent, bool negative,
+                                bool truncated, double& value);
+
+public:
+    // Больше цифр в quint64 без переполнения не накопить
+    static const int MAX_SIGNIFICANT_DIGITS = 19;
+};
+
+#endif // NUMBERPARSER_H
@@ -0,0 +1,141 @@
+#include "persistenceworker.h"
+#include "tracer.h"
+#include <QThread>
+#include <climits>
+
+class PersistenceWorker::Thread : public QThread
+{
+public:
+    explicit Thread(PersistenceWorker* worker)
+        : m_worker(worker)
+    {
+    }
+
+protected:
+    void run() override
+    {
+        Tracer::setThreadName("persistence");
+        m_worker->workerLoop();
+    }
+
+private:
+    PersistenceWorker* m_worker;
+};
+
+PersistenceWorker::PersistenceWorker(int debounceInterval, QObject* parent)
+    : QObject(parent)
+    , m_debounceInterval(debounceInterval)
+    , m_thread(new Thread(this))
+    , m_stopping(false)
+    , m_requested(0)
+    , m_completed(0)
+{
+    m_clock.start();
+    m_thread->start();
+}
+
+PersistenceWorker::~PersistenceWorker()
+{
+    {
+        QMutexLocker locker(&m_mutex);
+        m_stopping = true;
+        m_wakeUp.wakeOne();
+    }
+    m_thread->wait();
+}
+
+void PersistenceWorker::post(const Task& task)
+{
+    enqueue(QString(), task, 0);
+}
+
+void PersistenceWorker::post(const QString& key, const Task& task)
+{
+    enqueue(key, task, m_debounceInterval);
+}
+
+void PersistenceWorker::flush()
+{
+    QMutexLocker locker(&m_mutex);
+    const quint64 target = ++m_requested;
+    m_wakeUp.wakeOne();
+    while (m_completed < target) {
+        m_done.wait(&m_mutex);
+    }
+}
+
+int PersistenceWorker::pendingCount() const
+{
+    QMutexLocker locker(&m_mutex);
+    return m_queue.size();
+}
+
+int PersistenceWorker::debounceInterval() const
+{
+    return m_debounceInterval;
+}
+
+void PersistenceWorker::enqueue(const QString& key, const Task& task, qint64 delay)
+{
+    QMutexLocker locker(&m_mutex);
+    const qint64 due = m_clock.elapsed() + delay;
+    if (!key.isEmpty()) {
+        for (Request& request : m_queue) {
+            if (request.key == key) {
+                // Место в очереди сохраняется, откладывается только срок
+                request.task = task;
+                request.due = due;
+                return;
+            }
+        }
+    }
+
+    Request request;
+    request.key = key;
+    request.task = task;
+    request.due = due;
+    m_queue.append(request);
+    m_wakeUp.wakeOne();
+}
+
+void PersistenceWorker::workerLoop()
+{
+    QMutexLocker locker(&m_mutex);
+    for (;;) {
+        // При flush() и остановке сроки не ждутся
+        const quint64 requested = m_requested;
+        const bool forced = m_stopping || requested != m_completed;
+        const qint64 now = m_clock.elapsed();
+
+        int next = -1;
+        qint64 wait = -1;
+        for (int i = 0; i < m_queue.size(); ++i) {
+            const qint64 remaining = m_queue.at(i).due - now;
+            if (forced || remaining <= 0) {
+                next = i;
+                break;
+            }
+            if (wait < 0 || remaining < wait) {
+                wait = remaining;
+            }
+        }
+
+        if (next < 0) {
+            if (forced) {
+                m_completed = requested;
+                m_done.wakeAll();
+                if (m_stopping) {
+                    return;
+                }
+                continue;
+            }
+            m_wakeUp.wait(&m_mutex, wait < 0 ? ULONG_MAX : static_cast<unsigned long>(wait));
+            continue;
+        }
+
+        const Task task = m_queue.takeAt(next).task;
+        locker.unlock();
+        task();
+        locker.relock();
+    }
+}
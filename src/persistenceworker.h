@@ -0,0 +1,85 @@
+#ifndef PERSISTENCEWORKER_H
+#define PERSISTENCEWORKER_H
+
+#include <QElapsedTimer>
+#include <QList>
+#include <QMutex>
+#include <QObject>
+#include <QScopedPointer>
+#include <QString>
+#include <QWaitCondition>
+#include <functional>
+
+// Фоновый поток для записи на диск: настройки темы, текстовая история,
+// закрытие журнала. post() только ставит задачу в очередь, поэтому поток
+// интерфейса не ждет файловую систему (на сетевом домашнем каталоге - секунды).
+//
+// Задача получает данные копией: QString, QList и QByteArray разделяют их
+// до первого изменения, так что снимок состояния почти бесплатен, а сама задача
+// не трогает объекты интерфейса. Задачи выполняются по одной.
+//
+// Задачи с одинаковым ключом сливаются: еще не начатая задача заменяется новой
+// и откладывается на debounceInterval от последней постановки. Выполняется первая
+// в очереди задача, срок которой наступил, поэтому порядок постановки соблюдается
+// только среди задач без ключа: отложенную задачу с ключом обгоняют поставленные
+// позже. Записи, зависящие друг от друга, ставятся под одним ключом.
+// flush() и деструктор выполняют все оставшееся без ожидания, в порядке очереди,
+// поэтому при выходе на диск попадает последнее состояние
+class PersistenceWorker : public QObject
+{
+    Q_OBJECT
+
+public:
+    typedef std::function<void()> Task;
+
+public:
+    explicit PersistenceWorker(int debounceInterval = DEFAULT_DEBOUNCE_INTERVAL,
+                               QObject* parent = nullptr);
+    // Выполняет все поставленные задачи и останавливает поток
+    ~PersistenceWorker() override;
+
+public:
+    // Задача без слияния: выполняется, как только до нее дойдет очередь
+    void post(const Task& task);
+    // Задача заменяет еще не начатую задачу с тем же ключом
+    void post(const QString& key, const Task& task);
+    // Блокирует, пока не выполнятся все задачи, поставленные до вызова
+    void flush();
+    // Задач в очереди, не считая выполняемой
+    int pendingCount() const;
+    int debounceInterval() const;
+
+public:
+    // Пауза перед записью по ключу, мс
+    static const int DEFAULT_DEBOUNCE_INTERVAL = 300;
+
+private:
+    class Thread;
+    friend class Thread;
+
+    struct Request {
+        QString key;
+        Task task;
+        // Момент, раньше которого задачу не выполнять (по m_clock), мс
+        qint64 due;
+    };
+
+    void enqueue(const QString& key, const Task& task, qint64 delay);
+    void workerLoop();
+
+private:
+    const int m_debounceInterval;
+    QScopedPointer<Thread> m_thread;
+
+    // Состояние, общее с фоновым потоком
+    mutable QMutex m_mutex;
+    QWaitCondition m_wakeUp;
+    QWaitCondition m_done;
+    QList<Request> m_queue;
+    QElapsedTimer m_clock;
+    bool m_stopping;
+    quint64 m_requested;
+    quint64 m_completed;
+};
+
+#endif // PERSISTENCEWORKER_H
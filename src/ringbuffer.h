@@ -0,0 +1,129 @@
+#ifndef RINGBUFFER_H
+#define RINGBUFFER_H
+
+#include <QVector>
+#include <iterator>
+
+// Кольцевой буфер фиксированной емкости: добавление и вытеснение самого старого
+// элемента за O(1). Память растет по мере заполнения и не превышает емкость.
+// Индексы и итераторы идут от самого старого элемента к самому новому.
+template<typename T>
+class RingBuffer
+{
+public:
+    class const_iterator
+    {
+    public:
+        typedef std::random_access_iterator_tag iterator_category;
+        typedef T value_type;
+        typedef int difference_type;
+        typedef const T* pointer;
+        typedef const T& reference;
+
+        const_iterator() : m_buffer(nullptr), m_index(0) {}
+        const_iterator(const RingBuffer* buffer, int index) : m_buffer(buffer), m_index(index) {}
+
+        reference operator*() const { return m_buffer->at(m_index); }
+        pointer operator->() const { return &m_buffer->at(m_index); }
+        reference operator[](int offset) const { return m_buffer->at(m_index + offset); }
+
+        const_iterator& operator++() { ++m_index; return *this; }
+        const_iterator operator++(int) { const_iterator old = *this; ++m_index; return old; }
+        const_iterator& operator--() { --m_index; return *this; }
+        const_iterator operator--(int) { const_iterator old = *this; --m_index; return old; }
+        const_iterator& operator+=(int offset) { m_index += offset; return *this; }
+        const_iterator& operator-=(int offset) { m_index -= offset; return *this; }
+        const_iterator operator+(int offset) const { return const_iterator(m_buffer, m_index + offset); }
+        const_iterator operator-(int offset) const { return const_iterator(m_buffer, m_index - offset); }
+        int operator-(const const_iterator& other) const { return m_index - other.m_index; }
+
+        bool operator==(const const_iterator& other) const { return m_index == other.m_index; }
+        bool operator!=(const const_iterator& other) const { return m_index != other.m_index; }
+        bool operator<(const const_iterator& other) const { return m_index < other.m_index; }
+        bool operator>(const const_iterator& other) const { return m_index > other.m_index; }
+        bool operator<=(const const_iterator& other) const { return m_index <= other.m_index; }
+        bool operator>=(const const_iterator& other) const { return m_index >= other.m_index; }
+
+    private:
+        const RingBuffer* m_buffer;
+        int m_index;
+    };
+
+    typedef std::reverse_iterator<const_iterator> const_reverse_iterator;
+
+public:
+    explicit RingBuffer(int capacity = 0) : m_capacity(qMax(0, capacity)), m_head(0) {}
+
+public:
+    int capacity() const { return m_capacity; }
+    int size() const { return m_items.size(); }
+    bool isEmpty() const { return m_items.isEmpty(); }
+    bool isFull() const { return m_items.size() == m_capacity; }
+
+    // Меньшая емкость отбрасывает самые старые элементы. O(size)
+    void setCapacity(int capacity)
+    {
+        capacity = qMax(0, capacity);
+        const int kept = qMin(size(), capacity);
+        QVector<T> items;
+        items.reserve(kept);
+        for (int i = size() - kept; i < size(); ++i) {
+            items.append(at(i));
+        }
+        m_items.swap(items);
+        m_head = 0;
+        m_capacity = capacity;
+    }
+
+    // Добавляет элемент как самый новый; в полном буфере он занимает место самого старого
+    void append(const T& value)
+    {
+        if (m_capacity == 0) {
+            return;
+        }
+        if (m_items.size() < m_capacity) {
+            m_items.append(value);
+            return;
+        }
+        m_items[m_head] = value;
+        if (++m_head == m_capacity) {
+            m_head = 0;
+        }
+    }
+
+    void clear()
+    {
+        m_items.clear();
+        m_head = 0;
+    }
+
+public:
+    // 0 - самый старый элемент, size() - 1 - самый новый
+    const T& at(int index) const
+    {
+        Q_ASSERT(index >= 0 && index < size());
+        int slot = m_head + index;
+        if (slot >= m_items.size()) {
+            slot -= m_items.size();
+        }
+        return m_items.at(slot);
+    }
+
+    const T& operator[](int index) const { return at(index); }
+
+    const T& first() const { return at(0); }
+    const T& last() const { return at(size() - 1); }
+
+    const_iterator begin() const { return const_iterator(this, 0); }
+    const_iterator end() const { return const_iterator(this, size()); }
+    const_reverse_iterator rbegin() const { return const_reverse_iterator(end()); }
+    const_reverse_iterator rend() const { return const_reverse_iterator(begin()); }
+
+private:
+    QVector<T> m_items;
+    int m_capacity;
+    // Позиция самого старого элемента, пока буфер полон; иначе 0
+    int m_head;
+};
+
+#endif // RINGBUFFER_H
@@ -1,17 +1,21 @@
 #include "thememanager.h"
+#include "persistenceworker.h"
+#include "tracer.h"
+#include "logcategories.h"
 #include <QApplication>
 #include <QSettings>
-#include <QDebug>
 #include <QPalette>
 
 ThemeManager::ThemeManager(QObject *parent)
     : QObject(parent)
     , m_currentTheme(Theme::Light)
+    , m_persistence(nullptr)
 {
 }
 
 void ThemeManager::setTheme(Theme theme)
 {
+    const TraceSpan span("theme", "ThemeManager::setTheme");
     if (theme == Theme::System) {
         theme = detectSystemTheme();
     }
@@ -20,7 +24,7 @@ void ThemeManager::setTheme(Theme theme)
         m_currentTheme = theme;
         applyTheme(theme);
         emit themeChanged(theme);
-        qDebug() << "Тема изменена на:" << themeName(theme);
+        qCDebug(lcTheme) << "Тема изменена на:" << themeName(theme);
     }
 }
 
@@ -43,25 +47,41 @@ QString ThemeManager::getStyleSheet(Theme theme) const
 
 void ThemeManager::applyTheme(Theme theme)
 {
+    const TraceSpan span("theme", "ThemeManager::applyTheme");
     QString styleSheet = getStyleSheet(theme);
     qApp->setStyleSheet(styleSheet);
 }
 
 void ThemeManager::saveThemePreference()
 {
-    QSettings settings("Calculator", "Theme");
-    settings.setValue("theme", static_cast<int>(m_currentTheme));
-    qDebug() << "Настройки темы сохранены";
+    const int theme = static_cast<int>(m_currentTheme);
+    const PersistenceWorker::Task save = [theme]() {
+        QSettings settings("Calculator", "Theme");
+        settings.setValue("theme", theme);
+        qCDebug(lcTheme) << "Настройки темы сохранены";
+    };
+
+    if (m_persistence) {
+        m_persistence->post("theme", save);
+    } else {
+        save();
+    }
 }
 
 void ThemeManager::loadThemePreference()
 {
+    const TraceSpan span("theme", "ThemeManager::loadThemePreference");
     QSettings settings("Calculator", "Theme");
     int themeValue = settings.value("theme", static_cast<int>(Theme::Light)).toInt();
     Theme theme = static_cast<Theme>(themeValue);
     
     setTheme(theme);
-    qDebug() << "Настройки темы загружены:" << themeName(theme);
+    qCDebug(lcTheme) << "Настройки темы загружены:" << themeName(theme);
+}
+
+void ThemeManager::setPersistenceWorker(PersistenceWorker* worker)
+{
+    m_persistence = worker;
 }
 
 QString ThemeManager::themeName(Theme theme)
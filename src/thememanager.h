@@ -5,6 +5,8 @@
 #include <QMetaType>
 #include <QString>
 
+class PersistenceWorker;
+
 // Класс для управления темами оформления
 class ThemeManager : public QObject
 {
@@ -29,8 +31,10 @@ public:
     QString getStyleSheet(Theme theme) const;
     void applyTheme(Theme theme);
     
+    // С заданным PersistenceWorker сохранение идет в его потоке, иначе сразу
     void saveThemePreference();
     void loadThemePreference();
+    void setPersistenceWorker(PersistenceWorker* worker);
     static QString themeName(Theme theme);
 
 signals:
@@ -43,6 +47,7 @@ private:
 
 private:
     Theme m_currentTheme;
+    PersistenceWorker* m_persistence;
 };
 
 Q_DECLARE_METATYPE(ThemeManager::Theme)
@@ -0,0 +1,198 @@
+#include "tracer.h"
+#include "ringbuffer.h"
+
+#include <QElapsedTimer>
+#include <QJsonArray>
+#include <QJsonObject>
+#include <QMutex>
+#include <QSaveFile>
+#include <QSharedPointer>
+
+std::atomic<bool> Tracer::s_enabled(false);
+
+namespace {
+
+struct ThreadBuffer {
+    ThreadBuffer(int id, int capacity)
+        : id(id)
+        , name(QString("thread %1").arg(id))
+        , events(capacity)
+    {
+    }
+
+    const int id;
+    QMutex mutex;
+    QString name;
+    RingBuffer<Tracer::Event> events;
+};
+
+// Буферы живут до выхода из программы: события завершившихся потоков тоже попадают в трассу
+struct Registry {
+    Registry()
+        : capacity(Tracer::DEFAULT_BUFFER_CAPACITY)
+    {
+        clock.start();
+    }
+
+    QElapsedTimer clock;
+    QMutex mutex;
+    int capacity;
+    QVector<QSharedPointer<ThreadBuffer>> buffers;
+};
+
+Registry& registry()
+{
+    static Registry instance;
+    return instance;
+}
+
+thread_local ThreadBuffer* t_buffer = nullptr;
+
+ThreadBuffer* threadBuffer()
+{
+    if (!t_buffer) {
+        Registry& r = registry();
+        QMutexLocker locker(&r.mutex);
+        QSharedPointer<ThreadBuffer> buffer(new ThreadBuffer(r.buffers.size() + 1, r.capacity));
+        r.buffers.append(buffer);
+        t_buffer = buffer.data();
+    }
+    return t_buffer;
+}
+
+QVector<QSharedPointer<ThreadBuffer>> allBuffers()
+{
+    Registry& r = registry();
+    QMutexLocker locker(&r.mutex);
+    return r.buffers;
+}
+
+} // namespace
+
+void Tracer::setEnabled(bool enabled)
+{
+    // Часы запускаются до первого интервала, а не внутри него
+    registry();
+    s_enabled.store(enabled, std::memory_order_relaxed);
+}
+
+qint64 Tracer::now()
+{
+    return registry().clock.nsecsElapsed();
+}
+
+void Tracer::record(const char* category, const char* name, qint64 start, qint64 duration)
+{
+    ThreadBuffer* buffer = threadBuffer();
+    const Event event = { category, name, start, duration };
+    QMutexLocker locker(&buffer->mutex);
+    buffer->events.append(event);
+}
+
+void Tracer::setThreadName(const QString& name)
+{
+    ThreadBuffer* buffer = threadBuffer();
+    QMutexLocker locker(&buffer->mutex);
+    buffer->name = name;
+}
+
+void Tracer::setBufferCapacity(int capacity)
+{
+    Registry& r = registry();
+    QMutexLocker locker(&r.mutex);
+    r.capacity = qMax(1, capacity);
+}
+
+int Tracer::bufferCapacity()
+{
+    Registry& r = registry();
+    QMutexLocker locker(&r.mutex);
+    return r.capacity;
+}
+
+QVector<Tracer::Thread> Tracer::threads()
+{
+    QVector<Thread> result;
+    for (const QSharedPointer<ThreadBuffer>& buffer : allBuffers()) {
+        Thread thread;
+        thread.id = buffer->id;
+        QMutexLocker locker(&buffer->mutex);
+        thread.name = buffer->name;
+        thread.events.reserve(buffer->events.size());
+        for (const Event& event : buffer->events) {
+            thread.events.append(event);
+        }
+        result.append(thread);
+    }
+    return result;
+}
+
+int Tracer::eventCount()
+{
+    int count = 0;
+    for (const QSharedPointer<ThreadBuffer>& buffer : allBuffers()) {
+        QMutexLocker locker(&buffer->mutex);
+        count += buffer->events.size();
+    }
+    return count;
+}
+
+void Tracer::clear()
+{
+    for (const QSharedPointer<ThreadBuffer>& buffer : allBuffers()) {
+        QMutexLocker locker(&buffer->mutex);
+        buffer->events.clear();
+    }
+}
+
+QJsonDocument Tracer::toJson()
+{
+    QJsonArray events;
+    QJsonObject process;
+    process.insert("name", QString("process_name"));
+    process.insert("ph", QString("M"));
+    process.insert("pid", 1);
+    QJsonObject processArgs;
+    processArgs.insert("name", QString("calc"));
+    process.insert("args", processArgs);
+    events.append(process);
+
+    for (const Thread& thread : threads()) {
+        QJsonObject metadata;
+        metadata.insert("name", QString("thread_name"));
+        metadata.insert("ph", QString("M"));
+        metadata.insert("pid", 1);
+        metadata.insert("tid", thread.id);
+        QJsonObject args;
+        args.insert("name", thread.name);
+        metadata.insert("args", args);
+        events.append(metadata);
+
+        for (const Event& event : thread.events) {
+            QJsonObject json;
+            json.insert("cat", QString(event.category));
+            json.insert("name", QString(event.name));
+            json.insert("ph", QString("X"));
+            json.insert("ts", event.start / 1000.0);
+            json.insert("dur", event.duration / 1000.0);
+            json.insert("pid", 1);
+            json.insert("tid", thread.id);
+            events.append(json);
+        }
+    }
+
+    QJsonObject root;
+    root.insert("traceEvents", events);
+    root.insert("displayTimeUnit", QString("ms"));
+    return QJsonDocument(root);
+}
+
+bool Tracer::writeJson(const QString& filename)
+{
+    QSaveFile file(filename);
+    if (!file.open(QIODevice::WriteOnly)) {
+        return false;
+    }
+    file.write(toJson().toJson(QJsonDocument::Compact));
+    return file.commit();
+}
@@ -0,0 +1,94 @@
+#ifndef TRACER_H
+#define TRACER_H
+
+#include <QJsonDocument>
+#include <QString>
+#include <QVector>
+#include <atomic>
+
+// Трассировка горячих путей в формате Chrome trace (chrome://tracing, Perfetto).
+// Каждый поток пишет завершенные интервалы в свой кольцевой буфер: новые события
+// вытесняют самые старые, память потока не превышает bufferCapacity() событий.
+// Блокировка буфера берется только его потоком и экспортом, поэтому не конкурирует.
+//
+// Выключенная трассировка стоит TraceSpan одного чтения флага; включается
+// переменной CALC_TRACE или setEnabled(). Имена и категории - строковые литералы:
+// хранится только указатель
+class Tracer
+{
+public:
+    struct Event {
+        const char* category;
+        const char* name;
+        qint64 start;     // нс от запуска трассировщика
+        qint64 duration;  // нс
+    };
+
+    // Снимок буфера одного потока, события от старых к новым
+    struct Thread {
+        int id;
+        QString name;
+        QVector<Event> events;
+    };
+
+public:
+    static void setEnabled(bool enabled);
+    static bool isEnabled()
+    {
+        return s_enabled.load(std::memory_order_relaxed);
+    }
+
+    static qint64 now();
+    static void record(const char* category, const char* name, qint64 start, qint64 duration);
+    // Имя текущего потока в трассе; по умолчанию "thread N"
+    static void setThreadName(const QString& name);
+
+    // Емкость буферов, созданных после вызова; уже созданные не меняются
+    static void setBufferCapacity(int capacity);
+    static int bufferCapacity();
+
+public:
+    static QVector<Thread> threads();
+    static int eventCount();
+    static void clear();
+
+    // {"traceEvents": [...]} с событиями "X" (ts и dur в мкс) и именами потоков
+    static QJsonDocument toJson();
+    static bool writeJson(const QString& filename);
+
+public:
+    static const int DEFAULT_BUFFER_CAPACITY = 65536;
+
+private:
+    static std::atomic<bool> s_enabled;
+};
+
+// Интервал от создания до конца области видимости:
+//     const TraceSpan span("history", "saveToFile");
+class TraceSpan
+{
+public:
+    TraceSpan(const char* category, const char* name)
+        : m_category(category)
+        , m_name(name)
+        , m_start(Tracer::isEnabled() ? Tracer::now() : -1)
+    {
+    }
+
+    ~TraceSpan()
+    {
+        if (m_start >= 0) {
+            Tracer::record(m_category, m_name, m_start, Tracer::now() - m_start);
+        }
+    }
+
+    TraceSpan(const TraceSpan&) = delete;
+    TraceSpan& operator=(const TraceSpan&) = delete;
+
+private:
+    const char* m_category;
+    const char* m_name;
+    qint64 m_start;
+};
+
+#endif // TRACER_H
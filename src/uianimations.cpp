@@ -2,9 +2,28 @@
 #include <QGraphicsColorizeEffect>
 #include <QSequentialAnimationGroup>
 #include <QParallelAnimationGroup>
+#include "tracer.h"
+
+namespace {
+
+// Анимация идет после возврата из UIAnimations: ее время в трассе - отдельный
+// интервал от запуска до finished
+void traceRunning(QAbstractAnimation* animation, const char* name)
+{
+    if (!Tracer::isEnabled()) {
+        return;
+    }
+    const qint64 start = Tracer::now();
+    QObject::connect(animation, &QAbstractAnimation::finished, [name, start]() {
+        Tracer::record("animation", name, start, Tracer::now() - start);
+    });
+}
+
+} // namespace
 
 void UIAnimations::flashError(QWidget* widget, int duration)
 {
+    const TraceSpan span("animation", "UIAnimations::flashError");
     if (!widget) return;
     
     QString originalStyle = widget->styleSheet();
@@ -16,11 +35,13 @@ void UIAnimations::flashError(QWidget* widget, int duration)
     animation->setEasingCurve(QEasingCurve::OutQuad);
     
     QObject::connect(animation, &QPropertyAnimation::finished, animation, &QObject::deleteLater);
+    traceRunning(animation, "UIAnimations::flashError[run]");
     animation->start(QAbstractAnimation::DeleteWhenStopped);
 }
 
 void UIAnimations::flashSuccess(QWidget* widget, int duration)
 {
+    const TraceSpan span("animation", "UIAnimations::flashSuccess");
     if (!widget) return;
     
     QString originalStyle = widget->styleSheet();
@@ -32,11 +53,13 @@ void UIAnimations::flashSuccess(QWidget* widget, int duration)
     animation->setEasingCurve(QEasingCurve::OutQuad);
     
     QObject::connect(animation, &QPropertyAnimation::finished, animation, &QObject::deleteLater);
+    traceRunning(animation, "UIAnimations::flashSuccess[run]");
     animation->start(QAbstractAnimation::DeleteWhenStopped);
 }
 
 void UIAnimations::buttonPress(QWidget* button, int duration)
 {
+    const TraceSpan span("animation", "UIAnimations::buttonPress");
     if (!button) return;
     
     QPropertyAnimation* scaleDown = new QPropertyAnimation(button, "geometry");
@@ -56,11 +79,13 @@ void UIAnimations::buttonPress(QWidget* button, int duration)
     group->addAnimation(scaleUp);
     
     QObject::connect(group, &QSequentialAnimationGroup::finished, group, &QObject::deleteLater);
+    traceRunning(group, "UIAnimations::buttonPress[run]");
     group->start(QAbstractAnimation::DeleteWhenStopped);
 }
 
 void UIAnimations::fadeIn(QWidget* widget, int duration)
 {
+    const TraceSpan span("animation", "UIAnimations::fadeIn");
     if (!widget) return;
     
     QGraphicsOpacityEffect* effect = new QGraphicsOpacityEffect(widget);
@@ -76,11 +101,13 @@ void UIAnimations::fadeIn(QWidget* widget, int duration)
         effect->deleteLater();
     });
     QObject::connect(animation, &QPropertyAnimation::finished, animation, &QObject::deleteLater);
+    traceRunning(animation, "UIAnimations::fadeIn[run]");
     animation->start(QAbstractAnimation::DeleteWhenStopped);
 }
 
 void UIAnimations::fadeOut(QWidget* widget, int duration)
 {
+    const TraceSpan span("animation", "UIAnimations::fadeOut");
     if (!widget) return;
     
     QGraphicsOpacityEffect* effect = new QGraphicsOpacityEffect(widget);
@@ -96,11 +123,13 @@ void UIAnimations::fadeOut(QWidget* widget, int duration)
         effect->deleteLater();
     });
     QObject::connect(animation, &QPropertyAnimation::finished, animation, &QObject::deleteLater);
+    traceRunning(animation, "UIAnimations::fadeOut[run]");
     animation->start(QAbstractAnimation::DeleteWhenStopped);
 }
 
 void UIAnimations::shake(QWidget* widget, int duration)
 {
+    const TraceSpan span("animation", "UIAnimations::shake");
     if (!widget) return;
     
     QSequentialAnimationGroup* group = new QSequentialAnimationGroup();
@@ -132,5 +161,6 @@ void UIAnimations::shake(QWidget* widget, int duration)
     group->addAnimation(moveBack);
     
     QObject::connect(group, &QSequentialAnimationGroup::finished, group, &QObject::deleteLater);
+    traceRunning(group, "UIAnimations::shake[run]");
     group->start(QAbstractAnimation::DeleteWhenStopped);
 }
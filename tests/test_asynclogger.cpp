@@ -0,0 +1,223 @@
+#include "asynclogger.h"
+#include "logcategories.h"
+#include <QtTest/QtTest>
+#include <QBuffer>
+#include <QThread>
+#include <functional>
+
+/**
+ * @brief Тесты для класса AsyncLogger
+ *
+ * Формат строки, порядок вывода, запись из нескольких потоков, переполнение
+ * очереди, установка и снятие обработчика и уровни категорий по умолчанию.
+ */
+class TestAsyncLogger : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void testFormat();
+    void testOrder();
+    void testProducers();
+    void testOverflow();
+    void testInstall();
+    void testUninstallWhileLogging();
+    void testCategories();
+};
+
+namespace {
+
+class FunctionThread : public QThread
+{
+public:
+    explicit FunctionThread(const std::function<void()>& function)
+        : m_function(function)
+    {
+    }
+
+protected:
+    void run() override
+    {
+        m_function();
+    }
+
+private:
+    std::function<void()> m_function;
+};
+
+const QMessageLogContext memoryContext(nullptr, 0, nullptr, "calc.memory");
+
+// Строки вывода без завершающей пустой
+QStringList outputLines(const QBuffer& buffer)
+{
+    QStringList lines = QString::fromLocal8Bit(buffer.data()).split('\n');
+    if (!lines.isEmpty() && lines.last().isEmpty()) {
+        lines.removeLast();
+    }
+    return lines;
+}
+
+} // namespace
+
+void TestAsyncLogger::testFormat()
+{
+    const QString line = AsyncLogger::formatMessage(QtWarningMsg, "calc.memory", 0, "M+: 5");
+    QVERIFY(line.endsWith(" W calc.memory: M+: 5"));
+    QVERIFY(AsyncLogger::formatMessage(QtDebugMsg, "calc.ui", 0, "x").endsWith(" D calc.ui: x"));
+}
+
+void TestAsyncLogger::testOrder()
+{
+    QBuffer buffer;
+    QVERIFY(buffer.open(QIODevice::WriteOnly));
+    const int count = 5000;
+    // Емкость округляется до степени двойки и вмещает все сообщения
+    AsyncLogger logger(count);
+    QCOMPARE(logger.capacity(), 8192);
+    logger.setOutput(&buffer);
+
+    for (int i = 0; i < count; ++i) {
+        QVERIFY(logger.log(QtDebugMsg, memoryContext, QString::number(i)));
+    }
+    logger.flush();
+
+    const QStringList lines = outputLines(buffer);
+    QCOMPARE(lines.size(), count);
+    for (int i = 0; i < count; ++i) {
+        QVERIFY(lines.at(i).endsWith(QString(" D calc.memory: %1").arg(i)));
+    }
+}
+
+void TestAsyncLogger::testProducers()
+{
+    QBuffer buffer;
+    QVERIFY(buffer.open(QIODevice::WriteOnly));
+    const int threadCount = 4;
+    const int messages = 2000;
+    AsyncLogger logger(threadCount * messages);
+    logger.setOutput(&buffer);
+
+    QVector<FunctionThread*> threads;
+    for (int t = 0; t < threadCount; ++t) {
+        threads.append(new FunctionThread([&logger, t, messages]() {
+            for (int i = 0; i < messages; ++i) {
+                logger.log(QtInfoMsg, memoryContext, QString("%1:%2").arg(t).arg(i));
+            }
+        }));
+        threads.last()->start();
+    }
+    for (FunctionThread* thread : threads) {
+        thread->wait();
+        delete thread;
+    }
+    logger.flush();
+
+    // Очередь вмещает все сообщения; порядок внутри потока сохраняется
+    QCOMPARE(logger.droppedCount(), quint64(0));
+    const QStringList lines = outputLines(buffer);
+    QCOMPARE(lines.size(), threadCount * messages);
+    QVector<int> next(threadCount, 0);
+    for (const QString& line : lines) {
+        const QStringList parts = line.mid(line.lastIndexOf(' ') + 1).split(':');
+        QCOMPARE(parts.size(), 2);
+        const int thread = parts.at(0).toInt();
+        QCOMPARE(parts.at(1).toInt(), next[thread]);
+        ++next[thread];
+    }
+}
+
+void TestAsyncLogger::testOverflow()
+{
+    QBuffer buffer;
+    QVERIFY(buffer.open(QIODevice::WriteOnly));
+    const int count = 20000;
+    int accepted = 0;
+    quint64 dropped = 0;
+    {
+        AsyncLogger logger(2);
+        logger.setOutput(&buffer);
+        for (int i = 0; i < count; ++i) {
+            accepted += logger.log(QtDebugMsg, memoryContext, "x") ? 1 : 0;
+        }
+        logger.flush();
+        dropped = logger.droppedCount();
+    }
+
+    // Отброшенные сообщения не блокируют и учтены строкой о пропуске
+    QCOMPARE(quint64(accepted) + dropped, quint64(count));
+    const QStringList lines = outputLines(buffer);
+    int delivered = 0;
+    quint64 reported = 0;
+    for (const QString& line : lines) {
+        if (line.endsWith(" D calc.memory: x")) {
+            ++delivered;
+        } else {
+            reported += line.mid(line.lastIndexOf(' ') + 1).toULongLong();
+        }
+    }
+    QCOMPARE(delivered, accepted);
+    QCOMPARE(reported, dropped);
+}
+
+void TestAsyncLogger::testInstall()
+{
+    QBuffer buffer;
+    QVERIFY(buffer.open(QIODevice::WriteOnly));
+    {
+        AsyncLogger logger;
+        logger.setOutput(&buffer);
+        logger.install();
+        qWarning("через обработчик");
+        logger.uninstall();
+        qWarning("мимо логгера");
+        logger.flush();
+    }
+
+    const QStringList lines = outputLines(buffer);
+    QCOMPARE(lines.size(), 1);
+    QVERIFY(lines.first().endsWith(": через обработчик"));
+}
+
+void TestAsyncLogger::testUninstallWhileLogging()
+{
+    // Потоки пишут через обработчик, пока логгеры создаются и разрушаются:
+    // разрушение ждет начатые вызовы, а не обрывает их
+    std::atomic<bool> stop(false);
+    QVector<FunctionThread*> threads;
+    for (int t = 0; t < 4; ++t) {
+        threads.append(new FunctionThread([&stop]() {
+            while (!stop.load()) {
+                qWarning("из другого потока");
+            }
+        }));
+        threads.last()->start();
+    }
+
+    for (int i = 0; i < 100; ++i) {
+        QBuffer buffer;
+        QVERIFY(buffer.open(QIODevice::WriteOnly));
+        AsyncLogger logger(64);
+        logger.setOutput(&buffer);
+        logger.install();
+        QThread::usleep(100);
+    }
+
+    stop.store(true);
+    for (FunctionThread* thread : threads) {
+        thread->wait();
+        delete thread;
+    }
+}
+
+void TestAsyncLogger::testCategories()
+{
+    // Отладочный вывод выключен по умолчанию, предупреждения включены
+    QVERIFY(!lcMemory().isDebugEnabled());
+    QVERIFY(!lcHistory().isDebugEnabled());
+    QVERIFY(lcMemory().isInfoEnabled());
+    QVERIFY(lcStorage().isWarningEnabled());
+    QCOMPARE(QString(lcTheme().categoryName()), QString("calc.theme"));
+}
+
+QTEST_MAIN(TestAsyncLogger)
+#include "test_asynclogger.moc"
@@ -0,0 +1,138 @@
+#include "batchevaluator.h"
+#include "calculatorconfig.h"
+#include <QtTest/QtTest>
+#include <QBuffer>
+
+/**
+ * @brief Тесты для класса BatchEvaluator
+ */
+class TestBatchEvaluator : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void testBinaryOperations();
+    void testUnaryOperations();
+    void testUnicodeOperators();
+    void testErrors();
+    void testEmptyLines();
+    void testRunStream();
+    void testLastLineWithoutNewline();
+    void testDecimalBackend();
+
+private:
+    QByteArray evaluate(const QByteArray& line);
+    QByteArray runBatch(const QByteArray& input, BatchEvaluator::Statistics* stats = nullptr);
+};
+
+QByteArray TestBatchEvaluator::evaluate(const QByteArray& line)
+{
+    BatchEvaluator evaluator;
+    QByteArray out;
+    evaluator.evaluateLine(line.constData(), line.constData() + line.size(), out);
+    return out;
+}
+
+QByteArray TestBatchEvaluator::runBatch(const QByteArray& input, BatchEvaluator::Statistics* stats)
+{
+    QByteArray inputData = input;
+    QByteArray outputData;
+    QBuffer in(&inputData);
+    QBuffer out(&outputData);
+    in.open(QIODevice::ReadOnly);
+    out.open(QIODevice::WriteOnly);
+
+    BatchEvaluator evaluator;
+    BatchEvaluator::Statistics result = evaluator.run(&in, &out);
+    if (stats) {
+        *stats = result;
+    }
+    return outputData;
+}
+
+void TestBatchEvaluator::testBinaryOperations()
+{
+    QCOMPARE(evaluate("5 + 3"), QByteArray("8\n"));
+    QCOMPARE(evaluate("10 - 4"), QByteArray("6\n"));
+    QCOMPARE(evaluate("6 * 7"), QByteArray("42\n"));
+    QCOMPARE(evaluate("15 / 3"), QByteArray("5\n"));
+    QCOMPARE(evaluate("-2.5*-4"), QByteArray("10\n"));
+    QCOMPARE(evaluate("1e3 + 1"), QByteArray("1001\n"));
+}
+
+void TestBatchEvaluator::testUnaryOperations()
+{
+    QCOMPARE(evaluate("√(16)"), QByteArray("4\n"));
+    QCOMPARE(evaluate("sqrt(9)"), QByteArray("3\n"));
+    QCOMPARE(evaluate("x²(5)"), QByteArray("25\n"));
+    QCOMPARE(evaluate("±(7)"), QByteArray("-7\n"));
+    QCOMPARE(evaluate("1/x(4)"), QByteArray("0.25\n"));
+    QCOMPARE(evaluate("%(50)"), QByteArray("0.5\n"));
+}
+
+void TestBatchEvaluator::testUnicodeOperators()
+{
+    QCOMPARE(evaluate("6 × 7"), QByteArray("42\n"));
+    QCOMPARE(evaluate("8 ÷ 2"), QByteArray("4\n"));
+}
+
+void TestBatchEvaluator::testErrors()
+{
+    QCOMPARE(evaluate("1 / 0"), CalculatorConfig::ERROR_DIVISION_BY_ZERO.toUtf8() + "\n");
+    QCOMPARE(evaluate("√(-4)"), CalculatorConfig::ERROR_SQRT_NEGATIVE.toUtf8() + "\n");
+    QCOMPARE(evaluate("abc"), CalculatorConfig::ERROR_INVALID_INPUT.toUtf8() + "\n");
+    QCOMPARE(evaluate("5 +"), CalculatorConfig::ERROR_INVALID_INPUT.toUtf8() + "\n");
+    QCOMPARE(evaluate("5 + 3 4"), CalculatorConfig::ERROR_INVALID_INPUT.toUtf8() + "\n");
+}
+
+void TestBatchEvaluator::testEmptyLines()
+{
+    QCOMPARE(evaluate(""), QByteArray("\n"));
+    QCOMPARE(evaluate("   "), QByteArray("\n"));
+}
+
+void TestBatchEvaluator::testRunStream()
+{
+    BatchEvaluator::Statistics stats;
+    QByteArray output = runBatch("1 + 1\r\n2 * 3\n\n4 / 0\n", &stats);
+
+    QByteArray expected = "2\n6\n\n" + CalculatorConfig::ERROR_DIVISION_BY_ZERO.toUtf8() + "\n";
+    QCOMPARE(output, expected);
+    QCOMPARE(stats.lines, qint64(4));
+    QCOMPARE(stats.errors, qint64(1));
+}
+
+void TestBatchEvaluator::testLastLineWithoutNewline()
+{
+    QCOMPARE(runBatch("1 + 2\n3 + 4"), QByteArray("3\n7\n"));
+}
+
+void TestBatchEvaluator::testDecimalBackend()
+{
+    BatchEvaluator evaluator;
+    evaluator.setBackend(CalcHandler::Backend::Decimal);
+    QCOMPARE(evaluator.backend(), CalcHandler::Backend::Decimal);
+
+    // Результат не сводится к double: все цифры точности и точные десятичные суммы
+    const QByteArray input = "0.1 + 0.2\n1 ÷ 3\n(0.1 + 0.2) × 3 − 0.9\n1 ÷ 0\n"
+                             "123456789012345 × 1000000007\n";
+    QByteArray inputData = input;
+    QByteArray outputData;
+    QBuffer in(&inputData);
+    QBuffer out(&outputData);
+    in.open(QIODevice::ReadOnly);
+    out.open(QIODevice::WriteOnly);
+    evaluator.run(&in, &out);
+    QCOMPARE(outputData, QByteArray("0.3\n0.3333333333333333333333333333333333\n0\n")
+                         + CalculatorConfig::ERROR_DIVISION_BY_ZERO.toUtf8()
+                         + "\n1.23456789876542523086415e+23\n");
+
+    evaluator.setBackend(CalcHandler::Backend::Decimal, DecimalContext(5));
+    QByteArray rounded;
+    const QByteArray line = "2 ÷ 3";
+    evaluator.evaluateLine(line.constData(), line.constData() + line.size(), rounded);
+    QCOMPARE(rounded, QByteArray("0.66667\n"));
+}
+
+QTEST_MAIN(TestBatchEvaluator)
+#include "test_batchevaluator.moc"
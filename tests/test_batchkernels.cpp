@@ -0,0 +1,274 @@
+#include "batchkernels.h"
+#include "calchandler.h"
+#include <QtTest/QtTest>
+#include <QVector>
+#include <cmath>
+
+/**
+ * @brief Тесты для класса BatchKernels
+ *
+ * Каждый доступный набор инструкций сверяется с поэлементными
+ * CalcHandler::performBinaryOperation и CalcHandler::applyUnaryOperation.
+ */
+class TestBatchKernels : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+
+    void testMatchesScalarHandler();
+    void testDivisionByZeroMask();
+    void testTailElements();
+    void testInPlace();
+    void testUnknownOperation();
+    void testEmptyInput();
+    void testHandlerBatchApi();
+
+    void testUnaryMatchesScalarHandler();
+    void testUnaryDomainErrors();
+    void testUnaryTailElements();
+    void testUnaryUnknownOperation();
+    void testHandlerUnaryBatchApi();
+
+private:
+    QVector<BatchKernels::InstructionSet> instructionSets() const;
+
+    QVector<double> m_lhs;
+    QVector<double> m_rhs;
+};
+
+void TestBatchKernels::initTestCase()
+{
+    // Детерминированные данные с нулями, отрицательными числами и дробями
+    for (int i = 0; i < 1027; ++i) {
+        m_lhs.append((i % 17) * 1.25 - 7.0);
+        m_rhs.append(i % 5 == 0 ? 0.0 : (i % 11) * 0.5 - 2.5);
+    }
+}
+
+QVector<BatchKernels::InstructionSet> TestBatchKernels::instructionSets() const
+{
+    return QVector<BatchKernels::InstructionSet>()
+        << BatchKernels::InstructionSet::Scalar
+        << BatchKernels::InstructionSet::Sse2
+        << BatchKernels::InstructionSet::Avx2;
+}
+
+void TestBatchKernels::testMatchesScalarHandler()
+{
+    const CalcHandler::Operation ops[] = {
+        CalcHandler::Operation::Add,
+        CalcHandler::Operation::Subtract,
+        CalcHandler::Operation::Multiply,
+        CalcHandler::Operation::Divide
+    };
+
+    CalcHandler handler;
+    const int count = m_lhs.size();
+    QVector<double> out(count);
+    QVector<quint64> mask(BatchKernels::errorMaskWords(count));
+
+    for (BatchKernels::InstructionSet isa : instructionSets()) {
+        for (CalcHandler::Operation op : ops) {
+            BatchKernels::binary(isa, op, m_lhs.constData(), m_rhs.constData(),
+                                 out.data(), count, mask.data());
+
+            for (int i = 0; i < count; ++i) {
+                CalcHandler::CalculationResult expected =
+                    handler.performBinaryOperation(m_lhs[i], m_rhs[i], op);
+                QCOMPARE(BatchKernels::hasError(mask.constData(), i), !expected.success());
+                QCOMPARE(out[i], expected.value);
+            }
+        }
+    }
+}
+
+void TestBatchKernels::testDivisionByZeroMask()
+{
+    const double lhs[] = { 1.0, 2.0, 3.0, 4.0, 5.0, 6.0, 7.0, 8.0 };
+    const double rhs[] = { 1.0, 0.0, 3.0, -0.0, 5.0, 6.0, 0.0, 2.0 };
+    double out[8];
+    quint64 mask[1];
+
+    for (BatchKernels::InstructionSet isa : instructionSets()) {
+        int errors = BatchKernels::binary(isa, CalcHandler::Operation::Divide,
+                                          lhs, rhs, out, 8, mask);
+        QCOMPARE(errors, 3);
+        QCOMPARE(mask[0], quint64((1 << 1) | (1 << 3) | (1 << 6)));
+        QCOMPARE(out[1], 0.0);
+        QCOMPARE(out[7], 4.0);
+    }
+}
+
+void TestBatchKernels::testTailElements()
+{
+    // Длины, не кратные ширине вектора, обрабатываются скалярным хвостом
+    for (int count = 1; count <= 9; ++count) {
+        QVector<double> out(count);
+        QVector<quint64> mask(BatchKernels::errorMaskWords(count));
+        for (BatchKernels::InstructionSet isa : instructionSets()) {
+            int errors = BatchKernels::binary(isa, CalcHandler::Operation::Divide,
+                                              m_lhs.constData(), m_rhs.constData(),
+                                              out.data(), count, mask.data());
+            QCOMPARE(errors, (count + 4) / 5);
+            QVERIFY(BatchKernels::hasError(mask.constData(), 0));
+        }
+    }
+}
+
+void TestBatchKernels::testInPlace()
+{
+    QVector<double> values = m_lhs;
+    BatchKernels::binary(CalcHandler::Operation::Add, values.constData(), m_rhs.constData(),
+                         values.data(), values.size(), nullptr);
+
+    for (int i = 0; i < values.size(); ++i) {
+        QCOMPARE(values[i], m_lhs[i] + m_rhs[i]);
+    }
+}
+
+void TestBatchKernels::testUnknownOperation()
+{
+    double out[3] = { 1.0, 1.0, 1.0 };
+    quint64 mask[1];
+    int errors = BatchKernels::binary(CalcHandler::Operation::SquareRoot,
+                                      m_lhs.constData(), m_rhs.constData(), out, 3, mask);
+
+    QCOMPARE(errors, 3);
+    QCOMPARE(mask[0], quint64(7));
+    QCOMPARE(out[0], 0.0);
+}
+
+void TestBatchKernels::testEmptyInput()
+{
+    QCOMPARE(BatchKernels::binary(CalcHandler::Operation::Add, nullptr, nullptr,
+                                  nullptr, 0, nullptr), 0);
+    QCOMPARE(BatchKernels::errorMaskWords(0), 0);
+    QCOMPARE(BatchKernels::errorMaskWords(64), 1);
+    QCOMPARE(BatchKernels::errorMaskWords(65), 2);
+}
+
+void TestBatchKernels::testHandlerBatchApi()
+{
+    CalcHandler handler;
+    const double lhs[] = { 10.0, 1.0 };
+    const double rhs[] = { 4.0, 0.0 };
+    double out[2];
+    quint64 mask[1];
+
+    int errors = CalcHandler::performBinaryOperation(lhs, rhs, out, 2,
+                                                     CalcHandler::Operation::Divide, mask);
+
+    QCOMPARE(errors, 1);
+    QCOMPARE(out[0], 2.5);
+    QVERIFY(BatchKernels::hasError(mask, 1));
+    // Пакетный API не переводит обработчик в состояние ошибки
+    QCOMPARE(handler.currentState(), CalcHandler::State::Idle);
+}
+
+void TestBatchKernels::testUnaryMatchesScalarHandler()
+{
+    const CalcHandler::Operation ops[] = {
+        CalcHandler::Operation::Percent,
+        CalcHandler::Operation::Negate,
+        CalcHandler::Operation::Square,
+        CalcHandler::Operation::SquareRoot,
+        CalcHandler::Operation::Reciprocal
+    };
+
+    CalcHandler handler;
+    const int count = m_rhs.size();
+    QVector<double> out(count);
+    QVector<quint64> mask(BatchKernels::errorMaskWords(count));
+
+    for (BatchKernels::InstructionSet isa : instructionSets()) {
+        for (CalcHandler::Operation op : ops) {
+            BatchKernels::unary(isa, op, m_rhs.constData(), out.data(), count, mask.data());
+
+            for (int i = 0; i < count; ++i) {
+                CalcHandler::CalculationResult expected = handler.applyUnaryOperation(op, m_rhs[i]);
+                QCOMPARE(BatchKernels::hasError(mask.constData(), i), !expected.success());
+                QCOMPARE(out[i], expected.value);
+            }
+        }
+    }
+}
+
+void TestBatchKernels::testUnaryDomainErrors()
+{
+    const double values[] = { 4.0, -1.0, 0.0, -0.0, 9.0, -16.0, 0.25, 2.0 };
+    double out[8];
+    quint64 mask[1];
+
+    for (BatchKernels::InstructionSet isa : instructionSets()) {
+        // -0.0 не меньше нуля: корень из него допустим
+        int errors = BatchKernels::unary(isa, CalcHandler::Operation::SquareRoot,
+                                         values, out, 8, mask);
+        QCOMPARE(errors, 2);
+        QCOMPARE(mask[0], quint64((1 << 1) | (1 << 5)));
+        QCOMPARE(out[0], 2.0);
+        QCOMPARE(out[1], 0.0);
+        QCOMPARE(out[6], 0.5);
+
+        errors = BatchKernels::unary(isa, CalcHandler::Operation::Reciprocal,
+                                     values, out, 8, mask);
+        QCOMPARE(errors, 2);
+        QCOMPARE(mask[0], quint64((1 << 2) | (1 << 3)));
+        QCOMPARE(out[3], 0.0);
+        QCOMPARE(out[7], 0.5);
+
+        errors = BatchKernels::unary(isa, CalcHandler::Operation::Negate,
+                                     values, out, 8, mask);
+        QCOMPARE(errors, 0);
+        QCOMPARE(mask[0], quint64(0));
+        // Смена знака затрагивает и нули
+        QVERIFY(std::signbit(out[2]));
+        QVERIFY(!std::signbit(out[3]));
+    }
+}
+
+void TestBatchKernels::testUnaryTailElements()
+{
+    for (int count = 1; count <= 9; ++count) {
+        QVector<double> out(count);
+        QVector<quint64> mask(BatchKernels::errorMaskWords(count));
+        for (BatchKernels::InstructionSet isa : instructionSets()) {
+            int errors = BatchKernels::unary(isa, CalcHandler::Operation::Reciprocal,
+                                             m_rhs.constData(), out.data(), count, mask.data());
+            QCOMPARE(errors, (count + 4) / 5);
+            QVERIFY(BatchKernels::hasError(mask.constData(), 0));
+        }
+    }
+}
+
+void TestBatchKernels::testUnaryUnknownOperation()
+{
+    double out[3] = { 1.0, 1.0, 1.0 };
+    quint64 mask[1];
+    int errors = BatchKernels::unary(CalcHandler::Operation::Add, m_lhs.constData(), out, 3, mask);
+
+    QCOMPARE(errors, 3);
+    QCOMPARE(mask[0], quint64(7));
+    QCOMPARE(out[2], 0.0);
+}
+
+void TestBatchKernels::testHandlerUnaryBatchApi()
+{
+    CalcHandler handler;
+    double values[] = { 16.0, -4.0, 0.25 };
+    quint64 mask[1];
+
+    // Результат записывается поверх входного массива
+    int errors = CalcHandler::applyUnaryOperation(CalcHandler::Operation::SquareRoot,
+                                                  values, values, 3, mask);
+
+    QCOMPARE(errors, 1);
+    QCOMPARE(values[0], 4.0);
+    QCOMPARE(values[2], 0.5);
+    QVERIFY(BatchKernels::hasError(mask, 1));
+    QCOMPARE(handler.currentState(), CalcHandler::State::Idle);
+}
+
+QTEST_MAIN(TestBatchKernels)
+#include "test_batchkernels.moc"
@@ -0,0 +1,185 @@
+#include "calcengine.h"
+#include <QtTest/QtTest>
+#include <cmath>
+#include <limits>
+
+namespace {
+
+// Ноль с допуском: пример собственной проверки домена через Traits
+struct ToleranceTraits : NumericTraits<double>
+{
+    static bool isZero(double value) { return std::fabs(value) < 1e-12; }
+};
+
+Decimal parse(const char* text)
+{
+    return Decimal::fromString(text);
+}
+
+} // namespace
+
+/**
+ * @brief Тесты для шаблона CalcEngine
+ *
+ * Одни и те же проверки домена выполняются для float, double,
+ * long double и Decimal.
+ */
+class TestCalcEngine : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void testDomainErrors();
+    void testFloatEngine();
+    void testDoubleEngine();
+    void testLongDoubleEngine();
+    void testDecimalEngine();
+    void testCustomTraits();
+
+private:
+    template<typename T>
+    static void checkDomain();
+};
+
+template<typename T>
+void TestCalcEngine::checkDomain()
+{
+    typedef CalcEngine<T> Engine;
+
+    typename Engine::Result result = Engine::computeBinary(T(6), T(3), CalcOperation::Divide);
+    QVERIFY(result.success());
+    QVERIFY(result.value == T(2));
+
+    result = Engine::computeBinary(T(6), T(0), CalcOperation::Divide);
+    QCOMPARE(result.error, CalcError::DivisionByZero);
+    QVERIFY(result.value == T());
+
+    result = Engine::computeUnary(CalcOperation::Reciprocal, T(0));
+    QCOMPARE(result.error, CalcError::DivisionByZero);
+
+    result = Engine::computeUnary(CalcOperation::SquareRoot, T(-4));
+    QCOMPARE(result.error, CalcError::NegativeRoot);
+
+    result = Engine::computeUnary(CalcOperation::SquareRoot, T(16));
+    QVERIFY(result.success());
+    QVERIFY(result.value == T(4));
+
+    result = Engine::computeUnary(CalcOperation::Negate, T(5));
+    QVERIFY(result.value == T(-5));
+
+    result = Engine::computeUnary(CalcOperation::Square, T(-3));
+    QVERIFY(result.value == T(9));
+
+    // Бинарная операция в унарном вызове и наоборот
+    result = Engine::computeUnary(CalcOperation::Add, T(1));
+    QCOMPARE(result.error, CalcError::UnknownOperation);
+    result = Engine::computeBinary(T(1), T(2), CalcOperation::Percent);
+    QCOMPARE(result.error, CalcError::UnknownOperation);
+}
+
+void TestCalcEngine::testDomainErrors()
+{
+    checkDomain<float>();
+    checkDomain<double>();
+    checkDomain<long double>();
+    checkDomain<Decimal>();
+}
+
+void TestCalcEngine::testFloatEngine()
+{
+    CalcEngine<float>::Result result =
+        CalcEngine<float>::computeBinary(1.5f, 2.25f, CalcOperation::Add);
+    QVERIFY(result.success());
+    QCOMPARE(result.value, 3.75f);
+
+    result = CalcEngine<float>::computeUnary(CalcOperation::Percent, 50.0f);
+    QCOMPARE(result.value, 0.5f);
+
+    // Диапазон float заканчивается раньше, чем у double
+    result = CalcEngine<float>::computeBinary(3e38f, 10.0f, CalcOperation::Multiply);
+    QCOMPARE(result.error, CalcError::Overflow);
+    QCOMPARE(result.value, 0.0f);
+}
+
+void TestCalcEngine::testDoubleEngine()
+{
+    CalcEngine<double>::Result result =
+        CalcEngine<double>::computeBinary(3e38, 10.0, CalcOperation::Multiply);
+    QVERIFY(result.success());
+
+    result = CalcEngine<double>::computeBinary(1e308, 10.0, CalcOperation::Multiply);
+    QCOMPARE(result.error, CalcError::Overflow);
+
+    // Бесконечность во входе - не переполнение
+    const double inf = std::numeric_limits<double>::infinity();
+    result = CalcEngine<double>::computeBinary(inf, 1.0, CalcOperation::Add);
+    QVERIFY(result.success());
+    QVERIFY(std::isinf(result.value));
+
+    result = CalcEngine<double>::computeUnary(CalcOperation::Percent, 12.5);
+    QCOMPARE(result.value, 12.5 * 0.01);
+}
+
+void TestCalcEngine::testLongDoubleEngine()
+{
+    if (std::numeric_limits<long double>::digits <= std::numeric_limits<double>::digits) {
+        QSKIP("long double на этой платформе совпадает с double");
+    }
+
+    // 2^-60 теряется в double, но сохраняется в 64-битной мантиссе long double
+    const long double tiny = std::ldexp(1.0L, -60);
+    CalcEngine<long double>::Result sum =
+        CalcEngine<long double>::computeBinary(1.0L, tiny, CalcOperation::Add);
+    CalcEngine<long double>::Result difference =
+        CalcEngine<long double>::computeBinary(sum.value, 1.0L, CalcOperation::Subtract);
+    QVERIFY(difference.success());
+    QVERIFY(difference.value == tiny);
+
+    const double lost = (1.0 + std::ldexp(1.0, -60)) - 1.0;
+    QCOMPARE(lost, 0.0);
+}
+
+void TestCalcEngine::testDecimalEngine()
+{
+    const DecimalContext context(10);
+
+    CalcEngine<Decimal>::Result result =
+        CalcEngine<Decimal>::computeBinary(Decimal(1), Decimal(3), CalcOperation::Divide, context);
+    QVERIFY(result.success());
+    QCOMPARE(result.value.toString(), QString("0.3333333333"));
+
+    result = CalcEngine<Decimal>::computeBinary(parse("0.1"), parse("0.2"),
+                                                CalcOperation::Add, context);
+    QCOMPARE(result.value.toString(), QString("0.3"));
+
+    result = CalcEngine<Decimal>::computeUnary(CalcOperation::Percent, parse("12.5"), context);
+    QCOMPARE(result.value.toString(), QString("0.125"));
+
+    result = CalcEngine<Decimal>::computeUnary(CalcOperation::SquareRoot, Decimal(2), context);
+    QCOMPARE(result.value.toString(), QString("1.414213562"));
+
+    // Точность по умолчанию - DecimalContext::DEFAULT_DIGITS
+    result = CalcEngine<Decimal>::computeUnary(CalcOperation::Reciprocal, Decimal(7));
+    QCOMPARE(result.value.digitCount(), DecimalContext::DEFAULT_DIGITS);
+}
+
+void TestCalcEngine::testCustomTraits()
+{
+    typedef CalcEngine<double, ToleranceTraits> TolerantEngine;
+
+    // Стандартные свойства делят на сколь угодно малое число
+    QVERIFY(CalcEngine<double>::computeBinary(1.0, 1e-15, CalcOperation::Divide).success());
+
+    TolerantEngine::Result result =
+        TolerantEngine::computeBinary(1.0, 1e-15, CalcOperation::Divide);
+    QCOMPARE(result.error, CalcError::DivisionByZero);
+
+    result = TolerantEngine::computeUnary(CalcOperation::Reciprocal, -1e-13);
+    QCOMPARE(result.error, CalcError::DivisionByZero);
+
+    result = TolerantEngine::computeBinary(1.0, 4.0, CalcOperation::Divide);
+    QCOMPARE(result.value, 0.25);
+}
+
+QTEST_MAIN(TestCalcEngine)
+#include "test_calcengine.moc"
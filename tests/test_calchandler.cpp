@@ -1,4 +1,6 @@
 #include "calchandler.h"
+#include "calculatorconfig.h"
+#include "errormessages.h"
 #include <QtTest/QtTest>
 
 /**
@@ -49,6 +51,15 @@ private slots:
     void testLargeNumbers();
     void testSmallNumbers();
     void testChainedOperations();
+    void testOverflow();
+    void testInsufficientData();
+    
+    // Тесты десятичного режима
+    void testDecimalBackend();
+    void testDecimalBackendErrors();
+    
+    // Тесты сообщений об ошибках
+    void testErrorMessages();
 
 private:
     CalcHandler *m_handler;
@@ -85,16 +96,16 @@ void TestCalcHandler::testAddition()
 {
     auto result = m_handler->performBinaryOperation(5.0, 3.0, CalcHandler::Operation::Add);
     
-    QVERIFY(result.success);
+    QVERIFY(result.success());
     QCOMPARE(result.value, 8.0);
-    QVERIFY(result.errorMessage.isEmpty());
+    QCOMPARE(result.error, CalcHandler::Error::None);
 }
 
 void TestCalcHandler::testSubtraction()
 {
     auto result = m_handler->performBinaryOperation(10.0, 4.0, CalcHandler::Operation::Subtract);
     
-    QVERIFY(result.success);
+    QVERIFY(result.success());
     QCOMPARE(result.value, 6.0);
 }
 
@@ -102,7 +113,7 @@ void TestCalcHandler::testMultiplication()
 {
     auto result = m_handler->performBinaryOperation(6.0, 7.0, CalcHandler::Operation::Multiply);
     
-    QVERIFY(result.success);
+    QVERIFY(result.success());
     QCOMPARE(result.value, 42.0);
 }
 
@@ -110,7 +121,7 @@ void TestCalcHandler::testDivision()
 {
     auto result = m_handler->performBinaryOperation(15.0, 3.0, CalcHandler::Operation::Divide);
     
-    QVERIFY(result.success);
+    QVERIFY(result.success());
     QCOMPARE(result.value, 5.0);
 }
 
@@ -118,9 +129,9 @@ void TestCalcHandler::testDivisionByZero()
 {
     auto result = m_handler->performBinaryOperation(10.0, 0.0, CalcHandler::Operation::Divide);
     
-    QVERIFY(!result.success);
+    QVERIFY(!result.success());
     QCOMPARE(result.value, 0.0);
-    QVERIFY(!result.errorMessage.isEmpty());
+    QCOMPARE(result.error, CalcHandler::Error::DivisionByZero);
     QCOMPARE(m_handler->currentState(), CalcHandler::State::Error);
 }
 
@@ -132,18 +143,18 @@ void TestCalcHandler::testPercent()
 {
     auto result = m_handler->applyUnaryOperation(CalcHandler::Operation::Percent, 50.0);
     
-    QVERIFY(result.success);
+    QVERIFY(result.success());
     QCOMPARE(result.value, 0.5);
 }
 
 void TestCalcHandler::testNegate()
 {
     auto result = m_handler->applyUnaryOperation(CalcHandler::Operation::Negate, 42.0);
-    QVERIFY(result.success);
+    QVERIFY(result.success());
     QCOMPARE(result.value, -42.0);
     
     result = m_handler->applyUnaryOperation(CalcHandler::Operation::Negate, -42.0);
-    QVERIFY(result.success);
+    QVERIFY(result.success());
     QCOMPARE(result.value, 42.0);
 }
 
@@ -151,7 +162,7 @@ void TestCalcHandler::testSquare()
 {
     auto result = m_handler->applyUnaryOperation(CalcHandler::Operation::Square, 5.0);
     
-    QVERIFY(result.success);
+    QVERIFY(result.success());
     QCOMPARE(result.value, 25.0);
 }
 
@@ -159,7 +170,7 @@ void TestCalcHandler::testSquareRoot()
 {
     auto result = m_handler->applyUnaryOperation(CalcHandler::Operation::SquareRoot, 16.0);
     
-    QVERIFY(result.success);
+    QVERIFY(result.success());
     QCOMPARE(result.value, 4.0);
 }
 
@@ -167,8 +178,8 @@ void TestCalcHandler::testSquareRootNegative()
 {
     auto result = m_handler->applyUnaryOperation(CalcHandler::Operation::SquareRoot, -4.0);
     
-    QVERIFY(!result.success);
-    QVERIFY(!result.errorMessage.isEmpty());
+    QVERIFY(!result.success());
+    QCOMPARE(result.error, CalcHandler::Error::NegativeRoot);
     QCOMPARE(m_handler->currentState(), CalcHandler::State::Error);
 }
 
@@ -176,7 +187,7 @@ void TestCalcHandler::testReciprocal()
 {
     auto result = m_handler->applyUnaryOperation(CalcHandler::Operation::Reciprocal, 4.0);
     
-    QVERIFY(result.success);
+    QVERIFY(result.success());
     QCOMPARE(result.value, 0.25);
 }
 
@@ -184,8 +195,8 @@ void TestCalcHandler::testReciprocalZero()
 {
     auto result = m_handler->applyUnaryOperation(CalcHandler::Operation::Reciprocal, 0.0);
     
-    QVERIFY(!result.success);
-    QVERIFY(!result.errorMessage.isEmpty());
+    QVERIFY(!result.success());
+    QCOMPARE(result.error, CalcHandler::Error::DivisionByZero);
     QCOMPARE(m_handler->currentState(), CalcHandler::State::Error);
 }
 
@@ -260,7 +271,7 @@ void TestCalcHandler::testLargeNumbers()
 {
     auto result = m_handler->performBinaryOperation(1e10, 1e10, CalcHandler::Operation::Add);
     
-    QVERIFY(result.success);
+    QVERIFY(result.success());
     QCOMPARE(result.value, 2e10);
 }
 
@@ -268,7 +279,7 @@ void TestCalcHandler::testSmallNumbers()
 {
     auto result = m_handler->performBinaryOperation(0.0001, 0.0001, CalcHandler::Operation::Add);
     
-    QVERIFY(result.success);
+    QVERIFY(result.success());
     QCOMPARE(result.value, 0.0002);
 }
 
@@ -278,16 +289,102 @@ void TestCalcHandler::testChainedOperations()
     m_handler->setOperand(5.0);
     m_handler->setOperation(CalcHandler::Operation::Add);
     auto result = m_handler->performBinaryOperation(5.0, 3.0, CalcHandler::Operation::Add);
-    QVERIFY(result.success);
+    QVERIFY(result.success());
     QCOMPARE(result.value, 8.0);
     
     // 8 * 2 = 16
     m_handler->setOperand(result.value);
     m_handler->setOperation(CalcHandler::Operation::Multiply);
     result = m_handler->performBinaryOperation(result.value, 2.0, CalcHandler::Operation::Multiply);
-    QVERIFY(result.success);
+    QVERIFY(result.success());
     QCOMPARE(result.value, 16.0);
 }
 
+void TestCalcHandler::testOverflow()
+{
+    auto result = m_handler->performBinaryOperation(1e308, 10.0, CalcHandler::Operation::Multiply);
+    
+    QVERIFY(!result.success());
+    QCOMPARE(result.value, 0.0);
+    QCOMPARE(result.error, CalcHandler::Error::Overflow);
+    QCOMPARE(m_handler->currentState(), CalcHandler::State::Error);
+    
+    result = m_handler->applyUnaryOperation(CalcHandler::Operation::Square, 1e200);
+    QCOMPARE(result.error, CalcHandler::Error::Overflow);
+}
+
+void TestCalcHandler::testInsufficientData()
+{
+    auto result = m_handler->calculate();
+    
+    QVERIFY(!result.success());
+    QCOMPARE(result.error, CalcHandler::Error::InsufficientData);
+}
+
+// ============================================================
+// ТЕСТЫ ДЕСЯТИЧНОГО РЕЖИМА
+// ============================================================
+
+void TestCalcHandler::testDecimalBackend()
+{
+    QCOMPARE(m_handler->backend(), CalcHandler::Backend::Double);
+    auto result = m_handler->performBinaryOperation(0.1, 0.2, CalcHandler::Operation::Add);
+    QVERIFY(result.value != 0.3);
+    
+    m_handler->setBackend(CalcHandler::Backend::Decimal);
+    result = m_handler->performBinaryOperation(0.1, 0.2, CalcHandler::Operation::Add);
+    QVERIFY(result.success());
+    QCOMPARE(result.value, 0.3);
+    QCOMPARE(m_handler->storedValue(), 0.3);
+    
+    result = m_handler->performBinaryOperation(1.0, 0.9, CalcHandler::Operation::Subtract);
+    QCOMPARE(result.value, 0.1);
+    
+    m_handler->setDecimalContext(DecimalContext(4, DecimalRounding::Down));
+    result = m_handler->performBinaryOperation(2.0, 3.0, CalcHandler::Operation::Divide);
+    QCOMPARE(result.value, 0.6666);
+    
+    result = m_handler->applyUnaryOperation(CalcHandler::Operation::SquareRoot, 2.0);
+    QCOMPARE(result.value, 1.414);
+}
+
+void TestCalcHandler::testDecimalBackendErrors()
+{
+    m_handler->setBackend(CalcHandler::Backend::Decimal);
+    
+    auto result = m_handler->performBinaryOperation(1.0, 0.0, CalcHandler::Operation::Divide);
+    QCOMPARE(result.error, CalcHandler::Error::DivisionByZero);
+    QCOMPARE(m_handler->currentState(), CalcHandler::State::Error);
+    
+    result = m_handler->applyUnaryOperation(CalcHandler::Operation::SquareRoot, -4.0);
+    QCOMPARE(result.error, CalcHandler::Error::NegativeRoot);
+    
+    result = m_handler->applyUnaryOperation(CalcHandler::Operation::Reciprocal, 0.0);
+    QCOMPARE(result.error, CalcHandler::Error::DivisionByZero);
+    
+    // Результат за пределами double
+    result = m_handler->performBinaryOperation(1e308, 10.0, CalcHandler::Operation::Multiply);
+    QCOMPARE(result.error, CalcHandler::Error::Overflow);
+}
+
+// ============================================================
+// ТЕСТЫ СООБЩЕНИЙ ОБ ОШИБКАХ
+// ============================================================
+
+void TestCalcHandler::testErrorMessages()
+{
+    QVERIFY(ErrorMessages::text(CalcHandler::Error::None).isEmpty());
+    QCOMPARE(ErrorMessages::text(CalcHandler::Error::DivisionByZero),
+             CalculatorConfig::ERROR_DIVISION_BY_ZERO);
+    QCOMPARE(ErrorMessages::text(CalcHandler::Error::NegativeRoot),
+             CalculatorConfig::ERROR_SQRT_NEGATIVE);
+    QCOMPARE(ErrorMessages::text(CalcHandler::Error::Overflow),
+             CalculatorConfig::ERROR_OVERFLOW);
+    QVERIFY(!ErrorMessages::text(CalcHandler::Error::UnknownOperation).isEmpty());
+    QVERIFY(!ErrorMessages::text(CalcHandler::Error::InsufficientData).isEmpty());
+    QCOMPARE(ErrorMessages::text(CalcHandler::Error::InvalidInput),
+             CalculatorConfig::ERROR_INVALID_INPUT);
+}
+
 QTEST_MAIN(TestCalcHandler)
 #include "test_calchandler.moc"
@@ -1,6 +1,7 @@
 #include "../src/calculationhistory.h"
 #include <QtTest/QtTest>
 #include <QTemporaryFile>
+#include <QSignalSpy>
 
 class TestCalculationHistory : public QObject
 {
@@ -18,6 +19,10 @@ private slots:
     void testGetLast();
     void testCount();
     void testSaveAndLoad();
+    void testStructuredEntry();
+    void testEntriesWithoutCopy();
+    void testLargeHistoryEviction();
+    void testChangeSignals();
 
 private:
     CalculationHistory *m_history;
@@ -49,6 +54,12 @@ void TestCalculationHistory::testAddEntryWithExpressionAndResult()
     QCOMPARE(m_history->count(), 1);
     QVERIFY(m_history->getLast().contains("5 + 3"));
     QVERIFY(m_history->getLast().contains("8"));
+
+    // Результат - 6 значащих цифр; "%2" в выражении не подменяется результатом
+    m_history->addEntry("1 ÷ 3", 1.0 / 3.0);
+    QCOMPARE(m_history->getLast(), QString("1 ÷ 3 = 0.333333"));
+    m_history->addEntry("50%2", 0.1 + 0.2);
+    QCOMPARE(m_history->getLast(), QString("50%2 = 0.3"));
 }
 
 void TestCalculationHistory::testMaxSize()
@@ -136,5 +147,111 @@ void TestCalculationHistory::testSaveAndLoad()
     QCOMPARE(loadedHistory.getLast(), QString("5 + 3 = 8"));
 }
 
+void TestCalculationHistory::testStructuredEntry()
+{
+    HistoryEntry entry;
+    entry.expression = "1 ÷ 3";
+    entry.lhs = 1.0;
+    entry.operation = CalcOperation::Divide;
+    entry.rhs = 3.0;
+    entry.result = 1.0 / 3.0;
+    entry.resultPrecision = 10;
+    m_history->addEntry(entry);
+
+    const HistoryEntry& stored = m_history->entryAt(0);
+    QCOMPARE(stored.operation, CalcOperation::Divide);
+    QCOMPARE(stored.lhs, 1.0);
+    QCOMPARE(stored.rhs, 3.0);
+    QCOMPARE(stored.result, 1.0 / 3.0);
+    QVERIFY(stored.timestamp > 0);
+    QCOMPARE(m_history->getLast(), QString("1 ÷ 3 = 0.3333333333"));
+
+    // У готовой строки результат разбирается в число
+    m_history->addEntry("2 + 2 = 4");
+    QCOMPARE(m_history->entryAt(0).result, 4.0);
+    QCOMPARE(m_history->entryAt(0).operation, CalcOperation::None);
+    QVERIFY(qIsNaN(m_history->entryAt(0).lhs));
+}
+
+void TestCalculationHistory::testEntriesWithoutCopy()
+{
+    m_history->addEntry("5 + 3", 8.0);
+    m_history->addEntry("10 - 2", 8.0);
+    m_history->addEntry("5 + 3", 8.0);
+
+    const CalculationHistory::Entries& entries = m_history->entries();
+    QCOMPARE(entries.size(), 3);
+    QCOMPARE(entries.first().expression, QString("5 + 3"));
+    QCOMPARE(entries.last().text(), m_history->getLast());
+    QCOMPARE(m_history->entryAt(1).text(), QString("10 - 2 = 8"));
+
+    // Одинаковые выражения разделяют одни данные
+    QVERIFY(entries.at(0).expression.constData() == entries.at(2).expression.constData());
+}
+
+void TestCalculationHistory::testLargeHistoryEviction()
+{
+    const int maxSize = 100000;
+    m_history->setMaxSize(maxSize);
+    for (int i = 0; i < 3 * maxSize; ++i) {
+        m_history->addEntry(QString::number(i % 1000) + " + 1", i % 1000 + 1.0);
+    }
+
+    QCOMPARE(m_history->count(), maxSize);
+    QCOMPARE(m_history->getLast(), QString("999 + 1 = 1000"));
+    QCOMPARE(m_history->entries().first().text(), QString("0 + 1 = 1"));
+
+    m_history->setMaxSize(10);
+    QCOMPARE(m_history->count(), 10);
+    QCOMPARE(m_history->entryAt(9).text(), QString("990 + 1 = 991"));
+}
+
+void TestCalculationHistory::testChangeSignals()
+{
+    m_history->setMaxSize(3);
+    QSignalSpy changedSpy(m_history, &CalculationHistory::historyChanged);
+    QSignalSpy addedSpy(m_history, &CalculationHistory::entriesAdded);
+    QSignalSpy evictedSpy(m_history, &CalculationHistory::entriesEvicted);
+    QSignalSpy resetSpy(m_history, &CalculationHistory::historyReset);
+
+    for (int i = 0; i < 3; ++i) {
+        m_history->addEntry(QString::number(i) + " + 1", i + 1.0);
+    }
+    QCOMPARE(addedSpy.count(), 3);
+    QCOMPARE(addedSpy.at(0).at(0).toInt(), 1);
+    QCOMPARE(evictedSpy.count(), 0);
+
+    // Полная история: сначала вытеснение, потом добавление
+    m_history->addEntry("3 + 1", 4.0);
+    QCOMPARE(evictedSpy.count(), 1);
+    QCOMPARE(evictedSpy.at(0).at(0).toInt(), 1);
+    QCOMPARE(addedSpy.count(), 4);
+    QCOMPARE(changedSpy.count(), 4);
+
+    // Уменьшение размера - одно уведомление на все вытесненные записи
+    m_history->setMaxSize(1);
+    QCOMPARE(evictedSpy.count(), 2);
+    QCOMPARE(evictedSpy.at(1).at(0).toInt(), 2);
+    QCOMPARE(changedSpy.count(), 5);
+    m_history->setMaxSize(5);
+    QCOMPARE(changedSpy.count(), 5);
+
+    QTemporaryFile tempFile;
+    QVERIFY(tempFile.open());
+    QString filename = tempFile.fileName();
+    tempFile.close();
+    m_history->saveToFile(filename);
+
+    // Загрузка и очистка - один сброс без построчных сигналов
+    m_history->loadFromFile(filename);
+    QCOMPARE(resetSpy.count(), 1);
+    QCOMPARE(changedSpy.count(), 6);
+    m_history->clear();
+    QCOMPARE(resetSpy.count(), 2);
+    QCOMPARE(changedSpy.count(), 7);
+    QCOMPARE(addedSpy.count(), 4);
+    QCOMPARE(evictedSpy.count(), 2);
+}
+
 QTEST_MAIN(TestCalculationHistory)
 #include "test_calculationhistory.moc"
@@ -0,0 +1,264 @@
+#include "calculatorsession.h"
+#include "calculationhistory.h"
+#include "calculatorconfig.h"
+#include "memorymanager.h"
+#include <QtTest/QtTest>
+#include <QSignalSpy>
+
+/**
+ * @brief Тесты для класса CalculatorSession
+ *
+ * Тот же ввод, что и в окне, но без виджетов: цифры и лимит, цепочки операций,
+ * унарные операции, ошибки, записи истории, память и сброс.
+ */
+class TestCalculatorSession : public QObject
+{
+    Q_OBJECT
+
+    typedef CalculatorSession::Key Key;
+
+private slots:
+    void init();
+    void cleanup();
+
+    void testDigitEntry();
+    void testDigitLimit();
+    void testChainedOperations();
+    void testUnaryOperations();
+    void testErrors();
+    void testHistoryEntries();
+    void testMemory();
+    void testReset();
+    void testKeyFromChar();
+
+private:
+    void type(const QString& keys);
+
+private:
+    CalculationHistory *m_history;
+    MemoryManager *m_memory;
+    CalculatorSession *m_session;
+};
+
+void TestCalculatorSession::init()
+{
+    m_history = new CalculationHistory();
+    m_memory = new MemoryManager();
+    m_session = new CalculatorSession(m_history, m_memory);
+}
+
+void TestCalculatorSession::cleanup()
+{
+    delete m_session;
+    delete m_memory;
+    delete m_history;
+    m_session = nullptr;
+    m_memory = nullptr;
+    m_history = nullptr;
+}
+
+void TestCalculatorSession::type(const QString& keys)
+{
+    for (QChar c : keys) {
+        Key key;
+        QVERIFY2(CalculatorSession::keyFromChar(c, key), qPrintable(QString(c)));
+        m_session->press(key);
+    }
+}
+
+void TestCalculatorSession::testDigitEntry()
+{
+    QSignalSpy displaySpy(m_session, &CalculatorSession::displayChanged);
+    type("12.5");
+    QCOMPARE(m_session->displayText(), QString("12.5"));
+    QCOMPARE(displaySpy.count(), 4);
+    QCOMPARE(displaySpy.last().at(0).toString(), QString("12.5"));
+
+    // Вторая точка не добавляется, "." на пустом дисплее дает "0."
+    QVERIFY(!m_session->press(Key::DecimalPoint));
+    QVERIFY(m_session->press(Key::Backspace));
+    QCOMPARE(m_session->displayText(), QString("12."));
+    QVERIFY(m_session->press(Key::ClearEntry));
+    QVERIFY(m_session->press(Key::DecimalPoint));
+    QCOMPARE(m_session->displayText(), CalculatorConfig::ZERO_WITH_DECIMAL);
+}
+
+void TestCalculatorSession::testDigitLimit()
+{
+    for (int i = 0; i < CalculatorConfig::MAX_DIGIT_LENGTH; ++i) {
+        QVERIFY(m_session->press(CalculatorSession::digitKey(i % 10)));
+    }
+    QVERIFY(!m_session->press(Key::Digit1));
+    QCOMPARE(m_session->displayText(), QString("0123456789"));
+
+    // После оператора начинается новое число
+    QVERIFY(m_session->press(Key::Add));
+    QVERIFY(m_session->isOperatorPending());
+    QVERIFY(m_session->press(Key::Digit1));
+    QCOMPARE(m_session->displayText(), QString("1"));
+}
+
+void TestCalculatorSession::testChainedOperations()
+{
+    type("5+3+");
+    QCOMPARE(m_session->displayText(), QString("8"));
+    type("2=");
+    QCOMPARE(m_session->displayText(), QString("10"));
+    QVERIFY(m_session->isResultDisplayed());
+
+    // Повторный оператор заменяет предыдущий
+    m_session->reset();
+    type("6+*4=");
+    QCOMPARE(m_session->displayText(), QString("24"));
+
+    // "=" без операции ничего не делает
+    m_session->reset();
+    type("7");
+    QVERIFY(!m_session->press(Key::Equals));
+    QCOMPARE(m_session->displayText(), QString("7"));
+}
+
+void TestCalculatorSession::testUnaryOperations()
+{
+    type("9");
+    QVERIFY(m_session->press(Key::SquareRoot));
+    QCOMPARE(m_session->displayText(), QString("3"));
+    QVERIFY(m_session->press(Key::Square));
+    QCOMPARE(m_session->displayText(), QString("9"));
+    QVERIFY(m_session->press(Key::Negate));
+    QCOMPARE(m_session->displayText(), QString("-9"));
+
+    m_session->reset();
+    type("4");
+    QVERIFY(m_session->press(Key::Reciprocal));
+    QCOMPARE(m_session->displayText(), QString("0.25"));
+
+    m_session->reset();
+    QVERIFY(!m_session->press(Key::Square));
+}
+
+void TestCalculatorSession::testErrors()
+{
+    QSignalSpy errorSpy(m_session, &CalculatorSession::errorOccurred);
+    type("5/0=");
+    QCOMPARE(errorSpy.count(), 1);
+    QCOMPARE(m_session->displayText(), CalculatorConfig::ERROR_DIVISION_BY_ZERO);
+    QCOMPARE(errorSpy.first().at(0).toString(), CalculatorConfig::ERROR_DIVISION_BY_ZERO);
+    QCOMPARE(m_history->count(), 0);
+
+    // Текст ошибки затирается следующей цифрой
+    type("2");
+    QCOMPARE(m_session->displayText(), QString("2"));
+
+    m_session->press(Key::Negate);
+    QVERIFY(!m_session->press(Key::SquareRoot));
+    QCOMPARE(errorSpy.count(), 2);
+    QCOMPARE(m_session->displayText(), CalculatorConfig::ERROR_SQRT_NEGATIVE);
+
+    // Ошибку на дисплее нельзя взять операндом
+    QVERIFY(!m_session->press(Key::Square));
+    QCOMPARE(m_session->displayText(), CalculatorConfig::ERROR_INVALID_INPUT);
+    QCOMPARE(errorSpy.count(), 3);
+}
+
+void TestCalculatorSession::testHistoryEntries()
+{
+    type("12.*3=");
+    QCOMPARE(m_history->count(), 1);
+    HistoryEntry entry = m_history->entryAt(0);
+    QCOMPARE(entry.expression, QString("12. × 3"));
+    QCOMPARE(entry.lhs, 12.0);
+    QCOMPARE(entry.rhs, 3.0);
+    QCOMPARE(entry.result, 36.0);
+    QVERIFY(entry.operation == CalcHandler::Operation::Multiply);
+    QCOMPARE(entry.resultPrecision, CalculatorConfig::MAX_DIGIT_LENGTH);
+
+    m_session->press(Key::SquareRoot);
+    QCOMPARE(m_history->count(), 2);
+    entry = m_history->entryAt(0);
+    QCOMPARE(entry.expression, QString("√(36)"));
+    QCOMPARE(entry.result, 6.0);
+
+    // Без истории сеанс считает так же
+    m_session->setHistory(nullptr);
+    m_session->reset();
+    type("1+1=");
+    QCOMPARE(m_session->displayText(), QString("2"));
+    QCOMPARE(m_history->count(), 2);
+}
+
+void TestCalculatorSession::testMemory()
+{
+    QVERIFY(!m_session->press(Key::MemoryRecall));
+    QVERIFY(!m_session->press(Key::MemoryAdd));
+
+    type("8");
+    QVERIFY(m_session->press(Key::MemoryAdd));
+    QVERIFY(m_session->press(Key::MemoryAdd));
+    QCOMPARE(m_memory->value(), 16.0);
+    QVERIFY(m_session->press(Key::MemorySubtract));
+    QCOMPARE(m_memory->value(), 8.0);
+
+    m_session->reset();
+    type("5");
+    QVERIFY(m_session->press(Key::MemoryStore));
+    QCOMPARE(m_memory->value(), 5.0);
+    QCOMPARE(m_memory->listSize(), 1);
+
+    m_session->reset();
+    QVERIFY(m_session->press(Key::MemoryRecall));
+    QCOMPARE(m_session->displayText(), QString("5"));
+    QVERIFY(m_session->isResultDisplayed());
+    QVERIFY(m_session->press(Key::MemoryClear));
+    QVERIFY(!m_memory->hasValue());
+
+    m_session->showValue(2.5);
+    QCOMPARE(m_session->displayText(), QString("2.5"));
+    type("1");
+    QCOMPARE(m_session->displayText(), QString("1"));
+
+    m_session->setMemory(nullptr);
+    QVERIFY(!m_session->press(Key::MemoryStore));
+}
+
+void TestCalculatorSession::testReset()
+{
+    type("5+3");
+    QVERIFY(m_session->press(Key::Clear));
+    QVERIFY(m_session->displayText().isEmpty());
+    QVERIFY(!m_session->isOperatorPending());
+    QVERIFY(!m_session->isResultDisplayed());
+
+    // Отложенная операция сброшена
+    type("2");
+    QVERIFY(!m_session->press(Key::Equals));
+    QCOMPARE(m_session->displayText(), QString("2"));
+
+    // Переиспользованный сеанс дает тот же результат, что и новый
+    for (int i = 0; i < 3; ++i) {
+        m_session->reset();
+        type("7-2=");
+        QCOMPARE(m_session->displayText(), QString("5"));
+    }
+    QCOMPARE(m_history->count(), 3);
+}
+
+void TestCalculatorSession::testKeyFromChar()
+{
+    Key key;
+    QVERIFY(CalculatorSession::keyFromChar('7', key));
+    QVERIFY(key == Key::Digit7);
+    QVERIFY(CalculatorSession::keyFromChar(',', key));
+    QVERIFY(key == Key::DecimalPoint);
+    QVERIFY(CalculatorSession::keyFromChar(QChar(0x00D7), key));
+    QVERIFY(key == Key::Multiply);
+    QVERIFY(CalculatorSession::keyFromChar(QChar(0x00F7), key));
+    QVERIFY(key == Key::Divide);
+    QVERIFY(CalculatorSession::keyFromChar('%', key));
+    QVERIFY(key == Key::Percent);
+    QVERIFY(!CalculatorSession::keyFromChar('a', key));
+    QVERIFY(CalculatorSession::digitKey(0) == Key::Digit0);
+}
+
+QTEST_MAIN(TestCalculatorSession)
+#include "test_calculatorsession.moc"
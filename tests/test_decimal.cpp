@@ -0,0 +1,206 @@
+#include "decimal.h"
+#include <QtTest/QtTest>
+
+/**
+ * @brief Тесты для класса Decimal
+ *
+ * Ожидаемые значения сверены с модулем decimal из Python
+ * (General Decimal Arithmetic).
+ */
+class TestDecimal : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void testParseAndFormat();
+    void testParseErrors();
+    void testFromDouble();
+    void testExactAddition();
+    void testRoundingModes();
+    void testDivision();
+    void testSquareRoot();
+    void testKaratsubaMultiplication();
+    void testLargeExponentGap();
+    void testCompare();
+
+private:
+    static Decimal parse(const char* text);
+    static QString str(const Decimal& value);
+};
+
+Decimal TestDecimal::parse(const char* text)
+{
+    bool ok = false;
+    Decimal value = Decimal::fromString(text, &ok);
+    if (!ok) {
+        qWarning() << "Не разобрано:" << text;
+    }
+    return value;
+}
+
+QString TestDecimal::str(const Decimal& value)
+{
+    return value.toString();
+}
+
+void TestDecimal::testParseAndFormat()
+{
+    QCOMPARE(str(parse("0")), QString("0"));
+    QCOMPARE(str(parse("-0.000")), QString("0"));
+    QCOMPARE(str(parse("123.4500")), QString("123.45"));
+    QCOMPARE(str(parse("-0.001")), QString("-0.001"));
+    QCOMPARE(str(parse("1e3")), QString("1000"));
+    QCOMPARE(str(parse(".5")), QString("0.5"));
+    QCOMPARE(str(parse("1.5e25")), QString("1.5e+25"));
+    QCOMPARE(str(parse("2E-10")), QString("2e-10"));
+    QCOMPARE(str(parse("123456789012345678901234567890")),
+             QString("1.2345678901234567890123456789e+29"));
+
+    Decimal value = parse("-12.5");
+    QVERIFY(value.isNegative());
+    QCOMPARE(value.exponent(), -1);
+    QCOMPARE(value.digitCount(), 3);
+    QCOMPARE(value.adjustedExponent(), 1);
+    QCOMPARE(value.toDouble(), -12.5);
+}
+
+void TestDecimal::testParseErrors()
+{
+    bool ok = true;
+    Decimal::fromString("", &ok);
+    QVERIFY(!ok);
+    Decimal::fromString("1.2.3", &ok);
+    QVERIFY(!ok);
+    Decimal::fromString("1e", &ok);
+    QVERIFY(!ok);
+    Decimal::fromString("abc", &ok);
+    QVERIFY(!ok);
+    Decimal::fromString(" 42 ", &ok);
+    QVERIFY(ok);
+}
+
+void TestDecimal::testFromDouble()
+{
+    bool ok = false;
+    QCOMPARE(str(Decimal::fromDouble(0.1, &ok)), QString("0.1"));
+    QVERIFY(ok);
+    QCOMPARE(str(Decimal::fromDouble(-2.5e-8)), QString("-2.5e-8"));
+    QCOMPARE(str(Decimal::fromDouble(1e21)), QString("1e+21"));
+
+    Decimal::fromDouble(qInf(), &ok);
+    QVERIFY(!ok);
+}
+
+void TestDecimal::testExactAddition()
+{
+    const DecimalContext context;
+    QCOMPARE(str(Decimal::add(parse("0.1"), parse("0.2"), context)), QString("0.3"));
+    QCOMPARE(str(Decimal::subtract(parse("1"), parse("0.9"), context)), QString("0.1"));
+    QCOMPARE(str(Decimal::subtract(parse("5"), parse("5.0"), context)), QString("0"));
+    QCOMPARE(str(Decimal::multiply(parse("1.1"), parse("1.1"), context)), QString("1.21"));
+    QCOMPARE(Decimal::add(parse("0.1"), parse("0.2"), context).toDouble(), 0.3);
+}
+
+void TestDecimal::testRoundingModes()
+{
+    struct Case {
+        DecimalRounding rounding;
+        const char* value;
+        const char* expected;
+    };
+    const Case cases[] = {
+        { DecimalRounding::HalfEven, "2.5", "2" },
+        { DecimalRounding::HalfEven, "3.5", "4" },
+        { DecimalRounding::HalfEven, "2.51", "3" },
+        { DecimalRounding::HalfUp, "2.5", "3" },
+        { DecimalRounding::HalfUp, "-2.5", "-3" },
+        { DecimalRounding::HalfDown, "2.5", "2" },
+        { DecimalRounding::HalfDown, "2.500001", "3" },
+        { DecimalRounding::Up, "2.1", "3" },
+        { DecimalRounding::Up, "-2.1", "-3" },
+        { DecimalRounding::Down, "2.9", "2" },
+        { DecimalRounding::Ceiling, "-2.9", "-2" },
+        { DecimalRounding::Ceiling, "2.1", "3" },
+        { DecimalRounding::Floor, "-2.1", "-3" },
+        { DecimalRounding::Floor, "2.9", "2" },
+        { DecimalRounding::HalfUp, "9.9", "10" }
+    };
+
+    for (const Case& c : cases) {
+        const DecimalContext context(1, c.rounding);
+        QCOMPARE(str(parse(c.value).rounded(context)), QString(c.expected));
+    }
+}
+
+void TestDecimal::testDivision()
+{
+    QCOMPARE(str(Decimal::divide(parse("1"), parse("3"), DecimalContext(10))),
+             QString("0.3333333333"));
+    QCOMPARE(str(Decimal::divide(parse("2"), parse("3"), DecimalContext(10))),
+             QString("0.6666666667"));
+    QCOMPARE(str(Decimal::divide(parse("2"), parse("3"), DecimalContext(10, DecimalRounding::Down))),
+             QString("0.6666666666"));
+    QCOMPARE(str(Decimal::divide(parse("1"), parse("4"), DecimalContext())), QString("0.25"));
+    QCOMPARE(str(Decimal::divide(parse("-10"), parse("0.5"), DecimalContext())), QString("-20"));
+
+    // Многоконечностный делитель
+    QCOMPARE(str(Decimal::divide(parse("1"), parse("123456789012345678901"), DecimalContext(30))),
+             QString("8.1000000729000006634053960364e-21"));
+}
+
+void TestDecimal::testSquareRoot()
+{
+    QCOMPARE(str(Decimal::squareRoot(parse("16"), DecimalContext())), QString("4"));
+    QCOMPARE(str(Decimal::squareRoot(parse("0.0144"), DecimalContext())), QString("0.12"));
+    QCOMPARE(str(Decimal::squareRoot(parse("2"), DecimalContext(50))),
+             QString("1.4142135623730950488016887242096980785696718753769"));
+    QCOMPARE(str(Decimal::squareRoot(parse("2e-7"), DecimalContext(10))),
+             QString("0.0004472135955"));
+}
+
+void TestDecimal::testKaratsubaMultiplication()
+{
+    // (10^n - 1)^2 = 10^2n - 2 * 10^n + 1, операнды длиннее порога Карацубы
+    const int n = Decimal::KARATSUBA_THRESHOLD * Decimal::LIMB_DIGITS * 3 + 5;
+    const Decimal nines = parse(QByteArray(n, '9').constData());
+    const Decimal square = Decimal::multiply(nines, nines, DecimalContext(2 * n));
+
+    const QString expected = QString(n - 1, '9') + "8" + QString(n - 1, '0') + "1";
+    QCOMPARE(square.digitCount(), 2 * n);
+    QCOMPARE(str(Decimal::scaled(square, -2 * n)), "0." + expected);
+
+    // Несбалансированные длины
+    const Decimal shortNines = parse(QByteArray(Decimal::KARATSUBA_THRESHOLD * 10, '9').constData());
+    const Decimal product = Decimal::multiply(nines, shortNines, DecimalContext(4 * n));
+    const Decimal check = Decimal::subtract(Decimal::multiply(nines, Decimal::add(shortNines, Decimal(1),
+                                                              DecimalContext(4 * n)),
+                                                              DecimalContext(4 * n)),
+                                            nines, DecimalContext(4 * n));
+    QCOMPARE(product, check);
+}
+
+void TestDecimal::testLargeExponentGap()
+{
+    const DecimalContext context(5);
+    QCOMPARE(str(Decimal::add(parse("1e1000000"), parse("1"), context)), QString("1e+1000000"));
+    QCOMPARE(str(Decimal::subtract(parse("1e1000000"), parse("1"), context)),
+             QString("1e+1000000"));
+    QCOMPARE(str(Decimal::subtract(parse("1e1000000"), parse("1"),
+                                   DecimalContext(5, DecimalRounding::Down))),
+             QString("9.9999e+999999"));
+    QCOMPARE(str(Decimal::add(parse("1e1000000"), parse("1"), DecimalContext(5, DecimalRounding::Up))),
+             QString("1.0001e+1000000"));
+}
+
+void TestDecimal::testCompare()
+{
+    QVERIFY(parse("1.10") == parse("1.1"));
+    QVERIFY(parse("-2") < parse("-1.5"));
+    QVERIFY(parse("0") < parse("1e-100"));
+    QVERIFY(parse("99.9") < parse("100"));
+    QCOMPARE(Decimal::compare(parse("-0"), parse("0")), 0);
+    QCOMPARE(Decimal::compare(parse("12.34"), parse("12.3399")), 1);
+}
+
+QTEST_MAIN(TestDecimal)
+#include "test_decimal.moc"
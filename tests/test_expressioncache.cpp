@@ -0,0 +1,156 @@
+#include "expressioncache.h"
+#include <QtTest/QtTest>
+
+/**
+ * @brief Тесты для класса ExpressionCache
+ */
+class TestExpressionCache : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void testNormalize();
+    void testHitsAndMisses();
+    void testSharedProgramWithNewOperands();
+    void testBindOperands();
+    void testInvalidExpression();
+    void testSpaceInsideName();
+    void testEviction();
+    void testShrinkBudget();
+};
+
+void TestExpressionCache::testNormalize()
+{
+    QString key;
+    QVector<double> operands;
+
+    ExpressionCache::normalize("2 × 3 + 1", key, operands);
+    QCOMPARE(key, QString("#*#+#"));
+    QCOMPARE(operands, QVector<double>() << 2.0 << 3.0 << 1.0);
+
+    ExpressionCache::normalize("1/x(4) − x²(2.5e1)", key, operands);
+    QCOMPARE(key, QString("1/x(#)-x²(#)"));
+    QCOMPARE(operands, QVector<double>() << 4.0 << 25.0);
+
+    ExpressionCache::normalize("8 ÷ .5", key, operands);
+    QCOMPARE(key, QString("#/#"));
+    QCOMPARE(operands.at(1), 0.5);
+}
+
+void TestExpressionCache::testHitsAndMisses()
+{
+    ExpressionCache cache;
+
+    QCOMPARE(cache.evaluate("2 + 3").value, 5.0);
+    QCOMPARE(cache.evaluate("2 + 3").value, 5.0);
+    QCOMPARE(cache.evaluate("(2 + 3) * 2").value, 10.0);
+
+    ExpressionCache::Statistics stats = cache.statistics();
+    QCOMPARE(stats.hits, qint64(1));
+    QCOMPARE(stats.misses, qint64(2));
+    QCOMPARE(stats.evictions, qint64(0));
+    QCOMPARE(cache.size(), 2);
+    QVERIFY(cache.memoryUsage() > 0);
+
+    cache.resetStatistics();
+    QCOMPARE(cache.statistics().hits, qint64(0));
+}
+
+void TestExpressionCache::testSharedProgramWithNewOperands()
+{
+    ExpressionCache cache;
+
+    QCOMPARE(cache.evaluate("1 + 2 × 3").value, 7.0);
+    // Другие числа и написание операторов - та же программа
+    QCOMPARE(cache.evaluate("10+4*0.5").value, 12.0);
+    QCOMPARE(cache.evaluate("4 + 1 x 2").value, 6.0);
+
+    QCOMPARE(cache.size(), 1);
+    QCOMPARE(cache.statistics().hits, qint64(2));
+
+    QCOMPARE(cache.evaluate("1 ÷ 0").error, CalcHandler::Error::DivisionByZero);
+}
+
+void TestExpressionCache::testBindOperands()
+{
+    ExpressionCache cache;
+    ExpressionProgram program;
+    QVector<double> operands;
+
+    QVERIFY(!cache.program("√(a)", program, operands));
+    QVERIFY(cache.program("(1 + 1) ÷ 2", program, operands));
+    QCOMPARE(operands.size(), program.operandCount());
+
+    // Привязка новых значений без работы со строками
+    for (int i = 0; i < 5; ++i) {
+        operands[0] = i;
+        QCOMPARE(program.evaluate(operands.constData()).value, (i + 1.0) / 2.0);
+    }
+}
+
+void TestExpressionCache::testInvalidExpression()
+{
+    ExpressionCache cache;
+
+    QCOMPARE(cache.evaluate("5 +").error, CalcHandler::Error::InvalidInput);
+    QCOMPARE(cache.evaluate("5 +").error, CalcHandler::Error::InvalidInput);
+    // Ошибки разбора не кэшируются
+    QCOMPARE(cache.size(), 0);
+    QCOMPARE(cache.statistics().misses, qint64(2));
+}
+
+void TestExpressionCache::testSpaceInsideName()
+{
+    ExpressionCache cache;
+
+    QCOMPARE(cache.evaluate("sqrt(4)").value, 2.0);
+    QCOMPARE(cache.evaluate("sqrt (9)").value, 3.0);
+    // Разорванное имя - другой ключ: ошибка разбора, а не попадание в кэш
+    QCOMPARE(cache.evaluate("sq rt(4)").error, CalcHandler::Error::InvalidInput);
+    QCOMPARE(cache.evaluate("ne g(2)").error, CalcHandler::Error::InvalidInput);
+    QCOMPARE(cache.statistics().hits, qint64(1));
+
+    QString key;
+    QVector<double> operands;
+    ExpressionCache::normalize("sq rt(4)", key, operands);
+    QCOMPARE(key, QString("sq rt(#)"));
+}
+
+void TestExpressionCache::testEviction()
+{
+    ExpressionCache cache(1000);
+
+    // Разные формы выражений дают разные ключи
+    QString text = "1";
+    for (int i = 0; i < 20; ++i) {
+        text += " + 1";
+        QVERIFY(cache.evaluate(text).success());
+    }
+
+    QVERIFY(cache.memoryUsage() <= cache.memoryBudget());
+    QVERIFY(cache.size() < 20);
+    QCOMPARE(cache.statistics().evictions, qint64(20 - cache.size()));
+
+    // Последнее выражение осталось в кэше
+    cache.resetStatistics();
+    cache.evaluate(text);
+    QCOMPARE(cache.statistics().hits, qint64(1));
+}
+
+void TestExpressionCache::testShrinkBudget()
+{
+    ExpressionCache cache;
+    cache.evaluate("1 + 1");
+    cache.evaluate("1 - 1");
+    QCOMPARE(cache.size(), 2);
+
+    cache.setMemoryBudget(0);
+    QCOMPARE(cache.size(), 0);
+    QCOMPARE(cache.statistics().evictions, qint64(2));
+
+    cache.clear();
+    QCOMPARE(cache.memoryUsage(), 0);
+}
+
+QTEST_MAIN(TestExpressionCache)
+#include "test_expressioncache.moc"
@@ -0,0 +1,169 @@
+#include "expressioncompiler.h"
+#include "expressionprogram.h"
+#include <QtTest/QtTest>
+
+/**
+ * @brief Тесты для классов ExpressionCompiler и ExpressionProgram
+ */
+class TestExpressionCompiler : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void testPrecedence();
+    void testParentheses();
+    void testUnaryOperators();
+    void testPostfixOperators();
+    void testHistoryFormat();
+    void testUnicodeOperators();
+    void testUtf8Input();
+    void testSyntaxErrors();
+    void testEvaluationErrors();
+    void testOperandSlots();
+    void testReevaluate();
+
+private:
+    double evaluate(const QString& text);
+};
+
+double TestExpressionCompiler::evaluate(const QString& text)
+{
+    ExpressionProgram program;
+    if (!ExpressionCompiler::compile(text, program)) {
+        qWarning() << "Не скомпилировано:" << text;
+        return -12345.0;
+    }
+    CalcHandler::CalculationResult result = program.evaluate();
+    return result.success() ? result.value : -12345.0;
+}
+
+void TestExpressionCompiler::testPrecedence()
+{
+    QCOMPARE(evaluate("2 + 3 * 4"), 14.0);
+    QCOMPARE(evaluate("10 - 4 - 3"), 3.0);
+    QCOMPARE(evaluate("100 / 10 / 5"), 2.0);
+    QCOMPARE(evaluate("2 * 3 + 4 * 5"), 26.0);
+}
+
+void TestExpressionCompiler::testParentheses()
+{
+    QCOMPARE(evaluate("(2 + 3) * 4"), 20.0);
+    QCOMPARE(evaluate("((1))"), 1.0);
+    QCOMPARE(evaluate("2 * (3 + (4 - 1))"), 12.0);
+}
+
+void TestExpressionCompiler::testUnaryOperators()
+{
+    QCOMPARE(evaluate("-5 + 3"), -2.0);
+    QCOMPARE(evaluate("-2.5*-4"), 10.0);
+    QCOMPARE(evaluate("--3"), 3.0);
+    QCOMPARE(evaluate("+7"), 7.0);
+    QCOMPARE(evaluate("√16 + 1"), 5.0);
+    // Унарный минус слабее возведения в квадрат
+    QCOMPARE(evaluate("-3²"), -9.0);
+}
+
+void TestExpressionCompiler::testPostfixOperators()
+{
+    QCOMPARE(evaluate("5²"), 25.0);
+    QCOMPARE(evaluate("(1 + 2)²"), 9.0);
+    QCOMPARE(evaluate("50%"), 0.5);
+    QCOMPARE(evaluate("200 * 10%"), 20.0);
+    QCOMPARE(evaluate("3 + 4 × 2 ÷ (1 − 5)²"), 3.5);
+}
+
+void TestExpressionCompiler::testHistoryFormat()
+{
+    QCOMPARE(evaluate("√(16)"), 4.0);
+    QCOMPARE(evaluate("sqrt(9)"), 3.0);
+    QCOMPARE(evaluate("x²(5)"), 25.0);
+    QCOMPARE(evaluate("±(7)"), -7.0);
+    QCOMPARE(evaluate("1/x(4)"), 0.25);
+    QCOMPARE(evaluate("%(50)"), 0.5);
+    QCOMPARE(evaluate("1/x(2) + inv(4)"), 0.75);
+}
+
+void TestExpressionCompiler::testUnicodeOperators()
+{
+    QCOMPARE(evaluate("6 × 7"), 42.0);
+    QCOMPARE(evaluate("6 x 7"), 42.0);
+    QCOMPARE(evaluate("8 ÷ 2"), 4.0);
+    QCOMPARE(evaluate("8 − 2"), 6.0);
+    QCOMPARE(evaluate("1e3 + 1"), 1001.0);
+}
+
+void TestExpressionCompiler::testUtf8Input()
+{
+    const QByteArray text = QString("3 + 4 × 2 ÷ (1 − 5)²").toUtf8();
+    ExpressionProgram program;
+    QVERIFY(ExpressionCompiler::compile(text.constData(), text.constData() + text.size(), program));
+    QCOMPARE(program.evaluate().value, 3.5);
+
+    const QByteArray broken = "2 + \xE2\x88";
+    int errorPosition = -1;
+    QVERIFY(!ExpressionCompiler::compile(broken.constData(), broken.constData() + broken.size(),
+                                         program, &errorPosition));
+    QCOMPARE(errorPosition, 4);
+}
+
+void TestExpressionCompiler::testSyntaxErrors()
+{
+    ExpressionProgram program;
+    int errorPosition = -1;
+
+    QVERIFY(!ExpressionCompiler::compile("", program));
+    QVERIFY(!ExpressionCompiler::compile("abc", program));
+    QVERIFY(!ExpressionCompiler::compile("5 +", program));
+    QVERIFY(!ExpressionCompiler::compile("(1 + 2", program));
+    QVERIFY(!ExpressionCompiler::compile("1 + 2)", program));
+    QVERIFY(!ExpressionCompiler::compile("5 + 3 4", program, &errorPosition));
+    QCOMPARE(errorPosition, 6);
+    QVERIFY(!program.isValid());
+
+    QVERIFY(!ExpressionCompiler::compile(QString(1000, '('), program));
+}
+
+void TestExpressionCompiler::testEvaluationErrors()
+{
+    ExpressionProgram program;
+
+    QVERIFY(ExpressionCompiler::compile("1 / (2 - 2)", program));
+    QCOMPARE(program.evaluate().error, CalcHandler::Error::DivisionByZero);
+
+    QVERIFY(ExpressionCompiler::compile("√(1 - 5)", program));
+    QCOMPARE(program.evaluate().error, CalcHandler::Error::NegativeRoot);
+
+    QVERIFY(ExpressionCompiler::compile("1e308 * 10", program));
+    QCOMPARE(program.evaluate().error, CalcHandler::Error::Overflow);
+}
+
+void TestExpressionCompiler::testOperandSlots()
+{
+    ExpressionProgram program;
+    QVERIFY(ExpressionCompiler::compile("(1.5 + 2) * -3", program));
+
+    QCOMPARE(program.operandCount(), 3);
+    QCOMPARE(program.operands().at(0), 1.5);
+    QCOMPARE(program.operands().at(2), 3.0);
+    QCOMPARE(program.stackDepth(), 2);
+    // 1.5 2 + 3 neg *
+    QCOMPARE(program.instructions().size(), 6);
+    QCOMPARE(program.instructions().at(2).operation, CalcHandler::Operation::Add);
+}
+
+void TestExpressionCompiler::testReevaluate()
+{
+    ExpressionProgram program;
+    QVERIFY(ExpressionCompiler::compile("(0 + 0) × 0", program));
+
+    // Та же программа с новыми операндами, без повторного разбора
+    for (int i = 1; i <= 10; ++i) {
+        const double operands[] = { double(i), 1.0, 2.0 };
+        CalcHandler::CalculationResult result = program.evaluate(operands);
+        QVERIFY(result.success());
+        QCOMPARE(result.value, (i + 1.0) * 2.0);
+    }
+}
+
+QTEST_MAIN(TestExpressionCompiler)
+#include "test_expressioncompiler.moc"
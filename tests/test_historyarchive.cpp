@@ -0,0 +1,280 @@
+#include "historyarchive.h"
+#include "calculationhistory.h"
+#include <QtTest/QtTest>
+#include <QFile>
+#include <QFileInfo>
+#include <QTemporaryDir>
+#include <cmath>
+#include <cstring>
+
+/**
+ * @brief Тесты для класса HistoryArchive
+ *
+ * Точное восстановление всех полей, в том числе NaN и разных точностей,
+ * переход по индексу блоков, чтение отдельных столбцов, повреждения,
+ * обмен с текстовым файлом и загрузка архива в CalculationHistory.
+ */
+class TestHistoryArchive : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void init();
+
+    void testRoundTrip();
+    void testSeek();
+    void testColumns();
+    void testCorruptedBlock();
+    void testTruncatedFileRejected();
+    void testTextExportImport();
+    void testLoadIntoHistory();
+
+private:
+    QString path(const QString& name) const;
+    static HistoryEntry makeEntry(int i);
+    static bool sameEntry(const HistoryEntry& a, const HistoryEntry& b);
+    static bool sameDouble(double a, double b);
+    void writeArchive(const QString& filename, int count, int blockSize);
+
+private:
+    QScopedPointer<QTemporaryDir> m_directory;
+};
+
+void TestHistoryArchive::init()
+{
+    m_directory.reset(new QTemporaryDir());
+    QVERIFY(m_directory->isValid());
+}
+
+QString TestHistoryArchive::path(const QString& name) const
+{
+    return m_directory->filePath(name);
+}
+
+HistoryEntry TestHistoryArchive::makeEntry(int i)
+{
+    HistoryEntry entry;
+    if (i % 5 == 4) {
+        // Готовая строка: числа не заданы
+        entry.expression = QString("%1 * 2 = %2").arg(i).arg(i * 2);
+    } else if (i % 5 == 3) {
+        entry.expression = QString("sqrt(%1)").arg(i);
+        entry.lhs = i;
+        entry.operation = CalcOperation::SquareRoot;
+        entry.result = std::sqrt(double(i));
+        entry.resultPrecision = 6;
+    } else {
+        entry.expression = QString("%1 / 3").arg(i % 7);
+        entry.lhs = i % 7;
+        entry.operation = CalcOperation::Divide;
+        entry.rhs = 3.0;
+        entry.result = (i % 7) / 3.0;
+        entry.resultPrecision = 10;
+    }
+    // Неровный темп с паузой в середине
+    entry.timestamp = 1600000000000LL + i * 1500LL + (i % 3) * 7 + (i >= 50 ? 86400000LL : 0);
+    return entry;
+}
+
+bool TestHistoryArchive::sameDouble(double a, double b)
+{
+    return std::memcmp(&a, &b, sizeof(a)) == 0;
+}
+
+bool TestHistoryArchive::sameEntry(const HistoryEntry& a, const HistoryEntry& b)
+{
+    return a.expression == b.expression && sameDouble(a.lhs, b.lhs)
+        && sameDouble(a.rhs, b.rhs) && sameDouble(a.result, b.result)
+        && a.timestamp == b.timestamp && a.operation == b.operation
+        && a.resultPrecision == b.resultPrecision;
+}
+
+void TestHistoryArchive::writeArchive(const QString& filename, int count, int blockSize)
+{
+    HistoryArchive::Writer writer(blockSize);
+    QVERIFY(writer.open(filename));
+    for (int i = 0; i < count; ++i) {
+        writer.append(makeEntry(i));
+    }
+    QCOMPARE(writer.count(), qint64(count));
+    QVERIFY(writer.commit());
+}
+
+void TestHistoryArchive::testRoundTrip()
+{
+    const QString filename = path("history.archive");
+    writeArchive(filename, 100, 16);
+    QVERIFY(HistoryArchive::isArchive(filename));
+
+    HistoryArchive archive;
+    QVERIFY(archive.open(filename));
+    QCOMPARE(archive.count(), qint64(100));
+    QCOMPARE(archive.blockCount(), 7);
+    QCOMPARE(archive.blockFirstEntry(6), qint64(96));
+
+    HistoryEntry entry;
+    for (int i = 0; i < 100; ++i) {
+        QVERIFY(archive.next(entry));
+        QVERIFY2(sameEntry(entry, makeEntry(i)), qPrintable(QString::number(i)));
+    }
+    QVERIFY(!archive.next(entry));
+
+    // Пустой архив - тоже архив
+    writeArchive(filename, 0, 16);
+    QVERIFY(archive.open(filename));
+    QCOMPARE(archive.count(), qint64(0));
+    QVERIFY(!archive.next(entry));
+}
+
+void TestHistoryArchive::testSeek()
+{
+    const QString filename = path("history.archive");
+    writeArchive(filename, 100, 16);
+    HistoryArchive archive;
+    QVERIFY(archive.open(filename));
+
+    HistoryEntry entry;
+    QVERIFY(archive.seek(63));
+    QVERIFY(archive.next(entry));
+    QVERIFY(sameEntry(entry, makeEntry(63)));
+    QCOMPARE(archive.position(), qint64(64));
+    QVERIFY(archive.seek(5));
+    QVERIFY(archive.next(entry));
+    QVERIFY(sameEntry(entry, makeEntry(5)));
+    QVERIFY(!archive.seek(101));
+    QCOMPARE(archive.blockOf(47), 2);
+    QCOMPARE(archive.blockOf(48), 3);
+
+    // Первая запись после паузы
+    QVERIFY(archive.seekTime(makeEntry(49).timestamp + 1));
+    QCOMPARE(archive.position(), qint64(50));
+    QVERIFY(archive.seekTime(makeEntry(70).timestamp));
+    QCOMPARE(archive.position(), qint64(70));
+    QVERIFY(!archive.seekTime(makeEntry(99).timestamp + 1));
+    QVERIFY(!archive.next(entry));
+}
+
+void TestHistoryArchive::testColumns()
+{
+    const QString filename = path("history.archive");
+    writeArchive(filename, 40, 32);
+    HistoryArchive archive;
+    QVERIFY(archive.open(filename));
+
+    HistoryArchive::Block block;
+    QVERIFY(archive.readBlock(1, block, HistoryArchive::Results));
+    QCOMPARE(block.firstEntry, qint64(32));
+    QCOMPARE(block.count, 8);
+    QCOMPARE(block.results.size(), 8);
+    QVERIFY(block.expressions.isEmpty());
+    QVERIFY(block.timestamps.isEmpty());
+    for (int i = 0; i < block.count; ++i) {
+        QVERIFY(sameDouble(block.results.at(i), makeEntry(32 + i).result));
+    }
+
+    // Одинаковые выражения блока разделяют одну строку словаря
+    QVERIFY(archive.readBlock(0, block));
+    QVERIFY(block.dictionary.size() < block.count);
+    QCOMPARE(block.entry(0).expression, block.entry(7).expression);
+}
+
+void TestHistoryArchive::testCorruptedBlock()
+{
+    const QString filename = path("history.archive");
+    writeArchive(filename, 40, 16);
+
+    QFile file(filename);
+    QVERIFY(file.open(QIODevice::ReadWrite));
+    QByteArray data = file.readAll();
+    // Байт нагрузки первого блока
+    data[HistoryArchive::HEADER_SIZE + HistoryArchive::BLOCK_HEADER_SIZE + 10] ^= 0x40;
+    QVERIFY(file.seek(0));
+    QCOMPARE(file.write(data), qint64(data.size()));
+    file.close();
+
+    HistoryArchive archive;
+    QVERIFY(archive.open(filename));
+    HistoryArchive::Block block;
+    QVERIFY(!archive.readBlock(0, block));
+    QVERIFY(archive.readBlock(1, block));
+
+    HistoryEntry entry;
+    QVERIFY(!archive.next(entry));
+    QVERIFY(archive.seek(16));
+    QVERIFY(archive.next(entry));
+    QVERIFY(sameEntry(entry, makeEntry(16)));
+}
+
+void TestHistoryArchive::testTruncatedFileRejected()
+{
+    const QString filename = path("history.archive");
+    writeArchive(filename, 40, 16);
+
+    QFile file(filename);
+    QVERIFY(file.open(QIODevice::ReadOnly));
+    const QByteArray data = file.readAll();
+    file.close();
+
+    HistoryArchive archive;
+    QVERIFY(archive.open(data));
+    QVERIFY(!archive.open(data.left(data.size() - 1)));
+    QVERIFY(!archive.open(data.left(data.size() / 2)));
+    QVERIFY(!archive.open(QByteArray("CHAR")));
+}
+
+void TestHistoryArchive::testTextExportImport()
+{
+    const QString textFile = path("history.txt");
+    const QString archiveFile = path("history.archive");
+    const QString exported = path("exported.txt");
+
+    // Как пишет saveToFile: новые строки первыми
+    CalculationHistory history;
+    history.setMaxSize(400);
+    for (int i = 0; i < 300; ++i) {
+        history.addEntry(QString("%1 + 2").arg(i % 10), i % 10 + 2.0);
+    }
+    history.addEntry("custom line without result");
+    history.addEntry("1 / 3 = 0.3333");
+    history.saveToFile(textFile);
+
+    QVERIFY(HistoryArchive::importText(textFile, archiveFile, 64));
+    QVERIFY(!HistoryArchive::isArchive(textFile));
+    QVERIFY(HistoryArchive::isArchive(archiveFile));
+    // Повторяющиеся выражения уходят в словарь
+    QVERIFY(QFileInfo(archiveFile).size() < QFileInfo(textFile).size());
+
+    HistoryArchive archive;
+    QVERIFY(archive.open(archiveFile));
+    QCOMPARE(archive.count(), qint64(history.count()));
+    HistoryEntry entry;
+    QVERIFY(archive.next(entry));
+    QCOMPARE(entry.expression, QString("0 + 2"));
+    QCOMPARE(entry.result, 2.0);
+    archive.close();
+
+    QVERIFY(HistoryArchive::exportText(archiveFile, exported));
+    QFile original(textFile);
+    QFile copy(exported);
+    QVERIFY(original.open(QIODevice::ReadOnly));
+    QVERIFY(copy.open(QIODevice::ReadOnly));
+    QCOMPARE(copy.readAll(), original.readAll());
+}
+
+void TestHistoryArchive::testLoadIntoHistory()
+{
+    const QString filename = path("history.archive");
+    writeArchive(filename, 100, 16);
+
+    CalculationHistory history;
+    history.setMaxSize(30);
+    QSignalSpy resetSpy(&history, &CalculationHistory::historyReset);
+    history.loadFromFile(filename);
+    QCOMPARE(resetSpy.count(), 1);
+    QCOMPARE(history.count(), 30);
+    QVERIFY(sameEntry(history.entryAt(0), makeEntry(99)));
+    QVERIFY(sameEntry(history.entryAt(29), makeEntry(70)));
+}
+
+QTEST_MAIN(TestHistoryArchive)
+#include "test_historyarchive.moc"
@@ -0,0 +1,249 @@
+#include "historyindex.h"
+#include "calculationhistory.h"
+#include <QtTest/QtTest>
+#include <QTemporaryFile>
+#include <cmath>
+
+/**
+ * @brief Тесты для класса HistoryIndex
+ *
+ * Поиск по тексту, диапазону результата и операции, а также
+ * согласованность индекса с историей при вытеснении и сбросе.
+ */
+class TestHistoryIndex : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void init();
+    void cleanup();
+
+    void testTextSearch();
+    void testResultRange();
+    void testOperation();
+    void testEviction();
+    void testReset();
+    void testParse();
+    void testMatches();
+
+private:
+    void addOperation(double lhs, CalcOperation operation, const QString& symbol,
+                      double rhs, double result);
+
+private:
+    CalculationHistory* m_history;
+    HistoryIndex* m_index;
+};
+
+void TestHistoryIndex::init()
+{
+    m_history = new CalculationHistory();
+    m_history->setMaxSize(1000);
+    m_index = new HistoryIndex(m_history);
+}
+
+void TestHistoryIndex::cleanup()
+{
+    delete m_index;
+    delete m_history;
+}
+
+void TestHistoryIndex::addOperation(double lhs, CalcOperation operation, const QString& symbol,
+                                    double rhs, double result)
+{
+    HistoryEntry entry;
+    entry.expression = QString("%1 %2 %3").arg(lhs).arg(symbol).arg(rhs);
+    entry.lhs = lhs;
+    entry.operation = operation;
+    entry.rhs = rhs;
+    entry.result = result;
+    entry.resultPrecision = 6;
+    m_history->addEntry(entry);
+}
+
+void TestHistoryIndex::testTextSearch()
+{
+    m_history->addEntry("√(16) = 4");
+    m_history->addEntry("SQRT(9) = 3");
+    m_history->addEntry("12 + 34 = 46");
+    m_history->addEntry("34 + 12 = 46");
+
+    HistoryQuery query;
+    query.text = "√";
+    QCOMPARE(m_index->search(query), QVector<int>() << 3);
+
+    // Без учета регистра
+    query.text = "sqrt";
+    QCOMPARE(m_index->search(query), QVector<int>() << 2);
+
+    // Все триграммы "12 + 3" есть в обеих записях, но подстрока - только в одной
+    query.text = "12 + 3";
+    QCOMPARE(m_index->search(query), QVector<int>() << 1);
+
+    // Результат - не часть текста выражения
+    query.text = "46";
+    QVERIFY(m_index->search(query).isEmpty());
+
+    query.text = "+";
+    QCOMPARE(m_index->search(query), QVector<int>() << 0 << 1);
+    QCOMPARE(m_index->search(query, 1), QVector<int>() << 0);
+    QCOMPARE(m_index->search(HistoryQuery()).size(), 4);
+}
+
+void TestHistoryIndex::testResultRange()
+{
+    m_history->addEntry("a = 1500000");
+    m_history->addEntry("b = 2000000");
+    m_history->addEntry("c = 2000001");
+    m_history->addEntry("d = -0");
+    m_history->addEntry("e = 999999");
+
+    HistoryQuery query;
+    query.minResult = 1e6;
+    query.maxResult = 2e6;
+    QCOMPARE(m_index->search(query), QVector<int>() << 3 << 4);
+
+    query.maxResult = std::numeric_limits<double>::quiet_NaN();
+    QCOMPARE(m_index->search(query), QVector<int>() << 2 << 3 << 4);
+
+    // -0 входит в диапазон с нулевой границей
+    query.minResult = 0;
+    query.maxResult = 0;
+    QCOMPARE(m_index->search(query), QVector<int>() << 1);
+
+    query.minResult = 5;
+    query.maxResult = 1;
+    QVERIFY(m_index->search(query).isEmpty());
+}
+
+void TestHistoryIndex::testOperation()
+{
+    addOperation(144, CalcOperation::Divide, "÷", 12, 12);
+    addOperation(24, CalcOperation::Multiply, "×", 12, 288);
+    addOperation(100, CalcOperation::Divide, "÷", 4, 25);
+    addOperation(36, CalcOperation::Divide, "÷", 12, 3);
+
+    HistoryQuery query;
+    query.operation = CalcOperation::Divide;
+    query.rhs = 12;
+    QCOMPARE(m_index->search(query), QVector<int>() << 0 << 3);
+
+    query.rhs = std::numeric_limits<double>::quiet_NaN();
+    QCOMPARE(m_index->search(query).size(), 3);
+
+    // Условия складываются
+    query.rhs = 12;
+    query.minResult = 10;
+    QCOMPARE(m_index->search(query), QVector<int>() << 3);
+
+    query = HistoryQuery();
+    query.operation = CalcOperation::Subtract;
+    QVERIFY(m_index->search(query).isEmpty());
+}
+
+void TestHistoryIndex::testEviction()
+{
+    const int maxSize = 100;
+    m_history->setMaxSize(maxSize);
+    HistoryQuery query;
+    query.text = "7 +";
+    QVERIFY(m_index->search(query).isEmpty());
+    QVERIFY(m_index->isBuilt());
+
+    // Вытеснений хватает, чтобы индекс несколько раз вычистил мертвые номера
+    for (int i = 0; i < 20000; ++i) {
+        m_history->addEntry(QString::number(i % 10) + " + 1", i % 10 + 1.0);
+    }
+    const QVector<int> rows = m_index->search(query);
+    QCOMPARE(rows.size(), maxSize / 10);
+    for (int row : rows) {
+        QCOMPARE(m_history->entryAt(row).expression, QString("7 + 1"));
+    }
+
+    query = HistoryQuery();
+    query.minResult = 8;
+    query.maxResult = 8;
+    QCOMPARE(m_index->search(query), rows);
+
+    m_history->setMaxSize(5);
+    QCOMPARE(m_index->search(query), QVector<int>() << 2);
+}
+
+void TestHistoryIndex::testReset()
+{
+    m_history->addEntry("1 + 1 = 2");
+    HistoryQuery query;
+    query.text = "1";
+    QCOMPARE(m_index->search(query).size(), 1);
+
+    m_history->clear();
+    QVERIFY(!m_index->isBuilt());
+    QVERIFY(m_index->search(query).isEmpty());
+
+    QTemporaryFile tempFile;
+    QVERIFY(tempFile.open());
+    tempFile.write("1 + 1 = 2\n2 + 2 = 4\n1 * 5 = 5\n");
+    tempFile.close();
+    m_history->loadFromFile(tempFile.fileName());
+    QVERIFY(!m_index->isBuilt());
+    QCOMPARE(m_index->search(query), QVector<int>() << 0 << 2);
+}
+
+void TestHistoryIndex::testParse()
+{
+    HistoryQuery query = HistoryQuery::parse(" 1e6..2e6 ");
+    QCOMPARE(query.minResult, 1e6);
+    QCOMPARE(query.maxResult, 2e6);
+    QVERIFY(query.text.isEmpty());
+
+    query = HistoryQuery::parse("..-5");
+    QVERIFY(std::isnan(query.minResult));
+    QCOMPARE(query.maxResult, -5.0);
+
+    query = HistoryQuery::parse("√(2");
+    QCOMPARE(query.text, QString("√(2"));
+    QVERIFY(std::isnan(query.minResult));
+
+    // Не числа по краям - обычный текст
+    query = HistoryQuery::parse("a..b");
+    QCOMPARE(query.text, QString("a..b"));
+
+    QVERIFY(HistoryQuery::parse("  ").isEmpty());
+}
+
+void TestHistoryIndex::testMatches()
+{
+    m_history->addEntry("√(16) = 4");
+    m_history->addEntry("12 + 34 = 46");
+    m_history->addEntry("d = -0");
+    addOperation(144, CalcOperation::Divide, "÷", 12, 12);
+    addOperation(100, CalcOperation::Divide, "÷", 4, 25);
+
+    // Проверка одной записи совпадает с поиском по индексу
+    QVector<HistoryQuery> queries;
+    queries.append(HistoryQuery::parse("√"));
+    queries.append(HistoryQuery::parse("2 + 3"));
+    queries.append(HistoryQuery::parse("46"));
+    queries.append(HistoryQuery::parse("0..0"));
+    queries.append(HistoryQuery::parse("10.."));
+    queries.append(HistoryQuery::parse("÷ 1"));
+    HistoryQuery operation;
+    operation.operation = CalcOperation::Divide;
+    operation.rhs = 12;
+    queries.append(operation);
+    operation.rhs = std::numeric_limits<double>::quiet_NaN();
+    queries.append(operation);
+
+    for (const HistoryQuery& query : queries) {
+        QVector<int> rows;
+        for (int row = 0; row < m_history->count(); ++row) {
+            if (HistoryIndex::matches(query, m_history->entryAt(row))) {
+                rows.append(row);
+            }
+        }
+        QCOMPARE(rows, m_index->search(query));
+    }
+}
+
+QTEST_MAIN(TestHistoryIndex)
+#include "test_historyindex.moc"
@@ -0,0 +1,302 @@
+#include "historyjournal.h"
+#include "calculationhistory.h"
+#include <QtTest/QtTest>
+#include <QDir>
+#include <QFileInfo>
+#include <QTemporaryDir>
+#include <QtEndian>
+
+/**
+ * @brief Тесты для класса HistoryJournal
+ *
+ * Журнал проверяется через CalculationHistory, как его использует приложение,
+ * а восстановление после сбоя - порчей файла на диске.
+ */
+class TestHistoryJournal : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void init();
+
+    void testCrc32();
+    void testVarint();
+    void testRoundTrip();
+    void testTornTail();
+    void testCorruptedRecord();
+    void testCompaction();
+    void testFailedSnapshotRetried();
+    void testMigrationFromText();
+    void testClearIsPersisted();
+
+private:
+    QString journalPath() const;
+    static HistoryJournal::Options fastOptions();
+    static void fill(CalculationHistory& history, int count);
+
+private:
+    QScopedPointer<QTemporaryDir> m_directory;
+};
+
+void TestHistoryJournal::init()
+{
+    m_directory.reset(new QTemporaryDir());
+    QVERIFY(m_directory->isValid());
+}
+
+QString TestHistoryJournal::journalPath() const
+{
+    return m_directory->filePath("history.journal");
+}
+
+HistoryJournal::Options TestHistoryJournal::fastOptions()
+{
+    HistoryJournal::Options options;
+    options.flushInterval = 10;
+    options.syncInterval = 0;
+    return options;
+}
+
+void TestHistoryJournal::fill(CalculationHistory& history, int count)
+{
+    for (int i = 0; i < count; ++i) {
+        HistoryEntry entry;
+        entry.expression = QString("%1 × 2").arg(i);
+        entry.lhs = i;
+        entry.operation = CalcOperation::Multiply;
+        entry.rhs = 2.0;
+        entry.result = i * 2.0;
+        entry.resultPrecision = 10;
+        history.addEntry(entry);
+    }
+}
+
+void TestHistoryJournal::testCrc32()
+{
+    // Контрольное значение CRC-32 из стандарта
+    QCOMPARE(HistoryJournal::crc32("123456789", 9), 0xCBF43926u);
+    QCOMPARE(HistoryJournal::crc32("", 0), 0u);
+    QCOMPARE(HistoryJournal::crc32("The quick brown fox jumps over the lazy dog", 43), 0x414FA339u);
+}
+
+void TestHistoryJournal::testVarint()
+{
+    const quint64 values[] = { 0, 1, 127, 128, 300, 0xFFFFFFFFull, ~0ull };
+    QByteArray data;
+    for (quint64 value : values) {
+        HistoryJournal::appendVarint(value, data);
+    }
+    QCOMPARE(data.left(4), QByteArray("\x00\x01\x7f\x80", 4));
+
+    const char* pos = data.constData();
+    const char* end = pos + data.size();
+    for (quint64 expected : values) {
+        quint64 value = 0;
+        QVERIFY(HistoryJournal::readVarint(pos, end, value));
+        QCOMPARE(value, expected);
+    }
+    QCOMPARE(pos, end);
+
+    // Оборванное число не читается
+    const char* torn = data.constData() + 3;
+    quint64 value = 0;
+    QVERIFY(!HistoryJournal::readVarint(torn, torn + 1, value));
+}
+
+void TestHistoryJournal::testRoundTrip()
+{
+    {
+        CalculationHistory history;
+        QVERIFY(history.openJournal(journalPath(), fastOptions()));
+        fill(history, 3);
+        history.addEntry("√(9) = 3");
+    }
+    QVERIFY(HistoryJournal::isJournal(journalPath()));
+
+    CalculationHistory restored;
+    QVERIFY(restored.openJournal(journalPath(), fastOptions()));
+    QCOMPARE(restored.count(), 4);
+    QCOMPARE(restored.getLast(), QString("√(9) = 3"));
+
+    const HistoryEntry& entry = restored.entryAt(1);
+    QCOMPARE(entry.expression, QString("2 × 2"));
+    QCOMPARE(entry.operation, CalcOperation::Multiply);
+    QCOMPARE(entry.lhs, 2.0);
+    QCOMPARE(entry.rhs, 2.0);
+    QCOMPARE(entry.result, 4.0);
+    QVERIFY(entry.timestamp > 0);
+    QCOMPARE(entry.text(), QString("2 × 2 = 4"));
+}
+
+void TestHistoryJournal::testTornTail()
+{
+    {
+        CalculationHistory history;
+        QVERIFY(history.openJournal(journalPath(), fastOptions()));
+        fill(history, 3);
+    }
+
+    QFile file(journalPath());
+    const qint64 validSize = file.size();
+
+    // Сбой посреди записи кадра: заголовок обещает больше байт, чем есть в файле
+    QVERIFY(file.open(QIODevice::ReadWrite));
+    file.seek(validSize);
+    const char torn[] = { 100, 0, 0, 0, 1, 2, 3, 4, 5, 6 };
+    file.write(torn, sizeof(torn));
+    file.close();
+
+    CalculationHistory restored;
+    restored.loadFromFile(journalPath());
+    QCOMPARE(restored.count(), 3);
+    QCOMPARE(restored.getLast(), QString("2 × 2 = 4"));
+    QCOMPARE(QFile(journalPath()).size(), validSize);
+
+    // После обрезки журнал снова пригоден для дописывания
+    QVERIFY(restored.openJournal(journalPath(), fastOptions()));
+    fill(restored, 1);
+    restored.closeJournal();
+
+    CalculationHistory reopened;
+    reopened.loadFromFile(journalPath());
+    QCOMPARE(reopened.count(), 4);
+}
+
+void TestHistoryJournal::testCorruptedRecord()
+{
+    {
+        CalculationHistory history;
+        QVERIFY(history.openJournal(journalPath(), fastOptions()));
+        fill(history, 3);
+    }
+
+    QFile file(journalPath());
+    QVERIFY(file.open(QIODevice::ReadWrite));
+    QByteArray data = file.readAll();
+
+    // Порча последнего байта выражения во второй записи
+    const int firstFrame = HistoryJournal::HEADER_SIZE;
+    const int firstLength = qFromLittleEndian<quint32>(data.constData() + firstFrame);
+    const int secondFrame = firstFrame + HistoryJournal::FRAME_HEADER_SIZE + firstLength;
+    const int secondLength = qFromLittleEndian<quint32>(data.constData() + secondFrame);
+    data[secondFrame + HistoryJournal::FRAME_HEADER_SIZE + secondLength - 1] = '#';
+    file.seek(0);
+    file.write(data);
+    file.close();
+
+    int records = 0;
+    RingBuffer<HistoryEntry> entries(10);
+    QVERIFY(HistoryJournal::replay(journalPath(), entries, &records));
+    QCOMPARE(records, 1);
+    QCOMPARE(entries.size(), 1);
+    QCOMPARE(entries.first().expression, QString("0 × 2"));
+    QCOMPARE(QFile(journalPath()).size(), qint64(secondFrame));
+}
+
+void TestHistoryJournal::testCompaction()
+{
+    const int maxSize = 10;
+    const int added = 5000;
+    {
+        CalculationHistory history;
+        history.setMaxSize(maxSize);
+        QVERIFY(history.openJournal(journalPath(), fastOptions()));
+        fill(history, added);
+    }
+
+    // Файл не хранит все записи подряд: старые кадры сжимаются
+    int records = 0;
+    RingBuffer<HistoryEntry> entries(added);
+    QVERIFY(HistoryJournal::replay(journalPath(), entries, &records));
+    QVERIFY(records < added);
+
+    CalculationHistory restored;
+    restored.setMaxSize(maxSize);
+    restored.loadFromFile(journalPath());
+    QCOMPARE(restored.count(), maxSize);
+    QCOMPARE(restored.entryAt(0).lhs, double(added - 1));
+    QCOMPARE(restored.entries().first().lhs, double(added - maxSize));
+}
+
+void TestHistoryJournal::testFailedSnapshotRetried()
+{
+    const int maxSize = 5000;
+    const int beforeFailure = 100;
+    const int added = 1200;
+    const QString snapshotPath = HistoryJournal::snapshotFileName(journalPath());
+    {
+        CalculationHistory history;
+        history.setMaxSize(maxSize);
+        QVERIFY(history.openJournal(journalPath(), fastOptions()));
+        fill(history, beforeFailure);
+        history.flushJournal();
+
+        // Каталог на месте снимка: QSaveFile не может его заменить, сжатие не удается
+        QVERIFY(QDir().mkdir(snapshotPath));
+        fill(history, added);
+        history.flushJournal();
+        QVERIFY(QFileInfo(snapshotPath).isDir());
+
+        // Журнал остался прежнего поколения: записей после сжатия в нем нет
+        RingBuffer<HistoryEntry> entries(maxSize);
+        int records = 0;
+        QVERIFY(HistoryJournal::replay(journalPath(), entries, &records));
+        QVERIFY(records >= beforeFailure);
+        QVERIFY(records < beforeFailure + added);
+
+        QVERIFY(QDir().rmdir(snapshotPath));
+        fill(history, 10);
+    }
+
+    // Снимок и кадры после сжатия записаны при повторе, ни одна запись не потеряна
+    QVERIFY(QFileInfo(snapshotPath).isFile());
+    CalculationHistory restored;
+    restored.setMaxSize(maxSize);
+    restored.loadFromFile(journalPath());
+    QCOMPARE(restored.count(), beforeFailure + added + 10);
+    QCOMPARE(restored.entryAt(0).lhs, 9.0);
+    QCOMPARE(restored.entryAt(10).lhs, double(added - 1));
+    QCOMPARE(restored.entryAt(restored.count() - 1).lhs, 0.0);
+    QCOMPARE(restored.entryAt(10 + added).lhs, double(beforeFailure - 1));
+}
+
+void TestHistoryJournal::testMigrationFromText()
+{
+    const QString textPath = m_directory->filePath("history.txt");
+    {
+        CalculationHistory history;
+        history.addEntry("5 + 3 = 8");
+        history.addEntry("10 - 2 = 8");
+        history.saveToFile(textPath);
+    }
+
+    {
+        CalculationHistory history;
+        history.loadFromFile(textPath);
+        QVERIFY(history.openJournal(journalPath(), fastOptions()));
+    }
+
+    CalculationHistory restored;
+    restored.loadFromFile(journalPath());
+    QCOMPARE(restored.count(), 2);
+    QCOMPARE(restored.entryAt(0).result, 8.0);
+}
+
+void TestHistoryJournal::testClearIsPersisted()
+{
+    {
+        CalculationHistory history;
+        QVERIFY(history.openJournal(journalPath(), fastOptions()));
+        fill(history, 5);
+        history.clear();
+        fill(history, 1);
+    }
+
+    CalculationHistory restored;
+    restored.loadFromFile(journalPath());
+    QCOMPARE(restored.count(), 1);
+    QCOMPARE(restored.getLast(), QString("0 × 2 = 0"));
+}
+
+QTEST_MAIN(TestHistoryJournal)
+#include "test_historyjournal.moc"
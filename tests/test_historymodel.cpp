@@ -0,0 +1,203 @@
+#include "historymodel.h"
+#include "calculationhistory.h"
+#include <QtTest/QtTest>
+#include <QSignalSpy>
+
+/**
+ * @brief Тесты для класса HistoryModel
+ *
+ * Модель проверяется без представления: порядок строк, роли
+ * и пошаговые уведомления при изменении истории.
+ */
+class TestHistoryModel : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void init();
+    void cleanup();
+
+    void testNewestFirst();
+    void testStructuredRoles();
+    void testTextRoles();
+    void testSplitText();
+    void testIncrementalChanges();
+    void testFilter();
+    void testInsertFilterRows();
+    void testInvalidIndex();
+
+private:
+    CalculationHistory* m_history;
+    HistoryModel* m_model;
+};
+
+void TestHistoryModel::init()
+{
+    m_history = new CalculationHistory();
+    m_model = new HistoryModel(m_history);
+}
+
+void TestHistoryModel::cleanup()
+{
+    delete m_model;
+    delete m_history;
+}
+
+void TestHistoryModel::testNewestFirst()
+{
+    m_history->addEntry("1 + 1 = 2");
+    m_history->addEntry("2 + 2 = 4");
+    m_history->addEntry("3 + 3 = 6");
+
+    QCOMPARE(m_model->rowCount(), 3);
+    QCOMPARE(m_model->index(0).data().toString(), QString("3 + 3 = 6"));
+    QCOMPARE(m_model->index(2).data().toString(), QString("1 + 1 = 2"));
+    QCOMPARE(m_model->rowCount(m_model->index(0)), 0);
+}
+
+void TestHistoryModel::testStructuredRoles()
+{
+    HistoryEntry entry;
+    entry.expression = "10 ÷ 4";
+    entry.lhs = 10;
+    entry.operation = CalcOperation::Divide;
+    entry.rhs = 4;
+    entry.result = 2.5;
+    entry.resultPrecision = 10;
+    entry.timestamp = 123456;
+    m_history->addEntry(entry);
+
+    const QModelIndex index = m_model->index(0);
+    QCOMPARE(index.data(HistoryModel::ExpressionRole).toString(), QString("10 ÷ 4"));
+    QCOMPARE(index.data(HistoryModel::ResultRole).toString(), QString("2.5"));
+    QCOMPARE(index.data(HistoryModel::TimestampRole).toLongLong(), qint64(123456));
+    QCOMPARE(index.data(Qt::DisplayRole).toString(), QString("10 ÷ 4 = 2.5"));
+}
+
+void TestHistoryModel::testTextRoles()
+{
+    m_history->addEntry("√(16) = 4");
+    m_history->addEntry("без результата");
+
+    QCOMPARE(m_model->index(1).data(HistoryModel::ExpressionRole).toString(), QString("√(16)"));
+    QCOMPARE(m_model->index(1).data(HistoryModel::ResultRole).toString(), QString("4"));
+    QCOMPARE(m_model->index(0).data(HistoryModel::ExpressionRole).toString(),
+             QString("без результата"));
+    QVERIFY(m_model->index(0).data(HistoryModel::ResultRole).toString().isEmpty());
+}
+
+void TestHistoryModel::testSplitText()
+{
+    QString expression, result;
+    HistoryModel::splitText("(1 = 1) = 1", expression, result);
+    QCOMPARE(expression, QString("(1 = 1)"));
+    QCOMPARE(result, QString("1"));
+}
+
+void TestHistoryModel::testIncrementalChanges()
+{
+    m_history->setMaxSize(2);
+    QSignalSpy resetSpy(m_model, &HistoryModel::modelReset);
+    QSignalSpy insertSpy(m_model, &HistoryModel::rowsInserted);
+    QSignalSpy removeSpy(m_model, &HistoryModel::rowsRemoved);
+
+    m_history->addEntry("1 + 1 = 2");
+    QCOMPARE(insertSpy.count(), 1);
+    QCOMPARE(insertSpy.at(0).at(1).toInt(), 0);
+    QCOMPARE(insertSpy.at(0).at(2).toInt(), 0);
+    QCOMPARE(m_model->rowCount(), 1);
+
+    // Кэш строки не переживает изменение истории
+    QCOMPARE(m_model->index(0).data().toString(), QString("1 + 1 = 2"));
+    m_history->addEntry("2 + 2 = 4");
+    QCOMPARE(m_model->index(0).data().toString(), QString("2 + 2 = 4"));
+
+    // Переполнение: нижняя строка удаляется, новая вставляется сверху
+    m_history->addEntry("3 + 3 = 6");
+    QCOMPARE(removeSpy.count(), 1);
+    QCOMPARE(removeSpy.at(0).at(1).toInt(), 1);
+    QCOMPARE(removeSpy.at(0).at(2).toInt(), 1);
+    QCOMPARE(insertSpy.count(), 3);
+    QCOMPARE(m_model->rowCount(), 2);
+    QCOMPARE(m_model->index(1).data().toString(), QString("2 + 2 = 4"));
+    QCOMPARE(resetSpy.count(), 0);
+
+    m_history->clear();
+    QCOMPARE(resetSpy.count(), 1);
+    QCOMPARE(m_model->rowCount(), 0);
+}
+
+void TestHistoryModel::testFilter()
+{
+    m_history->setMaxSize(4);
+    m_history->addEntry("1 + 1 = 2");
+    m_history->addEntry("2 + 2 = 4");
+    m_history->addEntry("3 + 3 = 6");
+
+    m_model->setFilter(QVector<int>() << 0 << 2);
+    QVERIFY(m_model->isFiltered());
+    QCOMPARE(m_model->rowCount(), 2);
+    QCOMPARE(m_model->index(1).data().toString(), QString("1 + 1 = 2"));
+
+    // Новая запись не попадает в фильтр, строки показывают прежние записи
+    QSignalSpy insertSpy(m_model, &HistoryModel::rowsInserted);
+    m_history->addEntry("4 + 4 = 8");
+    QCOMPARE(insertSpy.count(), 0);
+    QCOMPARE(m_model->index(0).data().toString(), QString("3 + 3 = 6"));
+
+    // Вытесненная запись удаляется из фильтра
+    QSignalSpy removeSpy(m_model, &HistoryModel::rowsRemoved);
+    m_history->addEntry("5 + 5 = 10");
+    QCOMPARE(removeSpy.count(), 1);
+    QCOMPARE(m_model->rowCount(), 1);
+    QCOMPARE(m_model->index(0).data().toString(), QString("3 + 3 = 6"));
+
+    m_model->clearFilter();
+    QVERIFY(!m_model->isFiltered());
+    QCOMPARE(m_model->rowCount(), 4);
+}
+
+void TestHistoryModel::testInsertFilterRows()
+{
+    m_history->addEntry("1 + 1 = 2");
+    m_history->addEntry("2 × 2 = 4");
+    m_model->setFilter(QVector<int>() << 1);
+
+    QSignalSpy resetSpy(m_model, &HistoryModel::modelReset);
+    QSignalSpy insertSpy(m_model, &HistoryModel::rowsInserted);
+    QSignalSpy removeSpy(m_model, &HistoryModel::rowsRemoved);
+    m_history->addEntry("3 × 3 = 9");
+    m_history->addEntry("4 + 4 = 8");
+    // Новые записи - индексы 0 и 1, подошла только 0
+    m_model->insertFilterRows(QVector<int>() << 0);
+    QCOMPARE(insertSpy.count(), 1);
+    QCOMPARE(insertSpy.first().at(1).toInt(), 0);
+    QCOMPARE(insertSpy.first().at(2).toInt(), 0);
+    QCOMPARE(m_model->rowCount(), 2);
+    QCOMPARE(m_model->index(0).data().toString(), QString("4 + 4 = 8"));
+    QCOMPARE(m_model->index(1).data().toString(), QString("1 + 1 = 2"));
+
+    // Строки сверх предела удаляются снизу
+    m_history->addEntry("5 + 5 = 10");
+    m_model->insertFilterRows(QVector<int>() << 0, 2);
+    QCOMPARE(removeSpy.count(), 1);
+    QCOMPARE(m_model->rowCount(), 2);
+    QCOMPARE(m_model->index(1).data().toString(), QString("4 + 4 = 8"));
+    QCOMPARE(resetSpy.count(), 0);
+
+    // Без фильтра строки добавляет сама модель
+    m_model->clearFilter();
+    m_model->insertFilterRows(QVector<int>() << 0);
+    QCOMPARE(m_model->rowCount(), 5);
+}
+
+void TestHistoryModel::testInvalidIndex()
+{
+    m_history->addEntry("1 + 1 = 2");
+    QVERIFY(!m_model->data(QModelIndex()).isValid());
+    QVERIFY(!m_model->index(0).data(Qt::DecorationRole).isValid());
+    QVERIFY(!m_model->index(5).isValid());
+}
+
+QTEST_MAIN(TestHistoryModel)
+#include "test_historymodel.moc"
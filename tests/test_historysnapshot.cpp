@@ -0,0 +1,258 @@
+#include "historysnapshot.h"
+#include "historyjournal.h"
+#include "calculationhistory.h"
+#include <QtTest/QtTest>
+#include <QTemporaryDir>
+#include <QtEndian>
+
+/**
+ * @brief Тесты для класса HistorySnapshot
+ *
+ * Формат снимка проверяется напрямую, ленивая загрузка и поколения -
+ * через CalculationHistory с журналом.
+ */
+class TestHistorySnapshot : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void init();
+
+    void testRoundTrip();
+    void testTruncatedFileRejected();
+    void testCorruptedFrame();
+    void testLazyLoad();
+    void testStaleJournalIgnored();
+    void testMaxSizeTrimsArchive();
+
+private:
+    QString path(const QString& name) const;
+    static HistoryEntry makeEntry(int i);
+    static QByteArray makeFrames(int count);
+    static HistoryJournal::Options fastOptions();
+    void writeSnapshot(const QString& filename, int count);
+
+private:
+    QScopedPointer<QTemporaryDir> m_directory;
+};
+
+void TestHistorySnapshot::init()
+{
+    m_directory.reset(new QTemporaryDir());
+    QVERIFY(m_directory->isValid());
+}
+
+QString TestHistorySnapshot::path(const QString& name) const
+{
+    return m_directory->filePath(name);
+}
+
+HistoryEntry TestHistorySnapshot::makeEntry(int i)
+{
+    HistoryEntry entry;
+    entry.expression = QString("%1 + 1").arg(i);
+    entry.lhs = i;
+    entry.operation = CalcOperation::Add;
+    entry.rhs = 1.0;
+    entry.result = i + 1.0;
+    entry.resultPrecision = 10;
+    entry.timestamp = 1000 + i;
+    return entry;
+}
+
+QByteArray TestHistorySnapshot::makeFrames(int count)
+{
+    QByteArray frames;
+    for (int i = 0; i < count; ++i) {
+        HistoryJournal::appendFrame(makeEntry(i), frames);
+    }
+    return frames;
+}
+
+HistoryJournal::Options TestHistorySnapshot::fastOptions()
+{
+    HistoryJournal::Options options;
+    options.flushInterval = 10;
+    options.syncInterval = 0;
+    return options;
+}
+
+void TestHistorySnapshot::writeSnapshot(const QString& filename, int count)
+{
+    QFile file(filename);
+    QVERIFY(file.open(QIODevice::WriteOnly));
+    file.write(HistorySnapshot::serialize(7, makeFrames(count), count));
+}
+
+void TestHistorySnapshot::testRoundTrip()
+{
+    writeSnapshot(path("history.snapshot"), 3);
+    QVERIFY(HistorySnapshot::isSnapshot(path("history.snapshot")));
+
+    HistorySnapshot snapshot;
+    QVERIFY(snapshot.open(path("history.snapshot")));
+    QCOMPARE(snapshot.count(), 3);
+    QCOMPARE(snapshot.generation(), quint16(7));
+
+    for (int i = 0; i < 3; ++i) {
+        HistoryEntry entry;
+        QVERIFY(snapshot.entryAt(i, entry));
+        QCOMPARE(entry.expression, QString("%1 + 1").arg(i));
+        QCOMPARE(entry.result, i + 1.0);
+        QCOMPARE(entry.timestamp, qint64(1000 + i));
+    }
+
+    // Диапазон кадров совпадает с исходными байтами
+    const QByteArray all = makeFrames(3);
+    QCOMPARE(snapshot.frames(0, 3), all);
+    QCOMPARE(snapshot.frames(1, 1), QByteArray());
+    QVERIFY(all.endsWith(snapshot.frames(1, 3)));
+
+    // Снимок в памяти читается так же, как из файла
+    HistorySnapshot inMemory;
+    QVERIFY(inMemory.open(HistorySnapshot::serialize(8, all, 3)));
+    QCOMPARE(inMemory.generation(), quint16(8));
+    HistoryEntry entry;
+    QVERIFY(inMemory.entryAt(2, entry));
+    QCOMPARE(entry.lhs, 2.0);
+    QVERIFY(!inMemory.open(all));
+}
+
+void TestHistorySnapshot::testTruncatedFileRejected()
+{
+    writeSnapshot(path("history.snapshot"), 3);
+    QFile file(path("history.snapshot"));
+    QVERIFY(file.resize(file.size() - 1));
+
+    HistorySnapshot snapshot;
+    QVERIFY(!snapshot.open(path("history.snapshot")));
+    QVERIFY(!snapshot.isOpen());
+    QCOMPARE(snapshot.count(), 0);
+}
+
+void TestHistorySnapshot::testCorruptedFrame()
+{
+    writeSnapshot(path("history.snapshot"), 3);
+
+    // Порча текста выражения в первой записи
+    QFile file(path("history.snapshot"));
+    QVERIFY(file.open(QIODevice::ReadWrite));
+    file.seek(HistorySnapshot::HEADER_SIZE + HistoryJournal::FRAME_HEADER_SIZE
+              + HistoryJournal::FIXED_PAYLOAD_SIZE);
+    file.write("#", 1);
+    file.close();
+
+    HistorySnapshot snapshot;
+    QVERIFY(snapshot.open(path("history.snapshot")));
+    HistoryEntry entry;
+    QVERIFY(!snapshot.entryAt(0, entry));
+    QVERIFY(snapshot.entryAt(1, entry));
+    QCOMPARE(entry.lhs, 1.0);
+}
+
+void TestHistorySnapshot::testLazyLoad()
+{
+    const int added = 3000;
+    QStringList expected;
+    {
+        CalculationHistory history;
+        history.setMaxSize(added);
+        QVERIFY(history.openJournal(path("history.journal"), fastOptions()));
+        for (int i = 0; i < added; ++i) {
+            history.addEntry(makeEntry(i));
+        }
+        expected = history.getAll();
+    }
+    QVERIFY(HistorySnapshot::isSnapshot(HistoryJournal::snapshotFileName(path("history.journal"))));
+
+    CalculationHistory restored;
+    restored.setMaxSize(added);
+    QVERIFY(restored.openJournal(path("history.journal"), fastOptions()));
+    QCOMPARE(restored.count(), added);
+    // В памяти только журнал после последнего сжатия, снимок не разобран
+    QVERIFY(restored.entries().size() < added / 2);
+    QCOMPARE(restored.entryAt(added - 1).lhs, 0.0);
+    QCOMPARE(restored.getAll(), expected);
+
+    // Новая запись дописывается после старых, снимок остается на месте
+    restored.addEntry(makeEntry(added));
+    QCOMPARE(restored.count(), added);
+    QCOMPARE(restored.entryAt(0).lhs, double(added));
+    QCOMPARE(restored.entryAt(added - 1).lhs, 1.0);
+}
+
+void TestHistorySnapshot::testStaleJournalIgnored()
+{
+    const int added = 1100;
+    {
+        CalculationHistory history;
+        history.setMaxSize(added);
+        QVERIFY(history.openJournal(path("history.journal"), fastOptions()));
+        for (int i = 0; i < added; ++i) {
+            history.addEntry(makeEntry(i));
+        }
+    }
+
+    // Сбой между записью снимка и очисткой журнала: журнал прежнего поколения
+    QFile file(path("history.journal"));
+    QVERIFY(file.open(QIODevice::ReadWrite));
+    char header[HistoryJournal::HEADER_SIZE];
+    QCOMPARE(file.read(header, sizeof(header)), qint64(sizeof(header)));
+    const quint16 generation = qFromLittleEndian<quint16>(header + 6);
+    qToLittleEndian<quint16>(generation - 1, header + 6);
+    file.seek(0);
+    file.write(header, sizeof(header));
+    file.close();
+
+    HistorySnapshot snapshot;
+    QVERIFY(snapshot.open(HistoryJournal::snapshotFileName(path("history.journal"))));
+    const int snapshotCount = snapshot.count();
+    QVERIFY(snapshotCount > 0 && snapshotCount < added);
+    snapshot.close();
+
+    {
+        CalculationHistory restored;
+        restored.setMaxSize(added);
+        QVERIFY(restored.openJournal(path("history.journal"), fastOptions()));
+        QCOMPARE(restored.count(), snapshotCount);
+        restored.addEntry(makeEntry(added));
+    }
+
+    // После открытия журнал снова согласован со снимком
+    CalculationHistory reopened;
+    reopened.setMaxSize(added);
+    reopened.loadFromFile(path("history.journal"));
+    QCOMPARE(reopened.count(), snapshotCount + 1);
+    QCOMPARE(reopened.entryAt(0).lhs, double(added));
+}
+
+void TestHistorySnapshot::testMaxSizeTrimsArchive()
+{
+    const int added = 2000;
+    {
+        CalculationHistory history;
+        history.setMaxSize(added);
+        QVERIFY(history.openJournal(path("history.journal"), fastOptions()));
+        for (int i = 0; i < added; ++i) {
+            history.addEntry(makeEntry(i));
+        }
+    }
+
+    CalculationHistory restored;
+    restored.setMaxSize(added);
+    restored.loadFromFile(path("history.journal"));
+    QCOMPARE(restored.count(), added);
+
+    restored.setMaxSize(1500);
+    QCOMPARE(restored.count(), 1500);
+    QCOMPARE(restored.entryAt(0).lhs, double(added - 1));
+    QCOMPARE(restored.entryAt(1499).lhs, double(added - 1500));
+
+    // Переполнение вытесняет самые старые записи снимка
+    restored.addEntry(makeEntry(added));
+    QCOMPARE(restored.count(), 1500);
+    QCOMPARE(restored.entryAt(1499).lhs, double(added - 1499));
+}
+
+QTEST_MAIN(TestHistorySnapshot)
+#include "test_historysnapshot.moc"
@@ -0,0 +1,254 @@
+#include "keystrokelog.h"
+#include "calculationhistory.h"
+#include "memorymanager.h"
+#include <QtTest/QtTest>
+#include <QTemporaryDir>
+
+/**
+ * @brief Тесты для класса KeystrokeLog
+ *
+ * Кодирование всех типов событий, запись во время работы сеанса и прогон
+ * записанного журнала на новом сеансе, обнаружение расхождений,
+ * оборванный хвост и исходное значение памяти.
+ */
+class TestKeystrokeLog : public QObject
+{
+    Q_OBJECT
+
+    typedef CalculatorSession::Key Key;
+
+private slots:
+    void init();
+
+    void testEncodeDecode();
+    void testRecordAndReplay();
+    void testReplayDetectsMismatch();
+    void testTruncatedLog();
+    void testMemoryAtStart();
+
+private:
+    // Как MainWindow::press: клавиша, затем проверка, если на дисплее результат
+    static void press(CalculatorSession& session, KeystrokeLog::Recorder& recorder, Key key);
+    static void pressAll(CalculatorSession& session, KeystrokeLog::Recorder& recorder,
+                         const QString& keys);
+
+private:
+    QScopedPointer<QTemporaryDir> m_directory;
+};
+
+void TestKeystrokeLog::init()
+{
+    m_directory.reset(new QTemporaryDir());
+    QVERIFY(m_directory->isValid());
+}
+
+void TestKeystrokeLog::press(CalculatorSession& session, KeystrokeLog::Recorder& recorder,
+                             Key key)
+{
+    recorder.recordKey(key);
+    session.press(key);
+    if (session.isResultDisplayed()) {
+        recorder.recordCheck();
+    }
+}
+
+void TestKeystrokeLog::pressAll(CalculatorSession& session, KeystrokeLog::Recorder& recorder,
+                                const QString& keys)
+{
+    for (QChar c : keys) {
+        Key key;
+        QVERIFY(CalculatorSession::keyFromChar(c, key));
+        press(session, recorder, key);
+    }
+}
+
+void TestKeystrokeLog::testEncodeDecode()
+{
+    KeystrokeLog log;
+    KeystrokeLog::Event memory;
+    memory.type = KeystrokeLog::EventType::Memory;
+    memory.value = -2.5;
+    log.append(memory);
+
+    KeystrokeLog::Event key;
+    key.time = 150;
+    key.key = Key::MemoryStore;
+    log.append(key);
+
+    KeystrokeLog::Event value;
+    value.type = KeystrokeLog::EventType::Value;
+    value.time = 100000;
+    value.value = 1.0 / 3.0;
+    log.append(value);
+
+    KeystrokeLog::Event check;
+    check.type = KeystrokeLog::EventType::Check;
+    check.time = 100001;
+    check.display = "√ ошибка";
+    check.entries = 300;
+    check.expression = "12 × 3";
+    log.append(check);
+
+    const QByteArray data = log.encode();
+    // Тип и разность времени: 1 + 1 байт у памяти и проверки, 1 + 2 у нажатия,
+    // 1 + 3 у значения; числа по 8 байт; длины строк по байту, число записей - 2 байта
+    QCOMPARE(data.size(), KeystrokeLog::HEADER_SIZE + 10 + 3 + 12
+                              + 2 + 1 + int(check.display.toUtf8().size())
+                              + 2 + 1 + int(check.expression.toUtf8().size()));
+
+    KeystrokeLog decoded;
+    QVERIFY(decoded.decode(data));
+    QCOMPARE(decoded.count(), 4);
+    const QVector<KeystrokeLog::Event>& events = decoded.events();
+    QVERIFY(events.at(0).type == KeystrokeLog::EventType::Memory);
+    QCOMPARE(events.at(0).value, -2.5);
+    QVERIFY(events.at(1).key == Key::MemoryStore);
+    QCOMPARE(events.at(1).time, qint64(150));
+    QCOMPARE(events.at(2).value, 1.0 / 3.0);
+    QCOMPARE(events.at(2).time, qint64(100000));
+    QVERIFY(events.at(3).type == KeystrokeLog::EventType::Check);
+    QCOMPARE(events.at(3).display, check.display);
+    QCOMPARE(events.at(3).entries, quint64(300));
+    QCOMPARE(events.at(3).expression, check.expression);
+
+    const QString filename = m_directory->filePath("keys.log");
+    QVERIFY(log.save(filename));
+    QVERIFY(KeystrokeLog::isKeystrokeLog(filename));
+    KeystrokeLog loaded;
+    QVERIFY(loaded.load(filename));
+    QCOMPARE(loaded.encode(), data);
+}
+
+void TestKeystrokeLog::testRecordAndReplay()
+{
+    const QString filename = m_directory->filePath("keys.log");
+    {
+        CalculationHistory history;
+        MemoryManager memory;
+        CalculatorSession session(&history, &memory);
+        // Записи, сделанные до начала журнала, при прогоне не учитываются
+        history.addEntry("1 + 1", 2.0);
+
+        KeystrokeLog::Recorder recorder;
+        QVERIFY(recorder.open(filename, &session));
+        pressAll(session, recorder, "12.5+7*3=");
+        press(session, recorder, Key::SquareRoot);
+        press(session, recorder, Key::MemoryStore);
+        pressAll(session, recorder, "5/0=");
+        press(session, recorder, Key::Clear);
+        recorder.recordValue(42.0);
+        session.showValue(42.0);
+        recorder.recordCheck();
+        pressAll(session, recorder, "+8");
+        recorder.close();
+        QVERIFY(!recorder.isOpen());
+    }
+
+    KeystrokeLog log;
+    QVERIFY(log.load(filename));
+
+    CalculationHistory history;
+    MemoryManager memory;
+    CalculatorSession session(&history, &memory);
+    const KeystrokeLog::ReplayResult result = log.replay(session);
+    QVERIFY2(result.passed(), qPrintable(result.expected + " / " + result.actual));
+    QCOMPARE(result.keys, 18);
+    // Результаты "=" и √, MS при результате на дисплее, ошибка, значение из списка
+    // и итоговая
+    QCOMPARE(result.checks, 6);
+    QCOMPARE(session.displayText(), QString("8"));
+    // 12.5 + 7 при нажатии "×", затем "=", √ и отложенное "×" при нажатии "÷"
+    QCOMPARE(history.count(), 4);
+
+    // Повторный прогон на том же сеансе дает то же самое
+    QVERIFY(log.replay(session).passed());
+    QCOMPARE(history.count(), 8);
+}
+
+void TestKeystrokeLog::testReplayDetectsMismatch()
+{
+    CalculationHistory history;
+    CalculatorSession session(&history);
+    KeystrokeLog log;
+
+    const Key keys[] = { Key::Digit6, Key::Multiply, Key::Digit7, Key::Equals };
+    for (Key key : keys) {
+        KeystrokeLog::Event event;
+        event.key = key;
+        log.append(event);
+        session.press(key);
+    }
+    KeystrokeLog::Event check = KeystrokeLog::checkpoint(session, 0);
+    QCOMPARE(check.display, QString("42"));
+    QCOMPARE(check.entries, quint64(1));
+    QCOMPARE(check.expression, QString("6 × 7"));
+
+    check.expression = "6 × 8";
+    log.append(check);
+    KeystrokeLog::ReplayResult result = log.replay(session);
+    QVERIFY(!result.passed());
+    QCOMPARE(result.failedEvent, 4);
+    QVERIFY(result.expected.contains("6 × 8"));
+    QVERIFY(result.actual.contains("6 × 7"));
+
+    // Без истории сверяется только дисплей
+    CalculatorSession withoutHistory;
+    QVERIFY(log.replay(withoutHistory).passed());
+}
+
+void TestKeystrokeLog::testTruncatedLog()
+{
+    KeystrokeLog log;
+    for (int i = 0; i < 3; ++i) {
+        KeystrokeLog::Event event;
+        event.key = CalculatorSession::digitKey(i);
+        event.time = i * 200;
+        log.append(event);
+    }
+    KeystrokeLog::Event check;
+    check.type = KeystrokeLog::EventType::Check;
+    check.time = 700;
+    check.display = "12";
+    log.append(check);
+    const QByteArray data = log.encode();
+
+    // Оборванное последнее событие отбрасывается
+    KeystrokeLog decoded;
+    QVERIFY(decoded.decode(data.left(data.size() - 1)));
+    QCOMPARE(decoded.count(), 3);
+    QVERIFY(decoded.decode(data.left(KeystrokeLog::HEADER_SIZE)));
+    QCOMPARE(decoded.count(), 0);
+
+    // Неизвестный тип события и чужой заголовок - не журнал
+    QByteArray corrupted = data;
+    corrupted[KeystrokeLog::HEADER_SIZE + 2] = char(0x90);
+    QVERIFY(!decoded.decode(corrupted));
+    QCOMPARE(decoded.count(), 0);
+    QVERIFY(!decoded.decode(QByteArray("CHAR\x01\x00\x00\x00", 8)));
+    QVERIFY(!decoded.decode(QByteArray("CKEY")));
+}
+
+void TestKeystrokeLog::testMemoryAtStart()
+{
+    const QString filename = m_directory->filePath("keys.log");
+    {
+        MemoryManager memory;
+        memory.store(7.0);
+        CalculatorSession session(nullptr, &memory);
+        KeystrokeLog::Recorder recorder;
+        QVERIFY(recorder.open(filename, &session));
+        press(session, recorder, Key::MemoryRecall);
+        recorder.close();
+    }
+
+    KeystrokeLog log;
+    QVERIFY(log.load(filename));
+    MemoryManager memory;
+    CalculatorSession session(nullptr, &memory);
+    QVERIFY(log.replay(session).passed());
+    QCOMPARE(session.displayText(), QString("7"));
+    QCOMPARE(memory.value(), 7.0);
+}
+
+QTEST_MAIN(TestKeystrokeLog)
+#include "test_keystrokelog.moc"
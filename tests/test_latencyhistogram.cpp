@@ -0,0 +1,132 @@
+#include "latencyhistogram.h"
+#include <QtTest/QtTest>
+#include <QJsonArray>
+#include <algorithm>
+#include <random>
+
+/**
+ * @brief Тесты для класса LatencyHistogram
+ *
+ * Границы корзин, погрешность процентилей против точной сортировки,
+ * объединение, значения за пределами диапазона и JSON.
+ */
+class TestLatencyHistogram : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void testEmpty();
+    void testBuckets();
+    void testPercentiles();
+    void testMerge();
+    void testClamp();
+    void testJson();
+};
+
+void TestLatencyHistogram::testEmpty()
+{
+    LatencyHistogram histogram;
+    QCOMPARE(histogram.count(), qint64(0));
+    QCOMPARE(histogram.valueAtPercentile(99.0), qint64(0));
+    QCOMPARE(histogram.mean(), 0.0);
+}
+
+void TestLatencyHistogram::testBuckets()
+{
+    // Малые значения - каждое в своей корзине
+    QCOMPARE(LatencyHistogram::bucketIndex(0), 0);
+    QCOMPARE(LatencyHistogram::bucketIndex(255), 255);
+    QCOMPARE(LatencyHistogram::bucketIndex(256), 256);
+    QCOMPARE(LatencyHistogram::bucketIndex(257), 256);
+    QCOMPARE(LatencyHistogram::bucketIndex(LatencyHistogram::MAX_VALUE),
+             LatencyHistogram::BUCKET_COUNT - 1);
+
+    // Корзины идут подряд без пропусков и перекрытий
+    for (int i = 1; i < LatencyHistogram::BUCKET_COUNT; ++i) {
+        QCOMPARE(LatencyHistogram::bucketLowest(i), LatencyHistogram::bucketHighest(i - 1) + 1);
+        QCOMPARE(LatencyHistogram::bucketIndex(LatencyHistogram::bucketLowest(i)), i);
+        QCOMPARE(LatencyHistogram::bucketIndex(LatencyHistogram::bucketHighest(i)), i);
+    }
+    QCOMPARE(LatencyHistogram::bucketHighest(LatencyHistogram::BUCKET_COUNT - 1),
+             LatencyHistogram::MAX_VALUE);
+}
+
+void TestLatencyHistogram::testPercentiles()
+{
+    // Задержки от 50 мкс до 200 мс с тяжелым хвостом
+    std::mt19937_64 generator(42);
+    std::lognormal_distribution<double> distribution(std::log(2e6), 1.0);
+    QVector<qint64> values;
+    LatencyHistogram histogram;
+    for (int i = 0; i < 20000; ++i) {
+        const qint64 value = qBound<qint64>(50000, qint64(distribution(generator)), 200000000);
+        values.append(value);
+        histogram.record(value);
+    }
+    std::sort(values.begin(), values.end());
+
+    QCOMPARE(histogram.count(), qint64(values.size()));
+    QCOMPARE(histogram.min(), values.first());
+    QCOMPARE(histogram.max(), values.last());
+    const double percentiles[] = { 0.0, 50.0, 90.0, 99.0, 99.9, 100.0 };
+    for (double percentile : percentiles) {
+        const int rank = qMax(1, int(std::ceil(percentile / 100.0 * values.size())));
+        const qint64 exact = values.at(rank - 1);
+        const qint64 estimate = histogram.valueAtPercentile(percentile);
+        QVERIFY2(estimate >= exact && estimate - exact <= exact / 128 + 1,
+                 qPrintable(QString("%1: %2 / %3").arg(percentile).arg(estimate).arg(exact)));
+    }
+}
+
+void TestLatencyHistogram::testMerge()
+{
+    LatencyHistogram fast;
+    LatencyHistogram slow;
+    for (int i = 1; i <= 100; ++i) {
+        fast.record(i);
+        slow.record(i * 1000000);
+    }
+
+    LatencyHistogram total;
+    total.merge(fast);
+    total.merge(slow);
+    QCOMPARE(total.count(), qint64(200));
+    QCOMPARE(total.min(), qint64(1));
+    QCOMPARE(total.max(), qint64(100000000));
+    QCOMPARE(total.valueAtPercentile(50.0), qint64(100));
+    QCOMPARE(total.mean(), (fast.mean() + slow.mean()) / 2.0);
+
+    total.reset();
+    QCOMPARE(total.count(), qint64(0));
+    QCOMPARE(total.max(), qint64(0));
+}
+
+void TestLatencyHistogram::testClamp()
+{
+    LatencyHistogram histogram;
+    histogram.record(-5);
+    histogram.record(LatencyHistogram::MAX_VALUE * 4);
+    QCOMPARE(histogram.min(), qint64(0));
+    QCOMPARE(histogram.max(), LatencyHistogram::MAX_VALUE);
+    QCOMPARE(histogram.valueAtPercentile(100.0), LatencyHistogram::MAX_VALUE);
+}
+
+void TestLatencyHistogram::testJson()
+{
+    LatencyHistogram histogram;
+    histogram.record(10);
+    histogram.record(10);
+    histogram.record(1000);
+
+    const QJsonObject json = histogram.toJson();
+    QCOMPARE(json["count"].toInt(), 3);
+    QCOMPARE(json["p50"].toInt(), 10);
+    QCOMPARE(json["max"].toInt(), 1000);
+    const QJsonArray buckets = json["buckets"].toArray();
+    QCOMPARE(buckets.size(), 2);
+    QCOMPARE(buckets.at(0).toArray().at(1).toInt(), 2);
+    QCOMPARE(buckets.at(1).toArray().at(0).toInt(), 1000);
+}
+
+QTEST_MAIN(TestLatencyHistogram)
+#include "test_latencyhistogram.moc"
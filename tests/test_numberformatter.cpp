@@ -0,0 +1,181 @@
+#include "numberformatter.h"
+#include <QtTest/QtTest>
+#include <limits>
+
+/**
+ * @brief Тесты для класса NumberFormatter
+ *
+ * formatGeneral сверяется с QString::number(value, 'g', precision),
+ * formatShortest - по кратчайшему обратимому представлению.
+ */
+class TestNumberFormatter : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void testShortestDigits();
+    void testFormatShortest();
+    void testShortestRoundTrip();
+    void testGeneralMatchesQt();
+    void testGeneralTies();
+    void testSpecialValues();
+    void testUtf8Buffer();
+
+private:
+    static QString shortest(double value);
+    static QString general(double value, int precision);
+    static QVector<double> sampleValues();
+};
+
+QString TestNumberFormatter::shortest(double value)
+{
+    QChar buffer[NumberFormatter::BUFFER_SIZE];
+    const int length = NumberFormatter::formatShortest(value, buffer);
+    return QString(buffer, length);
+}
+
+QString TestNumberFormatter::general(double value, int precision)
+{
+    QChar buffer[NumberFormatter::BUFFER_SIZE];
+    const int length = NumberFormatter::formatGeneral(value, precision, buffer);
+    return QString(buffer, length);
+}
+
+QVector<double> TestNumberFormatter::sampleValues()
+{
+    QVector<double> values;
+    values << 0.0 << 1.0 << -1.0 << 0.1 << 0.2 << 0.3 << 0.1 + 0.2 << 1.0 / 3.0
+           << 2.0 / 3.0 << 100.0 << 123456789.0 << 1234567890123.0 << 1e15 << 1e16
+           << 1e17 << 1e21 << 1e22 << 1e-4 << 1e-5 << 1.5e-7 << 0.000123456789
+           << 9.999999999e9 << 99999.99999 << 3.14159265358979 << -2.718281828459045
+           << 1.7976931348623157e308 << 2.2250738585072014e-308 << 5e-324 << 9007199254740993.0;
+
+    // Детерминированный набор "неудобных" значений: частные случайных целых
+    quint64 state = 12345;
+    for (int i = 0; i < 2000; ++i) {
+        state = state * Q_UINT64_C(6364136223846793005) + Q_UINT64_C(1442695040888963407);
+        const double numerator = static_cast<double>(static_cast<qint64>(state >> 11) % 2000001 - 1000000);
+        const double denominator = static_cast<double>((state >> 40) % 9999 + 1);
+        const int scale = static_cast<int>((state >> 20) % 41) - 20;
+        values << numerator / denominator * std::pow(10.0, scale);
+    }
+    return values;
+}
+
+void TestNumberFormatter::testShortestDigits()
+{
+    NumberFormatter::Digits digits;
+    QVERIFY(NumberFormatter::shortestDigits(0.3, digits));
+    QCOMPARE(digits.significand, Q_UINT64_C(3));
+    QCOMPARE(digits.exponent, -1);
+    QCOMPARE(digits.digitCount, 1);
+    QVERIFY(!digits.negative);
+
+    QVERIFY(NumberFormatter::shortestDigits(-123.456, digits));
+    QCOMPARE(digits.significand, Q_UINT64_C(123456));
+    QCOMPARE(digits.exponent, -3);
+    QCOMPARE(digits.digitCount, 6);
+    QVERIFY(digits.negative);
+
+    QVERIFY(NumberFormatter::shortestDigits(1200.0, digits));
+    QCOMPARE(digits.significand, Q_UINT64_C(12));
+    QCOMPARE(digits.exponent, 2);
+
+    QVERIFY(NumberFormatter::shortestDigits(0.0, digits));
+    QCOMPARE(digits.significand, Q_UINT64_C(0));
+    QCOMPARE(digits.digitCount, 1);
+
+    QVERIFY(!NumberFormatter::shortestDigits(std::numeric_limits<double>::infinity(), digits));
+    QVERIFY(!NumberFormatter::shortestDigits(std::numeric_limits<double>::quiet_NaN(), digits));
+}
+
+void TestNumberFormatter::testFormatShortest()
+{
+    QCOMPARE(shortest(0.1), QString("0.1"));
+    QCOMPARE(shortest(0.1 + 0.2), QString("0.30000000000000004"));
+    QCOMPARE(shortest(1.0 / 3.0), QString("0.3333333333333333"));
+    QCOMPARE(shortest(100.0), QString("100"));
+    QCOMPARE(shortest(-2.5), QString("-2.5"));
+    QCOMPARE(shortest(1e16), QString("10000000000000000"));
+    QCOMPARE(shortest(1e17), QString("1e+17"));
+    QCOMPARE(shortest(1e21), QString("1e+21"));
+    QCOMPARE(shortest(1e-4), QString("0.0001"));
+    QCOMPARE(shortest(1e-5), QString("1e-05"));
+    QCOMPARE(shortest(5e-324), QString("5e-324"));
+    QCOMPARE(shortest(1.7976931348623157e308), QString("1.7976931348623157e+308"));
+    QCOMPARE(shortest(-0.0), QString("-0"));
+}
+
+void TestNumberFormatter::testShortestRoundTrip()
+{
+    const QVector<double> values = sampleValues();
+    for (double value : values) {
+        const QString text = shortest(value);
+        bool ok = false;
+        QCOMPARE(text.toDouble(&ok), value);
+        QVERIFY(ok);
+
+        // Минимальность: на одну цифру меньше значение уже не восстанавливается
+        NumberFormatter::Digits digits;
+        NumberFormatter::shortestDigits(value, digits);
+        if (digits.digitCount > 1) {
+            const QString shorter = QString::number(value, 'g', digits.digitCount - 1);
+            QVERIFY2(shorter.toDouble() != value, qPrintable(text));
+        }
+    }
+}
+
+void TestNumberFormatter::testGeneralMatchesQt()
+{
+    const QVector<double> values = sampleValues();
+    for (double value : values) {
+        for (int precision = 1; precision <= 17; ++precision) {
+            QCOMPARE(general(value, precision), QString::number(value, 'g', precision));
+        }
+    }
+}
+
+void TestNumberFormatter::testGeneralTies()
+{
+    // Точные середины решаются по точному значению, а не по кратчайшим цифрам
+    QCOMPARE(general(2.5, 1), QString::number(2.5, 'g', 1));
+    QCOMPARE(general(0.125, 2), QString::number(0.125, 'g', 2));
+    QCOMPARE(general(0.15, 1), QString::number(0.15, 'g', 1));
+    QCOMPARE(general(1.0000000005, 10), QString::number(1.0000000005, 'g', 10));
+    QCOMPARE(general(0.15, 1), QString("0.1"));
+
+    // Перенос разряда при округлении вверх
+    QCOMPARE(general(9.9999999999, 10), QString("10"));
+    QCOMPARE(general(999999.7, 6), QString("1e+06"));
+}
+
+void TestNumberFormatter::testSpecialValues()
+{
+    const double inf = std::numeric_limits<double>::infinity();
+    const double nan = std::numeric_limits<double>::quiet_NaN();
+
+    QCOMPARE(shortest(inf), QString("inf"));
+    QCOMPARE(shortest(-inf), QString("-inf"));
+    QCOMPARE(shortest(nan), QString("nan"));
+
+    QCOMPARE(general(inf, 10), QString::number(inf, 'g', 10));
+    QCOMPARE(general(nan, 10), QString::number(nan, 'g', 10));
+    QCOMPARE(general(-0.0, 10), QString::number(-0.0, 'g', 10));
+    QCOMPARE(general(0.0, 10), QString("0"));
+}
+
+void TestNumberFormatter::testUtf8Buffer()
+{
+    const QVector<double> values = sampleValues();
+    char buffer[NumberFormatter::BUFFER_SIZE];
+    for (double value : values) {
+        int length = NumberFormatter::formatGeneral(value, 10, buffer);
+        QCOMPARE(QByteArray(buffer, length), QByteArray::number(value, 'g', 10));
+
+        length = NumberFormatter::formatShortest(value, buffer);
+        QCOMPARE(QString::fromLatin1(QByteArray(buffer, length)), shortest(value));
+    }
+}
+
+QTEST_MAIN(TestNumberFormatter)
+#include "test_numberformatter.moc"
@@ -0,0 +1,196 @@
+#include "numberparser.h"
+#include "numberformatter.h"
+#include <QtTest/QtTest>
+#include <cstring>
+#include <limits>
+
+/**
+ * @brief Тесты для класса NumberParser
+ *
+ * Результат сверяется с QString::toDouble побитово: корректное округление
+ * не допускает расхождений ни в одном последнем бите.
+ */
+class TestNumberParser : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void testSimpleNumbers();
+    void testMatchesQt();
+    void testHalfwayCases();
+    void testLongMantissa();
+    void testRangeLimits();
+    void testInvalidInput();
+    void testParsePrefix();
+    void testDecimalToDouble();
+
+private:
+    static bool sameBits(double a, double b);
+    static double parse(const QString& text, bool* ok = nullptr);
+};
+
+bool TestNumberParser::sameBits(double a, double b)
+{
+    return std::memcmp(&a, &b, sizeof(double)) == 0;
+}
+
+double TestNumberParser::parse(const QString& text, bool* ok)
+{
+    // QChar и 8-битный варианты обязаны совпадать
+    const QByteArray latin1 = text.toLatin1();
+    bool latin1Ok = false;
+    const double latin1Value = NumberParser::toDouble(latin1.constData(),
+                                                      latin1.constData() + latin1.size(), &latin1Ok);
+    bool textOk = false;
+    const double value = NumberParser::toDouble(text, &textOk);
+    if (!sameBits(value, latin1Value) || textOk != latin1Ok) {
+        qWarning("Варианты разбора расходятся для %s", qPrintable(text));
+        return -1.0;
+    }
+    if (ok) {
+        *ok = textOk;
+    }
+    return value;
+}
+
+void TestNumberParser::testSimpleNumbers()
+{
+    bool ok = false;
+    QCOMPARE(parse("0", &ok), 0.0);
+    QVERIFY(ok);
+    QCOMPARE(parse("42", &ok), 42.0);
+    QVERIFY(ok);
+    QCOMPARE(parse("-3.5"), -3.5);
+    QCOMPARE(parse("+3.5"), 3.5);
+    QCOMPARE(parse("0.1"), 0.1);
+    QCOMPARE(parse(".5"), 0.5);
+    QCOMPARE(parse("5."), 5.0);
+    QCOMPARE(parse("1e3"), 1000.0);
+    QCOMPARE(parse("1E-3"), 0.001);
+    QCOMPARE(parse("2.5e+2"), 250.0);
+    QCOMPARE(parse("  12.25\t"), 12.25);
+    QCOMPARE(parse("000123.4500"), 123.45);
+    QVERIFY(sameBits(parse("-0"), -0.0));
+}
+
+void TestNumberParser::testMatchesQt()
+{
+    // Детерминированный набор: кратчайшие и 'g'-представления случайных double
+    quint64 state = 2024;
+    for (int i = 0; i < 5000; ++i) {
+        state = state * Q_UINT64_C(6364136223846793005) + Q_UINT64_C(1442695040888963407);
+        double value = 0.0;
+        const quint64 bits = state & ~(Q_UINT64_C(1) << 63);
+        std::memcpy(&value, &bits, sizeof(value));
+        if (!qIsFinite(value)) {
+            continue;
+        }
+
+        char buffer[NumberFormatter::BUFFER_SIZE];
+        const QString shortest = QString::fromLatin1(
+            buffer, NumberFormatter::formatShortest(value, buffer));
+        QVERIFY2(sameBits(parse(shortest), value), qPrintable(shortest));
+
+        const QString general = QString::number(value, 'g', static_cast<int>(state >> 59) + 1);
+        QVERIFY2(sameBits(parse(general), general.toDouble()), qPrintable(general));
+    }
+}
+
+void TestNumberParser::testHalfwayCases()
+{
+    // Точная середина между соседними double: округление к четному
+    QVERIFY(sameBits(parse("9007199254740993"), 9007199254740992.0));
+    QVERIFY(sameBits(parse("9007199254740995"), 9007199254740996.0));
+    QVERIFY(sameBits(parse("9007199254740993.0000000000000000001"), 9007199254740994.0));
+    QVERIFY(sameBits(parse("1.00000000000000011102230246251565404236316680908203125"), 1.0));
+    QVERIFY(sameBits(parse("1.00000000000000011102230246251565404236316680908203126"),
+                     1.0000000000000002));
+}
+
+void TestNumberParser::testLongMantissa()
+{
+    const QString digits = "123456789012345678901234567890123456789";
+    QVERIFY(sameBits(parse(digits), digits.toDouble()));
+    QVERIFY(sameBits(parse("0." + digits), ("0." + digits).toDouble()));
+    QVERIFY(sameBits(parse(digits + "e-60"), (digits + "e-60").toDouble()));
+    QVERIFY(sameBits(parse("0.000000000000000000000000000001"), 1e-30));
+}
+
+void TestNumberParser::testRangeLimits()
+{
+    bool ok = false;
+    QVERIFY(sameBits(parse("1.7976931348623157e308", &ok), std::numeric_limits<double>::max()));
+    QVERIFY(ok);
+    QVERIFY(sameBits(parse("2.2250738585072014e-308", &ok), std::numeric_limits<double>::min()));
+    QVERIFY(ok);
+    QVERIFY(sameBits(parse("4.9406564584124654e-324", &ok), std::numeric_limits<double>::denorm_min()));
+    QVERIFY(ok);
+
+    QVERIFY(qIsInf(parse("1e400", &ok)));
+    QVERIFY(!ok);
+    QCOMPARE(parse("1e-400", &ok), 0.0);
+    QVERIFY(!ok);
+    QCOMPARE(parse("0e999999", &ok), 0.0);
+    QVERIFY(ok);
+
+    QVERIFY(qIsInf(parse("inf", &ok)));
+    QVERIFY(ok);
+    QVERIFY(parse("-inf") < 0.0);
+    QVERIFY(qIsNaN(parse("nan", &ok)));
+    QVERIFY(ok);
+}
+
+void TestNumberParser::testInvalidInput()
+{
+    const char* invalid[] = { "", " ", "-", ".", "e5", "1e", "1e+", "1.2.3", "12abc",
+                              "1 2", "--1", "0x10", "1,5", "infinity" };
+    for (const char* text : invalid) {
+        bool ok = true;
+        QCOMPARE(parse(text, &ok), 0.0);
+        QVERIFY2(!ok, text);
+    }
+}
+
+void TestNumberParser::testParsePrefix()
+{
+    const QString text = "12.5e2+3e*4";
+    const QChar* begin = text.constData();
+    const QChar* end = begin + text.size();
+
+    double value = 0.0;
+    bool ok = false;
+    const QChar* pos = NumberParser::parsePrefix(begin, end, value, &ok);
+    QCOMPARE(pos - begin, 6);
+    QCOMPARE(value, 1250.0);
+    QVERIFY(ok);
+
+    // "e" без цифр порядка в число не входит
+    pos = NumberParser::parsePrefix(pos + 1, end, value, &ok);
+    QCOMPARE(pos - begin, 8);
+    QCOMPARE(value, 3.0);
+
+    // Одна буква e - не число
+    QVERIFY(NumberParser::parsePrefix(pos, end, value, &ok) == pos);
+    QVERIFY(!ok);
+}
+
+void TestNumberParser::testDecimalToDouble()
+{
+    double value = 0.0;
+    QVERIFY(NumberParser::decimalToDouble(Q_UINT64_C(1), -1, false, false, value));
+    QCOMPARE(value, 0.1);
+    QVERIFY(NumberParser::decimalToDouble(Q_UINT64_C(25), 0, true, false, value));
+    QCOMPARE(value, -25.0);
+    QVERIFY(NumberParser::decimalToDouble(Q_UINT64_C(17976931348623157), 292, false, false, value));
+    QCOMPARE(value, std::numeric_limits<double>::max());
+
+    // Отброшенный хвост не влияет на результат
+    QVERIFY(NumberParser::decimalToDouble(Q_UINT64_C(1000000000000000000), -18, false, true, value));
+    QCOMPARE(value, 1.0);
+
+    // Середина 2^53 + 1: хвост решает, куда округлять
+    QVERIFY(!NumberParser::decimalToDouble(Q_UINT64_C(9007199254740993), 0, false, true, value));
+}
+
+QTEST_MAIN(TestNumberParser)
+#include "test_numberparser.moc"
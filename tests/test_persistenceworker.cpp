@@ -0,0 +1,161 @@
+#include "persistenceworker.h"
+#include "calculationhistory.h"
+#include <QtTest/QtTest>
+#include <QAtomicInt>
+#include <QTemporaryDir>
+#include <QThread>
+
+/**
+ * @brief Тесты для класса PersistenceWorker
+ *
+ * Порядок и поток выполнения задач, слияние задач с одним ключом,
+ * сброс очереди при flush() и в деструкторе, запись истории в фоне.
+ */
+class TestPersistenceWorker : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void testRunsInBackground();
+    void testOrder();
+    void testCoalescing();
+    void testDebounceExpires();
+    void testKeyedOvertaken();
+    void testDestructorFlushes();
+    void testHistoryInBackground();
+};
+
+void TestPersistenceWorker::testRunsInBackground()
+{
+    PersistenceWorker worker;
+    Qt::HANDLE taskThread = nullptr;
+    worker.post([&taskThread]() {
+        taskThread = QThread::currentThreadId();
+    });
+    worker.flush();
+    QVERIFY(taskThread != nullptr);
+    QVERIFY(taskThread != QThread::currentThreadId());
+}
+
+void TestPersistenceWorker::testOrder()
+{
+    PersistenceWorker worker;
+    QList<int> order;
+    for (int i = 0; i < 100; ++i) {
+        worker.post([&order, i]() {
+            order.append(i);
+        });
+    }
+    worker.flush();
+    QCOMPARE(order.size(), 100);
+    for (int i = 0; i < order.size(); ++i) {
+        QCOMPARE(order.at(i), i);
+    }
+    QCOMPARE(worker.pendingCount(), 0);
+}
+
+void TestPersistenceWorker::testCoalescing()
+{
+    // Срок заведомо больше теста: задача выполняется только по flush()
+    PersistenceWorker worker(60000);
+    QAtomicInt runs;
+    QAtomicInt lastValue(-1);
+    for (int i = 0; i < 100; ++i) {
+        worker.post("settings", [&runs, &lastValue, i]() {
+            runs.fetchAndAddOrdered(1);
+            lastValue.fetchAndStoreOrdered(i);
+        });
+    }
+    QCOMPARE(worker.pendingCount(), 1);
+
+    QTest::qWait(50);
+    QCOMPARE(runs.loadAcquire(), 0);
+
+    worker.flush();
+    QCOMPARE(runs.loadAcquire(), 1);
+    QCOMPARE(lastValue.loadAcquire(), 99);
+}
+
+void TestPersistenceWorker::testDebounceExpires()
+{
+    PersistenceWorker worker(20);
+    QAtomicInt runs;
+    worker.post("theme", [&runs]() {
+        runs.fetchAndAddOrdered(1);
+    });
+    QTRY_COMPARE(runs.loadAcquire(), 1);
+    QCOMPARE(worker.pendingCount(), 0);
+}
+
+void TestPersistenceWorker::testKeyedOvertaken()
+{
+    PersistenceWorker worker(60000);
+    QList<int> order;
+    QAtomicInt runs;
+    worker.post("settings", [&order, &runs]() {
+        order.append(1);
+        runs.fetchAndAddOrdered(1);
+    });
+    worker.post([&order, &runs]() {
+        order.append(2);
+        runs.fetchAndAddOrdered(1);
+    });
+
+    // Задача без ключа не ждет срока отложенной задачи, поставленной раньше
+    QTRY_COMPARE(runs.loadAcquire(), 1);
+    QCOMPARE(worker.pendingCount(), 1);
+    worker.flush();
+    QCOMPARE(order, QList<int>() << 2 << 1);
+}
+
+void TestPersistenceWorker::testDestructorFlushes()
+{
+    QAtomicInt runs;
+    {
+        PersistenceWorker worker(60000);
+        worker.post("theme", [&runs]() {
+            runs.fetchAndAddOrdered(1);
+        });
+        worker.post([&runs]() {
+            runs.fetchAndAddOrdered(1);
+        });
+    }
+    QCOMPARE(runs.loadAcquire(), 2);
+}
+
+void TestPersistenceWorker::testHistoryInBackground()
+{
+    QTemporaryDir directory;
+    QVERIFY(directory.isValid());
+    const QString textFile = directory.filePath("history.txt");
+    const QString journalFile = directory.filePath("history.journal");
+
+    PersistenceWorker worker(60000);
+    CalculationHistory history;
+    history.setPersistenceWorker(&worker);
+    history.addEntry("1 + 1 = 2");
+    history.addEntry("2 + 2 = 4");
+
+    // Сохранение откладывается, но чтение того же файла его дожидается
+    history.saveToFile(textFile);
+    QCOMPARE(worker.pendingCount(), 1);
+    CalculationHistory loaded;
+    loaded.setPersistenceWorker(&worker);
+    loaded.loadFromFile(textFile);
+    QCOMPARE(loaded.count(), 2);
+
+    // Журнал закрывается в потоке worker, после flush() файл полон
+    QVERIFY(history.openJournal(journalFile));
+    history.addEntry("3 + 3 = 6");
+    history.closeJournal();
+    QVERIFY(!history.hasJournal());
+    worker.flush();
+
+    CalculationHistory restored;
+    restored.loadFromFile(journalFile);
+    QCOMPARE(restored.count(), 3);
+    QCOMPARE(restored.getLast(), QString("3 + 3 = 6"));
+}
+
+QTEST_MAIN(TestPersistenceWorker)
+#include "test_persistenceworker.moc"
@@ -0,0 +1,112 @@
+#include "ringbuffer.h"
+#include <QtTest/QtTest>
+#include <algorithm>
+
+/**
+ * @brief Тесты для шаблона RingBuffer
+ */
+class TestRingBuffer : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void testAppend();
+    void testEviction();
+    void testIterators();
+    void testSetCapacity();
+    void testZeroCapacity();
+};
+
+void TestRingBuffer::testAppend()
+{
+    RingBuffer<int> buffer(3);
+    QVERIFY(buffer.isEmpty());
+    QCOMPARE(buffer.capacity(), 3);
+
+    buffer.append(1);
+    buffer.append(2);
+    QCOMPARE(buffer.size(), 2);
+    QVERIFY(!buffer.isFull());
+    QCOMPARE(buffer.first(), 1);
+    QCOMPARE(buffer.last(), 2);
+
+    buffer.clear();
+    QVERIFY(buffer.isEmpty());
+    QCOMPARE(buffer.capacity(), 3);
+}
+
+void TestRingBuffer::testEviction()
+{
+    RingBuffer<int> buffer(3);
+    for (int i = 1; i <= 7; ++i) {
+        buffer.append(i);
+    }
+
+    // Остаются три последних, от старого к новому
+    QVERIFY(buffer.isFull());
+    QCOMPARE(buffer.size(), 3);
+    QCOMPARE(buffer.at(0), 5);
+    QCOMPARE(buffer.at(1), 6);
+    QCOMPARE(buffer.at(2), 7);
+}
+
+void TestRingBuffer::testIterators()
+{
+    RingBuffer<int> buffer(4);
+    for (int i = 1; i <= 6; ++i) {
+        buffer.append(i);
+    }
+
+    QVector<int> forward;
+    for (int value : buffer) {
+        forward.append(value);
+    }
+    QCOMPARE(forward, QVector<int>() << 3 << 4 << 5 << 6);
+
+    QVector<int> backward;
+    for (RingBuffer<int>::const_reverse_iterator it = buffer.rbegin(); it != buffer.rend(); ++it) {
+        backward.append(*it);
+    }
+    QCOMPARE(backward, QVector<int>() << 6 << 5 << 4 << 3);
+
+    QCOMPARE(buffer.end() - buffer.begin(), 4);
+    QCOMPARE(buffer.begin()[2], 5);
+    QVERIFY(std::find(buffer.begin(), buffer.end(), 5) == buffer.begin() + 2);
+}
+
+void TestRingBuffer::testSetCapacity()
+{
+    RingBuffer<int> buffer(5);
+    for (int i = 1; i <= 8; ++i) {
+        buffer.append(i);
+    }
+
+    // Уменьшение оставляет самые новые
+    buffer.setCapacity(2);
+    QCOMPARE(buffer.size(), 2);
+    QCOMPARE(buffer.first(), 7);
+    QCOMPARE(buffer.last(), 8);
+
+    // Увеличение сохраняет порядок и дает место без вытеснения
+    buffer.setCapacity(4);
+    buffer.append(9);
+    buffer.append(10);
+    QCOMPARE(buffer.size(), 4);
+    QCOMPARE(buffer.first(), 7);
+    buffer.append(11);
+    QCOMPARE(buffer.first(), 8);
+    QCOMPARE(buffer.last(), 11);
+}
+
+void TestRingBuffer::testZeroCapacity()
+{
+    RingBuffer<int> buffer(0);
+    buffer.append(1);
+    QVERIFY(buffer.isEmpty());
+
+    RingBuffer<int> negative(-5);
+    QCOMPARE(negative.capacity(), 0);
+}
+
+QTEST_MAIN(TestRingBuffer)
+#include "test_ringbuffer.moc"
@@ -0,0 +1,194 @@
+#include "tracer.h"
+#include <QtTest/QtTest>
+#include <QJsonArray>
+#include <QJsonObject>
+#include <QTemporaryDir>
+#include <QThread>
+#include <functional>
+
+/**
+ * @brief Тесты для класса Tracer
+ *
+ * Запись интервалов только во включенном режиме, вытеснение старых событий,
+ * буферы разных потоков и формат Chrome trace.
+ */
+class TestTracer : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void init();
+    void cleanup();
+    void testDisabled();
+    void testSpan();
+    void testRingBuffer();
+    void testThreads();
+    void testJson();
+};
+
+namespace {
+
+class FunctionThread : public QThread
+{
+public:
+    explicit FunctionThread(const std::function<void()>& function)
+        : m_function(function)
+    {
+    }
+
+protected:
+    void run() override
+    {
+        m_function();
+    }
+
+private:
+    std::function<void()> m_function;
+};
+
+// События текущего потока: его буфер создается первым интервалом
+QVector<Tracer::Event> currentThreadEvents(const QString& name)
+{
+    for (const Tracer::Thread& thread : Tracer::threads()) {
+        if (thread.name == name) {
+            return thread.events;
+        }
+    }
+    return QVector<Tracer::Event>();
+}
+
+} // namespace
+
+void TestTracer::init()
+{
+    Tracer::setThreadName("test");
+    Tracer::clear();
+}
+
+void TestTracer::cleanup()
+{
+    Tracer::setEnabled(false);
+    Tracer::clear();
+}
+
+void TestTracer::testDisabled()
+{
+    QVERIFY(!Tracer::isEnabled());
+    {
+        const TraceSpan span("test", "disabled");
+    }
+    QCOMPARE(Tracer::eventCount(), 0);
+}
+
+void TestTracer::testSpan()
+{
+    Tracer::setEnabled(true);
+    const qint64 before = Tracer::now();
+    {
+        const TraceSpan outer("test", "outer");
+        const TraceSpan inner("test", "inner");
+    }
+    const qint64 after = Tracer::now();
+
+    // Вложенный интервал закрывается первым
+    const QVector<Tracer::Event> events = currentThreadEvents("test");
+    QCOMPARE(events.size(), 2);
+    QCOMPARE(QString(events.at(0).name), QString("inner"));
+    QCOMPARE(QString(events.at(1).name), QString("outer"));
+    QCOMPARE(QString(events.at(1).category), QString("test"));
+    QVERIFY(events.at(1).start >= before);
+    QVERIFY(events.at(1).start <= events.at(0).start);
+    QVERIFY(events.at(0).start + events.at(0).duration
+            <= events.at(1).start + events.at(1).duration);
+    QVERIFY(events.at(1).start + events.at(1).duration <= after);
+}
+
+void TestTracer::testRingBuffer()
+{
+    // Емкость действует на буферы новых потоков
+    const int capacity = Tracer::bufferCapacity();
+    Tracer::setBufferCapacity(4);
+    Tracer::setEnabled(true);
+    FunctionThread* thread = new FunctionThread([]() {
+        Tracer::setThreadName("ring");
+        for (qint64 i = 0; i < 10; ++i) {
+            Tracer::record("test", "ring", i, 1);
+        }
+    });
+    thread->start();
+    thread->wait();
+    delete thread;
+    Tracer::setBufferCapacity(capacity);
+
+    const QVector<Tracer::Event> events = currentThreadEvents("ring");
+    QCOMPARE(events.size(), 4);
+    QCOMPARE(events.first().start, qint64(6));
+    QCOMPARE(events.last().start, qint64(9));
+}
+
+void TestTracer::testThreads()
+{
+    Tracer::setEnabled(true);
+    const int threadCount = 4;
+    const int spans = 1000;
+    QVector<FunctionThread*> threads;
+    for (int i = 0; i < threadCount; ++i) {
+        threads.append(new FunctionThread([i, spans]() {
+            Tracer::setThreadName(QString("worker %1").arg(i));
+            for (int j = 0; j < spans; ++j) {
+                const TraceSpan span("test", "worker");
+            }
+        }));
+        threads.last()->start();
+    }
+    for (FunctionThread* thread : threads) {
+        thread->wait();
+        delete thread;
+    }
+
+    QSet<int> ids;
+    for (const Tracer::Thread& thread : Tracer::threads()) {
+        QVERIFY(!ids.contains(thread.id));
+        ids.insert(thread.id);
+    }
+    for (int i = 0; i < threadCount; ++i) {
+        QCOMPARE(currentThreadEvents(QString("worker %1").arg(i)).size(), spans);
+    }
+    QCOMPARE(Tracer::eventCount(), threadCount * spans);
+}
+
+void TestTracer::testJson()
+{
+    Tracer::setEnabled(true);
+    Tracer::record("history", "CalculationHistory::saveToFile", 2500, 1500);
+
+    const QJsonObject root = Tracer::toJson().object();
+    const QJsonArray events = root["traceEvents"].toArray();
+    int threadNames = 0;
+    QJsonObject span;
+    for (int i = 0; i < events.size(); ++i) {
+        const QJsonObject event = events.at(i).toObject();
+        if (event["ph"].toString() == "M" && event["name"].toString() == "thread_name") {
+            ++threadNames;
+        }
+        if (event["ph"].toString() == "X") {
+            span = event;
+        }
+    }
+    QCOMPARE(threadNames, Tracer::threads().size());
+    QCOMPARE(span["name"].toString(), QString("CalculationHistory::saveToFile"));
+    QCOMPARE(span["cat"].toString(), QString("history"));
+    QCOMPARE(span["ts"].toDouble(), 2.5);
+    QCOMPARE(span["dur"].toDouble(), 1.5);
+
+    QTemporaryDir directory;
+    QVERIFY(directory.isValid());
+    const QString filename = directory.filePath("trace.json");
+    QVERIFY(Tracer::writeJson(filename));
+    QFile file(filename);
+    QVERIFY(file.open(QIODevice::ReadOnly));
+    QCOMPARE(file.readAll(), Tracer::toJson().toJson(QJsonDocument::Compact));
+}
+
+QTEST_MAIN(TestTracer)
+#include "test_tracer.moc"